@@ -0,0 +1,716 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <vector>
+#include <cstdlib>
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+#include "parcat.h"
+
+#define PRINT_NALUS 0
+
+enum NalUnitType
+{
+  TRAIL_N = 0, // 0
+  TRAIL_R,     // 1
+
+  TSA_N,       // 2
+  TSA_R,       // 3
+
+  STSA_N,      // 4
+  STSA_R,      // 5
+
+  RADL_N,      // 6
+  RADL_R,      // 7
+
+  RASL_N,      // 8
+  RASL_R,      // 9
+
+  RESERVED_VCL_N10,
+  RESERVED_VCL_R11,
+  RESERVED_VCL_N12,
+  RESERVED_VCL_R13,
+  RESERVED_VCL_N14,
+  RESERVED_VCL_R15,
+
+  BLA_W_LP,    // 16
+  BLA_W_RADL,  // 17
+  BLA_N_LP,    // 18
+  IDR_W_RADL,  // 19
+  IDR_N_LP,    // 20
+  CRA,         // 21
+  RESERVED_IRAP_VCL22,
+  RESERVED_IRAP_VCL23,
+
+  RESERVED_VCL24,
+  RESERVED_VCL25,
+  RESERVED_VCL26,
+  RESERVED_VCL27,
+  RESERVED_VCL28,
+  RESERVED_VCL29,
+  RESERVED_VCL30,
+  RESERVED_VCL31,
+
+  VPS,                     // 32
+  SPS,                     // 33
+  PPS,                     // 34
+  ACCESS_UNIT_DELIMITER,   // 35
+  EOS,                     // 36
+  EOB,                     // 37
+  FILLER_DATA,             // 38
+  PREFIX_SEI,              // 39
+  SUFFIX_SEI,              // 40
+
+  RESERVED_NVCL41,
+  RESERVED_NVCL42,
+  RESERVED_NVCL43,
+  RESERVED_NVCL44,
+  RESERVED_NVCL45,
+  RESERVED_NVCL46,
+  RESERVED_NVCL47,
+  UNSPECIFIED_48,
+  UNSPECIFIED_49,
+  UNSPECIFIED_50,
+  UNSPECIFIED_51,
+  UNSPECIFIED_52,
+  UNSPECIFIED_53,
+  UNSPECIFIED_54,
+  UNSPECIFIED_55,
+  UNSPECIFIED_56,
+  UNSPECIFIED_57,
+  UNSPECIFIED_58,
+  UNSPECIFIED_59,
+  UNSPECIFIED_60,
+  UNSPECIFIED_61,
+  UNSPECIFIED_62,
+  UNSPECIFIED_63,
+  INVALID,
+};
+
+const bool verbose = false;
+
+const char * NALU_TYPE[] =
+{
+    "TRAIL_N",
+    "TRAIL_R",
+    "TSA_N",
+    "TSA_R",
+    "STSA_N",
+    "STSA_R",
+    "RADL_N",
+    "RADL_R",
+    "RASL_N",
+    "RASL_R",
+    "RSV_VCL_N10",
+    "RSV_VCL_N12",
+    "RSV_VCL_N14",
+    "RSV_VCL_R11",
+    "RSV_VCL_R13",
+    "RSV_VCL_R15",
+    "BLA_W_LP",
+    "BLA_W_RADL",
+    "BLA_N_LP",
+    "IDR_W_RADL",
+    "IDR_N_LP",
+    "CRA_NUT",
+    "RSV_IRAP_VCL22",
+    "RSV_IRAP_VCL23",
+    "unk",
+    "unk",
+    "unk",
+    "unk",
+    "unk",
+    "unk",
+    "unk",
+    "unk",
+    "VPS_NUT",
+    "SPS_NUT",
+    "PPS_NUT",
+    "AUD_NUT",
+    "EOS_NUT",
+    "EOB_NUT",
+    "FD_NUT",
+    "PREFIX_SEI_NUT",
+    "SUFFIX_SEI_NUT",
+};
+
+/// size of the blocks in which the segments are read and the output file is written
+static const size_t chunk_size = 1 << 22;
+
+/**
+ Find the first zero byte sequence 0x000000 or start code prefix 0x000001, both of which end a NAL unit.
+ @param[in]  p    the beginning of the buffer
+ @param[in]  end  the end of the buffer
+ @return          the position of the first byte of the sequence, or end if there is none
+ */
+static const uint8_t * find_zero_sequence(const uint8_t * p, const uint8_t * end)
+{
+  while (end - p >= 3)
+  {
+    p = (const uint8_t *) memchr(p, 0, end - p - 2);
+    if (p == NULL)
+    {
+      return end;
+    }
+    if (p[1] == 0 && p[2] <= 1)
+    {
+      return p;
+    }
+    p++;
+  }
+  return end;
+}
+
+/**
+ Find the first start code prefix 0x000001.
+ @param[in]  p    the beginning of the buffer
+ @param[in]  end  the end of the buffer
+ @return          the position of the first byte of the start code prefix, or end if there is none
+ */
+static const uint8_t * find_start_code(const uint8_t * p, const uint8_t * end)
+{
+  for (p = find_zero_sequence(p, end); p != end && p[2] != 0x01; p = find_zero_sequence(p + 1, end))
+  {
+  }
+  return p;
+}
+
+/// reader of the RBSP bits of a NAL unit, which skips the emulation prevention bytes of the EBSP
+struct rbsp_reader
+{
+  const uint8_t * data;      ///< the NAL unit, starting with the NAL unit header
+  size_t          size;      ///< the size of the NAL unit
+  size_t          byte_pos;  ///< the byte of the next bit
+  int             bit_pos;   ///< the next bit in the byte, 0 is the most significant bit
+  int             zeros;     ///< the number of zero bytes preceding byte_pos
+  bool            overrun;   ///< set when a read goes beyond the end of the NAL unit
+};
+
+static void rbsp_init(rbsp_reader & r, const uint8_t * nalu, size_t size)
+{
+  r.data = nalu;
+  r.size = size;
+  r.byte_pos = 2; // skip the NAL unit header
+  r.bit_pos = 0;
+  r.zeros = 0;
+  r.overrun = false;
+}
+
+/**
+ Read one bit.
+ @param[in,out]  r         the reader
+ @param[out]     byte_pos  the byte of the NAL unit holding the bit, may be NULL
+ @param[out]     bit_pos   the bit within the byte, 0 is the most significant bit, may be NULL
+ @return                   the bit, 0 if the NAL unit is overrun
+ */
+static uint32_t read_bit(rbsp_reader & r, size_t * byte_pos = NULL, int * bit_pos = NULL)
+{
+  if (r.bit_pos == 0 && r.zeros >= 2 && r.byte_pos < r.size && r.data[r.byte_pos] == 0x03)
+  {
+    // emulation_prevention_three_byte
+    r.byte_pos++;
+    r.zeros = 0;
+  }
+  if (r.byte_pos >= r.size)
+  {
+    r.overrun = true;
+    return 0;
+  }
+  if (byte_pos != NULL)
+  {
+    *byte_pos = r.byte_pos;
+    *bit_pos = r.bit_pos;
+  }
+  uint32_t bit = (r.data[r.byte_pos] >> (7 - r.bit_pos)) & 1;
+  if (++r.bit_pos == 8)
+  {
+    r.zeros = r.data[r.byte_pos] == 0 ? r.zeros + 1 : 0;
+    r.byte_pos++;
+    r.bit_pos = 0;
+  }
+  return bit;
+}
+
+/// read a u(n) syntax element
+static uint32_t read_bits(rbsp_reader & r, int n)
+{
+  uint32_t value = 0;
+  for (int i = 0; i < n; i++)
+  {
+    value = (value << 1) | read_bit(r);
+  }
+  return value;
+}
+
+/// read a ue(v) syntax element
+static uint32_t read_uvlc(rbsp_reader & r)
+{
+  int leading_zeros = 0;
+  while (read_bit(r) == 0 && !r.overrun && leading_zeros < 32)
+  {
+    leading_zeros++;
+  }
+  if (leading_zeros >= 32)
+  {
+    r.overrun = true;
+    return 0;
+  }
+  return (1u << leading_zeros) - 1 + read_bits(r, leading_zeros);
+}
+
+/// syntax elements of a sequence parameter set needed to locate slice_pic_order_cnt_lsb
+struct parcat_sps
+{
+  bool valid;
+  bool separate_colour_plane_flag;
+  int  bits_for_poc;                 ///< log2_max_pic_order_cnt_lsb_minus4 + 4
+  int  slice_segment_address_bits;   ///< Ceil(Log2(PicSizeInCtbsY))
+};
+
+/// syntax elements of a picture parameter set needed to locate slice_pic_order_cnt_lsb
+struct parcat_pps
+{
+  bool valid;
+  int  sps_id;
+  bool dependent_slice_segments_enabled_flag;
+  bool output_flag_present_flag;
+  int  num_extra_slice_header_bits;
+};
+
+/// the parameter sets of a segment, indexed by their id
+struct parcat_parameter_sets
+{
+  parcat_sps sps[16];
+  parcat_pps pps[64];
+};
+
+static void skip_profile_tier_level(rbsp_reader & r, int max_sub_layers_minus1)
+{
+  read_bits(r, 8);  // general_profile_space, general_tier_flag, general_profile_idc
+  read_bits(r, 32); // general_profile_compatibility_flag[]
+  read_bits(r, 32); // general_progressive_source_flag ... general_max_14bit_constraint_flag and reserved bits
+  read_bits(r, 16); // ... general_inbld_flag or reserved bit
+  read_bits(r, 8);  // general_level_idc
+  bool sub_layer_profile_present_flag[8];
+  bool sub_layer_level_present_flag[8];
+  for (int i = 0; i < max_sub_layers_minus1; i++)
+  {
+    sub_layer_profile_present_flag[i] = read_bit(r) != 0;
+    sub_layer_level_present_flag[i] = read_bit(r) != 0;
+  }
+  if (max_sub_layers_minus1 > 0)
+  {
+    read_bits(r, 2 * (8 - max_sub_layers_minus1)); // reserved_zero_2bits[]
+  }
+  for (int i = 0; i < max_sub_layers_minus1; i++)
+  {
+    if (sub_layer_profile_present_flag[i])
+    {
+      read_bits(r, 8);  // sub_layer_profile_space[], sub_layer_tier_flag[], sub_layer_profile_idc[]
+      read_bits(r, 32); // sub_layer_profile_compatibility_flag[][]
+      read_bits(r, 32); // sub_layer_progressive_source_flag[] ... reserved bits
+      read_bits(r, 16); // ... sub_layer_inbld_flag[] or reserved bit
+    }
+    if (sub_layer_level_present_flag[i])
+    {
+      read_bits(r, 8); // sub_layer_level_idc[]
+    }
+  }
+}
+
+/**
+ Parse the part of a sequence parameter set that is needed to locate slice_pic_order_cnt_lsb.
+ @return  false if the parameter set could not be parsed
+ */
+static bool parse_sps(const uint8_t * nalu, size_t size, parcat_parameter_sets & ps)
+{
+  rbsp_reader r;
+  rbsp_init(r, nalu, size);
+  read_bits(r, 4); // sps_video_parameter_set_id
+  int max_sub_layers_minus1 = read_bits(r, 3);
+  read_bit(r);     // sps_temporal_id_nesting_flag
+  skip_profile_tier_level(r, max_sub_layers_minus1);
+  uint32_t sps_id = read_uvlc(r);
+  if (r.overrun || sps_id >= 16)
+  {
+    return false;
+  }
+  parcat_sps & sps = ps.sps[sps_id];
+  uint32_t chroma_format_idc = read_uvlc(r);
+  sps.separate_colour_plane_flag = chroma_format_idc == 3 && read_bit(r) != 0;
+  uint32_t pic_width = read_uvlc(r);
+  uint32_t pic_height = read_uvlc(r);
+  if (read_bit(r)) // conformance_window_flag
+  {
+    read_uvlc(r);
+    read_uvlc(r);
+    read_uvlc(r);
+    read_uvlc(r);
+  }
+  read_uvlc(r);    // bit_depth_luma_minus8
+  read_uvlc(r);    // bit_depth_chroma_minus8
+  sps.bits_for_poc = read_uvlc(r) + 4;
+  bool sub_layer_ordering_info_present_flag = read_bit(r) != 0;
+  for (int i = sub_layer_ordering_info_present_flag ? 0 : max_sub_layers_minus1; i <= max_sub_layers_minus1; i++)
+  {
+    read_uvlc(r);  // sps_max_dec_pic_buffering_minus1[]
+    read_uvlc(r);  // sps_max_num_reorder_pics[]
+    read_uvlc(r);  // sps_max_latency_increase_plus1[]
+  }
+  uint32_t log2_min_cb_size = read_uvlc(r) + 3;
+  uint32_t log2_ctb_size = log2_min_cb_size + read_uvlc(r);
+  if (r.overrun || sps.bits_for_poc > 16 || log2_ctb_size > 6)
+  {
+    sps.valid = false;
+    return false;
+  }
+  uint32_t ctb_size = 1 << log2_ctb_size;
+  uint32_t pic_size_in_ctbs = ((pic_width + ctb_size - 1) / ctb_size) * ((pic_height + ctb_size - 1) / ctb_size);
+  sps.slice_segment_address_bits = 0;
+  while ((1u << sps.slice_segment_address_bits) < pic_size_in_ctbs)
+  {
+    sps.slice_segment_address_bits++;
+  }
+  sps.valid = true;
+  return true;
+}
+
+/**
+ Parse the part of a picture parameter set that is needed to locate slice_pic_order_cnt_lsb.
+ @return  false if the parameter set could not be parsed
+ */
+static bool parse_pps(const uint8_t * nalu, size_t size, parcat_parameter_sets & ps)
+{
+  rbsp_reader r;
+  rbsp_init(r, nalu, size);
+  uint32_t pps_id = read_uvlc(r);
+  if (r.overrun || pps_id >= 64)
+  {
+    return false;
+  }
+  parcat_pps & pps = ps.pps[pps_id];
+  pps.sps_id = read_uvlc(r);
+  pps.dependent_slice_segments_enabled_flag = read_bit(r) != 0;
+  pps.output_flag_present_flag = read_bit(r) != 0;
+  pps.num_extra_slice_header_bits = read_bits(r, 3);
+  pps.valid = !r.overrun && pps.sps_id < 16;
+  return pps.valid;
+}
+
+/// mask of the positions in [begin, end) of the NAL unit that start a 0x000000, 0x000001, 0x000002 or 0x000003 pattern
+static uint32_t emulation_patterns(const uint8_t * nalu, size_t size, size_t begin, size_t end)
+{
+  uint32_t mask = 0;
+  for (size_t i = begin; i < end && i + 2 < size; i++)
+  {
+    if (nalu[i] == 0 && nalu[i + 1] == 0 && nalu[i + 2] <= 3)
+    {
+      mask |= 1u << (i - begin);
+    }
+  }
+  return mask;
+}
+
+/**
+ Rewrite the slice_pic_order_cnt_lsb of a non-IDR slice segment in place, shifting the POC by poc_base.
+ The slice segment header is parsed up to slice_pic_order_cnt_lsb with the parameter sets of the segment. As the
+ NAL unit is rewritten in place, a rewrite that would need emulation prevention bytes to be added or removed fails.
+ @param[in,out]  nalu          the NAL unit, starting with the NAL unit header
+ @param[in]      size          the size of the NAL unit
+ @param[in]      nalu_type     the NAL unit type
+ @param[in]      ps            the parameter sets of the segment
+ @param[in]      poc_base      the POC offset of the segment
+ @param[out]     first_slice   set to the first_slice_segment_in_pic_flag
+ @return                       false if the slice segment header could not be parsed or rewritten
+ */
+static bool rewrite_poc(uint8_t * nalu, size_t size, int nalu_type, const parcat_parameter_sets & ps, int poc_base, bool * first_slice)
+{
+  rbsp_reader r;
+  rbsp_init(r, nalu, size);
+
+  *first_slice = read_bit(r) != 0;
+  if (nalu_type >= BLA_W_LP && nalu_type <= RESERVED_IRAP_VCL23)
+  {
+    read_bit(r); // no_output_of_prior_pics_flag
+  }
+  uint32_t pps_id = read_uvlc(r);
+  if (r.overrun || pps_id >= 64 || !ps.pps[pps_id].valid || !ps.sps[ps.pps[pps_id].sps_id].valid)
+  {
+    fprintf(stderr, "Error: slice segment refers to a missing parameter set\n");
+    return false;
+  }
+  const parcat_pps & pps = ps.pps[pps_id];
+  const parcat_sps & sps = ps.sps[pps.sps_id];
+
+  if (!*first_slice)
+  {
+    if (pps.dependent_slice_segments_enabled_flag && read_bit(r))
+    {
+      // a dependent slice segment takes the POC of the preceding slice segment
+      return !r.overrun;
+    }
+    read_bits(r, sps.slice_segment_address_bits); // slice_segment_address
+  }
+  read_bits(r, pps.num_extra_slice_header_bits);  // slice_reserved_flag[]
+  read_uvlc(r);                                   // slice_type
+  if (pps.output_flag_present_flag)
+  {
+    read_bit(r);                                  // pic_output_flag
+  }
+  if (sps.separate_colour_plane_flag)
+  {
+    read_bits(r, 2);                              // colour_plane_id
+  }
+
+  size_t byte_pos[16];
+  int bit_pos[16];
+  uint32_t poc_lsb = 0;
+  for (int i = 0; i < sps.bits_for_poc; i++)
+  {
+    poc_lsb = (poc_lsb << 1) | read_bit(r, &byte_pos[i], &bit_pos[i]);
+  }
+  if (r.overrun)
+  {
+    fprintf(stderr, "Error: slice segment header is truncated\n");
+    return false;
+  }
+
+  // only the LSBs are coded, the POC MSBs of the segment do not change them. The IDR pictures of all but the first
+  // segment are dropped, so the POCs of the output are counted from the IDR picture at POC 0
+  uint32_t new_poc_lsb = (poc_lsb + poc_base) & ((1u << sps.bits_for_poc) - 1);
+
+  size_t window_begin = byte_pos[0] < 4 ? 2 : byte_pos[0] - 2;
+  size_t window_end = byte_pos[sps.bits_for_poc - 1] + 1;
+  uint32_t patterns = emulation_patterns(nalu, size, window_begin, window_end);
+  for (int i = 0; i < sps.bits_for_poc; i++)
+  {
+    uint8_t bit = uint8_t(0x80 >> bit_pos[i]);
+    if ((new_poc_lsb >> (sps.bits_for_poc - 1 - i)) & 1)
+    {
+      nalu[byte_pos[i]] |= bit;
+    }
+    else
+    {
+      nalu[byte_pos[i]] &= ~bit;
+    }
+  }
+  if (emulation_patterns(nalu, size, window_begin, window_end) != patterns)
+  {
+    fprintf(stderr, "Error: the rewritten slice_pic_order_cnt_lsb would need a change of emulation prevention bytes\n");
+    return false;
+  }
+  return true;
+}
+
+/**
+ Filter a segment and append it to the output file.
+ The segment is read in chunks, the NAL units are modified in the read buffer and consecutive NAL units that are
+ kept are written with a single call, so that the memory use does not depend on the segment size.
+ @param[in]      path          the segment bitstream file
+ @param[in]      idx           the index of the segment, starting at 1
+ @param[in,out]  poc_base      the POC offset of the segment, incremented by the number of pictures of the segment
+ @param[in]      fdo           the output file
+ @return                       false if the segment could not be read or the output file could not be written
+ */
+static bool process_segment(const char * path, int idx, int * poc_base, FILE * fdo)
+{
+  FILE * fdi = fopen(path, "rb");
+
+  if (fdi == NULL)
+  {
+    fprintf(stderr, "Error: could not open input file: %s\n", path);
+    return false;
+  }
+
+  std::vector<uint8_t> buf(chunk_size);
+  size_t len = 0;          // number of bytes in buf
+  size_t pos = 0;          // end of the last NAL unit processed
+  size_t run_start = 0;    // bytes kept, but not yet written
+  size_t run_end = 0;
+  long long buf_offset = 0; // file offset of buf[0]
+  bool eof = false;
+  bool ok = true;
+
+  int cnt = 0;
+  bool idr_found = false;
+  bool skip_next_sei = false;
+  bool parsed = true;
+  parcat_parameter_sets ps = parcat_parameter_sets();
+
+  while (ok && parsed)
+  {
+    const uint8_t * begin = buf.data() + pos;
+    const uint8_t * end = buf.data() + len;
+    const uint8_t * start_code = find_start_code(begin, end);
+    const uint8_t * nal_end = start_code == end ? end : find_zero_sequence(start_code + 3, end);
+
+    if (nal_end == end && !eof)
+    {
+      // the NAL unit may continue after the buffer: write the kept bytes, move the rest to the front and read on
+      ok = fwrite(buf.data() + run_start, 1, run_end - run_start, fdo) == run_end - run_start;
+      memmove(buf.data(), buf.data() + pos, len - pos);
+      buf_offset += pos;
+      len -= pos;
+      pos = run_start = run_end = 0;
+      if (len == buf.size())
+      {
+        buf.resize(buf.size() * 2);
+      }
+      size_t sz = fread(buf.data() + len, 1, buf.size() - len, fdi);
+      len += sz;
+      eof = sz == 0;
+      continue;
+    }
+    if (end - start_code <= 3)
+    {
+      break;
+    }
+
+    const size_t nal_start = start_code + 3 - buf.data();
+    const size_t nal_stop = nal_end - buf.data();
+
+    if(verbose)
+    {
+       printf( "!! Found NAL at offset %lld (0x%04llX), size %lld (0x%04llX) \n",
+          buf_offset + (long long int)pos,
+          buf_offset + (long long int)pos,
+          (long long int)(nal_stop - nal_start),
+          (long long int)(nal_stop - nal_start) );
+    }
+
+    int nalu_type = buf[nal_start] >> 1;
+
+    if (nalu_type == SPS && !parse_sps(&buf[nal_start], nal_stop - nal_start, ps))
+    {
+      fprintf(stderr, "Error: could not parse SPS in %s\n", path);
+      parsed = false;
+      break;
+    }
+    if (nalu_type == PPS && !parse_pps(&buf[nal_start], nal_stop - nal_start, ps))
+    {
+      fprintf(stderr, "Error: could not parse PPS in %s\n", path);
+      parsed = false;
+      break;
+    }
+    if(nalu_type < 32 && nalu_type != IDR_W_RADL && nalu_type != IDR_N_LP)
+    {
+      bool first_slice = false;
+      if (!rewrite_poc(&buf[nal_start], nal_stop - nal_start, nalu_type, ps, *poc_base, &first_slice))
+      {
+        fprintf(stderr, "Error: could not rewrite the POC of a slice segment in %s\n", path);
+        parsed = false;
+        break;
+      }
+      if (first_slice)
+      {
+        ++cnt;
+      }
+    }
+
+    if(idx > 1 && (nalu_type == IDR_W_RADL || nalu_type == IDR_N_LP))
+    {
+      skip_next_sei = true;
+      idr_found = true;
+    }
+
+    if((idx > 1 && (nalu_type == IDR_W_RADL || nalu_type == IDR_N_LP )) || ((idx>1 && !idr_found) && ( nalu_type == VPS || nalu_type == SPS || nalu_type == PPS))
+      || (nalu_type == SUFFIX_SEI && skip_next_sei))
+    {
+    }
+    else
+    {
+      if (run_end != pos)
+      {
+        ok = fwrite(buf.data() + run_start, 1, run_end - run_start, fdo) == run_end - run_start;
+        run_start = pos;
+      }
+      run_end = nal_stop;
+    }
+
+    if(nalu_type == SUFFIX_SEI && skip_next_sei)
+    {
+      skip_next_sei = false;
+    }
+
+    pos = nal_stop;
+  }
+
+  if (ok && parsed && fwrite(buf.data() + run_start, 1, run_end - run_start, fdo) != run_end - run_start)
+  {
+    ok = false;
+  }
+  if (!ok)
+  {
+    fprintf(stderr, "Error: could not write output file\n");
+  }
+  else if (!parsed)
+  {
+    ok = false;
+  }
+  else if (ferror(fdi))
+  {
+    fprintf(stderr, "Error: input file was not read completely: %s\n", path);
+    ok = false;
+  }
+  fclose(fdi);
+
+  *poc_base += cnt;
+  return ok;
+}
+
+bool parcat(const std::vector<std::string> & segments, const std::string & output)
+{
+  FILE * fdo = fopen(output.c_str(), "wb");
+  if (fdo==NULL)
+  {
+    fprintf(stderr, "Error: could not open output file: %s\n", output.c_str());
+    return false;
+  }
+  setvbuf(fdo, NULL, _IOFBF, chunk_size);
+  int poc_base = 0;
+  bool ok = true;
+
+  for(size_t i = 0; i < segments.size() && ok; ++i)
+  {
+    ok = process_segment(segments[i].c_str(), int(i + 1), &poc_base, fdo);
+  }
+
+  if (fclose(fdo) != 0 && ok)
+  {
+    fprintf(stderr, "Error: could not write output file: %s\n", output.c_str());
+    ok = false;
+  }
+  return ok;
+}
@@ -42,7 +42,7 @@
 
 #include "SEIRemovalApp.h"
 #include "TLibDecoder/AnnexBread.h"
-#include "TLibDecoder/NALread.h"
+#include "TLibDecoder/TDecHeaderParser.h"
 
 //! \ingroup DecoderApp
 //! \{
@@ -68,19 +68,15 @@ SEIRemovalApp::SEIRemovalApp()
  - returns the number of mismatching pictures
  */
 
-Void read2(InputNALUnit& nalu)
+Void read2(const uint8_t* nalUnit, NALUnit& nalu)
 {
-  TComInputBitstream& bs = nalu.getBitstream();
-
-  Bool forbidden_zero_bit = bs.read(1);           // forbidden_zero_bit
+  Bool forbidden_zero_bit = (nalUnit[0] >> 7) != 0;  // forbidden_zero_bit
   if (forbidden_zero_bit != 0)
   {
     std::cerr << "Forbidden zero-bit not '0'" << std::endl;
     exit(1);
   }
-  nalu.m_nalUnitType = (NalUnitType) bs.read(6);  // nal_unit_type
-  nalu.m_nuhLayerId = bs.read(6);                 // nuh_layer_id
-  nalu.m_temporalId = bs.read(3) - 1;             // nuh_temporal_id_plus1
+  TDecHeaderParser::parseNalUnitHeader(nalUnit, nalu); // nal_unit_type, nuh_layer_id, nuh_temporal_id_plus1
 }
 
 UInt SEIRemovalApp::decode()
@@ -97,29 +93,19 @@ UInt SEIRemovalApp::decode()
 
   ofstream bitstreamFileOut(m_bitstreamFileNameOut.c_str(), ifstream::out | ifstream::binary);
 
-  InputByteStream bytestream(bitstreamFileIn);
-
-  bitstreamFileIn.clear();
-  bitstreamFileIn.seekg( 0, ios::beg );
+  AnnexBNALUnitReader nalUnitReader(bitstreamFileIn);
 
   int unitCnt = 0;
 
-  while (!!bitstreamFileIn)
+  const uint8_t* nalUnit = NULL;
+  size_t numBytes = 0;
+  AnnexBStats stats = AnnexBStats();
+  while (nalUnitReader.readNALUnit(nalUnit, numBytes, stats))
   {
-    /* location serves to work around a design fault in the decoder, whereby
-     * the process of reading a new slice that is the first slice of a new frame
-     * requires the SEIRemovalApp::decode() method to be called again with the same
-     * nal unit. */
-    AnnexBStats stats = AnnexBStats();
-
-    InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
-
     // call actual decoding function
-    if (nalu.getBitstream().getFifo().empty())
+    if (numBytes < 2)
     {
       /* this can happen if the following occur:
-       *  - empty input file
        *  - two back-to-back start_code_prefixes
        *  - start_code_prefix immediately followed by EOF
        */
@@ -127,7 +113,8 @@ UInt SEIRemovalApp::decode()
     }
     else
     {
-      read2( nalu );
+      NALUnit nalu;
+      read2( nalUnit, nalu );
       unitCnt++;
 
       bool bWrite = true;
@@ -142,9 +129,10 @@ UInt SEIRemovalApp::decode()
         char ch = 0;
         for( int i = 0 ; i < iNumZeros; i++ ) { bitstreamFileOut.write( &ch, 1 ); }
         ch = 1; bitstreamFileOut.write( &ch, 1 );
-        bitstreamFileOut.write( (const char*)nalu.getBitstream().getFifo().data(), nalu.getBitstream().getFifo().size() );
+        bitstreamFileOut.write( (const char*)nalUnit, numBytes );
       }
     }
+    stats = AnnexBStats();
   }
 
   return 0;
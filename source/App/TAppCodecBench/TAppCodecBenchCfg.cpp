@@ -0,0 +1,172 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2025, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/** \file     TAppCodecBenchCfg.cpp
+    \brief    Codec throughput benchmark configuration class
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include "TAppCodecBenchCfg.h"
+#include "Utilities/program_options_lite.h"
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup TAppCodecBench
+//! \{
+
+static const TChar* const contentNames[NUMBER_OF_BENCH_CONTENTS] = { "gradient", "pan", "noise", "mixed" };
+
+// ====================================================================================================================
+// Constructor / destructor
+// ====================================================================================================================
+
+TAppCodecBenchCfg::TAppCodecBenchCfg()
+: m_outputFileName()
+, m_cfgDirectory()
+, m_cfgFileNames()
+, m_encoderOptions()
+, m_sourceWidth( 0 )
+, m_sourceHeight( 0 )
+, m_frameRate( 0 )
+, m_framesToBeEncoded( 0 )
+, m_qp( 0 )
+, m_content( BENCH_CONTENT_MIXED )
+, m_decode( true )
+{
+}
+
+TAppCodecBenchCfg::~TAppCodecBenchCfg()
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param argc number of arguments
+    \param argv array of arguments
+    \retval true when the benchmark can be run
+ */
+Bool TAppCodecBenchCfg::parseCfg( Int argc, TChar* argv[] )
+{
+  Bool do_help = false;
+  string cfg_cfgFileNames;
+  string cfg_content;
+  const string defaultCfgFileNames("encoder_intra_main.cfg encoder_intra_main10.cfg encoder_intra_main_rext.cfg "
+                                   "encoder_lowdelay_main.cfg encoder_lowdelay_main10.cfg encoder_lowdelay_main_rext.cfg "
+                                   "encoder_randomaccess_main.cfg encoder_randomaccess_main10.cfg encoder_randomaccess_main_rext.cfg");
+
+  po::Options opts;
+  opts.addOptions()
+  ("help",                      do_help,                               false,      "this help text")
+  ("Output,o",                  m_outputFileName,                      string(""), "JSON report file name, only the summary table is printed if not set")
+  ("CfgDir",                    m_cfgDirectory,                        string("cfg"), "directory holding the encoder configuration files")
+  ("Cfgs",                      cfg_cfgFileNames,              defaultCfgFileNames, "list of encoder configuration files to benchmark")
+  ("EncoderOptions",            m_encoderOptions,                      string(""), "additional options passed to every encoder run, e.g. \"--IntraPeriod=8 --SAO=0\"")
+  ("SourceWidth,-wdt",          m_sourceWidth,                         416,        "width of the synthetic source")
+  ("SourceHeight,-hgt",         m_sourceHeight,                        240,        "height of the synthetic source")
+  ("FrameRate,-fr",             m_frameRate,                           30,         "frame rate of the synthetic source")
+  ("FramesToBeEncoded,f",       m_framesToBeEncoded,                   16,         "number of frames to encode")
+  ("QP,q",                      m_qp,                                  32,         "QP used by every encoder run")
+  ("Content",                   cfg_content,                           string("mixed"), "synthetic content: gradient, pan, noise or mixed")
+  ("Decode",                    m_decode,                              true,       "decode each bitstream in-process and verify the decoded picture hashes")
+  ;
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const list<const TChar*>& argv_unhandled = po::scanArgv(opts, argc, (const TChar**) argv, err);
+
+  for (list<const TChar*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    fprintf(stderr, "Unhandled argument ignored: `%s'\n", *it);
+  }
+
+  if (do_help)
+  {
+    po::doHelp(cout, opts);
+    return false;
+  }
+
+  if (err.is_errored)
+  {
+    return false;
+  }
+
+  m_cfgFileNames.clear();
+  istringstream cfgStream(cfg_cfgFileNames);
+  string cfgFileName;
+  while (cfgStream >> cfgFileName)
+  {
+    m_cfgFileNames.push_back(cfgFileName);
+  }
+  if (m_cfgFileNames.empty())
+  {
+    fprintf(stderr, "No encoder configuration files given, aborting\n");
+    return false;
+  }
+
+  Int content = 0;
+  while (content < NUMBER_OF_BENCH_CONTENTS && cfg_content != contentNames[content])
+  {
+    content++;
+  }
+  if (content == NUMBER_OF_BENCH_CONTENTS)
+  {
+    fprintf(stderr, "Unknown Content `%s', aborting\n", cfg_content.c_str());
+    return false;
+  }
+  m_content = BenchContent(content);
+
+  if (m_sourceWidth <= 0 || m_sourceHeight <= 0 || m_frameRate <= 0 || m_framesToBeEncoded <= 0)
+  {
+    fprintf(stderr, "SourceWidth, SourceHeight, FrameRate and FramesToBeEncoded must be positive, aborting\n");
+    return false;
+  }
+
+  return true;
+}
+
+/** \param content synthetic content
+    \returns the name used for the content by the Content option
+ */
+const TChar* TAppCodecBenchCfg::getContentName( BenchContent content )
+{
+  return contentNames[content];
+}
+
+//! \}
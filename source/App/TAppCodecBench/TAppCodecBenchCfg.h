@@ -0,0 +1,98 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2025, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/** \file     TAppCodecBenchCfg.h
+    \brief    Codec throughput benchmark configuration class (header)
+*/
+
+#ifndef __TAPPCODECBENCHCFG__
+#define __TAPPCODECBENCHCFG__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TLibCommon/CommonDef.h"
+#include <string>
+#include <vector>
+
+//! \ingroup TAppCodecBench
+//! \{
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// synthetic source content
+enum BenchContent
+{
+  BENCH_CONTENT_GRADIENT = 0,                         ///< smooth gradient moving diagonally
+  BENCH_CONTENT_PAN      = 1,                         ///< textured picture panning across the frame
+  BENCH_CONTENT_NOISE    = 2,                         ///< uniform noise, uncorrelated between frames
+  BENCH_CONTENT_MIXED    = 3,                         ///< gradient, pan and noise side by side
+  NUMBER_OF_BENCH_CONTENTS
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// codec throughput benchmark configuration class
+class TAppCodecBenchCfg
+{
+protected:
+  std::string               m_outputFileName;         ///< JSON report file name, no report is written if empty
+  std::string               m_cfgDirectory;           ///< directory holding the encoder configuration files
+  std::vector<std::string>  m_cfgFileNames;           ///< encoder configuration files to benchmark, relative to m_cfgDirectory
+  std::string               m_encoderOptions;         ///< additional options passed to every encoder run
+  Int                       m_sourceWidth;
+  Int                       m_sourceHeight;
+  Int                       m_frameRate;
+  Int                       m_framesToBeEncoded;
+  Int                       m_qp;
+  BenchContent              m_content;
+  Bool                      m_decode;                 ///< decode and verify each bitstream
+
+public:
+  TAppCodecBenchCfg();
+  virtual ~TAppCodecBenchCfg();
+
+  Bool  parseCfg( Int argc, TChar* argv[] );          ///< initialize option class from configuration
+
+  static const TChar* getContentName( BenchContent content );
+};
+
+//! \}
+
+#endif // __TAPPCODECBENCHCFG__
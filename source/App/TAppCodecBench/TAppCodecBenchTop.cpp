@@ -0,0 +1,477 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2025, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/** \file     TAppCodecBenchTop.cpp
+    \brief    Codec throughput benchmark application class
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "TAppCodecBenchTop.h"
+#include "TAppEncTop.h"
+#include "TAppDecTop.h"
+#include "Utilities/program_options_lite.h"
+#include "libmd5/MD5.h"
+
+using namespace std;
+
+//! \ingroup TAppCodecBench
+//! \{
+
+/// name under which the synthetic input is registered as a TVideoIOYuv memory file
+static const TChar* const sourceFileName    = "CodecBench-source.yuv";
+/// bitstream name handed to the encoder and decoder option parsers; the file itself is never opened
+static const TChar* const bitstreamFileName = "CodecBench.bin";
+
+// ====================================================================================================================
+// Local class and function definitions
+// ====================================================================================================================
+
+/// encoder application giving access to the input file format selected by the configuration
+class BenchEncoder : public TAppEncTop
+{
+public:
+  Int          getInputFileWidth       () const { return m_inputFileWidth;  }
+  Int          getInputFileHeight      () const { return m_inputFileHeight; }
+  ChromaFormat getInputChromaFormat    () const { return m_InputChromaFormatIDC; }
+  const Int*   getInputBitDepths       () const { return m_inputBitDepth; }
+  Int          getBitDepth             ( const ChannelType chType ) const { return m_internalBitDepth[chType]; }
+  Int          getFramesToBeEncoded    () const { return m_framesToBeEncoded; }
+  Int          getNumSourceFrames      () const { return Int(m_FrameSkip) + m_framesToBeEncoded * Int(m_temporalSubsampleRatio); }
+  Double       getEncodedSeconds       () const { return Double(m_framesToBeEncoded) * m_temporalSubsampleRatio / m_iFrameRate; }
+};
+
+/// deterministic pseudo-random number generator, so that every run encodes the same source
+class BenchRandom
+{
+public:
+  BenchRandom( UInt seed ) : m_state( seed ) {}
+
+  Double next()                { m_state = m_state * 1664525u + 1013904223u; return Double( m_state >> 8 ) / Double( 1 << 24 ); }
+
+private:
+  UInt m_state;
+};
+
+/// triangle wave with period 1 and range [0, 1]
+static inline Double triangle( Double u )
+{
+  return 2.0 * fabs( u - floor( u ) - 0.5 );
+}
+
+/** synthetic sample value in the range [0, 1]
+ *  \param content content type, BENCH_CONTENT_MIXED selects the type by horizontal position
+ *  \param x       horizontal position in luma samples
+ *  \param y       vertical position in luma samples
+ *  \param frame   frame index
+ *  \param compID  colour component
+ *  \param width   picture width in luma samples
+ *  \param rng     random number generator used for noise
+ */
+static Double sampleValue( BenchContent content, Int x, Int y, Int frame, ComponentID compID, Int width, BenchRandom &rng )
+{
+  if (content == BENCH_CONTENT_MIXED)
+  {
+    content = BenchContent( std::min( x * 3 / width, 2 ) );
+  }
+  const Bool luma = isLuma( compID );
+
+  switch (content)
+  {
+    case BENCH_CONTENT_GRADIENT:
+    {
+      const Double u = ( x + 0.5 * y + 4.0 * frame ) / 256.0;
+      return luma ? 0.1 + 0.8 * triangle( u ) : 0.4 + 0.2 * triangle( 0.5 * u + 0.25 * compID );
+    }
+    case BENCH_CONTENT_PAN:
+    {
+      // a fixed texture of sinusoids and random 8x8 blocks, panning right and down
+      const Int  px   = x + 3 * frame;
+      const Int  py   = y + frame;
+      const UInt hash = ( UInt( px >> 3 ) * 73856093u ) ^ ( UInt( py >> 3 ) * 19349663u ) ^ ( UInt( compID ) * 83492791u );
+      const Double block = Double( ( hash * 2654435761u ) >> 24 ) / 255.0 - 0.5;
+      return luma ? 0.5 + 0.2 * sin( px * 0.09 ) * cos( py * 0.05 ) + 0.25 * block
+                    : 0.5 + 0.1 * sin( px * 0.03 + compID ) + 0.1 * block;
+    }
+    default:
+      return luma ? 0.2 + 0.6 * rng.next() : 0.4 + 0.2 * rng.next();
+  }
+}
+
+/// reset the peak resident set size of the process, where supported
+static Void resetPeakRss()
+{
+#ifdef __linux__
+  FILE *clearRefs = fopen( "/proc/self/clear_refs", "w" );
+  if (clearRefs != NULL)
+  {
+    fputs( "5", clearRefs );
+    fclose( clearRefs );
+  }
+#endif
+}
+
+/// peak resident set size in KB since the last resetPeakRss(), or -1 where not supported
+static Int64 getPeakRssKB()
+{
+  Int64 peak = -1;
+#ifdef __linux__
+  FILE *status = fopen( "/proc/self/status", "r" );
+  if (status != NULL)
+  {
+    TChar line[256];
+    long long value;
+    while (fgets( line, sizeof(line), status ) != NULL)
+    {
+      if (sscanf( line, "VmHWM: %lld kB", &value ) == 1)
+      {
+        peak = value;
+        break;
+      }
+    }
+    fclose( status );
+  }
+#endif
+  return peak;
+}
+
+static Double elapsedMs( const chrono::steady_clock::time_point &start )
+{
+  return chrono::duration<Double, milli>( chrono::steady_clock::now() - start ).count();
+}
+
+/// formats a measurement, or returns unavailable if the measurement was not taken
+static string formatNumber( Double value, Bool available, const TChar* format, const TChar* unavailable )
+{
+  if (!available)
+  {
+    return unavailable;
+  }
+  TChar text[64];
+  snprintf( text, sizeof(text), format, value );
+  return text;
+}
+
+static const TChar* chromaFormatName( ChromaFormat format )
+{
+  static const TChar* const names[NUM_CHROMA_FORMAT] = { "400", "420", "422", "444" };
+  return names[format];
+}
+
+// ====================================================================================================================
+// Constructor / destructor
+// ====================================================================================================================
+
+TAppCodecBenchTop::TAppCodecBenchTop()
+: m_results()
+{
+}
+
+TAppCodecBenchTop::~TAppCodecBenchTop()
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Int TAppCodecBenchTop::run()
+{
+  Int failures = 0;
+
+  for (UInt i = 0; i < m_cfgFileNames.size(); i++)
+  {
+    BenchResult result;
+    if (!xBenchCfg( m_cfgFileNames[i], result ))
+    {
+      fprintf( stderr, "\nbenchmark of `%s' failed\n", m_cfgFileNames[i].c_str() );
+      failures++;
+      continue;
+    }
+    if (result.hashErrors > 0)
+    {
+      failures++;
+    }
+    m_results.push_back( result );
+  }
+
+  xPrintSummary();
+
+  if (!m_outputFileName.empty())
+  {
+    ofstream reportFile( m_outputFileName.c_str() );
+    if (!reportFile)
+    {
+      fprintf( stderr, "\nfailed to open report file `%s'\n", m_outputFileName.c_str() );
+      return 1;
+    }
+    xWriteReport( reportFile );
+  }
+
+  return failures;
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+/** encode the synthetic source with one configuration file and decode the result, all in memory
+ *  \param cfgFileName encoder configuration file, relative to CfgDir
+ *  \param result      measurements
+ *  \retval false if the encoder or decoder could not be configured
+ */
+Bool TAppCodecBenchTop::xBenchCfg( const string &cfgFileName, BenchResult &result )
+{
+  const string cfgPath = m_cfgDirectory.empty() ? cfgFileName : m_cfgDirectory + "/" + cfgFileName;
+
+  vector<string> encoderArgs;
+  encoderArgs.push_back( "CodecBench" );
+  encoderArgs.push_back( "-c" );
+  encoderArgs.push_back( cfgPath );
+  ostringstream options;
+  options << "--SourceWidth="       << m_sourceWidth       << " "
+          << "--SourceHeight="      << m_sourceHeight      << " "
+          << "--FrameRate="         << m_frameRate         << " "
+          << "--FramesToBeEncoded=" << m_framesToBeEncoded << " "
+          << "--QP="                << m_qp                << " "
+          << "--InputFile="         << sourceFileName      << " "
+          << "--BitstreamFile="     << bitstreamFileName   << " "
+          << "--ReconFile= "
+          << "--SEIDecodedPictureHash=1 "
+          << m_encoderOptions;
+  istringstream optionStream( options.str() );
+  string option;
+  while (optionStream >> option)
+  {
+    encoderArgs.push_back( option );
+  }
+  vector<TChar*> encoderArgv;
+  for (UInt i = 0; i < encoderArgs.size(); i++)
+  {
+    encoderArgv.push_back( const_cast<TChar*>( encoderArgs[i].c_str() ) );
+  }
+
+  BenchEncoder *encoder = new BenchEncoder;
+  encoder->create();
+  Bool configured = false;
+  try
+  {
+    configured = encoder->parseCfg( Int( encoderArgv.size() ), &encoderArgv[0] );
+  }
+  catch (df::program_options_lite::ParseFailure &e)
+  {
+    cerr << "Error parsing option \"" << e.arg << "\" with argument \"" << e.val << "\"." << endl;
+  }
+  if (!configured)
+  {
+    encoder->destroy();
+    delete encoder;
+    return false;
+  }
+
+  result.cfgFileName   = cfgFileName;
+  result.width         = encoder->getInputFileWidth();
+  result.height        = encoder->getInputFileHeight();
+  result.chromaFormat  = encoder->getInputChromaFormat();
+  result.bitDepth      = encoder->getBitDepth( CHANNEL_TYPE_LUMA );
+  result.inputBitDepth = encoder->getInputBitDepths()[CHANNEL_TYPE_LUMA];
+  result.frames        = encoder->getFramesToBeEncoded();
+
+  // generate the input file in memory, in the format the configuration expects
+  vector<UChar> source;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  xGenerateSource( source, result.width, result.height, result.chromaFormat, encoder->getInputBitDepths(), encoder->getNumSourceFrames() );
+  result.sourceMs = elapsedMs( start );
+  TVideoIOYuv::registerMemoryFile( sourceFileName, source.empty() ? NULL : &source[0], source.size() );
+
+  ostringstream bitstream( ios::out | ios::binary );
+  resetPeakRss();
+  start = chrono::steady_clock::now();
+  encoder->encode( bitstream );
+  result.encodeMs        = elapsedMs( start );
+  result.encodePeakRssKB = getPeakRssKB();
+
+  TVideoIOYuv::unregisterMemoryFile( sourceFileName );
+  const Double encodedSeconds = encoder->getEncodedSeconds();
+  encoder->destroy();
+  delete encoder;
+  vector<UChar>().swap( source );
+
+  string bitstreamData = bitstream.str();
+  bitstream.str( string() );
+  result.bytes = bitstreamData.size();
+  result.kbps  = encodedSeconds > 0 ? 0.008 * result.bytes / encodedSeconds : 0;
+
+  MD5 md5;
+  if (!bitstreamData.empty())
+  {
+    md5.update( reinterpret_cast<UChar*>( &bitstreamData[0] ), UInt( bitstreamData.size() ) );
+  }
+  UChar digest[MD5_DIGEST_STRING_LENGTH];
+  md5.finalize( digest );
+  result.bitstreamMD5.clear();
+  for (UInt i = 0; i < MD5_DIGEST_STRING_LENGTH; i++)
+  {
+    TChar hex[3];
+    snprintf( hex, sizeof(hex), "%02x", digest[i] );
+    result.bitstreamMD5 += hex;
+  }
+
+  result.decodeMs        = -1;
+  result.decodePeakRssKB = -1;
+  result.hashErrors      = -1;
+  if (m_decode)
+  {
+    const string decoderBitstreamArg = string( "--BitstreamFile=" ) + bitstreamFileName;
+    TChar* decoderArgv[2] = { const_cast<TChar*>( "CodecBench" ), const_cast<TChar*>( decoderBitstreamArg.c_str() ) };
+
+    TAppDecTop *decoder = new TAppDecTop;
+    decoder->create();
+    if (!decoder->parseCfg( 2, decoderArgv ))
+    {
+      decoder->destroy();
+      delete decoder;
+      return false;
+    }
+
+    istringstream decoderInput( bitstreamData, ios::in | ios::binary );
+    resetPeakRss();
+    start = chrono::steady_clock::now();
+    decoder->decode( decoderInput );
+    result.decodeMs        = elapsedMs( start );
+    result.decodePeakRssKB = getPeakRssKB();
+    result.hashErrors      = Int( decoder->getNumberOfChecksumErrorsDetected() );
+
+    decoder->destroy();
+    delete decoder;
+  }
+
+  return true;
+}
+
+/** generate numFrames frames of synthetic content as the contents of an 8-bit or 16-bit little-endian YUV file
+ */
+Void TAppCodecBenchTop::xGenerateSource( vector<UChar> &data, Int width, Int height, ChromaFormat format, const Int bitDepth[MAX_NUM_CHANNEL_TYPE], Int numFrames ) const
+{
+  const Bool is16bit = bitDepth[CHANNEL_TYPE_LUMA] > 8 || ( format != CHROMA_400 && bitDepth[CHANNEL_TYPE_CHROMA] > 8 );
+  BenchRandom rng( 12345 );
+
+  data.clear();
+  for (Int frame = 0; frame < numFrames; frame++)
+  {
+    for (UInt comp = 0; comp < getNumberValidComponents( format ); comp++)
+    {
+      const ComponentID compID = ComponentID( comp );
+      const UInt csx    = getComponentScaleX( compID, format );
+      const UInt csy    = getComponentScaleY( compID, format );
+      const Int  maxVal = ( 1 << bitDepth[toChannelType( compID )] ) - 1;
+
+      for (Int y = 0; y < ( height >> csy ); y++)
+      {
+        for (Int x = 0; x < ( width >> csx ); x++)
+        {
+          const Double value  = sampleValue( m_content, x << csx, y << csy, frame, compID, width, rng );
+          const Int    sample = Clip3( 0, maxVal, Int( value * maxVal + 0.5 ) );
+          data.push_back( UChar( sample & 0xff ) );
+          if (is16bit)
+          {
+            data.push_back( UChar( sample >> 8 ) );
+          }
+        }
+      }
+    }
+  }
+}
+
+Void TAppCodecBenchTop::xWriteReport( ostream &os ) const
+{
+  TChar line[1024];
+
+  os << "{\n";
+  os << "  \"benchmark\": \"HM codec\",\n";
+  os << "  \"version\": \"" << NV_VERSION << "\",\n";
+  os << "  \"high_bit_depth\": " << (RExt__HIGH_BIT_DEPTH_SUPPORT ? "true" : "false") << ",\n";
+  os << "  \"content\": \"" << getContentName( m_content ) << "\",\n";
+  snprintf( line, sizeof(line), "  \"qp\": %d,\n", m_qp );
+  os << line;
+  os << "  \"results\": [\n";
+  for (UInt i = 0; i < m_results.size(); i++)
+  {
+    const BenchResult &r = m_results[i];
+    const Bool decoded = r.decodeMs >= 0;
+    snprintf( line, sizeof(line),
+              "    { \"cfg\": \"%s\", \"width\": %d, \"height\": %d, \"chroma_format\": \"%s\", \"bit_depth\": %d, "
+              "\"input_bit_depth\": %d, \"frames\": %d, \"source_ms\": %.3f, \"encode_ms\": %.3f, \"decode_ms\": %s, \"encode_fps\": %s, \"decode_fps\": %s, "
+              "\"peak_rss_encode_kb\": %s, \"peak_rss_decode_kb\": %s, \"bytes\": %llu, \"kbps\": %.3f, "
+              "\"bitstream_md5\": \"%s\", \"hash_errors\": %s }%s\n",
+              r.cfgFileName.c_str(), r.width, r.height, chromaFormatName( r.chromaFormat ), r.bitDepth, r.inputBitDepth, r.frames,
+              r.sourceMs, r.encodeMs, formatNumber( r.decodeMs, decoded, "%.3f", "null" ).c_str(),
+              formatNumber( r.frames * 1000.0 / r.encodeMs, r.encodeMs > 0, "%.3f", "null" ).c_str(),
+              formatNumber( r.frames * 1000.0 / r.decodeMs, decoded && r.decodeMs > 0, "%.3f", "null" ).c_str(),
+              formatNumber( Double( r.encodePeakRssKB ), r.encodePeakRssKB >= 0, "%.0f", "null" ).c_str(),
+              formatNumber( Double( r.decodePeakRssKB ), r.decodePeakRssKB >= 0, "%.0f", "null" ).c_str(),
+              (unsigned long long)r.bytes, r.kbps, r.bitstreamMD5.c_str(),
+              formatNumber( r.hashErrors, decoded, "%.0f", "null" ).c_str(), i + 1 < m_results.size() ? "," : "" );
+    os << line;
+  }
+  os << "  ]\n";
+  os << "}\n";
+}
+
+Void TAppCodecBenchTop::xPrintSummary() const
+{
+  printf( "\n\nCODEC BENCHMARK (%s content, QP %d) ---------------------------------------------------------------------\n",
+          getContentName( m_content ), m_qp );
+  printf( "%-36s %5s %6s %9s %9s %9s %9s %9s %10s %9s %9s %6s\n", "cfg", "depth", "frames", "src ms", "enc ms", "enc fps",
+          "dec ms", "dec fps", "kbps", "enc MB", "dec MB", "hash" );
+  for (UInt i = 0; i < m_results.size(); i++)
+  {
+    const BenchResult &r = m_results[i];
+    const Bool decoded = r.decodeMs >= 0;
+    printf( "%-36s %5d %6d %9.1f %9.1f %9.2f %9s %9s %10.2f %9s %9s %6s\n", r.cfgFileName.c_str(), r.bitDepth, r.frames,
+            r.sourceMs, r.encodeMs, r.encodeMs > 0 ? r.frames * 1000.0 / r.encodeMs : 0.0,
+            formatNumber( r.decodeMs, decoded, "%.1f", "-" ).c_str(),
+            formatNumber( r.frames * 1000.0 / r.decodeMs, decoded && r.decodeMs > 0, "%.2f", "-" ).c_str(),
+            r.kbps,
+            formatNumber( r.encodePeakRssKB / 1024.0, r.encodePeakRssKB >= 0, "%.1f", "-" ).c_str(),
+            formatNumber( r.decodePeakRssKB / 1024.0, r.decodePeakRssKB >= 0, "%.1f", "-" ).c_str(),
+            !decoded ? "-" : r.hashErrors == 0 ? "ok" : "ERROR" );
+  }
+}
+
+//! \}
@@ -0,0 +1,100 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2025, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/** \file     TAppCodecBenchTop.h
+    \brief    Codec throughput benchmark application class (header)
+*/
+
+#ifndef __TAPPCODECBENCHTOP__
+#define __TAPPCODECBENCHTOP__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TAppCodecBenchCfg.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+//! \ingroup TAppCodecBench
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// codec throughput benchmark application class
+class TAppCodecBenchTop : public TAppCodecBenchCfg
+{
+protected:
+  /// measurements of one encoder configuration
+  struct BenchResult
+  {
+    std::string  cfgFileName;
+    Int          width;                               ///< width of the synthetic input file
+    Int          height;                              ///< height of the synthetic input file
+    ChromaFormat chromaFormat;                        ///< chroma format of the synthetic input file
+    Int          bitDepth;                            ///< internal luma bit depth used for coding
+    Int          inputBitDepth;                       ///< luma bit depth of the synthetic input file
+    Int          frames;                              ///< number of encoded frames
+    Double       sourceMs;                            ///< time spent generating the synthetic input
+    Double       encodeMs;
+    Double       decodeMs;                            ///< negative if the bitstream was not decoded
+    Int64        encodePeakRssKB;                     ///< peak resident set size during encoding, negative if not available
+    Int64        decodePeakRssKB;                     ///< peak resident set size during decoding, negative if not available
+    UInt64       bytes;                               ///< bitstream size
+    Double       kbps;
+    std::string  bitstreamMD5;
+    Int          hashErrors;                          ///< decoded picture hash mismatches, negative if not decoded
+  };
+
+  std::vector<BenchResult> m_results;
+
+public:
+  TAppCodecBenchTop();
+  virtual ~TAppCodecBenchTop();
+
+  Int   run();                                        ///< run all configurations, returns non-zero on failure
+
+protected:
+  Bool  xBenchCfg       ( const std::string &cfgFileName, BenchResult &result );
+  Void  xGenerateSource ( std::vector<UChar> &data, Int width, Int height, ChromaFormat format, const Int bitDepth[MAX_NUM_CHANNEL_TYPE], Int numFrames ) const;
+  Void  xWriteReport    ( std::ostream &os ) const;
+  Void  xPrintSummary   () const;
+};
+
+//! \}
+
+#endif // __TAPPCODECBENCHTOP__
@@ -82,12 +82,14 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
   ("SEIDecodedPictureHash",     m_decodedPictureHashSEIEnabled,        1,          "Control handling of decoded picture hash SEI messages\n"
                                                                                    "\t1: check hash in SEI messages if available in the bitstream\n"
                                                                                    "\t0: ignore SEI message")
+  ("SEIDecodedPictureHashAsync", m_decodedPictureHashSEIAsync,         false,      "Verify decoded picture hashes on a separate thread; results are printed in decoding order on separate lines")
   ("SEINoDisplay",              m_decodedNoDisplaySEIEnabled,          true,       "Control handling of decoded no display SEI messages")
   ("TarDecLayerIdSetFile,l",    cfg_TargetDecLayerIdSetFile,           string(""), "targetDecLayerIdSet file name. The file should include white space separated LayerId values to be decoded. Omitting the option or a value of -1 in the file decodes all layers.")
   ("RespectDefDispWindow,w",    m_respectDefDispWindow,                0,          "Only output content inside the default display window\n")
   ("SEIColourRemappingInfoFilename",  m_colourRemapSEIFileName,        string(""), "Colour Remapping YUV output file name. If empty, no remapping is applied (ignore SEI message)\n")
 #if JVET_X0048_X0103_FILM_GRAIN
   ("SEIFGSFilename",            m_SEIFGSFileName,                      string(""), "FGS YUV output file name. If empty, no film grain is applied (ignore SEI message)\n")
+  ("SEIFGSThreads",             m_SEIFGSThreads,                       0,          "Number of additional threads used for film grain synthesis")
 #endif
 #if SHUTTER_INTERVAL_SEI_PROCESSING
   ("SEIShutterIntervalPostFilename,-sii", m_shutterIntervalPostFileName,  string(""), "Post Filtering with Shutter Interval SEI. If empty, no filtering is applied (ignore SEI message)\n")
@@ -104,6 +106,9 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
 #if JVET_AK0194_DSC_SEI
   ("KeyStoreDir",              m_keyStoreDir,            std::string("keystore/pub"),    "Directory for locally stored public keys for verifying digitally signed content")
   ("TrustStoreDir",            m_trustStoreDir,          std::string("keystore/ca"),     "Directory for locally stored trusted CA certificates")
+#endif
+#if ENABLE_PROFILING
+  ("ProfileTraceFile",          m_profileTraceFileName,                string(""), "Chrome trace output file of the profiling timers. If empty, only the profile summary is printed")
 #endif
   ;
 
@@ -64,10 +64,12 @@ protected:
 
   Int           m_iMaxTemporalLayer;                  ///< maximum temporal layer to be decoded
   Int           m_decodedPictureHashSEIEnabled;       ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
+  Bool          m_decodedPictureHashSEIAsync;         ///< verify the decoded picture hash on a separate thread
   Bool          m_decodedNoDisplaySEIEnabled;         ///< Enable(true)/disable(false) writing only pictures that get displayed based on the no display SEI message
   std::string   m_colourRemapSEIFileName;             ///< output Colour Remapping file name
 #if JVET_X0048_X0103_FILM_GRAIN
   std::string   m_SEIFGSFileName;                     ///< output reconstruction file name
+  Int           m_SEIFGSThreads;                      ///< number of helper threads for film grain synthesis
 #endif
 #if SHUTTER_INTERVAL_SEI_PROCESSING
   std::string   m_shutterIntervalPostFileName;        ///< output Post Filtering file name
@@ -87,6 +89,9 @@ protected:
   std::string   m_keyStoreDir;
   std::string   m_trustStoreDir;
 #endif
+#if ENABLE_PROFILING
+  std::string   m_profileTraceFileName;               ///< Chrome trace output file of the profiling timers; if empty, only the profile summary is printed
+#endif
 
 public:
   TAppDecCfg()
@@ -97,10 +102,12 @@ public:
   , m_outputColourSpaceConvert(IPCOLOURSPACE_UNCHANGED)
   , m_iMaxTemporalLayer(-1)
   , m_decodedPictureHashSEIEnabled(0)
+  , m_decodedPictureHashSEIAsync(false)
   , m_decodedNoDisplaySEIEnabled(false)
   , m_colourRemapSEIFileName()
 #if JVET_X0048_X0103_FILM_GRAIN
   , m_SEIFGSFileName()
+  , m_SEIFGSThreads(0)
 #endif
 #if SHUTTER_INTERVAL_SEI_PROCESSING
   , m_shutterIntervalPostFileName()
@@ -115,6 +122,9 @@ public:
   , m_bClipOutputVideoToRec709Range(false)
 #if MCTS_ENC_CHECK
   , m_tmctsCheck(false)
+#endif
+#if ENABLE_PROFILING
+  , m_profileTraceFileName()
 #endif
   {
     for (UInt channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
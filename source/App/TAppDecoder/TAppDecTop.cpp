@@ -47,6 +47,7 @@
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "TLibCommon/TComCodingStatistics.h"
 #endif
+#include "TLibCommon/TComProfiler.h"
 
 //! \ingroup TAppDecoder
 //! \{
@@ -91,9 +92,6 @@ Void TAppDecTop::destroy()
  */
 Void TAppDecTop::decode()
 {
-  Int                 poc;
-  TComList<TComPic*>* pcListPic = NULL;
-
   ifstream bitstreamFile(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
   if (!bitstreamFile)
   {
@@ -101,8 +99,26 @@ Void TAppDecTop::decode()
     exit(EXIT_FAILURE);
   }
 
+  decode(bitstreamFile);
+}
+
+/**
+ - as decode(), but the bitstream is read from the given (seekable) stream rather than from the bitstream file
+ .
+ \param bitstreamFile  source bitstream stream
+ */
+Void TAppDecTop::decode(std::istream& bitstreamFile)
+{
+  Int                 poc;
+  TComList<TComPic*>* pcListPic = NULL;
+
   InputByteStream bytestream(bitstreamFile);
 
+#if ENABLE_PROFILING
+  TComProfiler::getInstance().reset();
+  TComProfiler::getInstance().setTraceEnabled(!m_profileTraceFileName.empty());
+#endif
+
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
     m_seiMessageFileStream.open(m_outputDecodedSEIMessagesFilename.c_str(), std::ios::out);
@@ -358,6 +374,14 @@ Void TAppDecTop::decode()
 
   // destroy internal classes
   xDestroyDecLib();
+
+#if ENABLE_PROFILING
+  TComProfiler::getInstance().printReport(std::cout, "(decoder)");
+  if (!m_profileTraceFileName.empty() && !TComProfiler::getInstance().writeChromeTrace(m_profileTraceFileName))
+  {
+    fprintf(stderr, "\nfailed to write profile trace file `%s'\n", m_profileTraceFileName.c_str());
+  }
+#endif
 }
 
 // ====================================================================================================================
@@ -406,6 +430,10 @@ Void TAppDecTop::xInitDecLib()
   // initialize decoder class
   m_cTDecTop.init();
   m_cTDecTop.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+  m_cTDecTop.setDecodedPictureHashSEIAsync(m_decodedPictureHashSEIAsync);
+#if JVET_X0048_X0103_FILM_GRAIN
+  m_cTDecTop.setFilmGrainSynthesisThreads(m_SEIFGSThreads);
+#endif
 #if MCTS_ENC_CHECK
   m_cTDecTop.setTMctsCheckEnabled(m_tmctsCheck);
 #endif
@@ -87,6 +87,7 @@ public:
   Void  create            (); ///< create internal members
   Void  destroy           (); ///< destroy internal members
   Void  decode            (); ///< main decoding function
+  Void  decode            (std::istream& bitstreamFile); ///< main decoding function, reading the bitstream from a stream
   UInt  getNumberOfChecksumErrorsDetected() const { return m_cTDecTop.getNumberOfChecksumErrorsDetected(); }
 
 #if SHUTTER_INTERVAL_SEI_PROCESSING
@@ -386,6 +386,35 @@ strToScalingListMode[] =
   {"file",    SCALING_LIST_FILE_READ}
 };
 
+// Speed presets, ordered from slowest to fastest. "reference" restores the common test condition tool settings; the
+// motion search range, which those conditions set per configuration, is only restricted by the faster presets.
+static const struct MapStrToPreset
+{
+  const TChar* str;
+  const TChar* settings;
+}
+strToPreset[] =
+{
+  {"reference", "FEN:1\nFDM:1\nECU:0\nCFM:0\nESD:0\nSplitEarlyTermination:0\nFastIntraGradient:0\nDepthRangePrediction:0\n"
+                "RDOQ:1\nRDOQTS:1\nFastRDOQ:0\nSelectiveRDOQ:0\nBipredSearchRange:4\nAMP:1\nMaxNumMergeCand:5\n"
+                "QuadtreeTUMaxDepthIntra:3\nQuadtreeTUMaxDepthInter:3\n"},
+  {"slow",      "FEN:1\nFDM:1\nECU:0\nCFM:0\nESD:1\nSplitEarlyTermination:1\nFastIntraGradient:0\nDepthRangePrediction:0\n"
+                "RDOQ:1\nRDOQTS:1\nFastRDOQ:0\nSelectiveRDOQ:0\nBipredSearchRange:4\nAMP:1\nMaxNumMergeCand:5\n"
+                "QuadtreeTUMaxDepthIntra:3\nQuadtreeTUMaxDepthInter:3\n"},
+  {"medium",    "FEN:1\nFDM:1\nECU:1\nCFM:1\nESD:1\nSplitEarlyTermination:1\nFastIntraGradient:1\nDepthRangePrediction:0\n"
+                "RDOQ:1\nRDOQTS:1\nFastRDOQ:0\nSelectiveRDOQ:0\nBipredSearchRange:4\nAMP:1\nMaxNumMergeCand:5\n"
+                "QuadtreeTUMaxDepthIntra:3\nQuadtreeTUMaxDepthInter:3\n"},
+  {"fast",      "FEN:1\nFDM:1\nECU:1\nCFM:1\nESD:1\nSplitEarlyTermination:1\nFastIntraGradient:1\nDepthRangePrediction:1\n"
+                "RDOQ:1\nRDOQTS:1\nFastRDOQ:1\nSelectiveRDOQ:1\nSearchRange:32\nBipredSearchRange:4\nAMP:1\nMaxNumMergeCand:3\n"
+                "QuadtreeTUMaxDepthIntra:2\nQuadtreeTUMaxDepthInter:3\n"},
+  {"veryfast",  "FEN:1\nFDM:1\nECU:1\nCFM:1\nESD:1\nSplitEarlyTermination:1\nFastIntraGradient:1\nDepthRangePrediction:1\n"
+                "RDOQ:1\nRDOQTS:0\nFastRDOQ:1\nSelectiveRDOQ:1\nSearchRange:16\nBipredSearchRange:2\nAMP:0\nMaxNumMergeCand:3\n"
+                "QuadtreeTUMaxDepthIntra:1\nQuadtreeTUMaxDepthInter:2\n"},
+  {"ultrafast", "FEN:1\nFDM:1\nECU:1\nCFM:1\nESD:1\nSplitEarlyTermination:1\nFastIntraGradient:1\nDepthRangePrediction:1\n"
+                "RDOQ:0\nRDOQTS:0\nFastRDOQ:0\nSelectiveRDOQ:0\nSearchRange:16\nBipredSearchRange:1\nAMP:0\nMaxNumMergeCand:2\n"
+                "QuadtreeTUMaxDepthIntra:1\nQuadtreeTUMaxDepthInter:1\n"}
+};
+
 template<typename T, typename P>
 static std::string enumToString(P map[], UInt mapLen, const T val)
 {
@@ -577,6 +606,22 @@ static inline istream& operator >> (std::istream &in, std::map<T1, T2> &map)
   return in;
 }
 
+/** Apply the speed preset named by arg, as if its settings had been given at this position in the configuration */
+static Void
+applyPreset(po::Options& opts, const std::string& arg, po::ErrorReporter& error_reporter)
+{
+  for (UInt i = 0; i < sizeof(strToPreset)/sizeof(*strToPreset); i++)
+  {
+    if (arg == strToPreset[i].str)
+    {
+      istringstream settings(strToPreset[i].settings);
+      po::parseConfigStream(opts, settings, "Preset " + arg, error_reporter);
+      return;
+    }
+  }
+  error_reporter.error("Preset") << "unknown preset '" << arg << "' (reference, slow, medium, fast, veryfast, ultrafast)\n";
+}
+
 static Void
 automaticallySelectRExtProfile(const Bool bUsingGeneralRExtTools,
                                const Bool bUsingChromaQPAdjustment,
@@ -772,6 +817,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   opts.addOptions()
   ("help",                                            do_help,                                          false, "this help text")
   ("c",    po::parseConfigFile, "configuration file name")
+  ("Preset",                                          applyPreset, "speed preset: reference, slow, medium, fast, veryfast or ultrafast; applied at its position, so later options override it")
   ("WarnUnknowParameter,w",                           warnUnknowParameter,                                  0, "warn for unknown configuration parameters instead of failing")
 
   // File, I/O and source parameters
@@ -807,6 +853,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("xPSNRYWeight,-xPS0",                              m_dXPSNRWeight[COMPONENT_Y],             ( Double )1.0, "xPSNR weighting factor for Y (default: 1.0)")
   ("xPSNRCbWeight,-xPS1",                             m_dXPSNRWeight[COMPONENT_Cb],            ( Double )1.0, "xPSNR weighting factor for Cb (default: 1.0)")
   ("xPSNRCrWeight,-xPS2",                             m_dXPSNRWeight[COMPONENT_Cr],            ( Double )1.0, "xPSNR weighting factor for Cr (default: 1.0)")
+  ("MetricThreads",                                   m_metricThreads,                                      0, "Number of additional threads used to calculate the quality metrics of a picture")
+  ("AsyncMetrics",                                    m_asyncMetrics,                                   false, "Calculate the quality metrics of a picture on a separate thread while it is entropy coded")
   ("CabacZeroWordPaddingEnabled",                     m_cabacZeroWordPaddingEnabled,                     true, "0 do not add conforming cabac-zero-words to bit streams, 1 (default) = add cabac-zero-words as required")
   ("ChromaFormatIDC,-cf",                             tmpChromaFormat,                                      0, "ChromaFormatIDC (400|420|422|444 or set 0 (default) for same as InputChromaFormat)")
   ("ConformanceWindowMode",                           m_conformanceWindowMode,                              0, "Window conformance mode (0: no window, 1:automatic padding, 2:padding parameters specified, 3:conformance window parameters specified")
@@ -821,11 +869,17 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
   ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
   ("FramesToBeEncoded,f",                             m_framesToBeEncoded,                                  0, "Number of frames to be encoded (default=all)")
+  ("ParallelSegments",                                m_parallelSegments,                                   0, "Split the sequence at intra periods and encode this many segments concurrently in child encoder processes, the segments are concatenated into the bitstream file (0: sequential encoding)")
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+  ("SummaryExcludeFirstPicture",                      m_summaryExcludeFirstPicture,                     false, "Do not count the first picture in the summary, set for the segments of ParallelSegments that repeat the last picture of the previous segment")
+  ("CtuStatsFile",                                    m_ctuStatsFileName,                            string(), "CSV file receiving the encoding time, RD evaluations and decisions of every CTU. If empty, do not produce a file.")
+#if ENABLE_PROFILING
+  ("ProfileTraceFile",                                m_profileTraceFileName,                        string(), "Chrome trace output file of the profiling timers. If empty, only the profile summary is printed")
+#endif
 
   //Field coding parameters
   ("FieldCoding",                                     m_isField,                                        false, "Signals if it's a field based coding")
@@ -931,12 +985,16 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
 #if JVET_Y0077_BIM
   ("BIM",                                             m_bimEnabled,                                     false, "Block Importance Mapping QP adaptation depending on estimated propagation of reference samples.")
 #endif
+  ("CuTree",                                          m_cuTreeEnabled,                                  false, "Lookahead based CU-tree QP adaptation depending on the propagated inter dependency of 16x16 blocks")
+  ("CuTreeLookahead",                                 m_cuTreeLookahead,                                   16, "Number of pictures analysed beyond the current GOP for the CU-tree propagation")
+  ("CuTreeStrength",                                  m_cuTreeStrength,                                   2.0, "Strength of the CU-tree QP adaptation (QP offset per doubling of the propagated cost)")
   ("AdaptiveQP,-aq",                                  m_bUseAdaptiveQP,                                 false, "QP adaptation based on a psycho-visual model")
   ("MaxQPAdaptationRange,-aqr",                       m_iQPAdaptationRange,                                 6, "QP adaptation range")
   ("dQPFile,m",                                       m_dQPFileName,                               string(""), "dQP file name")
   ("RDOQ",                                            m_useRDOQ,                                         true)
   ("RDOQTS",                                          m_useRDOQTS,                                       true)
   ("SelectiveRDOQ",                                   m_useSelectiveRDOQ,                               false, "Enable selective RDOQ")
+  ("FastRDOQ",                                        m_useFastRDOQ,                                    false, "Enable approximate RDOQ that codes coefficient groups below two quantisation steps as all-zero")
   ("RDpenalty",                                       m_rdPenalty,                                          0,  "RD-penalty for 32x32 TU for intra in non-intra slices. 0:disabled  1:RD-penalty  2:maximum RD-penalty")
 
   // Deblocking filter parameters
@@ -981,6 +1039,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
 
   ("ConstrainedIntraPred",                            m_bUseConstrainedIntraPred,                       false, "Constrained Intra Prediction")
   ("FastUDIUseMPMEnabled",                            m_bFastUDIUseMPMEnabled,                           true, "If enabled, adapt intra direction search, accounting for MPM")
+  ("FastIntraGradient",                               m_fastIntraGradient,                              false, "If enabled, restrict the Hadamard intra direction search to modes pre-selected from a Sobel edge direction histogram")
+  ("FastIntraGradientModes",                          m_fastIntraGradientModes,                             3, "Number of edge direction histogram peaks (each with its two neighbouring modes) selected by FastIntraGradient")
   ("FastMEForGenBLowDelayEnabled",                    m_bFastMEForGenBLowDelayEnabled,                   true, "If enabled use a fast ME for generalised B Low Delay slices")
   ("UseBLambdaForNonKeyLowDelayPictures",             m_bUseBLambdaForNonKeyLowDelayPictures,            true, "Enables use of B-Lambda for non-key low-delay pictures")
   ("PCMEnabledFlag",                                  m_usePCM,                                         false)
@@ -1022,6 +1082,9 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("FDM",                                             m_useFastDecisionForMerge,                         true, "Fast decision for Merge RD Cost")
   ("CFM",                                             m_bUseCbfFastMode,                                false, "Cbf fast mode setting")
   ("ESD",                                             m_useEarlySkipDetection,                          false, "Early SKIP detection setting")
+  ("DepthRangePrediction",                            m_depthRangePrediction,                           false, "Restrict the CU depths searched in inter CTUs to the range used by the left, above and co-located CTUs")
+  ("SplitEarlyTermination",                           m_splitEarlyTermination,                          false, "Stop evaluating the sub-CUs of a split once their accumulated RD cost reaches that of the best unsplit mode")
+  ("ParallelRDCandidates",                            m_parallelRDCandidates,                               0, "Number of additional threads evaluating the independent mode candidates of a CU in parallel (0: sequential)")
   ( "RateControl",                                    m_RCEnableRateControl,                            false, "Rate control: enable rate control" )
   ( "TargetBitrate",                                  m_RCTargetBitrate,                                    0, "Rate control: target bit-rate" )
   ( "KeepHierarchicalBit",                            m_RCKeepHierarchicalBit,                              0, "Rate control: 0: equal bit allocation; 1: fixed ratio bit allocation; 2: adaptive ratio bit allocation" )
@@ -1032,6 +1095,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ( "RCCpbSaturation",                                m_RCCpbSaturationEnabled,                         false, "Rate control: enable target bits saturation to avoid CPB overflow and underflow" )
   ( "RCCpbSize",                                      m_RCCpbSize,                                         0u, "Rate control: CPB size" )
   ( "RCInitialCpbFullness",                           m_RCInitialCpbFullness,                             0.9, "Rate control: initial CPB fullness" )
+  ( "RCPass",                                         m_RCPass,                                             0, "Rate control: 0: single pass; 1: first pass of two-pass rate control, writing RCStatsFile; 2: second pass, allocating the bits according to RCStatsFile" )
+  ( "RCStatsFile",                                    m_RCStatsFileName,                             string(""), "Rate control: first-pass statistics file of two-pass rate control" )
   ("TransquantBypassEnable",                          m_TransquantBypassEnabledFlag,                    false, "transquant_bypass_enabled_flag indicator in PPS")
   ("TransquantBypassEnableFlag",                      m_TransquantBypassEnabledFlag,                    false, "deprecated alias for TransquantBypassEnable")
   ("CUTransquantBypassFlagForce",                     m_CUTransquantBypassFlagForce,                    false, "Force transquant bypass mode, when transquant_bypass_enabled_flag is enabled")
@@ -1230,6 +1295,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("SEIFGCCompModelPresentComp2",                     m_fgcSEICompModelPresent[2],                       false, "Specifies the presense of film grain modelling on colour component 2.")
 #if JVET_X0048_X0103_FILM_GRAIN
   ("SEIFGCAnalysisEnabled",                           m_fgcSEIAnalysisEnabled,                           false, "Control adaptive film grain parameter estimation - film grain analysis")
+  ("SEIFGCAnalysisThreads",                           m_fgcSEIAnalysisThreads,                               0, "Number of additional threads used for the film grain analysis of a picture")
+  ("SEIFGCAnalysisAsync",                             m_fgcSEIAnalysisAsync,                             false, "Run the film grain analysis of a picture on a worker thread while the picture is being encoded")
   ("SEIFGCExternalMask",                              m_fgcSEIExternalMask,                       string( "" ), "Read external file with mask for film grain analysis. If empty string, use internally calculated mask.")
   ("SEIFGCExternalDenoised",                          m_fgcSEIExternalDenoised,                   string( "" ), "Read external file with denoised sequence for film grain analysis. If empty string, use MCTF for denoising.")
   ("SEIFGCPerPictureSEI",                             m_fgcSEIPerPictureSEI,                             false, "Film Grain SEI is added for each picture as speciffied in RDD5 to ensure bit accurate synthesis in tricky mode")
@@ -1380,7 +1447,9 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
     ("FirstValidFrame", m_firstValidFrame, 0, "First valid frame")
     ("LastValidFrame", m_lastValidFrame, MAX_INT, "Last valid frame")
     ("TemporalFilterStrengthFrame*", m_gopBasedTemporalFilterStrengths, std::map<Int, Double>(), "Strength for every * frame in GOP based temporal filter, where * is an integer."
-                                                                                                   " E.g. --TemporalFilterStrengthFrame8 0.95 will enable GOP based temporal filter at every 8th frame with strength 0.95");
+                                                                                                   " E.g. --TemporalFilterStrengthFrame8 0.95 will enable GOP based temporal filter at every 8th frame with strength 0.95")
+    ("TemporalFilterThreads", m_gopBasedTemporalFilterThreads, 0, "Number of additional threads used for motion estimation and filtering in the temporal prefilter")
+    ("TemporalFilterLookahead", m_gopBasedTemporalFilterLookahead, 0, "Number of filtered pictures the temporal prefilter may prepare ahead of the encoder on a separate thread (0: filter inline)");
 
 #if EXTENSION_360_VIDEO
   TExt360AppEncCfg::TExt360AppEncCfgContext ext360CfgContext;
@@ -3078,6 +3147,31 @@ Void TAppEncCfg::xCheckParameter()
   {
     xConfirmPara( m_RCCpbSaturationEnabled != 0, "Target bits saturation cannot be processed without Rate control" );
   }
+  xConfirmPara( m_RCPass < 0 || m_RCPass > 2, "RCPass must be 0, 1 or 2" );
+  xConfirmPara( m_RCPass > 0 && m_RCStatsFileName.empty(), "Two-pass rate control requires RCStatsFile" );
+  xConfirmPara( m_RCPass == 2 && !m_RCEnableRateControl, "The second pass of two-pass rate control requires RateControl" );
+  if ( m_RCPass == 1 )
+  {
+    // the first pass only gathers statistics, so it is run with fast motion search and without RDOQ
+    if ( m_useRDOQ || m_useRDOQTS )
+    {
+      printf("Warning: RCPass is 1. Disabling RDOQ and RDOQTS for the first pass.\n");
+      m_useRDOQ          = false;
+      m_useRDOQTS        = false;
+      m_useFastRDOQ      = false;
+      m_useSelectiveRDOQ = false;
+    }
+    if ( m_motionEstimationSearchMethod != MESEARCH_DIAMOND && m_motionEstimationSearchMethod != MESEARCH_DIAMOND_ENHANCED )
+    {
+      printf("Warning: RCPass is 1. Using TZ fast search (FastSearch=1) for the first pass.\n");
+      m_motionEstimationSearchMethod = MESEARCH_DIAMOND;
+    }
+    if ( m_iSearchRange > 16 )
+    {
+      printf("Warning: RCPass is 1. Reducing SearchRange from %d to 16 for the first pass.\n", m_iSearchRange);
+      m_iSearchRange = 16;
+    }
+  }
   if (m_vuiParametersPresentFlag)
   {
     xConfirmPara(m_RCTargetBitrate == 0, "A target bit rate is required to be set for VUI/HRD parameters.");
@@ -3189,6 +3283,8 @@ Void TAppEncCfg::xCheckParameter()
 
     xConfirmPara(m_gopBasedTemporalFilterPastRefs <= 0 && m_gopBasedTemporalFilterFutureRefs <= 0,
                  "Either TemporalFilterPastRefs or TemporalFilterFutureRefs must be larger than 0 when TemporalFilter is enabled");
+    xConfirmPara(m_gopBasedTemporalFilterThreads < 0, "TemporalFilterThreads must not be negative");
+    xConfirmPara(m_gopBasedTemporalFilterLookahead < 0, "TemporalFilterLookahead must not be negative");
 
     if ((m_gopBasedTemporalFilterPastRefs != 0 && m_gopBasedTemporalFilterPastRefs != TF_DEFAULT_REFS)
         || (m_gopBasedTemporalFilterFutureRefs != 0 && m_gopBasedTemporalFilterFutureRefs != TF_DEFAULT_REFS))
@@ -3196,12 +3292,43 @@ Void TAppEncCfg::xCheckParameter()
       printf("Warning: Number of frames used for temporal prefilter is different from default.\n");
     }
   }
+#if JVET_X0048_X0103_FILM_GRAIN
+  xConfirmPara(m_fgcSEIAnalysisThreads < 0, "SEIFGCAnalysisThreads must not be negative");
+  xConfirmPara(m_metricThreads < 0, "MetricThreads must not be negative");
+#endif
+
 #if JVET_Y0077_BIM
   if (m_bimEnabled)
   {
     xConfirmPara(m_temporalSubsampleRatio != 1, "Block Importance Mapping only support Temporal sub-sample ratio 1");
   }
 #endif
+  xConfirmPara( m_fastIntraGradient && m_fastIntraGradientModes < 1, "FastIntraGradientModes must be at least 1" );
+  xConfirmPara( m_parallelRDCandidates < 0, "ParallelRDCandidates must be greater than or equal to 0" );
+  if (m_cuTreeEnabled)
+  {
+    xConfirmPara(m_temporalSubsampleRatio != 1, "CU-tree only supports Temporal sub-sample ratio 1");
+    xConfirmPara(m_isField, "CU-tree does not support field coding");
+    xConfirmPara(m_cuTreeLookahead < 0, "CuTreeLookahead must be greater than or equal to 0");
+    xConfirmPara(m_cuTreeStrength < 0, "CuTreeStrength must be greater than or equal to 0");
+  }
+  xConfirmPara( m_parallelSegments < 0, "ParallelSegments must be greater than or equal to 0" );
+  if (m_parallelSegments > 0)
+  {
+    // the segments are concatenated as described in JVET-B0036, which relies on CRA intra pictures and one slice per picture
+    xConfirmPara(m_iIntraPeriod < 0, "ParallelSegments requires an intra period");
+    xConfirmPara(m_iDecodingRefreshType != 1, "ParallelSegments requires CRA intra pictures (DecodingRefreshType=1)");
+    xConfirmPara(m_isField, "ParallelSegments does not support field coding");
+    xConfirmPara(m_RCEnableRateControl, "ParallelSegments does not support rate control");
+    xConfirmPara(m_sliceMode != NO_SLICES || m_sliceSegmentMode != NO_SLICES, "ParallelSegments requires one slice per picture");
+    // the CU-tree lookahead of the last GOP of a segment would read pictures of the next segment
+    xConfirmPara(m_cuTreeEnabled, "ParallelSegments does not support CuTree");
+    // the per-slice-type summaries and the profile trace cannot be merged from the segment files
+    xConfirmPara(!m_summaryPicFilenameBase.empty(), "ParallelSegments does not support SummaryPicFilenameBase");
+#if ENABLE_PROFILING
+    xConfirmPara(!m_profileTraceFileName.empty(), "ParallelSegments does not support ProfileTraceFile");
+#endif
+  }
 
 #if EXTENSION_360_VIDEO
   check_failed |= m_ext360.verifyParameters();
@@ -3347,6 +3474,10 @@ Void TAppEncCfg::xPrintParameter()
     printf("Frame/Field                            : Frame based coding\n");
     printf("Frame index                            : %u - %d (%d frames)\n", m_FrameSkip, m_FrameSkip+m_framesToBeEncoded-1, m_framesToBeEncoded );
   }
+  if (m_parallelSegments > 0)
+  {
+    printf("Parallel segments                      : %d\n", m_parallelSegments );
+  }
   if (m_profile == Profile::MAINREXT)
   {
     UIProfileName validProfileName;
@@ -3414,6 +3545,7 @@ Void TAppEncCfg::xPrintParameter()
   printf("Cb QP Offset                           : %d\n", m_cbQpOffset   );
   printf("Cr QP Offset                           : %d\n", m_crQpOffset);
   printf("QP adaptation                          : %d (range=%d)\n", m_bUseAdaptiveQP, (m_bUseAdaptiveQP ? m_iQPAdaptationRange : 0) );
+  printf("CU-tree QP adaptation                  : %d (lookahead=%d, strength=%.2f)\n", m_cuTreeEnabled, (m_cuTreeEnabled ? m_cuTreeLookahead : 0), (m_cuTreeEnabled ? m_cuTreeStrength : 0.0) );
   printf("GOP size                               : %d\n", m_iGOPSize );
   printf("Input bit depth                        : (Y:%d, C:%d)\n", m_inputBitDepth[CHANNEL_TYPE_LUMA], m_inputBitDepth[CHANNEL_TYPE_CHROMA] );
   printf("MSB-extended bit depth                 : (Y:%d, C:%d)\n", m_MSBExtendedBitDepth[CHANNEL_TYPE_LUMA], m_MSBExtendedBitDepth[CHANNEL_TYPE_CHROMA] );
@@ -3458,6 +3590,7 @@ Void TAppEncCfg::xPrintParameter()
     printf("InitialQP                              : %d\n", m_RCInitialQP );
     printf("ForceIntraQP                           : %d\n", m_RCForceIntraQP );
     printf("CpbSaturation                          : %d\n", m_RCCpbSaturationEnabled );
+    printf("RCPass                                 : %d\n", m_RCPass );
     if (m_RCCpbSaturationEnabled)
     {
       printf("CpbSize                                : %d\n", m_RCCpbSize);
@@ -3484,6 +3617,10 @@ Void TAppEncCfg::xPrintParameter()
   printf("FDM:%d ", m_useFastDecisionForMerge            );
   printf("CFM:%d ", m_bUseCbfFastMode                    );
   printf("ESD:%d ", m_useEarlySkipDetection              );
+  printf("DRP:%d ", m_depthRangePrediction               );
+  printf("SET:%d ", m_splitEarlyTermination              );
+  printf("PRC:%d ", m_parallelRDCandidates               );
+  printf("FIG:%d ", m_fastIntraGradient ? m_fastIntraGradientModes : 0 );
   printf("RQT:%d ", 1                                    );
   printf("TransformSkip:%d ",     m_useTransformSkip     );
   printf("TransformSkipFast:%d ", m_useTransformSkipFast );
@@ -107,6 +107,7 @@ protected:
   Int       m_confWinBottom;
   Int       m_sourcePadding[2];                               ///< number of padded pixels for width and height
   Int       m_framesToBeEncoded;                              ///< number of encoded frames
+  Int       m_parallelSegments;                               ///< number of intra period segments encoded concurrently by child encoders (0: sequential encoding)
   Bool      m_AccessUnitDelimiter;                            ///< add Access Unit Delimiter NAL units
   InputColourSpaceConversion m_inputColourSpaceConvert;       ///< colour space conversion to apply to input video
   Bool      m_snrInternalColourSpace;                       ///< if true, then no colour space conversion is applied for snr calculation, otherwise inverse of input is applied.
@@ -121,6 +122,8 @@ protected:
 
   Bool      m_bXPSNREnableFlag;                              ///< xPSNR enable flag
   Double    m_dXPSNRWeight[MAX_NUM_COMPONENT];               ///< xPSNR per component weights
+  Int       m_metricThreads;                                 ///< additional threads used for the quality metric calculation
+  Bool      m_asyncMetrics;                                  ///< calculate the quality metrics while the picture is entropy coded
 
   Bool      m_cabacZeroWordPaddingEnabled;
   Bool      m_bClipInputVideoToRec709Range;
@@ -255,6 +258,7 @@ protected:
   Bool      m_useRDOQ;                                        ///< flag for using RD optimized quantization
   Bool      m_useRDOQTS;                                      ///< flag for using RD optimized quantization for transform skip
   Bool      m_useSelectiveRDOQ;                               ///< flag for using selective RDOQ
+  Bool      m_useFastRDOQ;                                    ///< flag for using approximate RDOQ with early zero-out of coefficient groups
   Int       m_rdPenalty;                                      ///< RD-penalty for 32x32 TU for intra in non-intra slices (0: no RD-penalty, 1: RD-penalty, 2: maximum RD-penalty)
   Bool      m_bDisableIntraPUsInInterSlices;                  ///< Flag for disabling intra predicted PUs in inter slices.
   MESearchMethod m_motionEstimationSearchMethod;
@@ -269,6 +273,9 @@ protected:
   Bool      m_useFastDecisionForMerge;                        ///< flag for using Fast Decision Merge RD-Cost
   Bool      m_bUseCbfFastMode;                                ///< flag for using Cbf Fast PU Mode Decision
   Bool      m_useEarlySkipDetection;                          ///< flag for using Early SKIP Detection
+  Bool      m_depthRangePrediction;                           ///< flag for restricting the CU depths searched per CTU
+  Bool      m_splitEarlyTermination;                          ///< flag for stopping the evaluation of a CU split once it cannot win
+  Int       m_parallelRDCandidates;                           ///< number of additional threads evaluating CU mode candidates in parallel
   SliceConstraint m_sliceMode;
   Int             m_sliceArgument;                            ///< argument according to selected slice mode
   SliceConstraint m_sliceSegmentMode;
@@ -285,6 +292,8 @@ protected:
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   Bool      m_bFastUDIUseMPMEnabled;
+  Bool      m_fastIntraGradient;                              ///< gradient histogram based intra mode pre-selection
+  Int       m_fastIntraGradientModes;                         ///< number of histogram peaks selected
   Bool      m_bFastMEForGenBLowDelayEnabled;
   Bool      m_bUseBLambdaForNonKeyLowDelayPictures;
 
@@ -424,9 +433,14 @@ protected:
   Int                   m_firstValidFrame;
   Int                   m_lastValidFrame;
   std::map<Int, Double> m_gopBasedTemporalFilterStrengths;             ///< Filter strength per frame for the GOP-based Temporal Filter
+  Int                   m_gopBasedTemporalFilterThreads;               ///< number of helper threads of the GOP-based Temporal Filter
+  Int                   m_gopBasedTemporalFilterLookahead;             ///< number of pictures filtered ahead of the encoder on a separate thread
 #if JVET_Y0077_BIM
   Bool                  m_bimEnabled;
 #endif
+  Bool                  m_cuTreeEnabled;                                  ///< lookahead based CU-tree QP adaptation enable/disable
+  Int                   m_cuTreeLookahead;                                ///< number of pictures analysed beyond the current GOP
+  Double                m_cuTreeStrength;                                 ///< QP offset per doubling of the propagated cost
 
   std::string           m_arSEIFileRoot;
   Bool                    m_fisheyeVIdeoInfoSEIEnabled;
@@ -451,6 +465,8 @@ protected:
   Bool      m_RCCpbSaturationEnabled;             ///< enable target bits saturation to avoid CPB overflow and underflow
   UInt      m_RCCpbSize;                          ///< CPB size
   Double    m_RCInitialCpbFullness;               ///< initial CPB fullness 
+  Int       m_RCPass;                             ///< two-pass rate control pass (0: single pass)
+  std::string m_RCStatsFileName;                  ///< first-pass statistics file of two-pass rate control
   ScalingListMode m_useScalingListId;                         ///< using quantization matrix
   std::string m_scalingListFileName;                          ///< quantization matrix file name
 
@@ -523,6 +539,8 @@ protected:
   Bool      m_fgcSEICompModelPresent[MAX_NUM_COMPONENT];
 #if JVET_X0048_X0103_FILM_GRAIN
   Bool      m_fgcSEIAnalysisEnabled;
+  Int       m_fgcSEIAnalysisThreads;
+  Bool      m_fgcSEIAnalysisAsync;
   std::string m_fgcSEIExternalMask;
   std::string m_fgcSEIExternalDenoised;
   Bool      m_fgcSEIPerPictureSEI;
@@ -548,6 +566,11 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  Bool        m_summaryExcludeFirstPicture;                   ///< do not count the first picture in the summary (it repeats the last picture of the previous ParallelSegments segment).
+  std::string m_ctuStatsFileName;                             ///< CSV file receiving the per-CTU statistics of the encoder decisions.
+#if ENABLE_PROFILING
+  std::string m_profileTraceFileName;                         ///< Chrome trace output file of the profiling timers; if empty, only the profile summary is printed.
+#endif
 
 #if EXTENSION_360_VIDEO
   TExt360AppEncCfg m_ext360;
@@ -590,6 +613,8 @@ public:
   Void  destroy   ();                                         ///< destroy option handling class
   Bool  parseCfg  ( Int argc, TChar* argv[] );                ///< parse configuration file to fill member variables
 
+  Int   getParallelSegments () const { return m_parallelSegments; }
+
 };// END CLASS DEFINITION TAppEncCfg
 
 //! \}
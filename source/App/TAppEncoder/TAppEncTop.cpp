@@ -42,10 +42,18 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <iomanip>
+#include <sstream>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 #include "TAppEncTop.h"
 #include "TLibEncoder/TEncTemporalFilter.h"
+#include "TLibEncoder/TEncLookahead.h"
 #include "TLibEncoder/AnnexBwrite.h"
+#include "TLibCommon/TComProfiler.h"
+#include "parcat.h"
 
 #if EXTENSION_360_VIDEO
 #include "TAppEncHelper360/TExt360AppEncTop.h"
@@ -56,6 +64,79 @@ using namespace std;
 //! \ingroup TAppEncoder
 //! \{
 
+// ====================================================================================================================
+// Local function definitions
+// ====================================================================================================================
+
+/// quotes a command line argument for the command processor started by std::system()
+static string quoteArgument( const string &arg )
+{
+#ifdef _WIN32
+  return "\"" + arg + "\"";
+#else
+  string quoted = "'";
+  for (size_t i = 0; i < arg.size(); i++)
+  {
+    quoted += arg[i] == '\'' ? string("'\\''") : string(1, arg[i]);
+  }
+  return quoted + "'";
+#endif
+}
+
+/// name of the file written by the encoder of segment \a segment in place of \a fileName
+static string segmentFileName( const string &fileName, Int segment )
+{
+  ostringstream name;
+  name << fileName << ".seg" << segment;
+  return name.str();
+}
+
+/** Read back the sequence results that a segment encoder appended to its summary file
+ * \param fileName   summary file of the segment encoder, written with PrintSequenceMSE enabled
+ * \param chFmt      chroma format of the coded video
+ * \param numPics    number of pictures counted in the summary
+ * \param frameRate  frame rate of the bit rate in the summary
+ * \param total      bits, PSNR and MSE values of the segment, accumulated over its pictures
+ * \retval           false if the summary file could not be read
+ */
+static Bool readSegmentSummary( const string &fileName, const ChromaFormat chFmt, const Int numPics, const Double frameRate, TEncAnalyze::ResultData &total )
+{
+  ifstream summaryFile(fileName.c_str());
+  string   line;
+  string   lastLine;
+  while (getline(summaryFile, line))
+  {
+    if (!line.empty())
+    {
+      lastLine = line;
+    }
+  }
+
+  // bit rate and Y-PSNR, followed for chroma formats other than 4:0:0 by the U, V and YUV PSNR and the Y, U, V and YUV MSE
+  istringstream values(lastLine);
+  Double rate    = 0;
+  Double psnrYUV = 0;
+  Double mseYUV  = 0;
+  values >> rate >> total.psnr[COMPONENT_Y];
+  if (chFmt != CHROMA_400)
+  {
+    values >> total.psnr[COMPONENT_Cb] >> total.psnr[COMPONENT_Cr] >> psnrYUV
+           >> total.MSEyuvframe[COMPONENT_Y] >> total.MSEyuvframe[COMPONENT_Cb] >> total.MSEyuvframe[COMPONENT_Cr] >> mseYUV;
+  }
+  if (!values)
+  {
+    return false;
+  }
+
+  total.bits = rate * 1000 * numPics / frameRate;
+  for (Int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    total.psnr[comp]        *= numPics;
+    total.MSEyuvframe[comp] *= numPics;
+  }
+  return true;
+}
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -105,6 +186,8 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setPrintFrameMSE                                     ( m_printFrameMSE);
   m_cTEncTop.setPrintSequenceMSE                                  ( m_printSequenceMSE);
   m_cTEncTop.setPrintMSSSIM                                       ( m_printMSSSIM );
+  m_cTEncTop.setMetricThreads                                     ( m_metricThreads );
+  m_cTEncTop.setAsyncMetrics                                      ( m_asyncMetrics );
 
   m_cTEncTop.setXPSNREnableFlag                                   ( m_bXPSNREnableFlag);
   for (Int id = 0 ; id < MAX_NUM_COMPONENT; id++)
@@ -217,6 +300,7 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setUseRDOQ                                           ( m_useRDOQ     );
   m_cTEncTop.setUseRDOQTS                                         ( m_useRDOQTS   );
   m_cTEncTop.setUseSelectiveRDOQ                                  ( m_useSelectiveRDOQ );
+  m_cTEncTop.setUseFastRDOQ                                       ( m_useFastRDOQ );
   m_cTEncTop.setRDpenalty                                         ( m_rdPenalty );
   m_cTEncTop.setMaxCUWidth                                        ( m_uiMaxCUWidth );
   m_cTEncTop.setMaxCUHeight                                       ( m_uiMaxCUHeight );
@@ -231,6 +315,9 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setUseFastDecisionForMerge                           ( m_useFastDecisionForMerge  );
   m_cTEncTop.setUseCbfFastMode                                    ( m_bUseCbfFastMode  );
   m_cTEncTop.setUseEarlySkipDetection                             ( m_useEarlySkipDetection );
+  m_cTEncTop.setDepthRangePrediction                              ( m_depthRangePrediction );
+  m_cTEncTop.setSplitEarlyTermination                             ( m_splitEarlyTermination );
+  m_cTEncTop.setParallelRDCandidates                              ( m_parallelRDCandidates );
   m_cTEncTop.setCrossComponentPredictionEnabledFlag               ( m_crossComponentPredictionEnabledFlag );
   m_cTEncTop.setUseReconBasedCrossCPredictionEstimate             ( m_reconBasedCrossCPredictionEstimate );
   m_cTEncTop.setLog2SaoOffsetScale                                ( CHANNEL_TYPE_LUMA  , m_log2SaoOffsetScale[CHANNEL_TYPE_LUMA]   );
@@ -248,6 +335,8 @@ Void TAppEncTop::xInitLibCfg()
   }
   m_cTEncTop.setUseConstrainedIntraPred                           ( m_bUseConstrainedIntraPred );
   m_cTEncTop.setFastUDIUseMPMEnabled                              ( m_bFastUDIUseMPMEnabled );
+  m_cTEncTop.setFastIntraGradient                                 ( m_fastIntraGradient );
+  m_cTEncTop.setFastIntraGradientModes                            ( m_fastIntraGradientModes );
   m_cTEncTop.setFastMEForGenBLowDelayEnabled                      ( m_bFastMEForGenBLowDelayEnabled );
   m_cTEncTop.setUseBLambdaForNonKeyLowDelayPictures               ( m_bUseBLambdaForNonKeyLowDelayPictures );
   m_cTEncTop.setPCMLog2MinSize                                    ( m_uiPCMLog2MinSize);
@@ -428,6 +517,7 @@ Void TAppEncTop::xInitLibCfg()
 #if JVET_Y0077_BIM
   m_cTEncTop.setBIM                                               ( m_bimEnabled );
 #endif
+  m_cTEncTop.setCuTree                                            ( m_cuTreeEnabled );
   m_cTEncTop.setCmpSEIEnabled                                     (m_cmpSEIEnabled);
   m_cTEncTop.setCmpSEICmpCancelFlag                               (m_cmpSEICmpCancelFlag);
   m_cTEncTop.setCmpSEICmpPersistenceFlag                          (m_cmpSEICmpPersistenceFlag);
@@ -473,6 +563,8 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setFilmGrainCharactersticsSEILog2ScaleFactor         ((UChar)m_fgcSEILog2ScaleFactor);
 #if JVET_X0048_X0103_FILM_GRAIN
   m_cTEncTop.setFilmGrainAnalysisEnabled                          (m_fgcSEIAnalysisEnabled);
+  m_cTEncTop.setFilmGrainAnalysisThreads                          (m_fgcSEIAnalysisThreads);
+  m_cTEncTop.setFilmGrainAnalysisAsync                            (m_fgcSEIAnalysisAsync);
   m_cTEncTop.setFilmGrainExternalMask                             (m_fgcSEIExternalMask);
   m_cTEncTop.setFilmGrainExternalDenoised                         (m_fgcSEIExternalDenoised);
   m_cTEncTop.setFilmGrainCharactersticsSEIPerPictureSEI           (m_fgcSEIPerPictureSEI);
@@ -553,6 +645,8 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setCpbSaturationEnabled                              ( m_RCCpbSaturationEnabled );
   m_cTEncTop.setCpbSize                                           ( m_RCCpbSize );
   m_cTEncTop.setInitialCpbFullness                                ( m_RCInitialCpbFullness );
+  m_cTEncTop.setRCPass                                            ( m_RCPass );
+  m_cTEncTop.setRCStatsFileName                                   ( m_RCStatsFileName );
   m_cTEncTop.setTransquantBypassEnabledFlag                       ( m_TransquantBypassEnabledFlag );
   m_cTEncTop.setCUTransquantBypassFlagForceValue                  ( m_CUTransquantBypassFlagForce );
   m_cTEncTop.setCostMode                                          ( m_costMode );
@@ -595,6 +689,8 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setSummaryOutFilename                                ( m_summaryOutFilename );
   m_cTEncTop.setSummaryPicFilenameBase                            ( m_summaryPicFilenameBase );
   m_cTEncTop.setSummaryVerboseness                                ( m_summaryVerboseness );
+  m_cTEncTop.setSummaryExcludeFirstPicture                        ( m_summaryExcludeFirstPicture );
+  m_cTEncTop.setCtuStatsFileName                                 ( m_ctuStatsFileName );
 
 #if JCTVC_AD0021_SEI_MANIFEST
   m_cTEncTop.setSEIManifestSEIEnabled(m_SEIManifestSEIEnabled);
@@ -667,6 +763,16 @@ Void TAppEncTop::encode()
     exit(EXIT_FAILURE);
   }
 
+  encode(bitstreamFile);
+}
+
+/**
+ - as encode(), but the access units are written to the given stream rather than to the bitstream file
+ .
+ \param bitstreamFile  target bitstream stream
+ */
+Void TAppEncTop::encode(std::ostream& bitstreamFile)
+{
   TComPicYuv*       pcPicYuvOrg = new TComPicYuv;
   TComPicYuv*       pcPicYuvRec = NULL;
 
@@ -683,6 +789,11 @@ Void TAppEncTop::encode()
   }
 #endif
 
+#if ENABLE_PROFILING
+  TComProfiler::getInstance().reset();
+  TComProfiler::getInstance().setTraceEnabled(!m_profileTraceFileName.empty());
+#endif
+
   // initialize internal class & member variables
   xInitLibCfg();
   xCreateLib();
@@ -733,6 +844,12 @@ Void TAppEncTop::encode()
       m_firstValidFrame, m_lastValidFrame,
       m_gopBasedTemporalFilterEnabled, m_cTEncTop.getAdaptQPmap(), m_bimEnabled);
 #endif
+    // the lookahead thread reads the pictures to be filtered by itself, so they have to be stored in the internal format
+    Bool lookaheadPossible = m_InputChromaFormatIDC == m_chromaFormatIDC;
+#if EXTENSION_360_VIDEO
+    lookaheadPossible = lookaheadPossible && !ext360.isEnabled();
+#endif
+    temporalFilter.createThreads(m_gopBasedTemporalFilterThreads, lookaheadPossible ? m_gopBasedTemporalFilterLookahead : 0);
   }
 #if JVET_X0048_X0103_FILM_GRAIN
   TEncTemporalFilter m_temporalFilterForFG;
@@ -756,8 +873,17 @@ Void TAppEncTop::encode()
       m_firstValidFrame, m_lastValidFrame,
       m_gopBasedTemporalFilterEnabled, m_cTEncTop.getAdaptQPmap(), m_bimEnabled);
 #endif
+    m_temporalFilterForFG.createThreads(m_gopBasedTemporalFilterThreads, 0);
   }
 #endif
+  TEncLookahead lookahead;
+  if ( m_cuTreeEnabled )
+  {
+    lookahead.init(m_FrameSkip, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth, m_sourceWidth, m_sourceHeight,
+      m_sourcePadding, m_framesToBeEncoded, m_bClipInputVideoToRec709Range, m_inputFileName, m_InputChromaFormatIDC,
+      m_chromaFormatIDC, m_inputColourSpaceConvert, m_iGOPSize, m_GOPList, m_iIntraPeriod, m_cuTreeLookahead, m_cuTreeStrength,
+      m_cTEncTop.getCuTreeQPOffsetMap());
+  }
   while ( !bEos )
   {
     // get buffers
@@ -794,6 +920,11 @@ Void TAppEncTop::encode()
       temporalFilter.filter(pcPicYuvOrg, m_iFrameRcvd);
     }
 
+    if ( m_cuTreeEnabled )
+    {
+      lookahead.analyse(m_iFrameRcvd);
+    }
+
     // increase number of received frames
     m_iFrameRcvd++;
 
@@ -870,9 +1001,248 @@ Void TAppEncTop::encode()
 
   printRateSummary();
 
+#if ENABLE_PROFILING
+  TComProfiler::getInstance().printReport(std::cout, "(encoder)");
+  if (!m_profileTraceFileName.empty() && !TComProfiler::getInstance().writeChromeTrace(m_profileTraceFileName))
+  {
+    fprintf(stderr, "\nfailed to write profile trace file `%s'\n", m_profileTraceFileName.c_str());
+  }
+#endif
+
   return;
 }
 
+/**
+ - split the sequence into segments of one intra period
+ - encode ParallelSegments segments at a time, each one by a child process running this executable with the
+   command line of this encoder and the frame range and output files of the segment
+ - concatenate the segment bitstreams into the bitstream file as described in JVET-B0036 and the segment
+   reconstructions into the reconstruction file
+ .
+ Segment i encodes the frames i*IntraPeriod to (i+1)*IntraPeriod. Its first picture, coded as IDR, repeats the
+ CRA picture that ends segment i-1 and is removed by the concatenation, so that the bitstream is identical to the
+ one of a sequential encoding as long as no encoder tool looks beyond the intra period.
+ \param argc  number of command line arguments
+ \param argv  command line arguments, argv[0] is run as the segment encoder
+ \retval      false if a segment could not be encoded or concatenated
+ */
+Bool TAppEncTop::encodeSegments( Int argc, TChar* argv[] )
+{
+  const chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+
+  vector<Int> segmentStart;
+  vector<Int> segmentFrames;
+  for (Int start = 0; start == 0 || start < m_framesToBeEncoded - 1; start += m_iIntraPeriod)
+  {
+    segmentStart.push_back(start);
+    segmentFrames.push_back(std::min(m_iIntraPeriod + 1, m_framesToBeEncoded - start));
+  }
+  const Int numSegments = Int(segmentStart.size());
+
+  string commandLine = quoteArgument(argv[0]);
+  for (Int i = 1; i < argc; i++)
+  {
+    commandLine += " " + quoteArgument(argv[i]);
+  }
+  // the frame range used by the temporal filter must not depend on the segment
+  ostringstream validFrames;
+  validFrames << " --FirstValidFrame=" << m_firstValidFrame << " --LastValidFrame=" << m_lastValidFrame;
+  commandLine += validFrames.str() + " --ParallelSegments=0";
+
+  vector<string> commands(numSegments);
+  for (Int segment = 0; segment < numSegments; segment++)
+  {
+    ostringstream command;
+    command << commandLine
+            << " --FrameSkip=" << m_FrameSkip + segmentStart[segment] * m_temporalSubsampleRatio
+            << " --FramesToBeEncoded=" << segmentFrames[segment] * m_temporalSubsampleRatio
+            << " " << quoteArgument("--BitstreamFile=" + segmentFileName(m_bitstreamFileName, segment));
+    if (!m_reconFileName.empty())
+    {
+      command << " " << quoteArgument("--ReconFile=" + segmentFileName(m_reconFileName, segment));
+    }
+    // the results of the segment are read back from its summary file, which does not count the repeated first picture
+    const string summaryFileName = segmentFileName(m_bitstreamFileName, segment) + ".summary";
+    remove(summaryFileName.c_str());
+    command << " " << quoteArgument("--SummaryOutFilename=" + summaryFileName) << " --PrintSequenceMSE=1";
+    if (segment > 0)
+    {
+      command << " --SummaryExcludeFirstPicture=1";
+    }
+    if (!m_ctuStatsFileName.empty())
+    {
+      command << " " << quoteArgument("--CtuStatsFile=" + segmentFileName(m_ctuStatsFileName, segment));
+    }
+    command << " > " << quoteArgument(segmentFileName(m_bitstreamFileName, segment) + ".log") << " 2>&1";
+#ifdef _WIN32
+    // cmd.exe removes the outer quotes of the command
+    commands[segment] = "\"" + command.str() + "\"";
+#else
+    commands[segment] = command.str();
+#endif
+  }
+
+  printf("Encoding %d segments of %d frames, %d at a time\n", numSegments, m_iIntraPeriod + 1, std::min(m_parallelSegments, numSegments));
+  fflush(stdout);
+
+  atomic<Int> nextSegment(0);
+  vector<Int> status(numSegments, -1);
+  mutex printMutex;
+  vector<thread> workers;
+  for (Int i = 0; i < std::min(m_parallelSegments, numSegments); i++)
+  {
+    workers.push_back(thread([&]()
+    {
+      for (Int segment = nextSegment++; segment < numSegments; segment = nextSegment++)
+      {
+        status[segment] = system(commands[segment].c_str());
+
+        lock_guard<mutex> lock(printMutex);
+        printf("Segment %3d, frames %5d - %5d: %s\n", segment, segmentStart[segment], segmentStart[segment] + segmentFrames[segment] - 1, status[segment] == 0 ? "done" : "FAILED");
+        fflush(stdout);
+      }
+    }));
+  }
+  for (size_t i = 0; i < workers.size(); i++)
+  {
+    workers[i].join();
+  }
+
+  vector<string> bitstreams;
+  for (Int segment = 0; segment < numSegments; segment++)
+  {
+    if (status[segment] != 0)
+    {
+      fprintf(stderr, "\nEncoding of segment %d failed, see %s\n", segment, (segmentFileName(m_bitstreamFileName, segment) + ".log").c_str());
+      return false;
+    }
+    bitstreams.push_back(segmentFileName(m_bitstreamFileName, segment));
+  }
+
+  if (!parcat(bitstreams, m_bitstreamFileName))
+  {
+    return false;
+  }
+
+  if (!m_reconFileName.empty())
+  {
+    // the first picture of every segment but the first one is already in the previous segment
+    ofstream reconFile(m_reconFileName.c_str(), ios::binary);
+    for (Int segment = 0; segment < numSegments && reconFile; segment++)
+    {
+      ifstream segmentRecon(segmentFileName(m_reconFileName, segment).c_str(), ios::binary | ios::ate);
+      const streamoff frameSize = segmentRecon.tellg() / segmentFrames[segment];
+      segmentRecon.seekg(segment > 0 ? frameSize : 0);
+      if (!segmentRecon || !(reconFile << segmentRecon.rdbuf()))
+      {
+        fprintf(stderr, "\nfailed to concatenate reconstruction file `%s'\n", segmentFileName(m_reconFileName, segment).c_str());
+        return false;
+      }
+      segmentRecon.close();
+      remove(segmentFileName(m_reconFileName, segment).c_str());
+    }
+  }
+
+  for (Int segment = 0; segment < numSegments; segment++)
+  {
+    remove(bitstreams[segment].c_str());
+  }
+
+  if (!m_ctuStatsFileName.empty())
+  {
+    // the rows of the repeated first picture of a segment are dropped and the POCs are made relative to the sequence
+    ofstream ctuStatsFile(m_ctuStatsFileName.c_str());
+    for (Int segment = 0; segment < numSegments && ctuStatsFile; segment++)
+    {
+      ifstream segmentCtuStats(segmentFileName(m_ctuStatsFileName, segment).c_str());
+      string   line;
+      Bool     header = true;
+      while (getline(segmentCtuStats, line))
+      {
+        if (header)
+        {
+          if (segment == 0)
+          {
+            ctuStatsFile << line << "\n";
+          }
+          header = false;
+          continue;
+        }
+        const Int poc = atoi(line.c_str());
+        if (segment == 0 || poc > 0)
+        {
+          ctuStatsFile << poc + segmentStart[segment] << line.substr(line.find(',')) << "\n";
+        }
+      }
+      if (header || !segmentCtuStats.eof() || !ctuStatsFile)
+      {
+        fprintf(stderr, "\nfailed to merge CTU statistics file `%s'\n", segmentFileName(m_ctuStatsFileName, segment).c_str());
+        return false;
+      }
+      segmentCtuStats.close();
+      remove(segmentFileName(m_ctuStatsFileName, segment).c_str());
+    }
+  }
+
+  // merge the results of the segment encoders, the picture repeated at the start of a segment is counted once
+  const Double frameRate = Double(m_iFrameRate) / m_temporalSubsampleRatio;
+  TEncAnalyze  total;
+  Bool         summariesRead = true;
+  printf("\nSegments -------------------------------------------------------\n");
+  printf("\tSegment   Frames |   Bitrate     Y-PSNR    U-PSNR    V-PSNR  \n");
+  for (Int segment = 0; segment < numSegments; segment++)
+  {
+    const string             summaryFileName = segmentFileName(m_bitstreamFileName, segment) + ".summary";
+    const Int                numPics         = segmentFrames[segment] - (segment > 0 ? 1 : 0);
+    TEncAnalyze::ResultData  summary;
+    if (!readSegmentSummary(summaryFileName, m_chromaFormatIDC, numPics, frameRate, summary))
+    {
+      fprintf(stderr, "\nfailed to read the results of segment %d from `%s'\n", segment, summaryFileName.c_str());
+      summariesRead = false;
+      continue;
+    }
+    printf("\t %7d %8d    a %12.4lf  %8.4lf  %8.4lf  %8.4lf\n", segment, numPics, summary.bits * frameRate / numPics / 1000,
+           summary.psnr[COMPONENT_Y] / numPics, summary.psnr[COMPONENT_Cb] / numPics, summary.psnr[COMPONENT_Cr] / numPics);
+    total.addResults(summary, numPics);
+  }
+  if (summariesRead)
+  {
+    BitDepths bitDepths;
+    for (Int channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++)
+    {
+      bitDepths.recon[channelType] = m_internalBitDepth[channelType];
+    }
+    // the summary files have no MSE-based, MS-SSIM and xPSNR values, nor the MSE for 4:0:0
+    TEncAnalyze::OutputLogControl logCtrl;
+    logCtrl.printFrameMSE       = false;
+    logCtrl.printMSEBasedSNR    = false;
+    logCtrl.printMSSSIM         = false;
+    logCtrl.printSequenceMSE    = m_printSequenceMSE && m_chromaFormatIDC != CHROMA_400;
+    logCtrl.printXPSNR          = false;
+    logCtrl.printHexPerPOCPSNRs = false;
+    total.setFrmRate(frameRate);
+    printf("\n\nSUMMARY --------------------------------------------------------\n");
+    total.printOut('a', m_chromaFormatIDC, logCtrl, bitDepths);
+    if (!m_summaryOutFilename.empty())
+    {
+      total.printSummary(m_chromaFormatIDC, logCtrl, bitDepths, m_summaryOutFilename);
+    }
+    for (Int segment = 0; segment < numSegments; segment++)
+    {
+      remove((segmentFileName(m_bitstreamFileName, segment) + ".summary").c_str());
+      remove((segmentFileName(m_bitstreamFileName, segment) + ".log").c_str());
+    }
+  }
+
+  ifstream bitstreamFile(m_bitstreamFileName.c_str(), ios::binary | ios::ate);
+  const Double bits = Double(bitstreamFile.tellg()) * 8;
+  const Double seconds = Double(m_framesToBeEncoded) * m_temporalSubsampleRatio / m_iFrameRate;
+  printf("\nBitstream %s: %d frames, %.0f bits (%.4f kbps)\n", m_bitstreamFileName.c_str(), m_framesToBeEncoded, bits, bits / seconds / 1000);
+  printf(" Total Time: %12.3f sec.\n", chrono::duration<Double>(chrono::steady_clock::now() - startTime).count());
+
+  return true;
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
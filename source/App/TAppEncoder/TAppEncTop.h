@@ -96,6 +96,8 @@ public:
   virtual ~TAppEncTop();
 
   Void        encode      ();                               ///< main encoding function
+  Void        encode      (std::ostream& bitstreamFile);    ///< main encoding function, writing the bitstream to a stream
+  Bool        encodeSegments(Int argc, TChar* argv[]);      ///< segment-parallel encoding by child encoder processes
   TEncTop&    getTEncTop  ()   { return  m_cTEncTop; }      ///< return encoder class pointer reference
 
 };// END CLASS DEFINITION TAppEncTop
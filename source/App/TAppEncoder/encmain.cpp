@@ -90,6 +90,14 @@ int main(int argc, char* argv[])
   EnvVar::printEnvVarInUse();
 #endif
 
+  if (cTAppEncTop.getParallelSegments() > 0)
+  {
+    // the segments are encoded by child processes, which print their own statistics
+    const Bool segmentsEncoded = cTAppEncTop.encodeSegments( argc, argv );
+    cTAppEncTop.destroy();
+    return segmentsEncoded ? 0 : 1;
+  }
+
   // starting time
   Double dResult;
   clock_t lBefore = clock();
@@ -0,0 +1,143 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2025, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file     TAppKernelBenchCfg.cpp
+    \brief    Kernel benchmark configuration class
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include "TAppKernelBenchCfg.h"
+#include "Utilities/program_options_lite.h"
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup TAppKernelBench
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor
+// ====================================================================================================================
+
+TAppKernelBenchCfg::TAppKernelBenchCfg()
+: m_outputFileName()
+, m_filter()
+, m_bitDepths()
+, m_minTimeMs( 20.0 )
+, m_listOnly( false )
+{
+}
+
+TAppKernelBenchCfg::~TAppKernelBenchCfg()
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param argc number of arguments
+    \param argv array of arguments
+ */
+Bool TAppKernelBenchCfg::parseCfg( Int argc, TChar* argv[] )
+{
+  Bool do_help = false;
+  string cfg_bitDepths;
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  const string defaultBitDepths("8 10 12 16");
+  const Int    maxBitDepth = 16;
+#else
+  const string defaultBitDepths("8 10 12");
+  const Int    maxBitDepth = 12;
+#endif
+
+  po::Options opts;
+  opts.addOptions()
+  ("help",                      do_help,                               false,      "this help text")
+  ("Output,o",                  m_outputFileName,                      string(""), "JSON output file name, results are written to stdout if not set")
+  ("Filter,f",                  m_filter,                              string(""), "only run the kernels whose name contains this string")
+  ("BitDepths",                 cfg_bitDepths,                   defaultBitDepths, "list of internal bit depths to benchmark")
+  ("MinTime",                   m_minTimeMs,                           20.0,       "minimum measurement time per benchmark case in milliseconds")
+  ("List",                      m_listOnly,                            false,      "list the benchmark cases without running them")
+  ;
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const list<const TChar*>& argv_unhandled = po::scanArgv(opts, argc, (const TChar**) argv, err);
+
+  for (list<const TChar*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    fprintf(stderr, "Unhandled argument ignored: `%s'\n", *it);
+  }
+
+  if (do_help)
+  {
+    po::doHelp(cout, opts);
+    return false;
+  }
+
+  if (err.is_errored)
+  {
+    return false;
+  }
+
+  m_bitDepths.clear();
+  istringstream bitDepthStream(cfg_bitDepths);
+  Int bitDepth;
+  while (bitDepthStream >> bitDepth)
+  {
+    if (bitDepth < 8 || bitDepth > maxBitDepth)
+    {
+      fprintf(stderr, "Bit depth %d is not supported by this build (8..%d), aborting\n", bitDepth, maxBitDepth);
+      return false;
+    }
+    m_bitDepths.push_back(bitDepth);
+  }
+  if (m_bitDepths.empty() || !bitDepthStream.eof())
+  {
+    fprintf(stderr, "Invalid BitDepths list `%s', aborting\n", cfg_bitDepths.c_str());
+    return false;
+  }
+  if (m_minTimeMs <= 0)
+  {
+    fprintf(stderr, "MinTime must be positive, aborting\n");
+    return false;
+  }
+
+  return true;
+}
+
+//! \}
@@ -0,0 +1,991 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2025, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file     TAppKernelBenchTop.cpp
+    \brief    Kernel benchmark application class
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "TAppKernelBenchTop.h"
+#include "TLibCommon/TComRom.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComTU.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComInterpolationFilter.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/TComYuv.h"
+#include "TLibCommon/TComWeightPrediction.h"
+#include "TLibCommon/TComPelSIMD.h"
+#include "TLibEncoder/TEncSbac.h"
+#include "TLibEncoder/TEncBinCoderCABAC.h"
+#include "TLibDecoder/TDecBinCoderCABAC.h"
+
+using namespace std;
+
+//! \ingroup TAppKernelBench
+//! \{
+
+// ====================================================================================================================
+// Constants and helpers
+// ====================================================================================================================
+
+static const Int  BENCH_QP            = 32;
+static const Int  BENCH_PIC_WIDTH     = 512;
+static const Int  BENCH_PIC_HEIGHT    = 256;
+static const Int  BENCH_CTU_SIZE      = 64;
+static const Int  BENCH_CTU_DEPTH     = 4;
+static const Int  BENCH_MIN_CU_SIZE   = BENCH_CTU_SIZE >> (BENCH_CTU_DEPTH - 1);
+static const Int  BENCH_MARGIN        = 8;                  ///< border around synthetic blocks for filter taps
+static const Int  BENCH_BINS_PER_CALL = 4096;
+
+static const Int  g_benchBlockSizes[] = { 4, 8, 16, 32, 64 };
+static const Int  NUM_BENCH_BLOCK_SIZES = sizeof(g_benchBlockSizes) / sizeof(g_benchBlockSizes[0]);
+
+/// deterministic linear congruential generator, so that every run benchmarks the same data
+class BenchRandom
+{
+public:
+  BenchRandom( UInt seed ) : m_state( seed ) {}
+
+  UInt next()                  { m_state = m_state * 1664525u + 1013904223u; return m_state >> 8; }
+  Int  range( Int lo, Int hi ) { return lo + Int( next() % UInt( hi - lo + 1 ) ); }
+
+private:
+  UInt m_state;
+};
+
+/** fill a plane with camera-like content: a diagonal gradient, a little noise and a DC offset per block of
+ *  blockSize samples, so that block edges are visible to the loop filters
+ */
+static Void fillPlane( Pel* dst, Int stride, Int width, Int height, Int bitDepth, Int blockSize, BenchRandom &rng )
+{
+  const Int scale  = 1 << (bitDepth - 8);
+  const Int maxVal = (1 << bitDepth) - 1;
+
+  for (Int y = 0; y < height; y++)
+  {
+    for (Int x = 0; x < width; x++)
+    {
+      const Int dc = ((((x / blockSize) * 7 + (y / blockSize) * 13) % 5) - 2) * 6;
+      const Int v  = (64 + ((x * 3 + y * 2) & 127) + dc) * scale + rng.range( -2 * scale, 2 * scale );
+      dst[y * stride + x] = Pel( Clip3( 0, maxVal, v ) );
+    }
+  }
+}
+
+/// fill with values of the intermediate (14-bit, offset removed) domain used between interpolation filter stages
+static Void fillIntermediate( Pel* dst, Int stride, Int width, Int height, Int bitDepth, BenchRandom &rng )
+{
+  const Int shift = std::max<Int>( 2, IF_INTERNAL_PREC - bitDepth );
+  fillPlane( dst, stride, width, height, bitDepth, 8, rng );
+  for (Int y = 0; y < height; y++)
+  {
+    for (Int x = 0; x < width; x++)
+    {
+      dst[y * stride + x] = Pel( (dst[y * stride + x] << shift) - IF_INTERNAL_OFFS );
+    }
+  }
+}
+
+static Void fillYuv( TComYuv &yuv, Int bitDepth, Bool intermediate, BenchRandom &rng )
+{
+  for (UInt comp = 0; comp < yuv.getNumberValidComponents(); comp++)
+  {
+    const ComponentID compID = ComponentID( comp );
+    if (intermediate)
+    {
+      fillIntermediate( yuv.getAddr( compID ), yuv.getStride( compID ), yuv.getWidth( compID ), yuv.getHeight( compID ), bitDepth, rng );
+    }
+    else
+    {
+      fillPlane( yuv.getAddr( compID ), yuv.getStride( compID ), yuv.getWidth( compID ), yuv.getHeight( compID ), bitDepth, 8, rng );
+    }
+  }
+}
+
+static Void fillResidual( Pel* dst, Int stride, Int width, Int height, Int bitDepth, BenchRandom &rng )
+{
+  const Int amplitude = 24 << (bitDepth - 8);
+  for (Int y = 0; y < height; y++)
+  {
+    for (Int x = 0; x < width; x++)
+    {
+      dst[y * stride + x] = Pel( ((x + y) & 4 ? amplitude : -amplitude) / 2 + rng.range( -amplitude, amplitude ) );
+    }
+  }
+}
+
+static Void setBitDepths( BitDepths &bitDepths, Int bitDepth )
+{
+  for (UInt ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    bitDepths.recon[ch] = bitDepth;
+#if O0043_BEST_EFFORT_DECODING
+    bitDepths.stream[ch] = bitDepth;
+#endif
+  }
+}
+
+/// depth of the CUs holding a TU of the given size; 4x4 TUs are the first quadrant of an 8x8 CU
+static UInt getBenchCuDepth( Int tuSize )
+{
+  const Int cuSize = std::max<Int>( tuSize, BENCH_MIN_CU_SIZE );
+  return g_aucConvertToBit[BENCH_CTU_SIZE] - g_aucConvertToBit[cuSize];
+}
+
+static string getBlockName( const TChar* prefix, Int size )
+{
+  TChar name[32];
+  snprintf( name, sizeof(name), "%s%d", prefix, size );
+  return string( name );
+}
+
+/// intra-coded 4:2:0 picture with uniformly sized CUs, used by the kernels that need CU and slice context
+class BenchPicture
+{
+public:
+  BenchPicture( Int bitDepth );
+
+  TComPic&    getPic()        { return m_pic; }
+  TComSlice*  getSlice()      { return m_pic.getSlice( 0 ); }
+  //! CTU in the second row and column, whose neighbours are all available for intra prediction
+  TComDataCU* getInnerCtu()   { return m_pic.getCtu( m_pic.getFrameWidthInCtus() + 1 ); }
+
+  Void        setUniformCUs( UInt cuDepth );
+
+private:
+  TComSPS     m_sps;
+  TComPPS     m_pps;
+  TComPic     m_pic;
+};
+
+BenchPicture::BenchPicture( Int bitDepth )
+{
+  m_sps.setChromaFormatIdc               ( CHROMA_420 );
+  m_sps.setPicWidthInLumaSamples         ( BENCH_PIC_WIDTH );
+  m_sps.setPicHeightInLumaSamples        ( BENCH_PIC_HEIGHT );
+  m_sps.setMaxCUWidth                    ( BENCH_CTU_SIZE );
+  m_sps.setMaxCUHeight                   ( BENCH_CTU_SIZE );
+  m_sps.setMaxTotalCUDepth               ( BENCH_CTU_DEPTH );
+  m_sps.setLog2MinCodingBlockSize        ( 3 );
+  m_sps.setLog2DiffMaxMinCodingBlockSize ( 3 );
+  m_sps.setQuadtreeTULog2MaxSize         ( 5 );
+  m_sps.setQuadtreeTULog2MinSize         ( 2 );
+  m_sps.setQuadtreeTUMaxDepthInter       ( 3 );
+  m_sps.setQuadtreeTUMaxDepthIntra       ( 3 );
+  m_sps.setMaxTrSize                     ( 32 );
+  for (UInt ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    const ChannelType chType = ChannelType( ch );
+    m_sps.setBitDepth      ( chType, bitDepth );
+#if O0043_BEST_EFFORT_DECODING
+    m_sps.setStreamBitDepth( chType, bitDepth );
+#endif
+    m_sps.setQpBDOffset    ( chType, 6 * (bitDepth - 8) );
+    m_sps.setPCMBitDepth   ( chType, bitDepth );
+  }
+
+#if REDUCED_ENCODER_MEMORY
+  m_pic.create( m_sps, m_pps, false, true
+#else
+  m_pic.create( m_sps, m_pps, true
+#endif
+#if SHUTTER_INTERVAL_SEI_PROCESSING
+              , false
+#endif
+#if JVET_X0048_X0103_FILM_GRAIN
+              , false
+#endif
+              );
+
+  const UInt numCtus = m_pic.getPicSym()->getNumberOfCtusInFrame();
+  TComSlice* slice   = getSlice();
+  slice->setSPS                          ( &m_pic.getPicSym()->getSPS() );
+  slice->setPPS                          ( &m_pic.getPicSym()->getPPS() );
+  slice->setPic                          ( &m_pic );
+  slice->setSliceType                    ( I_SLICE );
+  slice->setSliceQp                      ( BENCH_QP );
+  slice->setSliceCurStartCtuTsAddr       ( 0 );
+  slice->setSliceCurEndCtuTsAddr         ( numCtus );
+  slice->setSliceSegmentCurStartCtuTsAddr( 0 );
+  slice->setSliceSegmentCurEndCtuTsAddr  ( numCtus );
+  m_pic.setCurrSliceIdx( 0 );
+
+  BenchRandom rng( 0x1234 + bitDepth );
+  TComPicYuv* rec = m_pic.getPicYuvRec();
+  for (UInt comp = 0; comp < rec->getNumberValidComponents(); comp++)
+  {
+    const ComponentID compID = ComponentID( comp );
+    fillPlane( rec->getAddr( compID ), rec->getStride( compID ), rec->getWidth( compID ), rec->getHeight( compID ), bitDepth, 8 >> rec->getComponentScaleX( compID ), rng );
+  }
+
+  setUniformCUs( BENCH_CTU_DEPTH - 1 );
+}
+
+/// code every CTU as intra 2Nx2N CUs of depth cuDepth, with one transform unit per CU where the size allows
+Void BenchPicture::setUniformCUs( UInt cuDepth )
+{
+  const UInt cuSize      = BENCH_CTU_SIZE >> cuDepth;
+  const UInt trIdx       = cuSize > m_sps.getMaxTrSize() ? 1 : 0;
+  const UInt numCuParts  = m_pic.getNumPartitionsInCtu() >> (2 * cuDepth);
+
+  for (UInt ctuRsAddr = 0; ctuRsAddr < m_pic.getPicSym()->getNumberOfCtusInFrame(); ctuRsAddr++)
+  {
+    TComDataCU* ctu = m_pic.getCtu( ctuRsAddr );
+    ctu->initCtu( &m_pic, ctuRsAddr );
+    for (UInt absPartIdx = 0; absPartIdx < m_pic.getNumPartitionsInCtu(); absPartIdx += numCuParts)
+    {
+      ctu->setDepthSubParts   ( cuDepth, absPartIdx );
+      ctu->setSizeSubParts    ( cuSize, cuSize, absPartIdx, cuDepth );
+      ctu->setPredModeSubParts( MODE_INTRA, absPartIdx, cuDepth );
+      ctu->setPartSizeSubParts( SIZE_2Nx2N, absPartIdx, cuDepth );
+      ctu->setTrIdxSubParts   ( trIdx, absPartIdx, cuDepth );
+      ctu->setCbfSubParts     ( 1, COMPONENT_Y, absPartIdx, cuDepth );
+    }
+  }
+}
+
+/// gives access to the block-level SAO kernel
+class BenchSampleAdaptiveOffset : public TComSampleAdaptiveOffset
+{
+public:
+  using TComSampleAdaptiveOffset::offsetBlock;
+};
+
+// ====================================================================================================================
+// Constructor / destructor / public functions
+// ====================================================================================================================
+
+TAppKernelBenchTop::TAppKernelBenchTop()
+: m_sink( 0 )
+{
+}
+
+TAppKernelBenchTop::~TAppKernelBenchTop()
+{
+}
+
+Int TAppKernelBenchTop::run()
+{
+  initROM();
+
+  for (UInt i = 0; i < m_bitDepths.size(); i++)
+  {
+    const Int bitDepth = m_bitDepths[i];
+    xBenchDistortion   ( bitDepth );
+    xBenchInterpolation( bitDepth );
+    xBenchTransform    ( bitDepth );
+    xBenchQuant        ( bitDepth );
+    xBenchIntra        ( bitDepth );
+    xBenchLoopFilter   ( bitDepth );
+    xBenchSao          ( bitDepth );
+    xBenchYuv          ( bitDepth );
+  }
+  xBenchCabac();
+
+  destroyROM();
+
+  if (m_listOnly)
+  {
+    return 0;
+  }
+
+  if (m_outputFileName.empty())
+  {
+    xWriteReport( cout );
+  }
+  else
+  {
+    ofstream reportFile( m_outputFileName.c_str() );
+    if (!reportFile)
+    {
+      fprintf( stderr, "\nfailed to open report file `%s'\n", m_outputFileName.c_str() );
+      return 1;
+    }
+    xWriteReport( reportFile );
+  }
+  return 0;
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+Bool TAppKernelBenchTop::xSelected( const string &kernel ) const
+{
+  return m_filter.empty() || kernel.find( m_filter ) != string::npos;
+}
+
+/** time one benchmark case: the kernel is called in batches of doubling size until one batch takes at least
+ *  MinTime, and the time per call of that batch is recorded
+ */
+template<typename TKernel>
+Void TAppKernelBenchTop::xMeasure( const string &kernel, const string &variant, Int width, Int height, Int bitDepth,
+                                   Double workPerCall, Bool countsBins, TKernel kernelCall )
+{
+  if (!xSelected( kernel ))
+  {
+    return;
+  }
+  if (m_listOnly)
+  {
+    fprintf( stdout, "%-14s %-12s %2dx%-2d %2d-bit\n", kernel.c_str(), variant.c_str(), width, height, bitDepth );
+    return;
+  }
+
+  const Double minTimeNs = m_minTimeMs * 1e6;
+  Int64  sum       = kernelCall(); // warm-up
+  UInt64 calls     = 1;
+  Double elapsedNs = 0;
+  for (;;)
+  {
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (UInt64 i = 0; i < calls; i++)
+    {
+      sum += kernelCall();
+    }
+    elapsedNs = chrono::duration<Double, nano>( chrono::steady_clock::now() - start ).count();
+    if (elapsedNs >= minTimeNs)
+    {
+      break;
+    }
+    calls *= 2;
+  }
+  m_sink = m_sink + sum;
+
+  BenchResult result;
+  result.kernel      = kernel;
+  result.variant     = variant;
+  result.width       = width;
+  result.height      = height;
+  result.bitDepth    = bitDepth;
+  result.calls       = calls;
+  result.nsPerCall   = elapsedNs / Double( calls );
+  result.workPerCall = workPerCall;
+  result.countsBins  = countsBins;
+  m_results.push_back( result );
+
+  fprintf( stderr, "%-14s %-12s %2dx%-2d %2d-bit %12.1f ns/call\n", kernel.c_str(), variant.c_str(), width, height, bitDepth, result.nsPerCall );
+}
+
+Void TAppKernelBenchTop::xBenchDistortion( Int bitDepth )
+{
+  const Int   stride = MAX_CU_SIZE;
+  vector<Pel> org( stride * MAX_CU_SIZE );
+  vector<Pel> cur( stride * MAX_CU_SIZE );
+  BenchRandom rng( 1 );
+  fillPlane( &org[0], stride, MAX_CU_SIZE, MAX_CU_SIZE, bitDepth, 8, rng );
+  for (UInt i = 0; i < cur.size(); i++)
+  {
+    cur[i] = Pel( Clip3( 0, (1 << bitDepth) - 1, org[i] + rng.range( -8, 8 ) * (1 << (bitDepth - 8)) ) );
+  }
+
+  TComRdCost rdCost;
+  for (Int h = 0; h < NUM_BENCH_BLOCK_SIZES; h++)
+  {
+    for (Int w = 0; w < NUM_BENCH_BLOCK_SIZES; w++)
+    {
+      const Int width  = g_benchBlockSizes[w];
+      const Int height = g_benchBlockSizes[h];
+      DistParam distParam;
+
+      xMeasure( "rdcost.sse", "", width, height, bitDepth, width * height, false, [&]()
+      {
+        return Int64( rdCost.getDistPart( bitDepth, &cur[0], stride, &org[0], stride, width, height, COMPONENT_Y, DF_SSE ) );
+      } );
+
+      rdCost.setDistParam( distParam, bitDepth, &org[0], stride, &cur[0], stride, width, height, false );
+      xMeasure( "rdcost.sad", "", width, height, bitDepth, width * height, false, [&]()
+      {
+        return Int64( distParam.DistFunc( &distParam ) );
+      } );
+
+      rdCost.setDistParam( distParam, bitDepth, &org[0], stride, &cur[0], stride, width, height, true );
+      xMeasure( "rdcost.had", "", width, height, bitDepth, width * height, false, [&]()
+      {
+        return Int64( distParam.DistFunc( &distParam ) );
+      } );
+    }
+  }
+}
+
+Void TAppKernelBenchTop::xBenchInterpolation( Int bitDepth )
+{
+  const Int   stride = MAX_CU_SIZE + 2 * BENCH_MARGIN;
+  const Int   offset = BENCH_MARGIN * stride + BENCH_MARGIN;
+  vector<Pel> src  ( stride * stride );
+  vector<Pel> inter( stride * stride );
+  vector<Pel> dst  ( MAX_CU_SIZE * MAX_CU_SIZE );
+  BenchRandom rng( 2 );
+  fillPlane       ( &src[0],   stride, stride, stride, bitDepth, 8, rng );
+  fillIntermediate( &inter[0], stride, stride, stride, bitDepth, rng );
+
+  TComInterpolationFilter filter;
+  Pel* const srcOrg   = &src[offset];
+  Pel* const interOrg = &inter[offset];
+  Pel* const dstOrg   = &dst[0];
+
+  for (Int c = 0; c < 2; c++)
+  {
+    const ComponentID compID = c == 0 ? COMPONENT_Y : COMPONENT_Cb;
+    const string      kernel = c == 0 ? "interp.luma" : "interp.chroma";
+    const Int         frac   = c == 0 ? 2 : 4; // half-sample position
+
+    for (Int s = 0; s < NUM_BENCH_BLOCK_SIZES; s++)
+    {
+      const Int size = g_benchBlockSizes[s];
+      const Int work = size * size;
+
+      xMeasure( kernel, "copy", size, size, bitDepth, work, false, [&]()
+      {
+        filter.filterHor( compID, srcOrg, stride, dstOrg, MAX_CU_SIZE, size, size, 0, false, CHROMA_420, bitDepth );
+        return Int64( dstOrg[0] );
+      } );
+      xMeasure( kernel, "hor", size, size, bitDepth, work, false, [&]()
+      {
+        filter.filterHor( compID, srcOrg, stride, dstOrg, MAX_CU_SIZE, size, size, frac, true, CHROMA_420, bitDepth );
+        return Int64( dstOrg[0] );
+      } );
+      xMeasure( kernel, "hor_nolast", size, size, bitDepth, work, false, [&]()
+      {
+        filter.filterHor( compID, srcOrg, stride, dstOrg, MAX_CU_SIZE, size, size, frac, false, CHROMA_420, bitDepth );
+        return Int64( dstOrg[0] );
+      } );
+      xMeasure( kernel, "ver", size, size, bitDepth, work, false, [&]()
+      {
+        filter.filterVer( compID, srcOrg, stride, dstOrg, MAX_CU_SIZE, size, size, frac, true, true, CHROMA_420, bitDepth );
+        return Int64( dstOrg[0] );
+      } );
+      xMeasure( kernel, "ver_first", size, size, bitDepth, work, false, [&]()
+      {
+        filter.filterVer( compID, srcOrg, stride, dstOrg, MAX_CU_SIZE, size, size, frac, true, false, CHROMA_420, bitDepth );
+        return Int64( dstOrg[0] );
+      } );
+      xMeasure( kernel, "ver_last", size, size, bitDepth, work, false, [&]()
+      {
+        filter.filterVer( compID, interOrg, stride, dstOrg, MAX_CU_SIZE, size, size, frac, false, true, CHROMA_420, bitDepth );
+        return Int64( dstOrg[0] );
+      } );
+      xMeasure( kernel, "ver_mid", size, size, bitDepth, work, false, [&]()
+      {
+        filter.filterVer( compID, interOrg, stride, dstOrg, MAX_CU_SIZE, size, size, frac, false, false, CHROMA_420, bitDepth );
+        return Int64( dstOrg[0] );
+      } );
+    }
+  }
+}
+
+Void TAppKernelBenchTop::xBenchTransform( Int bitDepth )
+{
+  const Int      maxLog2TrDynamicRange = 15;
+  const Int      stride                = MAX_TU_SIZE;
+  vector<Pel>    resi  ( MAX_TU_SIZE * MAX_TU_SIZE );
+  vector<TCoeff> block ( MAX_TU_SIZE * MAX_TU_SIZE );
+  vector<TCoeff> coeff ( MAX_TU_SIZE * MAX_TU_SIZE );
+  vector<TCoeff> recon ( MAX_TU_SIZE * MAX_TU_SIZE );
+  BenchRandom    rng( 3 );
+  fillResidual( &resi[0], stride, MAX_TU_SIZE, MAX_TU_SIZE, bitDepth, rng );
+
+  for (Int s = 0; s < NUM_BENCH_BLOCK_SIZES; s++)
+  {
+    const Int size = g_benchBlockSizes[s];
+    if (size > MAX_TU_SIZE)
+    {
+      continue;
+    }
+    for (Int y = 0; y < size; y++)
+    {
+      for (Int x = 0; x < size; x++)
+      {
+        block[y * size + x] = resi[y * stride + x];
+      }
+    }
+
+    for (Int dst = (size == 4 ? 1 : 0); dst >= 0; dst--)
+    {
+      const Bool   useDST  = dst != 0;
+      const string variant = useDST ? "dst" : "dct";
+
+      xMeasure( "tr.fwd", variant, size, size, bitDepth, size * size, false, [&]()
+      {
+        xTrMxN( bitDepth, &block[0], &coeff[0], size, size, useDST, maxLog2TrDynamicRange );
+        return Int64( coeff[0] );
+      } );
+
+      xTrMxN( bitDepth, &block[0], &coeff[0], size, size, useDST, maxLog2TrDynamicRange );
+      xMeasure( "tr.inv", variant, size, size, bitDepth, size * size, false, [&]()
+      {
+        xITrMxN( bitDepth, &coeff[0], &recon[0], size, size, useDST, maxLog2TrDynamicRange );
+        return Int64( recon[0] );
+      } );
+    }
+  }
+}
+
+Void TAppKernelBenchTop::xBenchQuant( Int bitDepth )
+{
+  BenchPicture  picture( bitDepth );
+  TComDataCU*   ctu = picture.getInnerCtu();
+  const TComSPS &sps = *picture.getSlice()->getSPS();
+
+  const Int stride = MAX_TU_SIZE;
+  vector<Pel>    resi  ( MAX_TU_SIZE * MAX_TU_SIZE );
+  vector<Pel>    recon ( MAX_TU_SIZE * MAX_TU_SIZE );
+  vector<TCoeff> coeff ( MAX_TU_SIZE * MAX_TU_SIZE );
+  vector<TCoeff> arlCoeff( MAX_TU_SIZE * MAX_TU_SIZE );
+  BenchRandom    rng( 4 );
+  fillResidual( &resi[0], stride, MAX_TU_SIZE, MAX_TU_SIZE, bitDepth, rng );
+
+  Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE];
+  for (UInt ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    maxLog2TrDynamicRange[ch] = sps.getMaxLog2TrDynamicRange( ChannelType( ch ) );
+  }
+
+  // lambda as derived by TEncSlice for an intra picture
+  const Int    qpScale = 6 * (bitDepth - 8 - DISTORTION_PRECISION_ADJUSTMENT( bitDepth - 8 ));
+  const Double lambda  = 0.57 * pow( 2.0, (BENCH_QP + qpScale - 12) / 3.0 );
+  const Double lambdas[MAX_NUM_COMPONENT] = { lambda, lambda, lambda };
+
+  // rate estimates for RDOQ, from the initial CABAC state of the slice
+  TComOutputBitstream bitstream;
+  TEncBinCABAC        binCABAC;
+  TEncSbac            sbac;
+  binCABAC.init( &bitstream );
+  sbac.init( &binCABAC );
+  sbac.resetEntropy( picture.getSlice() );
+
+  const QpParam cQP( BENCH_QP, CHANNEL_TYPE_LUMA, sps.getQpBDOffset( CHANNEL_TYPE_LUMA ), 0, CHROMA_420 );
+  const TChar*  variants[] = { "flat", "rdoq", "fastrdoq" };
+
+  TComTrQuant trQuant;
+  for (Int v = 0; v < 3; v++)
+  {
+    trQuant.init( MAX_TU_SIZE, v > 0, true, false, v == 2, true, false
+#if ADAPTIVE_QP_SELECTION
+                , false
+#endif
+                );
+    trQuant.setFlatScalingList( maxLog2TrDynamicRange, sps.getBitDepths() );
+    trQuant.setUseScalingList( false );
+    trQuant.setLambdas( lambdas );
+    trQuant.selectLambda( COMPONENT_Y );
+
+    for (Int s = 0; s < NUM_BENCH_BLOCK_SIZES; s++)
+    {
+      const Int size = g_benchBlockSizes[s];
+      if (size > MAX_TU_SIZE)
+      {
+        continue;
+      }
+      sbac.estBit( trQuant.m_pcEstBitsSbac, size, size, CHANNEL_TYPE_LUMA, SCAN_DIAG );
+
+      picture.setUniformCUs( getBenchCuDepth( size ) );
+      TComTURecurse cuLevel( ctu, 0 );
+      TComTURecurse tu( cuLevel, false, size < BENCH_MIN_CU_SIZE ? TComTU::QUAD_SPLIT : TComTU::DONT_SPLIT );
+      TCoeff        absSum = 0;
+
+      xMeasure( "trquant.fwd", variants[v], size, size, bitDepth, size * size, false, [&]()
+      {
+        trQuant.transformNxN( tu, COMPONENT_Y, &resi[0], stride, &coeff[0],
+#if ADAPTIVE_QP_SELECTION
+                              &arlCoeff[0],
+#endif
+                              absSum, cQP );
+        return Int64( absSum );
+      } );
+
+      if (v == 0)
+      {
+        trQuant.transformNxN( tu, COMPONENT_Y, &resi[0], stride, &coeff[0],
+#if ADAPTIVE_QP_SELECTION
+                              &arlCoeff[0],
+#endif
+                              absSum, cQP );
+        xMeasure( "trquant.inv", variants[v], size, size, bitDepth, size * size, false, [&]()
+        {
+          trQuant.invTransformNxN( tu, COMPONENT_Y, &recon[0], stride, &coeff[0], cQP DEBUG_STRING_PASS_INTO( NULL ) );
+          return Int64( recon[0] );
+        } );
+      }
+    }
+  }
+}
+
+Void TAppKernelBenchTop::xBenchIntra( Int bitDepth )
+{
+  static const UInt modes[] = { PLANAR_IDX, DC_IDX, 2, 5, HOR_IDX, 18, VER_IDX, 30, 34 }; // planar, DC and a spread of angles
+  static const Int  numModes = sizeof(modes) / sizeof(modes[0]);
+
+  BenchPicture   picture( bitDepth );
+  TComDataCU*    ctu = picture.getInnerCtu();
+  TComPrediction prediction;
+  prediction.initTempBuff( CHROMA_420 );
+  vector<Pel>    pred( MAX_TU_SIZE * MAX_TU_SIZE );
+#if DEBUG_STRING
+  std::string    debugString;
+#endif
+
+  for (Int s = 0; s < NUM_BENCH_BLOCK_SIZES; s++)
+  {
+    const Int size = g_benchBlockSizes[s];
+    if (size > MAX_TU_SIZE)
+    {
+      continue;
+    }
+    picture.setUniformCUs( getBenchCuDepth( size ) );
+    TComTURecurse cuLevel( ctu, 0 );
+    TComTURecurse tu( cuLevel, false, size < BENCH_MIN_CU_SIZE ? TComTU::QUAD_SPLIT : TComTU::DONT_SPLIT );
+
+    for (Int filtered = 0; filtered < 2; filtered++)
+    {
+      const Bool bFilter = filtered != 0;
+      xMeasure( "intra.refs", bFilter ? "filtered" : "unfiltered", size, size, bitDepth, size * size, false, [&]()
+      {
+        prediction.initIntraPatternChType( tu, COMPONENT_Y, bFilter DEBUG_STRING_PASS_INTO( debugString ) );
+        return Int64( prediction.getPredictorPtr( COMPONENT_Y, bFilter )[0] );
+      } );
+    }
+
+    for (Int m = 0; m < numModes; m++)
+    {
+      const UInt mode    = modes[m];
+      const Bool bFilter = TComPrediction::filteringIntraReferenceSamples( COMPONENT_Y, mode, size, size, CHROMA_420, false );
+      prediction.initIntraPatternChType( tu, COMPONENT_Y, bFilter DEBUG_STRING_PASS_INTO( debugString ) );
+
+      xMeasure( "intra.pred", getBlockName( "mode", mode ), size, size, bitDepth, size * size, false, [&]()
+      {
+        prediction.predIntraAng( COMPONENT_Y, mode, NULL, 0, &pred[0], size, tu, bFilter );
+        return Int64( pred[0] );
+      } );
+    }
+  }
+}
+
+Void TAppKernelBenchTop::xBenchLoopFilter( Int bitDepth )
+{
+  BenchPicture   picture( bitDepth );
+  TComLoopFilter loopFilter;
+  loopFilter.create( BENCH_CTU_DEPTH );
+  loopFilter.setCfg( false );
+
+  TComPicYuv* rec = picture.getPic().getPicYuvRec();
+  for (UInt cuDepth = 0; cuDepth < BENCH_CTU_DEPTH; cuDepth++)
+  {
+    const Int cuSize = BENCH_CTU_SIZE >> cuDepth;
+    picture.setUniformCUs( cuDepth );
+
+    // the picture is filtered in place; repeated filtering keeps the decisions on every edge busy
+    xMeasure( "deblock.pic", getBlockName( "cu", cuSize ), BENCH_PIC_WIDTH, BENCH_PIC_HEIGHT, bitDepth, BENCH_PIC_WIDTH * BENCH_PIC_HEIGHT, false, [&]()
+    {
+      loopFilter.loopFilterPic( &picture.getPic() );
+      return Int64( rec->getAddr( COMPONENT_Y )[0] );
+    } );
+  }
+  loopFilter.destroy();
+}
+
+Void TAppKernelBenchTop::xBenchSao( Int bitDepth )
+{
+  const Int   stride = BENCH_CTU_SIZE + 2 * BENCH_MARGIN;
+  const Int   offset = BENCH_MARGIN * stride + BENCH_MARGIN;
+  vector<Pel> src( stride * stride );
+  vector<Pel> dst( BENCH_CTU_SIZE * BENCH_CTU_SIZE );
+  BenchRandom rng( 5 );
+  fillPlane( &src[0], stride, stride, stride, bitDepth, 8, rng );
+
+  BenchSampleAdaptiveOffset sao;
+  sao.create( BENCH_PIC_WIDTH, BENCH_PIC_HEIGHT, CHROMA_420, BENCH_CTU_SIZE, BENCH_CTU_SIZE, BENCH_CTU_DEPTH, 0, 0 );
+
+  const Int scale = 1 << (bitDepth - 8);
+  Int edgeOffsets[MAX_NUM_SAO_CLASSES] = { 0 };
+  Int bandOffsets[MAX_NUM_SAO_CLASSES] = { 0 };
+  edgeOffsets[0] = 3 * scale;
+  edgeOffsets[1] = 1 * scale;
+  edgeOffsets[3] = -1 * scale;
+  edgeOffsets[4] = -3 * scale;
+  for (Int band = 8; band < 12; band++)
+  {
+    bandOffsets[band] = (band - 10) * scale;
+  }
+
+  static const TChar* variants[] = { "eo0", "eo90", "eo135", "eo45", "bo" };
+  for (Int typeIdx = SAO_TYPE_START_EO; typeIdx <= SAO_TYPE_START_BO; typeIdx++)
+  {
+    Int* const offsets = typeIdx == SAO_TYPE_START_BO ? bandOffsets : edgeOffsets;
+    xMeasure( "sao.offset", variants[typeIdx], BENCH_CTU_SIZE, BENCH_CTU_SIZE, bitDepth, BENCH_CTU_SIZE * BENCH_CTU_SIZE, false, [&]()
+    {
+      sao.offsetBlock( bitDepth, typeIdx, offsets, &src[offset], &dst[0], stride, BENCH_CTU_SIZE, BENCH_CTU_SIZE, BENCH_CTU_SIZE,
+                       true, true, true, true, true, true, true, true );
+      return Int64( dst[0] );
+    } );
+  }
+  sao.destroy();
+}
+
+Void TAppKernelBenchTop::xBenchYuv( Int bitDepth )
+{
+  TComYuv org, pred, resi, inter0, inter1, dst;
+  org   .create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420 );
+  pred  .create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420 );
+  resi  .create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420 );
+  inter0.create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420 );
+  inter1.create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420 );
+  dst   .create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420 );
+
+  BenchRandom rng( 6 );
+  fillYuv( org,    bitDepth, false, rng );
+  fillYuv( pred,   bitDepth, false, rng );
+  fillYuv( inter0, bitDepth, true,  rng );
+  fillYuv( inter1, bitDepth, true,  rng );
+  for (UInt comp = 0; comp < resi.getNumberValidComponents(); comp++)
+  {
+    const ComponentID compID = ComponentID( comp );
+    fillResidual( resi.getAddr( compID ), resi.getStride( compID ), resi.getWidth( compID ), resi.getHeight( compID ), bitDepth, rng );
+  }
+
+  BitDepths bitDepths;
+  setBitDepths( bitDepths, bitDepth );
+
+  // explicit weights as getWpScaling() would derive them: w0=40/64, w1=24/64, offsets of +2 and -1 (8-bit units)
+  const Int      log2Denom = 6;
+  WPScalingParam wpBi0[MAX_NUM_COMPONENT], wpBi1[MAX_NUM_COMPONENT], wpUni[MAX_NUM_COMPONENT];
+  for (Int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    const Int offsetScale = 1 << (bitDepth - 8);
+    wpBi0[comp].w      = 40;
+    wpBi1[comp].w      = 24;
+    wpBi0[comp].o      = 2 * offsetScale;
+    wpBi1[comp].o      = -1 * offsetScale;
+    wpBi0[comp].offset = wpBi1[comp].offset = wpBi0[comp].o + wpBi1[comp].o;
+    wpBi0[comp].shift  = wpBi1[comp].shift  = log2Denom + 1;
+    wpBi0[comp].round  = wpBi1[comp].round  = 1 << log2Denom;
+
+    wpUni[comp].w      = 40;
+    wpUni[comp].offset = 2 * offsetScale;
+    wpUni[comp].shift  = log2Denom;
+    wpUni[comp].round  = 1 << (log2Denom - 1);
+  }
+
+  TComWeightPrediction weightPrediction;
+  for (Int s = 0; s < NUM_BENCH_BLOCK_SIZES; s++)
+  {
+    const Int    size = g_benchBlockSizes[s];
+    const Double work = size * size * 3 / 2; // luma and both 4:2:0 chroma blocks
+
+    xMeasure( "yuv.addClip", "", size, size, bitDepth, work, false, [&]()
+    {
+      dst.addClip( &pred, &resi, 0, size, bitDepths );
+      return Int64( dst.getAddr( COMPONENT_Y )[0] );
+    } );
+    xMeasure( "yuv.subtract", "", size, size, bitDepth, work, false, [&]()
+    {
+      dst.subtract( &org, &pred, 0, size );
+      return Int64( dst.getAddr( COMPONENT_Y )[0] );
+    } );
+    xMeasure( "yuv.addAvg", "", size, size, bitDepth, work, false, [&]()
+    {
+      dst.addAvg( &inter0, &inter1, 0, size, size, bitDepths );
+      return Int64( dst.getAddr( COMPONENT_Y )[0] );
+    } );
+    xMeasure( "wp.bi", "", size, size, bitDepth, work, false, [&]()
+    {
+      weightPrediction.addWeightBi( &inter0, &inter1, bitDepths, 0, size, size, wpBi0, wpBi1, &dst );
+      return Int64( dst.getAddr( COMPONENT_Y )[0] );
+    } );
+    xMeasure( "wp.uni", "", size, size, bitDepth, work, false, [&]()
+    {
+      weightPrediction.addWeightUni( &inter0, bitDepths, 0, size, size, wpUni, &dst );
+      return Int64( dst.getAddr( COMPONENT_Y )[0] );
+    } );
+  }
+
+  org.destroy();
+  pred.destroy();
+  resi.destroy();
+  inter0.destroy();
+  inter1.destroy();
+  dst.destroy();
+}
+
+Void TAppKernelBenchTop::xBenchCabac()
+{
+  static const Int    numContexts = 8;
+  static const UInt   probOfOne[numContexts] = { 3, 8, 15, 30, 50, 70, 85, 97 }; // percent
+  static const TChar* variants[] = { "ctx", "bypass", "bypass8" };
+
+  BenchRandom  rng( 7 );
+  vector<UInt> bins( BENCH_BINS_PER_CALL );
+  for (Int i = 0; i < BENCH_BINS_PER_CALL; i++)
+  {
+    bins[i] = rng.range( 0, 99 ) < Int( probOfOne[i % numContexts] ) ? 1 : 0;
+  }
+
+  ContextModel contexts[numContexts];
+  const Int    initValue = 154; // equiprobable initial state
+
+  for (Int v = 0; v < 3; v++)
+  {
+    TComOutputBitstream bitstream;
+    TEncBinCABAC        binEncoder;
+    binEncoder.init( &bitstream );
+
+    auto encodeBins = [&]()
+    {
+      bitstream.clear();
+      for (Int c = 0; c < numContexts; c++)
+      {
+        contexts[c].init( BENCH_QP, initValue );
+      }
+      binEncoder.start();
+      for (Int i = 0; i < BENCH_BINS_PER_CALL; )
+      {
+        if (v == 0)
+        {
+          binEncoder.encodeBin( bins[i], contexts[i % numContexts] );
+          i++;
+        }
+        else if (v == 1)
+        {
+          binEncoder.encodeBinEP( bins[i] );
+          i++;
+        }
+        else
+        {
+          UInt value = 0;
+          for (Int b = 0; b < 8; b++, i++)
+          {
+            value = (value << 1) | bins[i];
+          }
+          binEncoder.encodeBinsEP( value, 8 );
+        }
+      }
+      binEncoder.encodeBinTrm( 1 );
+      binEncoder.finish();
+      bitstream.writeByteAlignment();
+      return Int64( bitstream.getByteStreamLength() );
+    };
+
+    xMeasure( "cabac.enc", variants[v], 0, 0, 0, BENCH_BINS_PER_CALL, true, encodeBins );
+
+#if !RExt__DECODER_DEBUG_BIT_STATISTICS
+    encodeBins();
+    TComInputBitstream inputBitstream;
+    vector<uint8_t>&   fifo = inputBitstream.getFifo();
+    fifo.assign( bitstream.getByteStream(), bitstream.getByteStream() + bitstream.getByteStreamLength() );
+    fifo.resize( fifo.size() + 16, 0 );
+    TDecBinCABAC binDecoder;
+    binDecoder.init( &inputBitstream );
+
+    vector<UInt> decoded( BENCH_BINS_PER_CALL );
+    auto decodeBins = [&]()
+    {
+      inputBitstream.resetToStart();
+      for (Int c = 0; c < numContexts; c++)
+      {
+        contexts[c].init( BENCH_QP, initValue );
+      }
+      binDecoder.start();
+      for (Int i = 0; i < BENCH_BINS_PER_CALL; )
+      {
+        if (v == 0)
+        {
+          binDecoder.decodeBin( decoded[i], contexts[i % numContexts] );
+          i++;
+        }
+        else if (v == 1)
+        {
+          binDecoder.decodeBinEP( decoded[i] );
+          i++;
+        }
+        else
+        {
+          UInt value;
+          binDecoder.decodeBinsEP( value, 8 );
+          for (Int b = 7; b >= 0; b--, i++)
+          {
+            decoded[i] = (value >> b) & 1;
+          }
+        }
+      }
+      return Int64( decoded[BENCH_BINS_PER_CALL - 1] );
+    };
+
+    decodeBins();
+    if (decoded != bins)
+    {
+      fprintf( stderr, "warning: CABAC %s round trip mismatch\n", variants[v] );
+    }
+    xMeasure( "cabac.dec", variants[v], 0, 0, 0, BENCH_BINS_PER_CALL, true, decodeBins );
+#endif
+  }
+}
+
+Void TAppKernelBenchTop::xWriteReport( ostream &os ) const
+{
+  TChar line[512];
+
+  os << "{\n";
+  os << "  \"benchmark\": \"HM kernels\",\n";
+  os << "  \"version\": \"" << NV_VERSION << "\",\n";
+  os << "  \"high_bit_depth\": " << (RExt__HIGH_BIT_DEPTH_SUPPORT ? "true" : "false") << ",\n";
+  os << "  \"simd\": " << (PEL_SIMD ? "true" : "false") << ",\n";
+  snprintf( line, sizeof(line), "  \"min_time_ms\": %.3f,\n", m_minTimeMs );
+  os << line;
+  os << "  \"results\": [\n";
+  for (UInt i = 0; i < m_results.size(); i++)
+  {
+    const BenchResult &r = m_results[i];
+    const Double perSecond = r.nsPerCall > 0 ? r.workPerCall * 1e9 / r.nsPerCall : 0;
+    snprintf( line, sizeof(line),
+              "    { \"kernel\": \"%s\", \"variant\": \"%s\", \"width\": %d, \"height\": %d, \"bit_depth\": %d, "
+              "\"calls\": %llu, \"ns_per_call\": %.3f, \"%s\": %.6e }%s\n",
+              r.kernel.c_str(), r.variant.c_str(), r.width, r.height, r.bitDepth, (unsigned long long)r.calls, r.nsPerCall,
+              r.countsBins ? "bins_per_second" : "pixels_per_second", perSecond, i + 1 < m_results.size() ? "," : "" );
+    os << line;
+  }
+  os << "  ]\n";
+  os << "}\n";
+}
+
+//! \}
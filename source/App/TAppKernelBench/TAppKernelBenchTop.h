@@ -0,0 +1,105 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2025, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file     TAppKernelBenchTop.h
+    \brief    Kernel benchmark application class (header)
+*/
+
+#ifndef __TAPPKERNELBENCHTOP__
+#define __TAPPKERNELBENCHTOP__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TAppKernelBenchCfg.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+//! \ingroup TAppKernelBench
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// kernel benchmark application class
+class TAppKernelBenchTop : public TAppKernelBenchCfg
+{
+protected:
+  /// timing of one kernel for one block size and bit depth
+  struct BenchResult
+  {
+    std::string kernel;                               ///< kernel name, e.g. "interp.luma"
+    std::string variant;                              ///< kernel variant, e.g. "hor" or "rdoq"
+    Int         width;
+    Int         height;
+    Int         bitDepth;
+    UInt64      calls;                                ///< number of timed calls
+    Double      nsPerCall;
+    Double      workPerCall;                          ///< samples (or bins) processed by one call
+    Bool        countsBins;                           ///< workPerCall counts CABAC bins instead of samples
+  };
+
+  std::vector<BenchResult> m_results;
+  volatile Int64           m_sink;                    ///< consumes kernel outputs so that they are not optimised away
+
+public:
+  TAppKernelBenchTop();
+  virtual ~TAppKernelBenchTop();
+
+  Int   run();                                        ///< run all selected benchmarks and write the report
+
+protected:
+  Bool  xSelected         ( const std::string &kernel ) const;
+  template<typename TKernel>
+  Void  xMeasure          ( const std::string &kernel, const std::string &variant, Int width, Int height, Int bitDepth,
+                            Double workPerCall, Bool countsBins, TKernel kernelCall );
+
+  Void  xBenchDistortion   ( Int bitDepth );          ///< TComRdCost SSE, SAD and Hadamard
+  Void  xBenchInterpolation( Int bitDepth );          ///< TComInterpolationFilter luma and chroma
+  Void  xBenchTransform    ( Int bitDepth );          ///< partial butterfly forward and inverse transforms
+  Void  xBenchQuant        ( Int bitDepth );          ///< TComTrQuant with flat quantisation, RDOQ and fast RDOQ
+  Void  xBenchIntra        ( Int bitDepth );          ///< TComPrediction angular, planar and DC
+  Void  xBenchLoopFilter   ( Int bitDepth );          ///< TComLoopFilter on a whole picture
+  Void  xBenchSao          ( Int bitDepth );          ///< TComSampleAdaptiveOffset edge and band offsets
+  Void  xBenchYuv          ( Int bitDepth );          ///< TComYuv and TComWeightPrediction sample kernels
+  Void  xBenchCabac        ();                        ///< CABAC bin encoder and decoder
+
+  Void  xWriteReport      ( std::ostream &os ) const;
+};
+
+//! \}
+
+#endif // __TAPPKERNELBENCHTOP__
@@ -69,6 +69,7 @@ Bool TAppMctsExtCfg::parseCfg(Int argc, TChar* argv[])
     ("InputBitstreamFile,i", m_inputBitstreamFileName, string(""), "Input bitstream file name")
     ("OutputBitstreamFile,b", m_outputBitstreamFileName, string(""), "Output subbitstream file name")
     ("TargetMCTSIdx,d", m_targetMctsIdx, 0, "Target MCTS idx to be extracted. TargetMCTSIdx = 0 per default.")
+    ("ExtractAllMCTS,a", m_extractAllMcts, false, "Extract every MCTS of the extraction information SEI in one pass, MCTS n is written to <OutputBitstreamFile>.mcts<n>")
     ;
 
   po::setDefaults(opts);
@@ -92,6 +93,12 @@ Bool TAppMctsExtCfg::parseCfg(Int argc, TChar* argv[])
     return false;
   }
 
+  if (m_targetMctsIdx < 0)
+  {
+    fprintf(stderr, "TargetMCTSIdx must be non-negative, aborting\n");
+    return false;
+  }
+
   return true;
 }
 #endif
@@ -60,12 +60,14 @@ protected:
   std::string   m_inputBitstreamFileName;             ///< input bitstream file name
   std::string   m_outputBitstreamFileName;            ///< output subbitstream filename
   Int           m_targetMctsIdx;                      ///< MCTS Id extracted
+  Bool          m_extractAllMcts;                     ///< extract every MCTS of the extraction information SEI into its own sub-bitstream
 
 public:
   TAppMctsExtCfg()
     : m_inputBitstreamFileName()
     , m_outputBitstreamFileName()
     , m_targetMctsIdx(-1)
+    , m_extractAllMcts(false)
   {
 
   }
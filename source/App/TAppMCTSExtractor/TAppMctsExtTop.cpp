@@ -41,6 +41,8 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <fstream>
+#include <algorithm>
+#include <sstream>
 
 #include "TAppMctsExtTop.h"
 #include "TLibDecoder/AnnexBread.h"
@@ -68,6 +70,19 @@ Void TAppMctsExtTop::create()
 
 Void TAppMctsExtTop::destroy()
 {
+  for (std::vector<MctsOutput*>::iterator it = m_mctsOutputs.begin(); it != m_mctsOutputs.end(); it++)
+  {
+    if (*it != NULL)
+    {
+      for (AccessUnit::iterator nalu = (*it)->parameterSets.begin(); nalu != (*it)->parameterSets.end(); nalu++)
+      {
+        delete *nalu;
+      }
+      delete *it;
+    }
+  }
+  m_mctsOutputs.clear();
+
   m_inputBitstreamFileName.clear();
   m_outputBitstreamFileName.clear();
 }
@@ -77,11 +92,9 @@ Void TAppMctsExtTop::destroy()
 // ====================================================================================================================
 
 /**
- - create internal class
- - initialize internal class
- - until the end of the bitstream, call extraction function in TDecMctsExt class
- - delete allocated buffers
- - destroy internal class
+ - until the end of the bitstream, read the next NAL unit with the header-only parser
+ - collect the parameter sets of the target MCTS (or of every MCTS with ExtractAllMCTS) from the extraction information SEI message
+ - rewrite the header of each slice within an extracted MCTS and copy its slice data into the sub-bitstream of that MCTS
  .
  */
 Void TAppMctsExtTop::extract()
@@ -93,169 +106,166 @@ Void TAppMctsExtTop::extract()
     exit(EXIT_FAILURE);
   }
 
-  InputByteStream bytestream(bitstreamFile);
-
-  // create & initialize internal classes
-  xCreateMctsExtLib();
-  xInitMctsExtLib();
-
-  Int iSkipFrame = 0;
-  Int iPOCLastDisplay = 0;
+  AnnexBNALUnitReader nalUnitReader(bitstreamFile);
 
-  fstream bitstreamFileOut(m_outputBitstreamFileName.c_str(), fstream::binary | fstream::out);
-  if (!bitstreamFileOut)
+  if (!m_extractAllMcts)
   {
-    fprintf(stderr, "\nfailed to open output bitstream file `%s' for writing\n", m_outputBitstreamFileName.c_str());
-    exit(EXIT_FAILURE);
+    xCreateMctsOutput(m_targetMctsIdx, m_outputBitstreamFileName);
   }
 
-  AccessUnit outAccessUnit;
-  while (!!bitstreamFile)
+  SEIMessages prefixSEIs;
+  const uint8_t* nalUnit = NULL;
+  size_t numBytes = 0;
+  AnnexBStats stats = AnnexBStats();
+  while (nalUnitReader.readNALUnit(nalUnit, numBytes, stats))
   {
-    streampos location = bitstreamFile.tellg();
-    AnnexBStats stats = AnnexBStats();
-    InputNALUnit inNalu;
-
-    byteStreamNALUnit(bytestream, inNalu.getBitstream().getFifo(), stats);
-
-    Bool bNewPicture = false;
-    if (inNalu.getBitstream().getFifo().empty())
+    if (numBytes < 2)
     {
       fprintf(stderr, "Warning: Attempt to extract an empty NAL unit\n");
-    }
-    else
-    {
-      read(inNalu);
-      m_pcSlice = m_cTDecTop.getApcSlicePilot();
-      // decode HLS, skipping cabac decoding and reconstruction
-      bNewPicture = m_cTDecTop.decode(inNalu, iSkipFrame, iPOCLastDisplay, true);
-
-      if (bNewPicture)
-      {
-        bitstreamFile.clear();
-        bitstreamFile.seekg(location - streamoff(3));
-        bytestream.reset();
-      }
+      continue;
     }
 
-    if ((bNewPicture || !bitstreamFile || inNalu.m_nalUnitType == NAL_UNIT_EOS) &&
-      !m_cTDecTop.getFirstSliceInSequence())
+    NALUnit nalu;
+    TDecHeaderParser::parseNalUnitHeader(nalUnit, nalu);
+    if (nalu.m_nuhLayerId > 0)
     {
-      m_cTDecTop.getPcPic()->setReconMark(true);
-      if (bitstreamFile || inNalu.m_nalUnitType == NAL_UNIT_EOS)
-      {
-        m_cTDecTop.setFirstSliceInPicture(true);
-      }
+      fprintf(stderr, "Warning: found NAL unit with nuh_layer_id equal to %d. Ignoring.\n", nalu.m_nuhLayerId);
+      continue;
     }
 
-    if ((inNalu.m_nalUnitType == NAL_UNIT_VPS || inNalu.m_nalUnitType == NAL_UNIT_SPS ||
-      inNalu.m_nalUnitType == NAL_UNIT_PPS))
+    if (nalu.m_nalUnitType == NAL_UNIT_VPS || nalu.m_nalUnitType == NAL_UNIT_SPS || nalu.m_nalUnitType == NAL_UNIT_PPS)
     {
-      continue;
+      m_cHeaderParser.parseParameterSet(nalUnit, numBytes, nalu);
     }
-    else if (!m_mctsExtractionInfoPresent && inNalu.isSei())
+    else if (!m_mctsExtractionInfoPresent && nalu.m_nalUnitType == NAL_UNIT_PREFIX_SEI)
     {
       // search matching EIS and push parameter sets into AU
-      m_cTDecTop.xParsePrefixSEImessages();
-      if (!m_cTDecTop.getSEIs().empty())
+      m_cHeaderParser.parseSEI(nalUnit, numBytes, nalu, prefixSEIs);
+      if (!prefixSEIs.empty())
       {
         xExtractSuitableParameterSets(
-          getSeisByType(m_cTDecTop.getSEIs(), SEI::TEMP_MOTION_CONSTRAINED_TILE_SETS),
-          getSeisByType(m_cTDecTop.getSEIs(), SEI::MCTS_EXTRACTION_INFO_SET),
-          outAccessUnit);
+          getSeisByType(prefixSEIs, SEI::TEMP_MOTION_CONSTRAINED_TILE_SETS),
+          getSeisByType(prefixSEIs, SEI::MCTS_EXTRACTION_INFO_SET));
       }
     }
-    else if (!bNewPicture && m_mctsExtractionInfoPresent && inNalu.isSlice() && xIsNaluWithinMCTSSet(m_targetMctsIdx))
+    else if (nalu.isSlice())
     {
-      //rewrite input slice 
-
-      // setup
-      UInt numCtusInOutputPictures = m_cTDecTop.getPcPic()->getPicSym()->getTComTile(m_targetMctsIdx)->getTileHeightInCtus() * m_cTDecTop.getPcPic()->getPicSym()->getTComTile(m_targetMctsIdx)->getTileWidthInCtus();
-      UInt numCtusInInputPictures = m_cTDecTop.getPcPic()->getNumberOfCtusInFrame();
- 
-      m_cSlicePicSym.setNumberOfCtusInFrame(m_cTDecTop.getPcPic()->getPicSym(), numCtusInOutputPictures);
-      m_pcSlice->setPic(m_cTDecTop.getPcPic());
-      m_pcSlice->setSliceSegmentCurStartCtuTsAddr(0);
-      OutputNALUnit outNalu(m_pcSlice->getNalUnitType(), m_pcSlice->getTLayer());
-      m_cEntropyCoder.setEntropyCoder(&m_cCavlcCoder);
-      m_cEntropyCoder.setBitstream(&outNalu.m_Bitstream);
-      m_cEntropyCoder.encodeSliceHeader(m_pcSlice);
-
-      //convert
-      xInputToOutputSliceNaluConversion(inNalu, outNalu, m_pcSlice);
-
-      //write to file
-      outAccessUnit.push_back(new NALUnitEBSP(outNalu));
-      xWriteOutput(bitstreamFileOut, outAccessUnit);
-      outAccessUnit.clear();
-
-      //m_cTDecTop.getPcPic()->setNumberOfCtusInFrame(numCtusInInputPictures);
-      m_cSlicePicSym.setNumberOfCtusInFrame(m_cTDecTop.getPcPic()->getPicSym(), numCtusInInputPictures);
-
-      // console output
-      TChar c = (m_pcSlice->isIntra() ? 'I' : m_pcSlice->isInterP() ? 'P' : 'B');
-      if (!m_pcSlice->isReferenced())
+      // prefix SEI messages are collected up to the next picture
+      deleteSEIs(prefixSEIs);
+
+      // parse the slice segment header only, the slice data is copied as is
+      const size_t sliceDataOffset = m_cHeaderParser.parseSliceHeader(nalUnit, numBytes, nalu);
+
+      // each slice is parsed once and routed to the sub-bitstream of the MCTS containing it
+      const Int mctsIdx = m_mctsExtractionInfoPresent ? xGetMctsIdxOfSlice() : -1;
+      MctsOutput* output = (mctsIdx >= 0 && mctsIdx < (Int)m_mctsOutputs.size()) ? m_mctsOutputs[mctsIdx] : NULL;
+      if (output != NULL && output->extractionInfoPresent)
       {
-        c += 32;
+        // pending parameter sets are written in front of the slice
+        const Bool firstNaluInAccessUnit = output->parameterSets.empty();
+        xWriteOutput(output->bitstreamFile, output->parameterSets);
+        output->parameterSets.clear();
+
+        xWriteSlice(output->bitstreamFile, nalu, nalUnit, numBytes, sliceDataOffset, firstNaluInAccessUnit);
+
+        // console output
+        const TComSlice* slice = m_cHeaderParser.getSlice();
+        if (m_extractAllMcts)
+        {
+          printf("MCTS %3d ", mctsIdx);
+        }
+        TChar c = (slice->isIntra() ? 'I' : slice->isInterP() ? 'P' : 'B');
+        if (!slice->isReferenced())
+        {
+          c += 32;
+        }
+        printf("POC %4d TId: %1d ( %c-SLICE, QP%3d ) ", slice->getPOC(),
+          slice->getTLayer(),
+          c,
+          slice->getSliceQp());
+        printf(" %10d bits\n", (Int)numBytes);
       }
-      printf("POC %4d TId: %1d ( %c-SLICE, QP%3d ) ", m_pcSlice->getPOC(),
-        m_pcSlice->getTLayer(),
-        c,
-        m_pcSlice->getSliceQp());
-      printf(" %10d bits\n", (int)inNalu.getBitstream().getFifo().size());
     }
   }
 
+  deleteSEIs(prefixSEIs);
+
   if (!m_mctsExtractionInfoPresent)
   {
-    fprintf(stderr, "\nInput bitstream file `%s' does not contain MCTS extraction information for target MCTS index %d\n", m_inputBitstreamFileName.c_str(), m_targetMctsIdx);
+    if (m_extractAllMcts)
+    {
+      fprintf(stderr, "\nInput bitstream file `%s' does not contain MCTS extraction information\n", m_inputBitstreamFileName.c_str());
+    }
+    else
+    {
+      fprintf(stderr, "\nInput bitstream file `%s' does not contain MCTS extraction information for target MCTS index %d\n", m_inputBitstreamFileName.c_str(), m_targetMctsIdx);
+    }
   }
-
-  // delete buffers
-  m_cTDecTop.deletePicBuffer();
-
-  // destroy internal classes
-  xDestroyMctsExtLib();
-
 }
 
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
 
-
-Void TAppMctsExtTop::xCreateMctsExtLib()
-{
-  // create decoder class
-  m_cTDecTop.create();
-}
-
-Void TAppMctsExtTop::xDestroyMctsExtLib()
+/// name of the sub-bitstream of MCTS \a mctsIdx written in place of \a fileName with ExtractAllMCTS
+static std::string mctsFileName(const std::string &fileName, Int mctsIdx)
 {
-  // destroy decoder class
-  m_cTDecTop.destroy();
+  std::ostringstream name;
+  name << fileName << ".mcts" << mctsIdx;
+  return name.str();
 }
 
-Void TAppMctsExtTop::xInitMctsExtLib()
+TAppMctsExtTop::MctsOutput* TAppMctsExtTop::xCreateMctsOutput(Int mctsIdx, const std::string& fileName)
 {
-  // initialize decoder class
-  m_cTDecTop.init();
+  if (mctsIdx >= (Int)m_mctsOutputs.size())
+  {
+    m_mctsOutputs.resize(mctsIdx + 1, NULL);
+  }
+  if (m_mctsOutputs[mctsIdx] == NULL)
+  {
+    MctsOutput* output = new MctsOutput;
+    output->extractionInfoPresent = false;
+    output->bitstreamFile.open(fileName.c_str(), fstream::binary | fstream::out);
+    if (!output->bitstreamFile)
+    {
+      fprintf(stderr, "\nfailed to open output bitstream file `%s' for writing\n", fileName.c_str());
+      exit(EXIT_FAILURE);
+    }
+    m_mctsOutputs[mctsIdx] = output;
+  }
+  return m_mctsOutputs[mctsIdx];
 }
 
-
-Void TAppMctsExtTop::xExtractSuitableParameterSets(SEIMessages SEIMctsSEIs, SEIMessages SEIMctsEisSEIs, AccessUnit &accessUnit)
+/**
+ - take the first extraction information set of the EIS listing an extracted MCTS (every listed MCTS with ExtractAllMCTS)
+ - convert its VPS, SPS and PPS RBSPs into NAL units pending in the AU of that MCTS
+ .
+ */
+Void TAppMctsExtTop::xExtractSuitableParameterSets(SEIMessages SEIMctsSEIs, SEIMessages SEIMctsEisSEIs)
 {
   if (SEIMctsSEIs.size() && SEIMctsEisSEIs.size())
   {
     SEIMCTSExtractionInfoSet* SEIMCTSExtractionInfoSetSEI = (SEIMCTSExtractionInfoSet*) *(SEIMctsEisSEIs.begin());
     for (std::vector<SEIMCTSExtractionInfoSet::MCTSExtractionInfo>::iterator EisIter = SEIMCTSExtractionInfoSetSEI->m_MCTSExtractionInfoSets.begin(); EisIter != SEIMCTSExtractionInfoSetSEI->m_MCTSExtractionInfoSets.end(); EisIter++)
     {
-      for (int j = 0; j < EisIter->m_idxOfMctsInSet.size() && !m_mctsExtractionInfoPresent; j++)
+      for (int j = 0; j < EisIter->m_idxOfMctsInSet.size(); j++)
       {
-        for (int k = 0; k < EisIter->m_idxOfMctsInSet[j].size() && !m_mctsExtractionInfoPresent; k++)
+        for (int k = 0; k < EisIter->m_idxOfMctsInSet[j].size(); k++)
         {
-          if (EisIter->m_idxOfMctsInSet[j][k] == m_targetMctsIdx)
+          const Int mctsIdx = EisIter->m_idxOfMctsInSet[j][k];
+          MctsOutput* output = NULL;
+          if (m_extractAllMcts)
           {
+            output = xCreateMctsOutput(mctsIdx, mctsFileName(m_outputBitstreamFileName, mctsIdx));
+          }
+          else if (mctsIdx == m_targetMctsIdx)
+          {
+            output = m_mctsOutputs[mctsIdx];
+          }
+          if (output != NULL && !output->extractionInfoPresent)
+          {
+            AccessUnit &accessUnit = output->parameterSets;
+
             std::vector<TComInputBitstream> vps_rbsps;
             vps_rbsps.resize(EisIter->m_vpsRbspData.size());
             for (int jj = 0; jj < EisIter->m_vpsRbspData.size(); jj++)
@@ -299,9 +309,11 @@ Void TAppMctsExtTop::xExtractSuitableParameterSets(SEIMessages SEIMctsSEIs, SEIM
             m_cEntropyDecoder.setBitstream(&sps_rbsps[0]);
             m_cEntropyDecoder.decodeSPS(nestedSps);
 
-            printf("MCTS extraction info for target MCTS index %d found\n", m_targetMctsIdx);
+            printf("MCTS extraction info for target MCTS index %d found\n", mctsIdx);
             printf("Output bitstream resolution: %dx%d\n\n", nestedSps->getPicWidthInLumaSamples(), nestedSps->getPicHeightInLumaSamples());
+            delete nestedSps;
 
+            output->extractionInfoPresent = true;
             m_mctsExtractionInfoPresent = true;
           }
         }
@@ -311,71 +323,125 @@ Void TAppMctsExtTop::xExtractSuitableParameterSets(SEIMessages SEIMctsSEIs, SEIM
 }
 
 
-Bool TAppMctsExtTop::xIsNaluWithinMCTSSet(Int mcts_id)
+/** Index of the tile column (or row) containing the CTU at ctuPos, following the tile layout of TComPicSym::xInitTiles()
+ */
+static Int getTileIdxOfCtu(UInt ctuPos, UInt frameSizeInCtus, Int numTiles, Bool uniformSpacing, const TComPPS& pps, Bool column)
 {
-  UInt currNaluTSSliceSegAddr = m_pcSlice->getSliceSegmentCurStartCtuTsAddr();
-  UInt firstCtuAddrTSInMcts = m_cTDecTop.getPcPic()->getPicSym()->getCtuRsToTsAddrMap(m_cTDecTop.getPcPic()->getPicSym()->getTComTile(m_targetMctsIdx)->getFirstCtuRsAddr());
-  UInt lastCtuAddrTSInMcts = -1;
-
-  if (mcts_id < (m_cTDecTop.getPcPic()->getPicSym()->getNumTiles() - 1))
-  {// not last tile
-    lastCtuAddrTSInMcts = m_cTDecTop.getPcPic()->getPicSym()->getCtuRsToTsAddrMap(m_cTDecTop.getPcPic()->getPicSym()->getTComTile(m_targetMctsIdx + 1)->getFirstCtuRsAddr()) - 1;
-  }
-  else
+  UInt tileEnd = 0;
+  for (Int tileIdx = 0; tileIdx < numTiles - 1; tileIdx++)
   {
-    lastCtuAddrTSInMcts = m_cTDecTop.getPcPic()->getNumberOfCtusInFrame() - 1;
+    if (uniformSpacing)
+    {
+      tileEnd = ((tileIdx + 1) * frameSizeInCtus) / numTiles;
+    }
+    else
+    {
+      tileEnd += column ? pps.getTileColumnWidth(tileIdx) : pps.getTileRowHeight(tileIdx);
+    }
+    if (ctuPos < tileEnd)
+    {
+      return tileIdx;
+    }
   }
-
-  return (currNaluTSSliceSegAddr >= firstCtuAddrTSInMcts && currNaluTSSliceSegAddr <= lastCtuAddrTSInMcts);
+  return numTiles - 1;
 }
 
-
-Void TAppMctsExtTop::xInputToOutputSliceNaluConversion(InputNALUnit &inNalu, OutputNALUnit &outNalu, TComSlice* curSlice)
+/** The MCTS of a slice is identified by the tile containing its first CTU, as each tile forms one MCTS
+ */
+Int TAppMctsExtTop::xGetMctsIdxOfSlice()
 {
-  const UInt uiNumSubstreams = curSlice->getNumberOfSubstreamSizes() + 1;
+  const TComSlice* slice = m_cHeaderParser.getSlice();
+  const TComPPS*   pps   = m_cHeaderParser.getParameterSetManager().getPPS(slice->getPPSId());
+  const TComSPS*   sps   = m_cHeaderParser.getParameterSetManager().getSPS(pps->getSPSId());
 
-  TComInputBitstream **ppcSubstreams = NULL;
-  ppcSubstreams = new TComInputBitstream*[uiNumSubstreams];
-  for (UInt ui = 0; ui < uiNumSubstreams; ui++)
-  {
-    ppcSubstreams[ui] = inNalu.getBitstream().extractSubstream(ui + 1 < uiNumSubstreams ? (curSlice->getSubstreamSize(ui) << 3) : inNalu.getBitstream().getNumBitsLeft());
-  }
+  const UInt frameWidthInCtus  = (sps->getPicWidthInLumaSamples()  + sps->getMaxCUWidth()  - 1) / sps->getMaxCUWidth();
+  const UInt frameHeightInCtus = (sps->getPicHeightInLumaSamples() + sps->getMaxCUHeight() - 1) / sps->getMaxCUHeight();
+  const Int  numCols           = pps->getNumTileColumnsMinus1() + 1;
+  const Int  numRows           = pps->getNumTileRowsMinus1() + 1;
 
-  TComOutputBitstream  *pcBitstreamRedirect;
-  pcBitstreamRedirect = new TComOutputBitstream;
+  // the slice segment address is still a raster-scan address, as no picture is set up by the header parser
+  const UInt ctuRsAddr = slice->getSliceSegmentCurStartCtuTsAddr();
+  const Int  tileCol   = getTileIdxOfCtu(ctuRsAddr % frameWidthInCtus, frameWidthInCtus, numCols, pps->getTileUniformSpacingFlag(), *pps, true);
+  const Int  tileRow   = getTileIdxOfCtu(ctuRsAddr / frameWidthInCtus, frameHeightInCtus, numRows, pps->getTileUniformSpacingFlag(), *pps, false);
 
-  // Append substreams...
-  TComOutputBitstream *pcOut = pcBitstreamRedirect;
-  std::vector<TComOutputBitstream> substreamsOut(uiNumSubstreams);
+  return tileRow * numCols + tileCol;
+}
 
-  for (UInt ui = 0; ui < uiNumSubstreams; ui++)
+static Void writeUvlc(TComOutputBitstream& bitstream, UInt value)
+{
+  UInt length = 1;
+  UInt temp   = ++value;
+  while (temp > 1)
   {
-    std::vector<uint8_t> &bufIn = ppcSubstreams[ui]->getFifo();
-    std::vector<uint8_t> &bufOut = substreamsOut[ui].getFIFO();
-    bufOut.resize(bufIn.size());
-    bufOut = bufIn;
-    pcOut->addSubstream(&(substreamsOut[ui]));
+    temp >>= 1;
+    length += 2;
   }
+  bitstream.write(0, length >> 1);
+  bitstream.write(value, (length + 1) >> 1);
+}
 
-  // Byte-align
-  outNalu.m_Bitstream.writeByteAlignment();
+/**
+ - write the slice segment header of the extracted slice: the slice becomes the first one of the picture, the
+   slice_reserved_flag[]s are cleared and the entry points are dropped; all other syntax elements are copied bit by bit
+ - append the slice segment data of the input NAL unit as is
+ .
+ */
+Void TAppMctsExtTop::xWriteSlice(std::ostream& bitstreamFile, const NALUnit& nalu, const uint8_t* nalUnit, size_t numBytes, size_t sliceDataOffset, Bool firstNaluInAccessUnit)
+{
+  const TComSlice* slice = m_cHeaderParser.getSlice();
+  const TComPPS*   pps   = m_cHeaderParser.getParameterSetManager().getPPS(slice->getPPSId());
+
+  OutputNALUnit outNalu(nalu.m_nalUnitType, nalu.m_temporalId);
+  TComOutputBitstream& bitstream = outNalu.m_Bitstream;
 
-  // Perform bitstream concatenation
-  if (pcOut->getNumberOfWrittenBits() > 0)
+  bitstream.write(1, 1);                                           // first_slice_segment_in_pic_flag
+  if (slice->getRapPicFlag())
+  {
+    bitstream.write(slice->getNoOutputPriorPicsFlag() ? 1 : 0, 1); // no_output_of_prior_pics_flag
+  }
+  writeUvlc(bitstream, slice->getPPSId());                         // slice_pic_parameter_set_id
+  if (!slice->getDependentSliceSegmentFlag())
   {
-    outNalu.m_Bitstream.addSubstream(pcOut);
+    for (Int i = 0; i < pps->getNumExtraSliceHeaderBits(); i++)
+    {
+      bitstream.write(0, 1);                                       // slice_reserved_flag[]
+    }
   }
 
-  // clean-up
-  for (UInt ui = 0; ui < uiNumSubstreams; ui++)
+  TComInputBitstream& sliceHeader = m_cHeaderParser.getSliceHeaderBitstream();
+  sliceHeader.resetToStart();
+  UInt bitPos = 0;
+  while (bitPos < m_cHeaderParser.getSliceHeaderBodyStartBit())
   {
-    delete ppcSubstreams[ui];
+    const UInt numBits = std::min<UInt>(32, m_cHeaderParser.getSliceHeaderBodyStartBit() - bitPos);
+    sliceHeader.read(numBits);
+    bitPos += numBits;
+  }
+  while (bitPos < m_cHeaderParser.getSliceHeaderBodyEndBit())
+  {
+    const UInt numBits = std::min<UInt>(32, m_cHeaderParser.getSliceHeaderBodyEndBit() - bitPos);
+    bitstream.write(sliceHeader.read(numBits), numBits);
+    bitPos += numBits;
   }
-  delete[] ppcSubstreams;
-  delete pcBitstreamRedirect;
 
-  return;
+  if (pps->getSliceHeaderExtensionPresentFlag())
+  {
+    writeUvlc(bitstream, 0);                                       // slice_segment_header_extension_length
+  }
+  bitstream.writeByteAlignment();
 
+  // the header ends with a non-zero byte, so the slice data needs no further emulation prevention
+  static const UChar start_code_prefix[] = { 0,0,0,1 };
+  if (firstNaluInAccessUnit)
+  {
+    bitstreamFile.write(reinterpret_cast<const TChar*>(start_code_prefix), 4);
+  }
+  else
+  {
+    bitstreamFile.write(reinterpret_cast<const TChar*>(start_code_prefix + 1), 3);
+  }
+  writeNaluWithHeader(bitstreamFile, outNalu);
+  bitstreamFile.write(reinterpret_cast<const TChar*>(nalUnit + sliceDataOffset), std::streamsize(numBytes - sliceDataOffset));
 }
 
 Void TAppMctsExtTop::xWriteOutput(std::ostream& bitstreamFile, const AccessUnit accessUnit)
@@ -42,8 +42,10 @@
 #pragma once
 #endif // _MSC_VER > 1000
 
-#include "TLibDecoder/TDecTop.h"
-#include "TLibEncoder/TEncTop.h"
+#include <fstream>
+#include <vector>
+
+#include "TLibDecoder/TDecHeaderParser.h"
 #include "TLibCommon/AccessUnit.h"
 
 #if MCTS_EXTRACTION
@@ -61,15 +63,20 @@ class TAppMctsExtTop : public TAppMctsExtCfg
 {
 private:
   // class interface
-  TDecTop                         m_cTDecTop;                     ///< decoder class
-  TComSlice*                      m_pcSlice;                      ///< slice header class
+  TDecHeaderParser                m_cHeaderParser;                ///< header-only parser
   TDecEntropy                     m_cEntropyDecoder;              ///< entropy decoder class
   TDecCavlc                       m_cCavlcDecoder;                ///< CAVLC decoder class
-  TEncEntropy                     m_cEntropyCoder;                ///< entropy encoder class
-  TEncCavlc                       m_cCavlcCoder;                  ///< CAVLC encoder class
-  MctsExtractorTComPicSym         m_cSlicePicSym;
 
-  Bool                            m_mctsExtractionInfoPresent;    ///< indicates whether MCTS extraction info for the traget mcts idx has been found in the bitstream
+  /// output sub-bitstream of one extracted MCTS
+  struct MctsOutput
+  {
+    std::fstream                  bitstreamFile;                  ///< output sub-bitstream
+    AccessUnit                    parameterSets;                  ///< extracted parameter sets, written in front of the next slice of the MCTS
+    Bool                          extractionInfoPresent;          ///< indicates whether MCTS extraction info for this mcts idx has been found in the bitstream
+  };
+
+  std::vector<MctsOutput*>        m_mctsOutputs;                  ///< outputs indexed by mcts idx, NULL for MCTSs that are not extracted
+  Bool                            m_mctsExtractionInfoPresent;    ///< indicates whether MCTS extraction info for any extracted mcts idx has been found in the bitstream
 
 public:
   TAppMctsExtTop();
@@ -81,13 +88,10 @@ public:
   Void  extract(); ///< main extracting function
 
 protected:
-  Void  xCreateMctsExtLib(); ///< create internal classes
-  Void  xDestroyMctsExtLib(); ///< destroy internal classes
-  Void  xInitMctsExtLib(); ///< initialize decoder class
-
-  Void  xExtractSuitableParameterSets(SEIMessages SEIMctsSEIs, SEIMessages SEIMctsEisSEIs, AccessUnit &accessUnit); ///< search suitable EIS and extract parameter sets into AU
-  Bool  xIsNaluWithinMCTSSet(Int MCTS_id); ///< check whether given Nalu belongs to MCTS SET
-  Void  xInputToOutputSliceNaluConversion(InputNALUnit &inNalu, OutputNALUnit &outNalu, TComSlice* curSlice); ///< input to output nalu conversion
+  MctsOutput* xCreateMctsOutput(Int mctsIdx, const std::string& fileName); ///< open the output sub-bitstream of an MCTS
+  Void  xExtractSuitableParameterSets(SEIMessages SEIMctsSEIs, SEIMessages SEIMctsEisSEIs); ///< search suitable EIS and extract parameter sets into the AU of each extracted MCTS
+  Int   xGetMctsIdxOfSlice(); ///< mcts idx of the tile containing the last parsed slice
+  Void  xWriteSlice(std::ostream& bitstreamFile, const NALUnit& nalu, const uint8_t* nalUnit, size_t numBytes, size_t sliceDataOffset, Bool firstNaluInAccessUnit); ///< write the last parsed slice with a rewritten header and its slice data copied verbatim
   Void  xWriteOutput(std::ostream& bitstreamFile, const AccessUnit accessUnit); ///< write AU into output bitstream
 };
 
@@ -39,11 +39,36 @@
 
 #if JVET_X0048_X0103_FILM_GRAIN
 
+#if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0) && defined(__SSE4_1__)
+#include <smmintrin.h>
+#define FILM_GRAIN_ANALYSIS_SIMD 1
+#else
+#define FILM_GRAIN_ANALYSIS_SIMD 0
+#endif
+
+static const int FG_ANALYSIS_BAND_HEIGHT = 16;   // rows per task when a picture is processed in parallel
+
+// call func(rowStart, rowEnd) for bands of rows covering [0, height); bands run in parallel if a thread pool is given
+static void runRowBands(TComThreadPool* threadPool, const int height, const std::function<void(int, int)>& func)
+{
+  const int numBands = (height + FG_ANALYSIS_BAND_HEIGHT - 1) / FG_ANALYSIS_BAND_HEIGHT;
+  if (threadPool == nullptr || numBands <= 1)
+  {
+    func(0, height);
+    return;
+  }
+  threadPool->run(numBands, [&](Int band)
+  {
+    func(band * FG_ANALYSIS_BAND_HEIGHT, std::min(height, (band + 1) * FG_ANALYSIS_BAND_HEIGHT));
+  });
+}
+
 // ====================================================================================================================
 // Edge detection - Canny
 // ====================================================================================================================
-const int Canny::m_gx[3][3]{ { -1, 0, 1 }, { -2, 0, 2 }, { -1, 0, 1 } };
-const int Canny::m_gy[3][3]{ { -1, -2, -1 }, { 0, 0, 0 }, { 1, 2, 1 } };
+// the 3x3 Sobel kernels are gx[x][y] = m_sobelSmooth[x] * m_sobelDiff[y] and gy[x][y] = m_sobelDiff[x] * m_sobelSmooth[y]
+const int Canny::m_sobelSmooth[3]{ 1, 2, 1 };
+const int Canny::m_sobelDiff[3]{ -1, 0, 1 };
 
 const int Canny::m_gauss5x5[5][5]{ { 2, 4, 5, 4, 2 },
                                  { 4, 9, 12, 9, 4 },
@@ -61,6 +86,50 @@ Canny::~Canny()
   // uninit();
 }
 
+// quantize the edge direction atan2(gx, gy) to 0, 45, 90 or 135 degrees
+static inline Pel quantizeEdgeDirection(const Pel gx, const Pel gy)
+{
+  // 360 degrees are split into the 8 equal parts; edge direction is quantized
+  const double edge_threshold_22_5  = 22.5;
+  const double edge_threshold_67_5  = 67.5;
+  const double edge_threshold_112_5 = 112.5;
+  const double edge_threshold_157_5 = 157.5;
+  const double tan_22_5             = 0.41421356237309503;
+
+  // compare the gradient components directly unless the direction is close to a bin boundary
+  const double absX   = abs(gx);
+  const double absY   = abs(gy);
+  const double margin = 1e-6 * (absX + absY);
+  const double distV  = absX - tan_22_5 * absY;   // negative: within 22.5 degrees of the gy axis
+  const double distH  = absY - tan_22_5 * absX;   // negative: within 22.5 degrees of the gx axis
+  if (fabs(distV) > margin && fabs(distH) > margin)
+  {
+    if (distV < 0)
+    {
+      return 0;
+    }
+    if (distH < 0)
+    {
+      return 90;
+    }
+    return ((gx > 0) == (gy > 0)) ? 45 : 135;
+  }
+
+  double theta = (atan2(gx, gy) * 180) / PI;
+  Pel    dir   = 0;
+
+  /* Convert actual edge direction to approximate value - quantize directions */
+  if (((-edge_threshold_22_5 < theta) && (theta <= edge_threshold_22_5)) || ((edge_threshold_157_5 < theta) || (theta <= -edge_threshold_157_5)))
+    dir = 0;
+  if (((-edge_threshold_157_5 < theta) && (theta <= -edge_threshold_112_5)) || ((edge_threshold_22_5 < theta) && (theta <= edge_threshold_67_5)))
+    dir = 45;
+  if (((-edge_threshold_112_5 < theta) && (theta <= -edge_threshold_67_5)) || ((edge_threshold_67_5 < theta) && (theta <= edge_threshold_112_5)))
+    dir = 90;
+  if (((-edge_threshold_67_5 < theta) && (theta <= -edge_threshold_22_5)) || ((edge_threshold_112_5 < theta) && (theta <= edge_threshold_157_5)))
+    dir = 135;
+  return dir;
+}
+
 void Canny::gradient(TComPicYuv* buff1, TComPicYuv* buff2, unsigned int width, unsigned int height,
                      unsigned int convWidthS, unsigned int convHeightS, unsigned int bitDepth, ComponentID compID)
 {
@@ -68,138 +137,120 @@ void Canny::gradient(TComPicYuv* buff1, TComPicYuv* buff2, unsigned int width, u
   buff1 - magnitude; buff2 - orientation (Only luma in buff2)
   */
 
-  // 360 degrees are split into the 8 equal parts; edge direction is quantized 
-  const double edge_threshold_22_5  = 22.5;
-  const double edge_threshold_67_5  = 67.5;
-  const double edge_threshold_112_5 = 112.5;
-  const double edge_threshold_157_5 = 157.5;
-
-  const int maxClpRange = (1 << bitDepth) - 1;
+  const Pel maxClpRange = (Pel)((1 << bitDepth) - 1);
   const int padding     = convWidthS / 2;
 
-  // tmp buffs
-  TComPicYuv* tmpBuf1 = new TComPicYuv;
-  TComPicYuv* tmpBuf2 = new TComPicYuv;
-  tmpBuf1->createWithPadding(width, height, CHROMA_400);
-  tmpBuf2->createWithPadding(width, height, CHROMA_400);
-
   buff1->extendPicBorder(compID, padding, padding, false);
 
-  // Gx
-  for (int i = 0; i < width; i++)
+  const int  srcStride = buff1->getStride(compID, false);
+  const Pel* src       = buff1->getAddr(compID);
+  const int  dirStride = buff2->getStride(COMPONENT_Y, false);
+  Pel*       dir       = buff2->getAddr(COMPONENT_Y);
+
+  std::vector<Pel> magnitude(width * height);   // buff1 is read by neighbouring rows, so it is updated at the end
+
+  runRowBands(m_threadPool, height, [&](int rowStart, int rowEnd)
   {
-    for (int j = 0; j < height; j++)
+    // vertical pass for columns -1 .. width, followed by the horizontal pass
+    std::vector<Pel> colDiff(width + 2);
+    std::vector<Pel> colSmooth(width + 2);
+    std::vector<Pel> gx(width);
+    std::vector<Pel> gy(width);
+
+    for (int j = rowStart; j < rowEnd; j++)
     {
-      int acc = 0;
-      for (int x = 0; x < convWidthS; x++)
+      const Pel* above = src + (j - 1) * srcStride - 1;
+      const Pel* cur   = above + srcStride;
+      const Pel* below = cur + srcStride;
+
+      int i = 0;
+#if FILM_GRAIN_ANALYSIS_SIMD
+      for (; i + 8 <= (int)width + 2; i += 8)
       {
-        for (int y = 0; y < convHeightS; y++)
-        {
-          acc += (buff1->at(x - convWidthS / 2 + i, y - convHeightS / 2 + j, compID, false) * m_gx[x][y]);
-        }
+        const __m128i a = _mm_loadu_si128((const __m128i*)(above + i));
+        const __m128i c = _mm_loadu_si128((const __m128i*)(cur + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(below + i));
+        _mm_storeu_si128((__m128i*)&colDiff[i], _mm_sub_epi16(b, a));
+        _mm_storeu_si128((__m128i*)&colSmooth[i], _mm_add_epi16(_mm_add_epi16(a, b), _mm_slli_epi16(c, 1)));
+      }
+#endif
+      for (; i < (int)width + 2; i++)
+      {
+        colDiff[i]   = (Pel)(m_sobelDiff[0] * above[i] + m_sobelDiff[1] * cur[i] + m_sobelDiff[2] * below[i]);
+        colSmooth[i] = (Pel)(m_sobelSmooth[0] * above[i] + m_sobelSmooth[1] * cur[i] + m_sobelSmooth[2] * below[i]);
       }
-      tmpBuf1->at(i, j, ComponentID(0), false) = acc;
-    }
-  }
 
-  // Gy
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      int acc = 0;
-      for (int x = 0; x < convWidthS; x++)
+      i = 0;
+#if FILM_GRAIN_ANALYSIS_SIMD
+      for (; i + 8 <= (int)width; i += 8)
       {
-        for (int y = 0; y < convHeightS; y++)
-        {
-          acc += (buff1->at(x - convWidthS / 2 + i, y - convHeightS / 2 + j, compID, false) * m_gy[x][y]);
-        }
+        const __m128i d0 = _mm_loadu_si128((const __m128i*)&colDiff[i]);
+        const __m128i d1 = _mm_loadu_si128((const __m128i*)&colDiff[i + 1]);
+        const __m128i d2 = _mm_loadu_si128((const __m128i*)&colDiff[i + 2]);
+        const __m128i s0 = _mm_loadu_si128((const __m128i*)&colSmooth[i]);
+        const __m128i s2 = _mm_loadu_si128((const __m128i*)&colSmooth[i + 2]);
+        _mm_storeu_si128((__m128i*)&gx[i], _mm_add_epi16(_mm_add_epi16(d0, d2), _mm_slli_epi16(d1, 1)));
+        _mm_storeu_si128((__m128i*)&gy[i], _mm_sub_epi16(s2, s0));
+      }
+#endif
+      for (; i < (int)width; i++)
+      {
+        gx[i] = (Pel)(m_sobelSmooth[0] * colDiff[i] + m_sobelSmooth[1] * colDiff[i + 1] + m_sobelSmooth[2] * colDiff[i + 2]);
+        gy[i] = (Pel)(m_sobelDiff[0] * colSmooth[i] + m_sobelDiff[1] * colSmooth[i + 1] + m_sobelDiff[2] * colSmooth[i + 2]);
       }
-      tmpBuf2->at(i, j, ComponentID(0), false) = acc;
-    }
-  }
 
-  // magnitude
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      Pel tmp                     = (Pel)((abs(tmpBuf1->at(i, j, ComponentID(0), false)) + abs(tmpBuf2->at(i, j, ComponentID(0), false))) / 2);
-      buff1->at(i, j, compID, false) = (Pel) Clip3((Pel) 0, (Pel) maxClpRange, tmp);
+      Pel* magRow = &magnitude[j * width];
+      Pel* dirRow = dir + j * dirStride;
+      for (i = 0; i < (int)width; i++)
+      {
+        Pel tmp   = (Pel)((abs(gx[i]) + abs(gy[i])) / 2);
+        magRow[i] = Clip3((Pel)0, maxClpRange, tmp);
+        dirRow[i] = quantizeEdgeDirection(gx[i], gy[i]);
+      }
     }
-  }
+  });
 
-  // edge direction - quantized edge directions
-  for (int i = 0; i < width; i++)
+  Pel* dst = buff1->getAddr(compID);
+  for (int j = 0; j < height; j++)
   {
-    for (int j = 0; j < height; j++)
-    {
-      double theta = (atan2(tmpBuf1->at(i, j, ComponentID(0), false), tmpBuf2->at(i, j, ComponentID(0), false)) * 180) / PI;
-
-      /* Convert actual edge direction to approximate value - quantize directions */
-      if (((-edge_threshold_22_5 < theta) && (theta <= edge_threshold_22_5)) || ((edge_threshold_157_5 < theta) || (theta <= -edge_threshold_157_5)))
-        buff2->at(i, j, ComponentID(0), false) = 0;
-      if (((-edge_threshold_157_5 < theta) && (theta <= -edge_threshold_112_5)) || ((edge_threshold_22_5 < theta) && (theta <= edge_threshold_67_5)))
-        buff2->at(i, j, ComponentID(0), false) = 45;
-      if (((-edge_threshold_112_5 < theta) && (theta <= -edge_threshold_67_5)) || ((edge_threshold_67_5 < theta) && (theta <= edge_threshold_112_5)))
-        buff2->at(i, j, ComponentID(0), false) = 90;
-      if (((-edge_threshold_67_5 < theta) && (theta <= -edge_threshold_22_5)) || ((edge_threshold_112_5 < theta) && (theta <= edge_threshold_157_5)))
-        buff2->at(i, j, ComponentID(0), false) = 135;
-    }
+    ::memcpy(dst + j * srcStride, &magnitude[j * width], width * sizeof(Pel));
   }
 
   buff1->extendPicBorder(compID, padding, padding, false);   // extend border for the next steps
-  tmpBuf1->destroy();
-  tmpBuf2->destroy();
-  delete tmpBuf1;
-  tmpBuf1 = nullptr;
-  delete tmpBuf2;
-  tmpBuf2 = nullptr;
 }
 
 void Canny::suppressNonMax(TComPicYuv* buff1, TComPicYuv* buff2, unsigned int width, unsigned int height,
                            ComponentID compID)
 {
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      int rowShift = 0, colShift = 0;
+  const int  magStride = buff1->getStride(compID, false);
+  const Pel* mag       = buff1->getAddr(compID);
+  const int  dirStride = buff2->getStride(COMPONENT_Y, false);
+  Pel*       dir       = buff2->getAddr(COMPONENT_Y);
 
-      switch (buff2->at(i, j, ComponentID(0), false))
-      {
-      case 0:
-        rowShift = 1;
-        colShift = 0;
-        break;
-      case 45:
-        rowShift = 1;
-        colShift = 1;
-        break;
-      case 90:
-        rowShift = 0;
-        colShift = 1;
-        break;
-      case 135:
-        rowShift = -1;
-        colShift = 1;
-        break;
-      default: throw("Unsupported gradient direction."); break;
-      }
+  // neighbour offset along the edge direction, indexed by direction / 45
+  const int neighbourOffset[4] = { 1, 1 + magStride, magStride, -1 + magStride };
 
-      Pel pelCurrent             = buff1->at(i, j, compID, false);
-      Pel pelEdgeDirectionTop    = buff1->at(i + rowShift, j + colShift, compID, false);
-      Pel pelEdgeDirectionBottom = buff1->at(i - rowShift, j - colShift, compID, false);
-      if ((pelCurrent < pelEdgeDirectionTop) || (pelCurrent < pelEdgeDirectionBottom))
-      {
-        buff2->at(i, j, ComponentID(0), false) = 0;   // supress
-      }
-      else
+  runRowBands(m_threadPool, height, [&](int rowStart, int rowEnd)
+  {
+    for (int j = rowStart; j < rowEnd; j++)
+    {
+      const Pel* magRow = mag + j * magStride;
+      Pel*       dirRow = dir + j * dirStride;
+      for (int i = 0; i < width; i++)
       {
-        buff2->at(i, j, ComponentID(0), false) = buff1->at(i, j, compID, false);   // keep
+        const int offset     = neighbourOffset[dirRow[i] / 45];
+        const Pel pelCurrent = magRow[i];
+        if ((pelCurrent < magRow[i + offset]) || (pelCurrent < magRow[i - offset]))
+        {
+          dirRow[i] = 0;   // supress
+        }
+        else
+        {
+          dirRow[i] = pelCurrent;   // keep
+        }
       }
     }
-  }
+  });
   buff2->copyTo(buff1, ComponentID(0), compID, false, false);
 }
 
@@ -209,14 +260,29 @@ void Canny::doubleThreshold(TComPicYuv* buff, unsigned int width, unsigned int h
   Pel strongPel = ((Pel) 1 << bitDepth) - 1;
   Pel weekPel   = ((Pel) 1 << (bitDepth - 1)) - 1;
 
-  Pel highThreshold = 0;
-  Pel lowThreshold  = strongPel;
-  for (int i = 0; i < width; i++)
+  const int stride = buff->getStride(compID, false);
+  Pel*      pel    = buff->getAddr(compID);
+
+  std::vector<Pel> rowMax(height, 0);
+  runRowBands(m_threadPool, height, [&](int rowStart, int rowEnd)
   {
-    for (int j = 0; j < height; j++)
+    for (int j = rowStart; j < rowEnd; j++)
     {
-      highThreshold = std::max<Pel>(highThreshold, buff->at(i, j, compID, false));
+      const Pel* row = pel + j * stride;
+      Pel        max = 0;
+      for (int i = 0; i < width; i++)
+      {
+        max = std::max<Pel>(max, row[i]);
+      }
+      rowMax[j] = max;
     }
+  });
+
+  Pel highThreshold = 0;
+  Pel lowThreshold  = strongPel;
+  for (int j = 0; j < height; j++)
+  {
+    highThreshold = std::max<Pel>(highThreshold, rowMax[j]);
   }
 
   // global low and high threshold
@@ -226,18 +292,22 @@ void Canny::doubleThreshold(TComPicYuv* buff, unsigned int width, unsigned int h
           m_highThresholdRatio * lowThreshold);   // Canny recommended a upper:lower ratio between 2:1 and 3:1.
 
   // strong, week, supressed
-  for (int i = 0; i < width; i++)
+  runRowBands(m_threadPool, height, [&](int rowStart, int rowEnd)
   {
-    for (int j = 0; j < height; j++)
+    for (int j = rowStart; j < rowEnd; j++)
     {
-      if (buff->at(i, j, compID, false) > highThreshold)
-        buff->at(i, j, compID, false) = strongPel;
-      else if (buff->at(i, j, compID, false) <= highThreshold && buff->at(i, j, compID, false) > lowThreshold)
-        buff->at(i, j, compID, false) = weekPel;
-      else
-        buff->at(i, j, compID, false) = 0;
+      Pel* row = pel + j * stride;
+      for (int i = 0; i < width; i++)
+      {
+        if (row[i] > highThreshold)
+          row[i] = strongPel;
+        else if (row[i] > lowThreshold)
+          row[i] = weekPel;
+        else
+          row[i] = 0;
+      }
     }
-  }
+  });
 
   buff->extendPicBorder(compID, 1, 1, false); // extend one pixel on each side for the next step
 }
@@ -248,36 +318,56 @@ void Canny::edgeTracking(TComPicYuv* buff, unsigned int width, unsigned int heig
   Pel strongPel = ((Pel) 1 << bitDepth) - 1;
   Pel weekPel   = ((Pel) 1 << (bitDepth - 1)) - 1;
 
-  for (int i = 0; i < width; i++)
+  const int stride = buff->getStride(compID, false);
+  Pel*      pel    = buff->getAddr(compID);
+
+  // a promoted pixel can promote its neighbours, so weak pixels are resolved sequentially in column-major order;
+  // only the weak pixels are visited, they are collected in parallel
+  std::vector<std::vector<int>> weakInRow(height);
+  runRowBands(m_threadPool, height, [&](int rowStart, int rowEnd)
   {
-    for (int j = 0; j < height; j++)
+    for (int j = rowStart; j < rowEnd; j++)
     {
-      if (buff->at(i, j, compID, false) == weekPel)
+      const Pel* row = pel + j * stride;
+      for (int i = 0; i < width; i++)
       {
-        bool strong = false;
-
-        for (int x = 0; x < windowWidth; x++)
+        if (row[i] == weekPel)
         {
-          for (int y = 0; y < windowHeight; y++)
-          {
-            if (buff->at(x - windowWidth / 2 + i, y - windowHeight / 2 + j, compID, false) == strongPel)
-            {
-              strong = true;
-              break;
-            }
-          }
+          weakInRow[j].push_back(i);
         }
+      }
+    }
+  });
 
-        if (strong)
-        {
-          buff->at(i, j, compID, false) = strongPel;
-        }
-        else
+  std::vector<std::pair<int, int>> weakPels;
+  for (int j = 0; j < height; j++)
+  {
+    for (int i: weakInRow[j])
+    {
+      weakPels.push_back(std::make_pair(i, j));
+    }
+  }
+  std::sort(weakPels.begin(), weakPels.end());
+
+  for (const auto& pos: weakPels)
+  {
+    Pel* current = pel + pos.second * stride + pos.first;
+    bool strong  = false;
+
+    for (int y = 0; y < windowHeight && !strong; y++)
+    {
+      const Pel* row = current + (y - (int)windowHeight / 2) * stride - (int)windowWidth / 2;
+      for (int x = 0; x < windowWidth; x++)
+      {
+        if (row[x] == strongPel)
         {
-          buff->at(i, j, compID, false) = 0;   // supress
+          strong = true;
+          break;
         }
       }
     }
+
+    *current = strong ? strongPel : 0;   // promote or supress
   }
 }
 
@@ -330,108 +420,87 @@ Morph::~Morph()
   // uninit();
 }
 
-int Morph::dilation(TComPicYuv* buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter)
+// set every sample to target that has a target sample within numIter applications of the kernel window.
+// numIter passes of the kernel with replicated picture borders equal one pass of a (numIter * (kernelSize - 1) + 1)
+// square window clamped to the picture, which is evaluated separably in a single pass.
+void Morph::morph(TComPicYuv* buff, ComponentID compID, Pel target, int numIter)
 {
-  if (iter == numIter)
-    return iter;
-
-  const int width = buff->getWidth(compID);
+  const int width  = buff->getWidth(compID);
   const int height = buff->getHeight(compID);
-  unsigned int windowSize = m_kernelSize;
-  unsigned int padding    = windowSize / 2;
+  const int radius = numIter * (m_kernelSize / 2);
+  const int stride = buff->getStride(compID, false);
+  Pel*      pel    = buff->getAddr(compID);
 
-  Pel strongPel = ((Pel) 1 << bitDepth) - 1;
+  std::vector<UChar> rowHit(width * height);   // target within the horizontal extent of the window
 
-  TComPicYuv* tmpBuf = new TComPicYuv;
-  tmpBuf->createWithPadding(width, height, CHROMA_400);
-  buff->copyTo(tmpBuf, compID, ComponentID(0), false, false);
-
-  buff->extendPicBorder(compID, padding, padding, false);
-
-  for (int i = 0; i < width; i++)
+  runRowBands(m_threadPool, height, [&](int rowStart, int rowEnd)
   {
-    for (int j = 0; j < height; j++)
+    std::vector<int> count(width + 1, 0);   // running count of target samples in the row
+    for (int j = rowStart; j < rowEnd; j++)
     {
-      bool strong = false;
-      for (int x = 0; x < windowSize; x++)
+      const Pel* row = pel + j * stride;
+      for (int i = 0; i < width; i++)
       {
-        for (int y = 0; y < windowSize; y++)
-        {
-          if (buff->at(x - windowSize / 2 + i, y - windowSize / 2 + j, compID, false) == strongPel)
-          {
-            strong = true;
-            break;
-          }
-        }
+        count[i + 1] = count[i] + (row[i] == target);
       }
-      if (strong)
+      UChar* hit = &rowHit[j * width];
+      for (int i = 0; i < width; i++)
       {
-        tmpBuf->at(i, j, ComponentID(0), false) = strongPel;
+        hit[i] = count[std::min(width, i + radius + 1)] > count[std::max(0, i - radius)];
       }
     }
-  }
-
-  tmpBuf->copyTo(buff, ComponentID(0), compID, false, false);
-  tmpBuf->destroy();
-  delete tmpBuf;
-  tmpBuf = nullptr;
-
-  iter++;
-
-  iter = dilation(buff, bitDepth, compID, numIter, iter);
-
-  return iter;
-}
-
-int Morph::erosion(TComPicYuv* buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter)
-{
-  if (iter == numIter)
-    return iter;
+  });
 
-  const int width = buff->getWidth(compID);
-  const int height = buff->getHeight(compID);
-  unsigned int windowSize = m_kernelSize;
-  unsigned int padding    = windowSize / 2;
-
-  TComPicYuv* tmpBuf = new TComPicYuv;
-  tmpBuf->createWithPadding(width, height, CHROMA_400);
-  buff->copyTo(tmpBuf, compID, ComponentID(0), false, false);
-
-  buff->extendPicBorder(compID, padding, padding, false);
-
-  for (int i = 0; i < width; i++)
+  runRowBands(m_threadPool, height, [&](int rowStart, int rowEnd)
   {
-    for (int j = 0; j < height; j++)
+    std::vector<UChar> hit(width);
+    for (int j = rowStart; j < rowEnd; j++)
     {
-      bool week = false;
-      for (int x = 0; x < windowSize; x++)
+      const int top    = std::max(0, j - radius);
+      const int bottom = std::min(height - 1, j + radius);
+      std::fill(hit.begin(), hit.end(), 0);
+      for (int y = top; y <= bottom; y++)
       {
-        for (int y = 0; y < windowSize; y++)
+        const UChar* srcHit = &rowHit[y * width];
+        for (int i = 0; i < width; i++)
         {
-          if (buff->at(x - windowSize / 2 + i, y - windowSize / 2 + j, compID, false) == 0)
-          {
-            week = true;
-            break;
-          }
+          hit[i] |= srcHit[i];
         }
       }
-      if (week)
+      Pel* row = pel + j * stride;
+      for (int i = 0; i < width; i++)
       {
-        tmpBuf->at(i, j, ComponentID(0), false) = 0;
+        if (hit[i])
+        {
+          row[i] = target;
+        }
       }
     }
-  }
+  });
+
+  buff->extendPicBorder(compID, m_kernelSize / 2, m_kernelSize / 2, false);
+}
+
+int Morph::dilation(TComPicYuv* buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter)
+{
+  if (iter >= numIter)
+    return iter;
+
+  Pel strongPel = ((Pel) 1 << bitDepth) - 1;
+
+  morph(buff, compID, strongPel, numIter - iter);
 
-  tmpBuf->copyTo(buff, ComponentID(0), compID, false, false);
-  tmpBuf->destroy();
-  delete tmpBuf;
-  tmpBuf = nullptr;
+  return numIter;
+}
 
-  iter++;
+int Morph::erosion(TComPicYuv* buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter)
+{
+  if (iter >= numIter)
+    return iter;
 
-  iter = erosion(buff, bitDepth, compID, numIter, iter);
+  morph(buff, compID, 0, numIter - iter);
 
-  return iter;
+  return numIter;
 }
 
 // ====================================================================================================================
@@ -439,7 +508,8 @@ int Morph::erosion(TComPicYuv* buff, unsigned int bitDepth, ComponentID compID,
 // ====================================================================================================================
 FGAnalyser::FGAnalyser()
 {
-  // init();
+  m_edgeDetector.setThreadPool(&m_threadPool);
+  m_morphOperation.setThreadPool(&m_threadPool);
 }
 
 FGAnalyser::~FGAnalyser()
@@ -550,9 +620,17 @@ bool FGAnalyser::initBufs(TComPic *pic)
   return true;
 }
 
+// number of helper threads for the analysis of a picture; 0 runs it on the calling thread only
+void FGAnalyser::setNumThreads(int numThreads)
+{
+  m_threadPool.create(numThreads);
+}
+
 // delete picture buffers
 void FGAnalyser::destroy()
 {
+  waitForAnalysis();
+  m_threadPool.destroy();
   if (m_originalBuf != nullptr) {
     m_originalBuf->destroy();
     delete m_originalBuf;
@@ -579,6 +657,25 @@ void FGAnalyser::estimate_grain(TComPic*pic)
   estimate_grain_parameters();
 }
 
+// analyse the picture on a worker thread; the source and denoised pictures must not change until waitForAnalysis
+void FGAnalyser::startAnalysis(TComPic* pic)
+{
+  waitForAnalysis();
+  m_analysisThread = std::thread([this, pic]()
+  {
+    initBufs(pic);
+    estimate_grain(pic);
+  });
+}
+
+void FGAnalyser::waitForAnalysis()
+{
+  if (m_analysisThread.joinable())
+  {
+    m_analysisThread.join();
+  }
+}
+
 // find flat and low complexity regions of the frame
 void FGAnalyser::findMask()
 {
@@ -671,15 +768,25 @@ void FGAnalyser::suppressLowIntensity(const TComPicYuv& buff1, TComPicYuv& buff2
   Pel maxIntensity          = ((Pel) 1 << bitDepth) - 1;
   Pel lowIntensityThreshold = (Pel)(m_lowIntensityRatio * maxIntensity);
 
+  const int  srcStride = buff1.getStride(compID, false);
+  const int  dstStride = buff2.getStride(compID, false);
+  const Pel* src       = buff1.getAddr(compID);
+  Pel*       dst       = buff2.getAddr(compID);
+
   // strong, week, supressed
-  for (int i = 0; i < width; i++)
+  runRowBands(&m_threadPool, height, [&](int rowStart, int rowEnd)
   {
-    for (int j = 0; j < height; j++)
+    for (int j = rowStart; j < rowEnd; j++)
     {
-      if (buff1.at(i, j, compID, false) < lowIntensityThreshold)
-        buff2.at(i, j, compID, false) = maxIntensity;
+      const Pel* srcRow = src + j * srcStride;
+      Pel*       dstRow = dst + j * dstStride;
+      for (int i = 0; i < width; i++)
+      {
+        if (srcRow[i] < lowIntensityThreshold)
+          dstRow[i] = maxIntensity;
+      }
     }
-  }
+  });
 }
 
 void FGAnalyser::subsample(const TComPicYuv& input, TComPicYuv& output, ComponentID compID, const int factor, const int padding) const
@@ -712,7 +819,7 @@ void FGAnalyser::subsample(const TComPicYuv& input, TComPicYuv& output, Componen
   }
 }
 
-void FGAnalyser::upsample(const TComPicYuv& input, TComPicYuv& output, ComponentID compID, const int factor, const int padding) const
+void FGAnalyser::upsample(const TComPicYuv& input, TComPicYuv& output, ComponentID compID, const int factor, const int padding)
 {
   // binary mask upsampling
   // use simple replication of pixels
@@ -720,21 +827,30 @@ void FGAnalyser::upsample(const TComPicYuv& input, TComPicYuv& output, Component
   const int width  = input.getWidth(compID);
   const int height = input.getHeight(compID);
 
-  for (int i = 0; i < width; i++)
+  const int  srcStride = input.getStride(compID, false);
+  const int  dstStride = output.getStride(compID, false);
+  const Pel* src       = input.getAddr(compID);
+  Pel*       dst       = output.getAddr(compID);
+
+  runRowBands(&m_threadPool, height, [&](int rowStart, int rowEnd)
   {
-    for (int j = 0; j < height; j++)
+    for (int j = rowStart; j < rowEnd; j++)
     {
-      Pel currentPel = input.at(i, j, compID, false);
-
-      for (int x = 0; x < factor; x++)
+      const Pel* srcRow = src + j * srcStride;
+      Pel*       dstRow = dst + j * factor * dstStride;
+      for (int i = 0; i < width; i++)
       {
-        for (int y = 0; y < factor; y++)
+        for (int x = 0; x < factor; x++)
         {
-          output.at(i * factor + x, j * factor + y, compID, false) = currentPel;
+          dstRow[i * factor + x] = srcRow[i];
         }
       }
+      for (int y = 1; y < factor; y++)
+      {
+        ::memcpy(dstRow + y * dstStride, dstRow, width * factor * sizeof(Pel));
+      }
     }
-  }
+  });
 
   if (padding)
   {
@@ -747,13 +863,23 @@ void FGAnalyser::combineMasks(TComPicYuv& buff1, TComPicYuv& buff2, ComponentID
   const int width = buff1.getWidth(compID);
   const int height = buff1.getHeight(compID);
 
-  for (int i = 0; i < width; i++)
+  const int  dstStride = buff1.getStride(compID, false);
+  const int  srcStride = buff2.getStride(compID, false);
+  Pel*       dst       = buff1.getAddr(compID);
+  const Pel* src       = buff2.getAddr(compID);
+
+  runRowBands(&m_threadPool, height, [&](int rowStart, int rowEnd)
   {
-    for (int j = 0; j < height; j++)
+    for (int j = rowStart; j < rowEnd; j++)
     {
-      buff1.at(i, j, compID, false) = (buff1.at(i, j, compID, false) | buff2.at(i, j, compID, false));
+      Pel*       dstRow = dst + j * dstStride;
+      const Pel* srcRow = src + j * srcStride;
+      for (int i = 0; i < width; i++)
+      {
+        dstRow[i] |= srcRow[i];
+      }
     }
-  }
+  });
 }
 
 
@@ -794,24 +920,28 @@ void FGAnalyser::estimate_grain_parameters()
     unsigned int height = m_workingBuf->getHeight(compID);  // Height of current frame
     unsigned int windowSize  = FG_DATA_BASE_SIZE;           // Size for Film Grain block
     int          bitDepth     = m_bitDepths[channelId];
-    int          detect_edges = 0;
-    int          mean         = 0;
-    int          var          = 0;
 
     std::vector<int>       vec_mean;
     std::vector<int>       vec_var;
     std::vector<PelMatrix> squared_dct_grain_block_list;
 
-    for (int i = 0; i <= width - windowSize; i += windowSize)
-    {   // loop over windowSize x windowSize blocks
-      for (int j = 0; j <= height - windowSize; j += windowSize)
+    // columns of windowSize x windowSize blocks are analysed in parallel and their data points are concatenated in column order
+    const int                           numColumns = width / windowSize;
+    std::vector<std::vector<int>>       columnMean(numColumns);
+    std::vector<std::vector<int>>       columnVar(numColumns);
+    std::vector<std::vector<PelMatrix>> columnBlocks(numColumns);
+
+    m_threadPool.run(numColumns, [&](Int column)
+    {
+      const int i = column * windowSize;
+      for (int j = 0; j <= (int)height - (int)windowSize; j += windowSize)
       {
-        detect_edges = count_edges(*m_maskBuf, windowSize, compID, i, j);   // for flat region without edges
+        int detect_edges = count_edges(*m_maskBuf, windowSize, compID, i, j);   // for flat region without edges
 
         if (detect_edges)   // selection of uniform, flat and low-complexity area; extend to other features, e.g., variance.
         {
           // find transformed blocks; cut-off frequency estimation is done on 64 x 64 blocks as low-pass filtering on synthesis side is done on 64 x 64 blocks.
-          block_transform(*tmpBuff, squared_dct_grain_block_list, i, j, bitDepth, compID);
+          block_transform(*tmpBuff, columnBlocks[column], i, j, bitDepth, compID);
         }
 
         int step = windowSize / blockSize;
@@ -824,21 +954,28 @@ void FGAnalyser::estimate_grain_parameters()
             if (detect_edges)   // selection of uniform, flat and low-complexity area; extend to other features, e.g., variance.
             {
               // collect all data for parameter estimation; mean and variance are caluclated on blockSize x blockSize blocks
-              mean = meanVar(*m_workingBuf, blockSize, compID, i + k * blockSize, j + m * blockSize, false);
-              var  = meanVar(*tmpBuff, blockSize, compID, i + k * blockSize, j + m * blockSize, true);
+              int mean = meanVar(*m_workingBuf, blockSize, compID, i + k * blockSize, j + m * blockSize, false);
+              int var  = meanVar(*tmpBuff, blockSize, compID, i + k * blockSize, j + m * blockSize, true);
               // regularize high variations; controls excessively fluctuating points
               double tmp = 3.0 * pow((double)(var), .5) + .5;
               var = (int)tmp;
 
               if (var < (MAX_REAL_SCALE << (bitDepth - FG_BIT_DEPTH_8))) // limit data points to meaningful values. higher variance can be result of not perfect mask estimation (non-flat regions fall in estimation process)
               {
-                vec_mean.push_back(mean);   // mean of the filtered frame
-                vec_var.push_back(var);     // variance of the film grain estimate
+                columnMean[column].push_back(mean);   // mean of the filtered frame
+                columnVar[column].push_back(var);     // variance of the film grain estimate
               }
             }
           }
         }
       }
+    });
+
+    for (int column = 0; column < numColumns; column++)
+    {
+      vec_mean.insert(vec_mean.end(), columnMean[column].begin(), columnMean[column].end());
+      vec_var.insert(vec_var.end(), columnVar[column].begin(), columnVar[column].end());
+      std::move(columnBlocks[column].begin(), columnBlocks[column].end(), std::back_inserter(squared_dct_grain_block_list));
     }
 
     // calculate film grain parameters
@@ -1875,13 +2012,23 @@ void FGAnalyser::subtract(TComPicYuv& buffer1, TComPicYuv& buffer2)
     const Int widthSrc = buffer1.getWidth(compID);
     const Int heightSrc = buffer1.getHeight(compID);
 
-    for (int x=0; x<widthSrc; x++)
+    const int  srcStride = buffer1.getStride(compID, false);
+    const int  dstStride = buffer2.getStride(compID, false);
+    const Pel* src       = buffer1.getAddr(compID);
+    Pel*       dst       = buffer2.getAddr(compID);
+
+    runRowBands(&m_threadPool, heightSrc, [&](int rowStart, int rowEnd)
     {
-      for (int y = 0; y < heightSrc; y++)
+      for (int y = rowStart; y < rowEnd; y++)
       {
-        buffer2.at(x,y, compID, false) -= buffer1.at(x, y, compID, false);
+        const Pel* srcRow = src + y * srcStride;
+        Pel*       dstRow = dst + y * dstStride;
+        for (int x = 0; x < widthSrc; x++)
+        {
+          dstRow[x] -= srcRow[x];
+        }
       }
-    }
+    });
   }
 }
 
@@ -44,10 +44,13 @@
 #include "TLibCommon/SEI.h"
 #include "Utilities/TVideoIOYuv.h"
 #include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include <numeric>
 #include <cmath>
 #include <algorithm>
+#include <iterator>
+#include <thread>
 
 #if JVET_X0048_X0103_FILM_GRAIN
 static const double PI                                      = 3.14159265358979323846;
@@ -96,17 +99,19 @@ public:
   unsigned int      m_convWidthG = 5, m_convHeightG = 5;		  // Pixel's row and col positions for Gauss filtering
 
   void detect_edges(const TComPicYuv* orig, TComPicYuv* dest, unsigned int uiBitDepth, ComponentID compID);
+  void setThreadPool(TComThreadPool* threadPool) { m_threadPool = threadPool; }
 
 private:
-  static const int  m_gx[3][3];                               // Sobel kernel x
-  static const int  m_gy[3][3];                               // Sobel kernel y
+  static const int  m_sobelSmooth[3];                         // separable Sobel kernel, smoothing part
+  static const int  m_sobelDiff[3];                           // separable Sobel kernel, derivative part
   static const int  m_gauss5x5[5][5];                         // Gauss 5x5 kernel, integer approximation
 
   unsigned int      m_convWidthS = 3, m_convHeightS = 3;		  // Pixel's row and col positions for Sobel filtering
 
   double            m_lowThresholdRatio   = 0.1;               // low threshold rato
   int               m_highThresholdRatio  = 3;                 // high threshold rato
-  
+  TComThreadPool*   m_threadPool          = nullptr;           // row bands are processed in parallel when set
+
   void gradient   (TComPicYuv* buff1, TComPicYuv* buff2,
                     unsigned int width, unsigned int height,
                     unsigned int convWidthS, unsigned int convHeightS, unsigned int bitDepth, ComponentID compID );
@@ -126,9 +131,13 @@ public:
 
   int dilation  (TComPicYuv* buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter = 0);
   int erosion   (TComPicYuv* buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter = 0);
+  void setThreadPool(TComThreadPool* threadPool) { m_threadPool = threadPool; }
 
 private:
-  unsigned int m_kernelSize = 3;		// Dilation and erosion kernel size
+  unsigned int    m_kernelSize = 3;		// Dilation and erosion kernel size
+  TComThreadPool* m_threadPool = nullptr;
+
+  void morph    (TComPicYuv* buff, ComponentID compID, Pel target, int numIter);
 };
 
 
@@ -152,9 +161,14 @@ public:
       std::string filmGrainExternalMask,
       std::string filmGrainExternalDenoised);
   void destroy        ();
+  void setNumThreads  (int numThreads);
   bool initBufs       (TComPic* pic);
   void estimate_grain (TComPic* pic);
 
+  // run initBufs and estimate_grain on a worker thread; the estimated model must not be read before waitForAnalysis
+  void startAnalysis  (TComPic* pic);
+  void waitForAnalysis();
+
   int                                     getLog2scaleFactor()  { return m_log2ScaleFactor; };
   SEIFilmGrainCharacteristics::CompModel  getCompModel(int idx) { return m_compModel[idx];  };
 
@@ -172,6 +186,8 @@ private:
 
   Canny    m_edgeDetector;
   Morph    m_morphOperation;
+  TComThreadPool m_threadPool;
+  std::thread    m_analysisThread;
   double   m_lowIntensityRatio            = 0.1;                    // supress everything below 0.1*maxIntensityOffset
   static constexpr double m_tap_filtar[3] = { 1, 2, 1 };
   static constexpr double m_normTap       = 4.0;
@@ -208,7 +224,7 @@ private:
   int         count_edges           (TComPicYuv& buffer, int windowSize, ComponentID compID, int offsetX, int offsetY);
 
   void subsample                    (const TComPicYuv& input, TComPicYuv& output, ComponentID compID, const int factor = 2, const int padding = 0) const;
-  void upsample                     (const TComPicYuv& input, TComPicYuv& output, ComponentID compID, const int factor = 2, const int padding = 0) const;
+  void upsample                     (const TComPicYuv& input, TComPicYuv& output, ComponentID compID, const int factor = 2, const int padding = 0);
   void combineMasks                 (TComPicYuv& buff, TComPicYuv& buff2, ComponentID compID);
   void suppressLowIntensity         (const TComPicYuv& buff1, TComPicYuv& buff2, unsigned int bitDepth, ComponentID compID);
   void subtract                     (TComPicYuv& buffer1, TComPicYuv& buffer2);
@@ -42,6 +42,13 @@
 
 #if JVET_X0048_X0103_FILM_GRAIN
 
+#if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0) && defined(__SSE4_1__)
+#include <smmintrin.h>
+#define FILM_GRAIN_SIMD 1
+#else
+#define FILM_GRAIN_SIMD 0
+#endif
+
 /* static look up table definitions */
 static const int8_t gaussianLUT[2048] =
 {
@@ -270,6 +277,11 @@ void SEIFilmGrainSynthesizer::destroy()
   }
 }
 
+void SEIFilmGrainSynthesizer::setNumThreads(Int numThreads)
+{
+  m_threadPool.create(numThreads);
+}
+
 void SEIFilmGrainSynthesizer::grainSynthesizeAndBlend(TComPicYuv* pGrainBuf, Bool isIdrPic)
 {
   uint8_t     numComp = MAX_NUM_COMPONENT, compCtr; /* number of color components */
@@ -400,6 +412,7 @@ void SEIFilmGrainSynthesizer::grainSynthesizeAndBlend(TComPicYuv* pGrainBuf, Boo
   m_fgsArgs.blkSize = m_fgsBlkSize;
   m_fgsArgs.bitDepth = m_bitDepth;
   m_fgsArgs.pGrainSynt = m_grainSynt;
+  m_fgsArgs.pThreadPool = &m_threadPool;
 
   fgsProcess(m_fgsArgs);
 
@@ -767,23 +780,39 @@ void SEIFilmGrainSynthesizer::blendStripe(Pel *decSampleHbdOffsetY, Pel *grainSt
   int32_t  grainSample;
   uint16_t decodeSampleHbd;
   uint8_t bitDepthShift = (bitDepth - FG_BIT_DEPTH_8);
-  uint32_t bufInc = (strideSrc - widthComp);
-  uint32_t grainBufInc = (strideGrain - widthComp);
+#if FILM_GRAIN_SIMD
+  const uint32_t widthSimd = widthComp & ~7;
+  const __m128i  mmMax     = _mm_set1_epi32(maxRange);
+  const __m128i  mmZero    = _mm_setzero_si128();
+  const __m128i  mmShift   = _mm_cvtsi32_si128(bitDepthShift);
+#else
+  const uint32_t widthSimd = 0;
+#endif
 
   for (l = 0; l < blockHeight; l++) /* y direction */
   {
-    for (k = 0; k < widthComp; k++) /* x direction */
+#if FILM_GRAIN_SIMD
+    for (k = 0; k < widthSimd; k += 8)
+    {
+      const __m128i dec   = _mm_loadu_si128((const __m128i*)(decSampleHbdOffsetY + k));
+      const __m128i grain = _mm_loadu_si128((const __m128i*)(grainStripe + k));
+      __m128i lo = _mm_add_epi32(_mm_sll_epi32(_mm_cvtepi16_epi32(grain), mmShift), _mm_cvtepu16_epi32(dec));
+      __m128i hi = _mm_add_epi32(_mm_sll_epi32(_mm_cvtepi16_epi32(_mm_srli_si128(grain, 8)), mmShift), _mm_cvtepu16_epi32(_mm_srli_si128(dec, 8)));
+      lo = _mm_min_epi32(_mm_max_epi32(lo, mmZero), mmMax);
+      hi = _mm_min_epi32(_mm_max_epi32(hi, mmZero), mmMax);
+      _mm_storeu_si128((__m128i*)(decSampleHbdOffsetY + k), _mm_packus_epi32(lo, hi));
+    }
+#endif
+    for (k = widthSimd; k < widthComp; k++) /* x direction */
     {
-      decodeSampleHbd = *decSampleHbdOffsetY;
-      grainSample = *grainStripe;
+      decodeSampleHbd = decSampleHbdOffsetY[k];
+      grainSample = grainStripe[k];
       grainSample <<= bitDepthShift;
       grainSample = CLIP3(0, maxRange, grainSample + decodeSampleHbd);
-      *decSampleHbdOffsetY = (Pel)grainSample;
-      decSampleHbdOffsetY++;
-      grainStripe++;
+      decSampleHbdOffsetY[k] = (Pel)grainSample;
     }
-    decSampleHbdOffsetY += bufInc;
-    grainStripe += grainBufInc;
+    decSampleHbdOffsetY += strideSrc;
+    grainStripe += strideGrain;
   }
   return;
 }
@@ -791,48 +820,74 @@ void SEIFilmGrainSynthesizer::blendStripe(Pel *decSampleHbdOffsetY, Pel *grainSt
 void SEIFilmGrainSynthesizer::blendStripe_32x32(Pel *decSampleHbdOffsetY, Pel *grainStripe, uint32_t widthComp,
   uint32_t strideSrc, uint32_t strideGrain, uint32_t blockHeight, uint8_t bitDepth)
 {
-  uint32_t k, l;
-  uint16_t maxRange;
-  maxRange = (1 << bitDepth) - 1;
+  blendStripe(decSampleHbdOffsetY, grainStripe, widthComp, strideSrc, strideGrain, blockHeight, bitDepth);
+}
 
-  int32_t  grainSample;
-  uint16_t decodeSampleHbd;
-  uint8_t bitDepthShift = (bitDepth - FG_BIT_DEPTH_8);
-  uint32_t bufInc = (strideSrc - widthComp);
-  uint32_t grainBufInc = (strideGrain - widthComp);
+#if FILM_GRAIN_SIMD
+/* sum of a block of samples whose width is a multiple of 8 */
+static inline uint32_t simdBlockSum(const Pel *decSampleBlk, uint32_t strideComp, uint32_t ySize, uint32_t xSize)
+{
+  const __m128i mmOne = _mm_set1_epi16(1);
+  __m128i       sum   = _mm_setzero_si128();
+  for (uint32_t k = 0; k < ySize; k++)
+  {
+    for (uint32_t l = 0; l < xSize; l += 8)
+    {
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(decSampleBlk + l)), mmOne));
+    }
+    decSampleBlk += strideComp;
+  }
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+  return (uint32_t)_mm_cvtsi128_si32(sum);
+}
 
-  for (l = 0; l < blockHeight; l++) /* y direction */
+/* scaling of a block of grain pattern samples whose width is a multiple of 8 */
+static inline void simdScaleGrainBlk(Pel *grainStripe, uint32_t grainStride, const int8_t *database, uint32_t ySize,
+                                     uint32_t xSize, int16_t scaleFactor, uint8_t shift)
+{
+  const __m128i mmScale = _mm_set1_epi16(scaleFactor);
+  const __m128i mmShift = _mm_cvtsi32_si128(shift);
+  for (uint32_t l = 0; l < ySize; l++)
   {
-    for (k = 0; k < widthComp; k++) /* x direction */
+    for (uint32_t k = 0; k < xSize; k += 8)
     {
-      decodeSampleHbd = *decSampleHbdOffsetY;
-      grainSample = *grainStripe;
-      grainSample <<= bitDepthShift;
-      grainSample = CLIP3(0, maxRange, grainSample + decodeSampleHbd);
-      *decSampleHbdOffsetY = (Pel)grainSample;
-      decSampleHbdOffsetY++;
-      grainStripe++;
+      const __m128i pattern = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i*)(database + k)));
+      const __m128i prodLo  = _mm_mullo_epi16(pattern, mmScale);
+      const __m128i prodHi  = _mm_mulhi_epi16(pattern, mmScale);
+      const __m128i lo      = _mm_sra_epi32(_mm_unpacklo_epi16(prodLo, prodHi), mmShift);
+      const __m128i hi      = _mm_sra_epi32(_mm_unpackhi_epi16(prodLo, prodHi), mmShift);
+      _mm_storeu_si128((__m128i*)(grainStripe + k), _mm_packs_epi32(lo, hi));
     }
-    decSampleHbdOffsetY += bufInc;
-    grainStripe += grainBufInc;
+    grainStripe += grainStride;
+    database    += FG_DATA_BASE_SIZE;
   }
-  return;
 }
+#endif
 
 Pel SEIFilmGrainSynthesizer::blockAverage_8x8(Pel *decSampleBlk8, uint32_t widthComp, uint16_t *pNumSamples,
   uint8_t ySize, uint8_t xSize, uint8_t bitDepth)
 {
   uint32_t blockAvg = 0;
-  uint8_t  k;
-  uint8_t l;
-  for (k = 0; k < ySize; k++)
+#if FILM_GRAIN_SIMD
+  if ((xSize & 7) == 0)
+  {
+    blockAvg = simdBlockSum(decSampleBlk8, widthComp, ySize, xSize);
+  }
+  else
+#endif
   {
-    for (l = 0; l < xSize; l++)
+    uint8_t  k;
+    uint8_t l;
+    for (k = 0; k < ySize; k++)
     {
-      blockAvg += *decSampleBlk8;
-      decSampleBlk8++;
+      for (l = 0; l < xSize; l++)
+      {
+        blockAvg += *decSampleBlk8;
+        decSampleBlk8++;
+      }
+      decSampleBlk8 += widthComp - xSize;
     }
-    decSampleBlk8 += widthComp - xSize;
   }
 
   blockAvg = blockAvg >> (FG_BLK_8_shift + (bitDepth - FG_BIT_DEPTH_8));
@@ -845,16 +900,25 @@ uint32_t SEIFilmGrainSynthesizer::blockAverage_16x16(Pel *decSampleBlk8, uint32_
   uint8_t ySize, uint8_t xSize, uint8_t bitDepth)
 {
   uint32_t blockAvg = 0;
-  uint8_t  k;
-  uint8_t l;
-  for (k = 0; k < ySize; k++)
+#if FILM_GRAIN_SIMD
+  if ((xSize & 7) == 0)
+  {
+    blockAvg = simdBlockSum(decSampleBlk8, widthComp, ySize, xSize);
+  }
+  else
+#endif
   {
-    for (l = 0; l < xSize; l++)
+    uint8_t  k;
+    uint8_t l;
+    for (k = 0; k < ySize; k++)
     {
-      blockAvg += *decSampleBlk8;
-      decSampleBlk8++;
+      for (l = 0; l < xSize; l++)
+      {
+        blockAvg += *decSampleBlk8;
+        decSampleBlk8++;
+      }
+      decSampleBlk8 += widthComp - xSize;
     }
-    decSampleBlk8 += widthComp - xSize;
   }
 
   // blockAvg = blockAvg >> (FG_BLK_16_shift + (bitDepth - FG_BIT_DEPTH_8));
@@ -866,6 +930,9 @@ uint32_t SEIFilmGrainSynthesizer::blockAverage_16x16(Pel *decSampleBlk8, uint32_
 uint32_t SEIFilmGrainSynthesizer::blockAverage_32x32(Pel *decSampleBlk32, uint32_t strideComp, uint8_t bitDepth)
 {
   uint32_t blockAvg = 0;
+#if FILM_GRAIN_SIMD
+  blockAvg = simdBlockSum(decSampleBlk32, strideComp, FG_BLK_32, FG_BLK_32);
+#else
   uint8_t  k;
   uint8_t l;
   uint32_t bufInc = strideComp - FG_BLK_32;
@@ -877,6 +944,7 @@ uint32_t SEIFilmGrainSynthesizer::blockAverage_32x32(Pel *decSampleBlk32, uint32
     }
     decSampleBlk32 += bufInc;
   }
+#endif
   blockAvg = blockAvg >> (FG_BLK_32_shift + (bitDepth - FG_BIT_DEPTH_8));
   return blockAvg;
 }
@@ -889,6 +957,13 @@ void SEIFilmGrainSynthesizer::simulateGrainBlk8x8(Pel *grainStripe, uint32_t gra
   uint32_t l;
   int8_t * database_h_v = &grain_synt->dataBase[h][v][lOffset][kOffset];
   grainStripe += grainStripeOffsetBlk8;
+#if FILM_GRAIN_SIMD
+  if ((xSize & 7) == 0)
+  {
+    simdScaleGrainBlk(grainStripe, width, database_h_v, FG_BLK_8, xSize, scaleFactor, log2ScaleFactor + GRAIN_SCALE);
+    return;
+  }
+#endif
   uint32_t k;
   for (l = 0; l < FG_BLK_8; l++) /* y direction */
   {
@@ -912,6 +987,13 @@ void SEIFilmGrainSynthesizer::simulateGrainBlk16x16(Pel *grainStripe, uint32_t g
   uint32_t l;
   int8_t * database_h_v = &grain_synt->dataBase[h][v][lOffset][kOffset];
   grainStripe += grainStripeOffsetBlk8;
+#if FILM_GRAIN_SIMD
+  if ((xSize & 7) == 0)
+  {
+    simdScaleGrainBlk(grainStripe, width, database_h_v, FG_BLK_16, xSize, scaleFactor, log2ScaleFactor + GRAIN_SCALE);
+    return;
+  }
+#endif
   uint32_t k;
   for (l = 0; l < FG_BLK_16; l++) /* y direction */
   {
@@ -932,11 +1014,14 @@ void SEIFilmGrainSynthesizer::simulateGrainBlk32x32(Pel *grainStripe, uint32_t g
   uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t kOffset,
   uint32_t lOffset, uint8_t h, uint8_t v)
 {
-  uint32_t l;
   int8_t * database_h_v = &grain_synt->dataBase[h][v][lOffset][kOffset];
   grainStripe += grainStripeOffsetBlk32;
-  uint32_t k;
   uint8_t shiftVal = log2ScaleFactor + GRAIN_SCALE;
+#if FILM_GRAIN_SIMD
+  simdScaleGrainBlk(grainStripe, width, database_h_v, FG_BLK_32, FG_BLK_32, scaleFactor, shiftVal);
+#else
+  uint32_t l;
+  uint32_t k;
   uint32_t grainbufInc = width - FG_BLK_32;
 
   for (l = 0; l < FG_BLK_32; l++) /* y direction */
@@ -950,28 +1035,18 @@ void SEIFilmGrainSynthesizer::simulateGrainBlk32x32(Pel *grainStripe, uint32_t g
     grainStripe += grainbufInc;
     database_h_v += FG_DATA_BASE_SIZE - FG_BLK_32;
   }
+#endif
   return;
 }
 
 uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_8x8(fgsProcessArgs *inArgs)
 {
-  uint8_t  numComp, compCtr, blkId; /* number of color components */
-  uint8_t  log2ScaleFactor, h, v;
+  uint8_t  numComp, compCtr; /* number of color components */
+  uint8_t  log2ScaleFactor;
   uint8_t  bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
   uint32_t widthComp[MAX_NUM_COMPONENT], heightComp[MAX_NUM_COMPONENT], strideComp[MAX_NUM_COMPONENT];
-  Pel *    decSampleHbdBlk16, *decSampleHbdBlk8, *decSampleHbdOffsetY;
   Pel *    decHbdComp[MAX_NUM_COMPONENT];
-  uint16_t numSamples;
-  int16_t  scaleFactor;
-  uint32_t kOffset, lOffset, grainStripeOffset, grainStripeOffsetBlk8, offsetBlk8x8;
-  uint32_t kOffset_const, lOffset_const;
-  int16_t  scaleFactor_const;
-  Pel *    grainStripe; /* worth a row of 16x16 : Max size : 16xw;*/
-  int32_t  yOffset8x8, xOffset8x8;
-  uint32_t x, y;
-  uint32_t blockAvg, intensityInt; /* ec : seed to be used for the psudo random generator for a given color component */
   uint32_t grainStripeWidth;
-  uint32_t wdPadded;
 
   bitDepth        = inArgs->bitDepth;
   numComp         = inArgs->numComp;
@@ -985,70 +1060,71 @@ uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_8x8(fgsProcessArgs *inAr
     heightComp[compCtr] = inArgs->heightComp[compCtr];
   }
 
-  wdPadded = ((inArgs->widthComp[0] - 1) | 0xF) + 1;
-  grainStripe = new Pel[wdPadded * FG_BLK_16];
-
   if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
   {
     for (compCtr = 0; compCtr < numComp; compCtr++)
     {
       if (1 == inArgs->pFgcParameters->m_compModel[compCtr].bPresentFlag)
       {
-        decSampleHbdOffsetY  = decHbdComp[compCtr];
-        uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr];
         grainStripeWidth = ((widthComp[compCtr] - 1) | 0xF) + 1;   // Make next muliptle of 16
+        const uint32_t numStripes = heightComp[compCtr] / FG_BLK_16;
+        const uint32_t numBlksX   = grainStripeWidth / FG_BLK_16;
+        Pel *grainStripes = new Pel[grainStripeWidth * FG_BLK_16 * numStripes]; /* one 16xwidth grain stripe per row of 16x16 blocks */
 
-        /* Loop of 16x16 blocks */
-        for (y = 0; y < heightComp[compCtr]; y += FG_BLK_16)
+        /* Loop of 16x16 blocks, stripes are independent of each other */
+        inArgs->pThreadPool->run(numStripes, [&](Int stripe)
         {
+          const uint32_t y          = stripe * FG_BLK_16;
+          Pel *decSampleHbdOffsetY  = decHbdComp[compCtr] + y * strideComp[compCtr];
+          Pel *grainStripe          = grainStripes + stripe * grainStripeWidth * FG_BLK_16;
+          uint32_t *offset_tmp      = inArgs->fgsOffsets[compCtr] + stripe * numBlksX;
+
           /* Initialization of grain stripe of 16xwidth size */
           memset(grainStripe, 0, (grainStripeWidth * FG_BLK_16 * sizeof(Pel)));
-          for (x = 0; x < widthComp[compCtr]; x += FG_BLK_16)
+          for (uint32_t x = 0; x < widthComp[compCtr]; x += FG_BLK_16)
           {
             /* start position offset of decoded sample in x direction */
-            grainStripeOffset = x;
+            uint32_t grainStripeOffset = x;
 
-            decSampleHbdBlk16 = decSampleHbdOffsetY + x;
+            Pel *decSampleHbdBlk16 = decSampleHbdOffsetY + x;
 
-            kOffset_const = (MSB16(*offset_tmp) % 52);
+            uint32_t kOffset_const = (MSB16(*offset_tmp) % 52);
             kOffset_const &= 0xFFFC;
 
-            lOffset_const = (LSB16(*offset_tmp) % 56);
+            uint32_t lOffset_const = (LSB16(*offset_tmp) % 56);
             lOffset_const &= 0xFFF8;
-            scaleFactor_const = 1 - 2 * BIT0(*offset_tmp);
-            for (blkId = 0; blkId < NUM_8x8_BLKS_16x16; blkId++)
+            int16_t scaleFactor_const = 1 - 2 * BIT0(*offset_tmp);
+            for (uint8_t blkId = 0; blkId < NUM_8x8_BLKS_16x16; blkId++)
             {
-              yOffset8x8   = (blkId >> 1) * FG_BLK_8;
-              xOffset8x8   = (blkId & 0x1) * FG_BLK_8;
-              offsetBlk8x8 = xOffset8x8 + (yOffset8x8 * strideComp[compCtr]);
+              int32_t  yOffset8x8   = (blkId >> 1) * FG_BLK_8;
+              int32_t  xOffset8x8   = (blkId & 0x1) * FG_BLK_8;
+              uint32_t offsetBlk8x8 = xOffset8x8 + (yOffset8x8 * strideComp[compCtr]);
 
-              grainStripeOffsetBlk8 = grainStripeOffset + (xOffset8x8 + (yOffset8x8 * grainStripeWidth));
+              uint32_t grainStripeOffsetBlk8 = grainStripeOffset + (xOffset8x8 + (yOffset8x8 * grainStripeWidth));
 
-              decSampleHbdBlk8 = decSampleHbdBlk16 + offsetBlk8x8;
-              blockAvg = blockAverage_8x8(decSampleHbdBlk8, strideComp[compCtr], &numSamples, FG_BLK_8, FG_BLK_8, bitDepth);
+              Pel *decSampleHbdBlk8 = decSampleHbdBlk16 + offsetBlk8x8;
+              uint16_t numSamples;
+              uint32_t blockAvg = blockAverage_8x8(decSampleHbdBlk8, strideComp[compCtr], &numSamples, FG_BLK_8, FG_BLK_8, bitDepth);
 
               /* Selection of the component model */
-              intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
+              uint32_t intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
 
               if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
               {
                 /* 8x8 grain block offset using co-ordinates of decoded 8x8 block in the frame */
-                // kOffset = kOffset_const;
-                kOffset = kOffset_const + xOffset8x8;
-
-                lOffset = lOffset_const + yOffset8x8;
+                uint32_t kOffset = kOffset_const + xOffset8x8;
+                uint32_t lOffset = lOffset_const + yOffset8x8;
 
-                scaleFactor =
+                int16_t scaleFactor =
                   scaleFactor_const
                   * inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
-                h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
-                v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
+                uint8_t h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
+                uint8_t v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
 
                 /* 8x8 block grain simulation */
                 simulateGrainBlk8x8(grainStripe, grainStripeOffsetBlk8, inArgs->pGrainSynt, grainStripeWidth,
                                     log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, FG_BLK_8);
               } /* only if average falls in any interval */
-              //  }/* includes corner case handling */
             } /* 8x8 level block processing */
 
             /* uppdate the PRNG once per 16x16 block of samples */
@@ -1059,36 +1135,26 @@ uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_8x8(fgsProcessArgs *inAr
           deblockGrainStripe(grainStripe, widthComp[compCtr], FG_BLK_16, grainStripeWidth, FG_BLK_8);
 
           /* Blending of size 16xwidth*/
-
           blendStripe(decSampleHbdOffsetY, grainStripe, widthComp[compCtr], strideComp[compCtr], grainStripeWidth,
                       FG_BLK_16, bitDepth);
-          decSampleHbdOffsetY += FG_BLK_16 * strideComp[compCtr];
+        });
 
-        } /* end of component loop */
+        delete[] grainStripes;
       }
     }
   }
 
-  delete[] grainStripe;
   return FGS_SUCCESS;
 }
 
 uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_16x16(fgsProcessArgs *inArgs)
 {
   uint8_t  numComp, compCtr; /* number of color components */
-  uint8_t  log2ScaleFactor, h, v;
+  uint8_t  log2ScaleFactor;
   uint8_t  bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
   uint32_t widthComp[MAX_NUM_COMPONENT], heightComp[MAX_NUM_COMPONENT], strideComp[MAX_NUM_COMPONENT];
-  Pel *    decSampleHbdBlk16, *decSampleHbdOffsetY;
   Pel *    decHbdComp[MAX_NUM_COMPONENT];
-  uint16_t numSamples;
-  int16_t  scaleFactor;
-  uint32_t kOffset, lOffset, grainStripeOffset;
-  Pel *    grainStripe; /* worth a row of 16x16 : Max size : 16xw;*/
-  uint32_t x, y;
-  uint32_t blockAvg, intensityInt; /* ec : seed to be used for the psudo random generator for a given color component */
   uint32_t grainStripeWidth;
-  uint32_t wdPadded;
 
   bitDepth        = inArgs->bitDepth;
   numComp         = inArgs->numComp;
@@ -1102,57 +1168,60 @@ uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_16x16(fgsProcessArgs *in
     heightComp[compCtr] = inArgs->heightComp[compCtr];
   }
 
-  wdPadded = ((inArgs->widthComp[0] - 1) | 0xF) + 1;
-  grainStripe = new Pel[wdPadded * FG_BLK_16];
-
   if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
   {
     for (compCtr = 0; compCtr < numComp; compCtr++)
     {
       if (1 == inArgs->pFgcParameters->m_compModel[compCtr].bPresentFlag)
       {
-        decSampleHbdOffsetY  = decHbdComp[compCtr];
-        uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr];
         grainStripeWidth = ((widthComp[compCtr] - 1) | 0xF) + 1;   // Make next muliptle of 16
+        const uint32_t numStripes = heightComp[compCtr] / FG_BLK_16;
+        const uint32_t numBlksX   = grainStripeWidth / FG_BLK_16;
+        Pel *grainStripes = new Pel[grainStripeWidth * FG_BLK_16 * numStripes]; /* one 16xwidth grain stripe per row of 16x16 blocks */
 
-        /* Loop of 16x16 blocks */
-        for (y = 0; y < heightComp[compCtr]; y += FG_BLK_16)
+        /* Loop of 16x16 blocks, stripes are independent of each other */
+        inArgs->pThreadPool->run(numStripes, [&](Int stripe)
         {
+          const uint32_t y          = stripe * FG_BLK_16;
+          Pel *decSampleHbdOffsetY  = decHbdComp[compCtr] + y * strideComp[compCtr];
+          Pel *grainStripe          = grainStripes + stripe * grainStripeWidth * FG_BLK_16;
+          uint32_t *offset_tmp      = inArgs->fgsOffsets[compCtr] + stripe * numBlksX;
+
           /* Initialization of grain stripe of 16xwidth size */
           memset(grainStripe, 0, (grainStripeWidth * FG_BLK_16 * sizeof(Pel)));
-          for (x = 0; x < widthComp[compCtr]; x += FG_BLK_16)
+          for (uint32_t x = 0; x < widthComp[compCtr]; x += FG_BLK_16)
           {
             /* start position offset of decoded sample in x direction */
-            grainStripeOffset = x;
+            uint32_t grainStripeOffset = x;
 
-            decSampleHbdBlk16 = decSampleHbdOffsetY + x;
+            Pel *decSampleHbdBlk16 = decSampleHbdOffsetY + x;
 
-            blockAvg =
+            uint16_t numSamples;
+            uint32_t blockAvg =
               blockAverage_16x16(decSampleHbdBlk16, strideComp[compCtr], &numSamples, FG_BLK_16, FG_BLK_16, bitDepth);
             blockAvg = blockAvg >> (FG_BLK_16_shift + (bitDepth - FG_BIT_DEPTH_8));
             /* Selection of the component model */
-            intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
+            uint32_t intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
 
             if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
             {
-              kOffset = (MSB16(*offset_tmp) % 52);
+              uint32_t kOffset = (MSB16(*offset_tmp) % 52);
               kOffset &= 0xFFFC;
 
-              lOffset = (LSB16(*offset_tmp) % 56);
+              uint32_t lOffset = (LSB16(*offset_tmp) % 56);
               lOffset &= 0xFFF8;
-              scaleFactor = 1 - 2 * BIT0(*offset_tmp);
+              int16_t scaleFactor = 1 - 2 * BIT0(*offset_tmp);
 
               scaleFactor *=
                 inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
-              h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
-              v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
+              uint8_t h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
+              uint8_t v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
 
               /* 16x16 block grain simulation */
               simulateGrainBlk16x16(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth,
                                     log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, FG_BLK_16);
 
             } /* only if average falls in any interval */
-            //  }/* includes corner case handling */
             /* uppdate the PRNG once per 16x16 block of samples */
             offset_tmp++;
           } /* End of 16xwidth grain simulation */
@@ -1162,32 +1231,24 @@ uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_16x16(fgsProcessArgs *in
           /* Blending of size 16xwidth*/
           blendStripe(decSampleHbdOffsetY, grainStripe, widthComp[compCtr], strideComp[compCtr], grainStripeWidth,
                       FG_BLK_16, bitDepth);
-          decSampleHbdOffsetY += FG_BLK_16 * strideComp[compCtr];
+        });
 
-        } /* end of component loop */
+        delete[] grainStripes;
       }
     }
   }
 
-  delete[] grainStripe;
   return FGS_SUCCESS;
 }
 
 uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_32x32(fgsProcessArgs *inArgs)
 {
   uint8_t  numComp, compCtr; /* number of color components */
-  uint8_t  log2ScaleFactor, h, v;
+  uint8_t  log2ScaleFactor;
   uint8_t  bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
   uint32_t widthComp[MAX_NUM_COMPONENT], heightComp[MAX_NUM_COMPONENT], strideComp[MAX_NUM_COMPONENT];
-  Pel *    decSampleBlk32, *decSampleOffsetY;
   Pel *    decComp[MAX_NUM_COMPONENT];
-  int16_t  scaleFactor;
-  uint32_t kOffset, lOffset, grainStripeOffset;
-  Pel *    grainStripe;
-  uint32_t x, y;
-  uint32_t blockAvg, intensityInt; /* ec : seed to be used for the psudo random generator for a given color component */
   uint32_t grainStripeWidth;
-  uint32_t wdPadded;
 
   bitDepth = inArgs->bitDepth;
   numComp  = inArgs->numComp;
@@ -1202,46 +1263,49 @@ uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_32x32(fgsProcessArgs *in
     widthComp[compCtr]  = inArgs->widthComp[compCtr];
   }
 
-  wdPadded = ((inArgs->widthComp[0] - 1) | 0x1F) + 1;
-  grainStripe = new Pel[wdPadded * FG_BLK_32];
-
   if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
   {
     for (compCtr = 0; compCtr < numComp; compCtr++)
     {
       if (1 == inArgs->pFgcParameters->m_compModel[compCtr].bPresentFlag)
       {
-        uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr];
-        decSampleOffsetY     = decComp[compCtr];
         grainStripeWidth = ((widthComp[compCtr] - 1) | 0x1F) + 1;   // Make next muliptle of 32
+        const uint32_t numStripes = heightComp[compCtr] / FG_BLK_32;
+        const uint32_t numBlksX   = grainStripeWidth / FG_BLK_32;
+        Pel *grainStripes = new Pel[grainStripeWidth * FG_BLK_32 * numStripes]; /* one 32xwidth grain stripe per row of 32x32 blocks */
 
-        /* Loop of 32x32 blocks */
-        for (y = 0; y < heightComp[compCtr]; y += FG_BLK_32)
+        /* Loop of 32x32 blocks, stripes are independent of each other */
+        inArgs->pThreadPool->run(numStripes, [&](Int stripe)
         {
+          const uint32_t y       = stripe * FG_BLK_32;
+          Pel *decSampleOffsetY  = decComp[compCtr] + y * strideComp[compCtr];
+          Pel *grainStripe       = grainStripes + stripe * grainStripeWidth * FG_BLK_32;
+          uint32_t *offset_tmp   = inArgs->fgsOffsets[compCtr] + stripe * numBlksX;
+
           /* Initialization of grain stripe of 32xwidth size */
           memset(grainStripe, 0, (grainStripeWidth * FG_BLK_32 * sizeof(Pel)));
-          for (x = 0; x < widthComp[compCtr]; x += FG_BLK_32)
+          for (uint32_t x = 0; x < widthComp[compCtr]; x += FG_BLK_32)
           {
             /* start position offset of decoded sample in x direction */
-            grainStripeOffset = x;
-            decSampleBlk32    = decSampleOffsetY + x;
-            blockAvg = blockAverage_32x32(decSampleBlk32, strideComp[compCtr], bitDepth);
+            uint32_t grainStripeOffset = x;
+            Pel *decSampleBlk32        = decSampleOffsetY + x;
+            uint32_t blockAvg = blockAverage_32x32(decSampleBlk32, strideComp[compCtr], bitDepth);
 
             /* Selection of the component model */
-            intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
+            uint32_t intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
 
             if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
             {
-              kOffset = (MSB16(*offset_tmp) % 36);
+              uint32_t kOffset = (MSB16(*offset_tmp) % 36);
               kOffset &= 0xFFFC;
 
-              lOffset = (LSB16(*offset_tmp) % 40);
+              uint32_t lOffset = (LSB16(*offset_tmp) % 40);
               lOffset &= 0xFFF8;
-              scaleFactor = 1 - 2 * BIT0(*offset_tmp);
+              int16_t scaleFactor = 1 - 2 * BIT0(*offset_tmp);
 
               scaleFactor *= inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
-              h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
-              v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
+              uint8_t h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
+              uint8_t v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
 
               /* 32x32 block grain simulation */
               simulateGrainBlk32x32(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth,
@@ -1257,13 +1321,13 @@ uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_32x32(fgsProcessArgs *in
           deblockGrainStripe(grainStripe, widthComp[compCtr], FG_BLK_32, grainStripeWidth, FG_BLK_32);
 
           blendStripe_32x32(decSampleOffsetY, grainStripe, widthComp[compCtr], strideComp[compCtr], grainStripeWidth, FG_BLK_32, bitDepth);
-          decSampleOffsetY += FG_BLK_32 * strideComp[compCtr];
-        } /* end of component loop */
+        });
+
+        delete[] grainStripes;
       }
     }
   }
 
-  delete[] grainStripe;
   return FGS_SUCCESS;
 }
 
@@ -41,6 +41,7 @@
 
 #include "SEI.h"
 #include "TComPicYuv.h"
+#include "TComThreadPool.h"
 
 #if JVET_X0048_X0103_FILM_GRAIN
 
@@ -158,6 +159,7 @@ typedef struct fgsProcessArgs
   GrainSynthesisStruct *       pGrainSynt;
   uint8_t                      bitDepth;
   uint8_t                      blkSize;
+  TComThreadPool *             pThreadPool;   /* stripes of grain blocks are synthesized and blended in parallel */
 } fgsProcessArgs;
 
 class SEIFilmGrainSynthesizer
@@ -173,6 +175,7 @@ private:
   fgsProcessArgs               m_fgsArgs;
   GrainSynthesisStruct        *m_grainSynt;
   uint8_t                      m_fgsBlkSize;
+  TComThreadPool               m_threadPool;
 
 public:
   uint32_t                     m_poc;
@@ -185,6 +188,7 @@ public:
 
   void      create(uint32_t width, uint32_t height, ChromaFormat fmt, uint8_t bitDepth, uint32_t idrPicId);
   void      destroy   ();
+  void      setNumThreads(Int numThreads);
 
   void      fgsInit   ();
   void      grainSynthesizeAndBlend(TComPicYuv* pGrainBuf, Bool isIdrPic);
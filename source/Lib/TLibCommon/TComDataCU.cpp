@@ -591,6 +591,30 @@ Void TComDataCU::initEstData( const UInt uiDepth, const Int qp, const Bool bTran
   }
 }
 
+/** initialize a CU of the same size as pcCU for the estimation of a mode in the same area, e.g. by another instance of
+ *  the CU encoder
+ */
+Void TComDataCU::initEstDataFrom( const TComDataCU* pcCU, const UInt uiDepth, const Int qp, const Bool bTransquantBypass )
+{
+  assert( m_uiNumPartition == pcCU->m_uiNumPartition );
+
+  m_pcPic              = pcCU->m_pcPic;
+  m_pcSlice            = pcCU->m_pcSlice;
+  m_ctuRsAddr          = pcCU->m_ctuRsAddr;
+  m_absZIdxInCtu       = pcCU->m_absZIdxInCtu;
+  m_uiCUPelX           = pcCU->m_uiCUPelX;
+  m_uiCUPelY           = pcCU->m_uiCUPelY;
+  m_codedQP            = pcCU->m_codedQP;
+  m_codedChromaQpAdj   = pcCU->m_codedChromaQpAdj;
+
+  m_pCtuLeft           = pcCU->m_pCtuLeft;
+  m_pCtuAbove          = pcCU->m_pCtuAbove;
+  m_pCtuAboveLeft      = pcCU->m_pCtuAboveLeft;
+  m_pCtuAboveRight     = pcCU->m_pCtuAboveRight;
+
+  initEstData( uiDepth, qp, bTransquantBypass );
+}
+
 
 // initialize Sub partition
 Void TComDataCU::initSubCU( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDepth, Int qp )
@@ -184,6 +184,7 @@ public:
 
   Void          initCtu                       ( TComPic* pcPic, UInt ctuRsAddr );
   Void          initEstData                   ( const UInt uiDepth, const Int qp, const Bool bTransquantBypass );
+  Void          initEstDataFrom               ( const TComDataCU* pcCU, const UInt uiDepth, const Int qp, const Bool bTransquantBypass ); ///< initialize for a trial of the same CU area as pcCU
   Void          initSubCU                     ( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDepth, Int qp );
   Void          setOutsideCUPart              ( UInt uiAbsPartIdx, UInt uiDepth );
 
@@ -39,6 +39,7 @@
 #include "TComSlice.h"
 #include "TComMv.h"
 #include "TComTU.h"
+#include "TComProfiler.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -129,6 +130,7 @@ Void TComLoopFilter::destroy()
  */
 Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 {
+  PROFILE_SCOPE( PROF_LOOP_FILTER );
   // Horizontal filtering
   for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
   {
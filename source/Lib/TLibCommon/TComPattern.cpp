@@ -347,10 +347,7 @@ Void fillReferenceSamples( const Int bitDepth,
   if (iNumIntraNeighbor == 0)
   {
     // Fill border with DC value
-    for (i=0; i<uiWidth; i++)
-    {
-      piIntraTemp[i] = iDCValue;
-    }
+    std::fill_n(piIntraTemp, uiWidth, Pel(iDCValue));
     for (i=1; i<uiHeight; i++)
     {
       piIntraTemp[i*uiWidth] = iDCValue;
@@ -361,14 +358,14 @@ Void fillReferenceSamples( const Int bitDepth,
     // Fill top-left border and top and top right with rec. samples
     piRoiTemp = piRoiOrigin - iPicStride - 1;
 
+#if O0043_BEST_EFFORT_DECODING
     for (i=0; i<uiWidth; i++)
     {
-#if O0043_BEST_EFFORT_DECODING
       piIntraTemp[i] = piRoiTemp[i] << bitDepthDelta;
+    }
 #else
-      piIntraTemp[i] = piRoiTemp[i];
+    memcpy(piIntraTemp, piRoiTemp, uiWidth*sizeof(Pel));
 #endif
-    }
 
     // Fill left and below left border with rec. samples
     piRoiTemp = piRoiOrigin - 1;
@@ -386,17 +383,12 @@ Void fillReferenceSamples( const Int bitDepth,
   else // reference samples are partially available
   {
     // all above units have "unitWidth" samples each, all left/below-left units have "unitHeight" samples each
-    const Int  iTotalSamples = (iLeftUnits * unitHeight) + ((iAboveUnits + 1) * unitWidth);
     Pel  piIntraLine[5 * MAX_CU_SIZE];
     Pel  *piIntraLineTemp;
     const Bool *pbNeighborFlags;
 
 
-    // Initialize
-    for (i=0; i<iTotalSamples; i++)
-    {
-      piIntraLine[i] = iDCValue;
-    }
+    // every unit is either filled from the reconstruction or padded below, so the line needs no initialisation
 
     // Fill top-left sample
     piRoiTemp = piRoiOrigin - iPicStride - 1;
@@ -409,10 +401,7 @@ Void fillReferenceSamples( const Int bitDepth,
 #else
       Pel topLeftVal=piRoiTemp[0];
 #endif
-      for (i=0; i<unitWidth; i++)
-      {
-        piIntraLineTemp[i] = topLeftVal;
-      }
+      std::fill_n(piIntraLineTemp, unitWidth, topLeftVal);
     }
 
     // Fill left & below-left samples (downwards)
@@ -447,14 +436,14 @@ Void fillReferenceSamples( const Int bitDepth,
     {
       if (*pbNeighborFlags)
       {
+#if O0043_BEST_EFFORT_DECODING
         for (i=0; i<unitWidth; i++)
         {
-#if O0043_BEST_EFFORT_DECODING
           piIntraLineTemp[i] = piRoiTemp[i] << bitDepthDelta;
+        }
 #else
-          piIntraLineTemp[i] = piRoiTemp[i];
+        memcpy(piIntraLineTemp, piRoiTemp, unitWidth*sizeof(Pel));
 #endif
-        }
       }
       piRoiTemp += unitWidth;
       piIntraLineTemp += unitWidth;
@@ -482,20 +471,14 @@ Void fillReferenceSamples( const Int bitDepth,
         // fill left column
         while (iCurrJnit < iNextOrTop)
         {
-          for (i=0; i<unitHeight; i++)
-          {
-            piIntraLineCur[i] = refSample;
-          }
+          std::fill_n(piIntraLineCur, unitHeight, refSample);
           piIntraLineCur += unitHeight;
           iCurrJnit++;
         }
         // fill top row
         while (iCurrJnit < iNext)
         {
-          for (i=0; i<unitWidth; i++)
-          {
-            piIntraLineCur[i] = refSample;
-          }
+          std::fill_n(piIntraLineCur, unitWidth, refSample);
           piIntraLineCur += unitWidth;
           iCurrJnit++;
         }
@@ -510,10 +493,7 @@ Void fillReferenceSamples( const Int bitDepth,
         {
           const Int numSamplesInCurrUnit = (iCurrJnit >= iLeftUnits) ? unitWidth : unitHeight;
           const Pel refSample = *(piIntraLineCur-1);
-          for (i=0; i<numSamplesInCurrUnit; i++)
-          {
-            piIntraLineCur[i] = refSample;
-          }
+          std::fill_n(piIntraLineCur, numSamplesInCurrUnit, refSample);
           piIntraLineCur += numSamplesInCurrUnit;
           iCurrJnit++;
         }
@@ -529,10 +509,7 @@ Void fillReferenceSamples( const Int bitDepth,
 
     piIntraLineTemp = piIntraLine + uiHeight + unitWidth - 2;
     // top left, top and top right samples
-    for (i=0; i<uiWidth; i++)
-    {
-      piIntraTemp[i] = piIntraLineTemp[i];
-    }
+    memcpy(piIntraTemp, piIntraLineTemp, uiWidth*sizeof(Pel));
 
     piIntraLineTemp = piIntraLine + uiHeight - 1;
     for (i=1; i<uiHeight; i++)
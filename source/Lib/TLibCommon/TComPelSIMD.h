@@ -0,0 +1,116 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComPelSIMD.h
+    \brief    SSE helpers shared by the block-wise sample kernels of TComYuv and TComWeightPrediction
+*/
+
+#ifndef __TCOMPELSIMD__
+#define __TCOMPELSIMD__
+
+#include "CommonDef.h"
+
+#if VECTOR_CODING__INTERPOLATION_FILTER && defined(__SSE4_1__)
+#include <smmintrin.h>
+#define PEL_SIMD 1
+#else
+#define PEL_SIMD 0
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+#if PEL_SIMD
+// A vector holds 8 samples when Pel is a Short and 4 samples in the high bit-depth build, where
+// Pel is an Int. Kernels are instantiated for block widths 4 to 64; other widths (AMP partitions,
+// 2-sample chroma) stay on the scalar code.
+
+static const Int PEL_VEC = 16 / sizeof(Pel);
+
+//! loads one vector of samples; a row narrower than a vector only fills the lower half
+template<Int W>
+inline __m128i loadPelVec( const Pel* p )
+{
+  return W < PEL_VEC ? _mm_loadl_epi64( (const __m128i*)p ) : _mm_loadu_si128( (const __m128i*)p );
+}
+
+template<Int W>
+inline Void storePelVec( Pel* p, const __m128i v )
+{
+  if( W < PEL_VEC )
+  {
+    _mm_storel_epi64( (__m128i*)p, v );
+  }
+  else
+  {
+    _mm_storeu_si128( (__m128i*)p, v );
+  }
+}
+
+inline __m128i clipPelVec( const __m128i v, const __m128i vmax )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm_min_epi32( _mm_max_epi32( v, _mm_setzero_si128() ), vmax );
+#else
+  return _mm_min_epi16( _mm_max_epi16( v, _mm_setzero_si128() ), vmax );
+#endif
+}
+
+inline __m128i setPelVec( const Int v )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm_set1_epi32( v );
+#else
+  return _mm_set1_epi16( Short(v) );
+#endif
+}
+
+//! index of the SIMD kernel instantiation for a block width, or -1 if there is none
+inline Int getSIMDWidthIdx( const Int iWidth )
+{
+  switch( iWidth )
+  {
+    case  4: return 0;
+    case  8: return 1;
+    case 16: return 2;
+    case 32: return 3;
+    case 64: return 4;
+    default: return -1;
+  }
+}
+
+#endif
+
+//! \}
+
+#endif // __TCOMPELSIMD__
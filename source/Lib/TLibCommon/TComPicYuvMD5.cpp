@@ -33,6 +33,14 @@
 
 #include "TComPicYuv.h"
 #include "libmd5/MD5.h"
+#include <vector>
+
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <emmintrin.h>
+#define CHECKSUM_SIMD 1
+#else
+#define CHECKSUM_SIMD 0
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -86,39 +94,90 @@ static Void md5_plane(MD5& md5, const Pel* plane, UInt width, UInt height, UInt
 }
 
 
-UInt compCRC(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, TComPictureHash &digest)
+/**
+ * Slice-by-8 tables of the CRC-CCITT polynomial 0x1021.
+ * The picture hash CRC shifts the data into the register most significant bit first and flushes it with 16 zero
+ * bits at the end. That is the same as the direct, table-driven CRC with the initial value 0xffff passed through
+ * 16 zero bits (0x1d0f). table[k][b] is the contribution of byte b followed by k zero bytes.
+ */
+struct CRCTables
 {
-  UInt crcMsb;
-  UInt bitVal;
-  UInt crcVal = 0xffff;
-  UInt bitIdx;
-  for (UInt y = 0; y < height; y++)
+  UShort table[8][256];
+
+  CRCTables()
   {
-    for (UInt x = 0; x < width; x++)
+    for (UInt b = 0; b < 256; b++)
     {
-      // take CRC of first pictureData byte
-      for(bitIdx=0; bitIdx<8; bitIdx++)
+      UInt crc = b << 8;
+      for (UInt bitIdx = 0; bitIdx < 8; bitIdx++)
       {
-        crcMsb = (crcVal >> 15) & 1;
-        bitVal = (plane[y*stride+x] >> (7 - bitIdx)) & 1;
-        crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
+        crc = ((crc << 1) ^ ((crc & 0x8000) ? 0x1021 : 0)) & 0xffff;
       }
-      // take CRC of second pictureData byte if bit depth is greater than 8-bits
-      if(bitdepth > 8)
+      table[0][b] = crc;
+    }
+    for (UInt k = 1; k < 8; k++)
+    {
+      for (UInt b = 0; b < 256; b++)
       {
-        for(bitIdx=0; bitIdx<8; bitIdx++)
-        {
-          crcMsb = (crcVal >> 15) & 1;
-          bitVal = (plane[y*stride+x] >> (15 - bitIdx)) & 1;
-          crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-        }
+        const UInt prev = table[k-1][b];
+        table[k][b] = ((prev << 8) & 0xffff) ^ table[0][prev >> 8];
       }
     }
   }
-  for(bitIdx=0; bitIdx<16; bitIdx++)
+};
+
+static const CRCTables& getCRCTables()
+{
+  static const CRCTables tables;
+  return tables;
+}
+
+static const UInt CRC_DIRECT_INIT = 0x1d0f;
+
+/** update crcVal with n bytes, eight at a time */
+static UInt crcBytes(const CRCTables &crc, const UChar* data, UInt n, UInt crcVal)
+{
+  const UShort (*t)[256] = crc.table;
+  UInt i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    crcVal = t[7][data[i] ^ (crcVal >> 8)] ^ t[6][data[i+1] ^ (crcVal & 0xff)] ^
+             t[5][data[i+2]] ^ t[4][data[i+3]] ^ t[3][data[i+4]] ^ t[2][data[i+5]] ^ t[1][data[i+6]] ^ t[0][data[i+7]];
+  }
+  for (; i < n; i++)
+  {
+    crcVal = ((crcVal << 8) & 0xffff) ^ t[0][(crcVal >> 8) ^ data[i]];
+  }
+  return crcVal;
+}
+
+UInt compCRC(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, TComPictureHash &digest)
+{
+  const CRCTables &crc = getCRCTables();
+  const UInt bytesPerSample = bitdepth > 8 ? 2 : 1;
+  std::vector<UChar> line(width * bytesPerSample);
+  UInt crcVal = CRC_DIRECT_INIT;
+
+  for (UInt y = 0; y < height; y++)
   {
-    crcMsb = (crcVal >> 15) & 1;
-    crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
+    // the low byte of each sample comes first, followed by the high byte if bit depth is greater than 8-bits
+    const Pel* src = plane + y*stride;
+    if (bytesPerSample == 2)
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        line[2*x]   = src[x] & 0xff;
+        line[2*x+1] = (src[x] >> 8) & 0xff;
+      }
+    }
+    else
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        line[x] = src[x] & 0xff;
+      }
+    }
+    crcVal = crcBytes(crc, line.data(), width * bytesPerSample, crcVal);
   }
 
   digest.hash.push_back((crcVal>>8)  & 0xff);
@@ -138,23 +197,55 @@ UInt calcCRC(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bi
   return digestLen;
 }
 
+/**
+ * Sum over one line of ((sample & 0xff) ^ mask) and, for bit depths greater than 8, ((sample >> 8) ^ mask), where
+ * mask = (x & 0xff) ^ (x >> 8) ^ lineMask. The sum is taken modulo 2^32, so the order of the terms is free.
+ */
+static UInt checksumLine(const Pel* src, UInt width, UInt lineMask, Bool highByte)
+{
+  UInt sum = 0;
+  UInt x = 0;
+#if CHECKSUM_SIMD
+  // x >> 8 is constant over eight aligned samples
+  const __m128i lowByte = _mm_set1_epi16(0xff);
+  const __m128i ramp    = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m128i ones    = _mm_set1_epi16(1);
+  __m128i acc = _mm_setzero_si128();
+  for (; x + 8 <= width; x += 8)
+  {
+    const __m128i mask   = _mm_xor_si128(_mm_add_epi16(_mm_set1_epi16(x & 0xff), ramp), _mm_set1_epi16(((x >> 8) ^ lineMask) & 0xff));
+    const __m128i sample = _mm_loadu_si128((const __m128i*)(src + x));
+    __m128i terms = _mm_xor_si128(_mm_and_si128(sample, lowByte), mask);
+    if (highByte)
+    {
+      terms = _mm_add_epi16(terms, _mm_xor_si128(_mm_srli_epi16(sample, 8), mask));
+    }
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(terms, ones));
+  }
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4e));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xb1));
+  sum = _mm_cvtsi128_si32(acc);
+#endif
+  for (; x < width; x++)
+  {
+    const UChar xorMask = (x & 0xff) ^ (x >> 8) ^ lineMask;
+    sum += (src[x] & 0xff) ^ xorMask;
+    if (highByte)
+    {
+      sum += (src[x] >> 8) ^ xorMask;
+    }
+  }
+  return sum;
+}
+
 UInt compChecksum(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, TComPictureHash &digest, const BitDepths &/*bitDepths*/)
 {
   UInt checksum = 0;
-  UChar xor_mask;
 
   for (UInt y = 0; y < height; y++)
   {
-    for (UInt x = 0; x < width; x++)
-    {
-      xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8);
-      checksum = (checksum + ((plane[y*stride+x] & 0xff) ^ xor_mask)) & 0xffffffff;
-
-      if(bitdepth > 8)
-      {
-        checksum = (checksum + ((plane[y*stride+x]>>8) ^ xor_mask)) & 0xffffffff;
-      }
-    }
+    const UChar lineMask = (y & 0xff) ^ (y >> 8);
+    checksum = (checksum + checksumLine(plane + y*stride, width, lineMask, bitdepth > 8)) & 0xffffffff;
   }
 
   digest.hash.push_back((checksum>>24) & 0xff);
@@ -40,6 +40,13 @@
 #include "TComPic.h"
 #include "TComTU.h"
 
+#if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0) && defined(__SSE4_1__)
+#include <smmintrin.h>
+#define INTRA_PRED_SIMD 1
+#else
+#define INTRA_PRED_SIMD 0
+#endif
+
 //! \ingroup TLibCommon
 //! \{
 
@@ -66,6 +73,62 @@ const UChar TComPrediction::m_aucIntraFilter[MAX_NUM_CHANNEL_TYPE][MAX_INTRA_FIL
 
 };
 
+#if INTRA_PRED_SIMD
+// ====================================================================================================================
+// Vector kernels
+// ====================================================================================================================
+
+/// dst[x] = ((32-deltaFract)*ref[x] + deltaFract*ref[x+1] + 16) >> 5 for a width that is a multiple of 4
+static inline Void interpolateIntraRowSIMD( const Pel* ref, Pel* dst, const Int width, const Int deltaFract )
+{
+  const __m128i weights = _mm_set1_epi32(((deltaFract) << 16) | (32 - deltaFract));
+  const __m128i offset  = _mm_set1_epi32(16);
+
+  if (width == 4)
+  {
+    const __m128i pairs = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)ref), _mm_loadl_epi64((const __m128i*)(ref + 1)));
+    const __m128i sum   = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(pairs, weights), offset), 5);
+    _mm_storel_epi64((__m128i*)dst, _mm_packs_epi32(sum, sum));
+    return;
+  }
+
+  for (Int x = 0; x < width; x += 8)
+  {
+    const __m128i a     = _mm_loadu_si128((const __m128i*)(ref + x));
+    const __m128i b     = _mm_loadu_si128((const __m128i*)(ref + x + 1));
+    const __m128i sumLo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(a, b), weights), offset), 5);
+    const __m128i sumHi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(a, b), weights), offset), 5);
+    _mm_storeu_si128((__m128i*)(dst + x), _mm_packs_epi32(sumLo, sumHi));
+  }
+}
+
+/// dst[x*dstStride + y] = src[y*srcStride + x], width and height being multiples of 4
+static Void transposeBlockSIMD( const Pel* src, const Int srcStride, Pel* dst, const Int dstStride, const Int width, const Int height )
+{
+  for (Int y = 0; y < height; y += 4)
+  {
+    for (Int x = 0; x < width; x += 4)
+    {
+      const Pel    *s  = src + y * srcStride + x;
+      const __m128i r0 = _mm_loadl_epi64((const __m128i*)(s));
+      const __m128i r1 = _mm_loadl_epi64((const __m128i*)(s +     srcStride));
+      const __m128i r2 = _mm_loadl_epi64((const __m128i*)(s + 2 * srcStride));
+      const __m128i r3 = _mm_loadl_epi64((const __m128i*)(s + 3 * srcStride));
+      const __m128i t0 = _mm_unpacklo_epi16(r0, r1);
+      const __m128i t1 = _mm_unpacklo_epi16(r2, r3);
+      const __m128i c01 = _mm_unpacklo_epi32(t0, t1);
+      const __m128i c23 = _mm_unpackhi_epi32(t0, t1);
+
+      Pel *d = dst + x * dstStride + y;
+      _mm_storel_epi64((__m128i*)(d),                 c01);
+      _mm_storel_epi64((__m128i*)(d +     dstStride), _mm_srli_si128(c01, 8));
+      _mm_storel_epi64((__m128i*)(d + 2 * dstStride), c23);
+      _mm_storel_epi64((__m128i*)(d + 3 * dstStride), _mm_srli_si128(c23, 8));
+    }
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / initialize
 // ====================================================================================================================
@@ -186,6 +249,21 @@ Pel TComPrediction::predIntraGetPredValDC( const Pel* pSrc, Int iSrcStride, UInt
   Int iInd, iSum = 0;
   Pel pDcVal;
 
+#if INTRA_PRED_SIMD
+  if ((iWidth & 7) == 0)
+  {
+    const __m128i ones = _mm_set1_epi16(1);
+    __m128i       sum  = _mm_setzero_si128();
+    for (iInd = 0; iInd < iWidth; iInd += 8)
+    {
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(pSrc + iInd - iSrcStride)), ones));
+    }
+    sum  = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum  = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    iSum = _mm_cvtsi128_si32(sum);
+  }
+  else
+#endif
   for (iInd = 0;iInd < iWidth;iInd++)
   {
     iSum += pSrc[iInd-iSrcStride];
@@ -247,10 +325,7 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
 
     for (Int y=height;y>0;y--, pTrueDst+=dstStrideTrue)
     {
-      for (Int x=0; x<width;) // width is always a multiple of 4.
-      {
-        pTrueDst[x++] = dcval;
-      }
+      std::fill_n(pTrueDst, width, dcval); // width is always a multiple of 4.
     }
   }
   else // Do angular predictions
@@ -279,10 +354,7 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
     {
       const Int refMainOffsetPreScale = (bIsModeVer ? height : width ) - 1;
       const Int refMainOffset         = height - 1;
-      for (Int x=0;x<width+1;x++)
-      {
-        refAbove[x+refMainOffset] = pSrc[x-srcStride-1];
-      }
+      memcpy(refAbove+refMainOffset, pSrc-srcStride-1, (width+1)*sizeof(Pel));
       for (Int y=0;y<height+1;y++)
       {
         refLeft[y+refMainOffset] = pSrc[(y-1)*srcStride-1];
@@ -300,10 +372,7 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
     }
     else
     {
-      for (Int x=0;x<2*width+1;x++)
-      {
-        refAbove[x] = pSrc[x-srcStride-1];
-      }
+      memcpy(refAbove, pSrc-srcStride-1, (2*width+1)*sizeof(Pel));
       for (Int y=0;y<2*height+1;y++)
       {
         refLeft[y] = pSrc[(y-1)*srcStride-1];
@@ -325,10 +394,7 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
     {
       for (Int y=0;y<height;y++)
       {
-        for (Int x=0;x<width;x++)
-        {
-          pDst[y*dstStride+x] = refMain[x+1];
-        }
+        memcpy(pDst+y*dstStride, refMain+1, width*sizeof(Pel));
       }
 
       if (edgeFilter)
@@ -351,6 +417,9 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
         if (deltaFract)
         {
           // Do linear filtering
+#if INTRA_PRED_SIMD
+          interpolateIntraRowSIMD(refMain+deltaInt+1, pDsty, width, deltaFract);
+#else
           const Pel *pRM=refMain+deltaInt+1;
           Int lastRefMainPel=*pRM++;
           for (Int x=0;x<width;pRM++,x++)
@@ -359,14 +428,12 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
             pDsty[x+0] = (Pel) ( ((32-deltaFract)*lastRefMainPel + deltaFract*thisRefMainPel +16) >> 5 );
             lastRefMainPel=thisRefMainPel;
           }
+#endif
         }
         else
         {
           // Just copy the integer samples
-          for (Int x=0;x<width; x++)
-          {
-            pDsty[x] = refMain[x+deltaInt+1];
-          }
+          memcpy(pDsty, refMain+deltaInt+1, width*sizeof(Pel));
         }
       }
     }
@@ -374,6 +441,9 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
     // Flip the block if this is the horizontal mode
     if (!bIsModeVer)
     {
+#if INTRA_PRED_SIMD
+      transposeBlockSIMD(pDst, dstStride, pTrueDst, dstStrideTrue, width, height);
+#else
       for (Int y=0; y<height; y++)
       {
         for (Int x=0; x<width; x++)
@@ -383,6 +453,7 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
         pTrueDst++;
         pDst+=dstStride;
       }
+#endif
     }
   }
 }
@@ -766,6 +837,23 @@ Void TComPrediction::xPredIntraPlanar( const Pel* pSrc, Int srcStride, Pel* rpDs
     leftColumn[k]   <<= shift1Dhor;
   }
 
+#if INTRA_PRED_SIMD
+  // four columns at a time: horPred grows by rightColumn[y] and topRow[x] by bottomRow[x] per sample
+  const __m128i columnIndex = _mm_setr_epi32(1, 2, 3, 4);
+  for (Int y=0;y<height;y++)
+  {
+    const __m128i rightStep = _mm_set1_epi32(4 * rightColumn[y]);
+    __m128i       horPred   = _mm_add_epi32(_mm_set1_epi32(leftColumn[y] + width), _mm_mullo_epi32(_mm_set1_epi32(rightColumn[y]), columnIndex));
+    for (Int x=0;x<width;x+=4, horPred=_mm_add_epi32(horPred, rightStep))
+    {
+      const __m128i vertPred = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(topRow + x)), _mm_loadu_si128((const __m128i*)(bottomRow + x)));
+      _mm_storeu_si128((__m128i*)(topRow + x), vertPred);
+
+      const __m128i pred = _mm_srai_epi32(_mm_add_epi32(horPred, vertPred), shift1Dhor+1);
+      _mm_storel_epi64((__m128i*)(rpDst + y*dstStride + x), _mm_packs_epi32(pred, pred));
+    }
+  }
+#else
   const UInt topRowShift = 0;
 
   // Generate prediction signal
@@ -781,6 +869,7 @@ Void TComPrediction::xPredIntraPlanar( const Pel* pSrc, Int srcStride, Pel* rpDs
       rpDst[y*dstStride+x] = ( horPred + vertPred ) >> (shift1Dhor+1);
     }
   }
+#endif
 }
 
 /** Function for filtering intra DC predictor.
@@ -801,13 +890,25 @@ Void TComPrediction::xDCPredFiltering( const Pel* pSrc, Int iSrcStride, Pel* pDs
   if (isLuma(channelType) && (iWidth <= MAXIMUM_INTRA_FILTERED_WIDTH) && (iHeight <= MAXIMUM_INTRA_FILTERED_HEIGHT))
   {
     //top-left
-    pDst[0] = (Pel)((pSrc[-iSrcStride] + pSrc[-1] + 2 * pDst[0] + 2) >> 2);
+    const Pel topLeft = (Pel)((pSrc[-iSrcStride] + pSrc[-1] + 2 * pDst[0] + 2) >> 2);
 
     //top row (vertical filter)
+#if INTRA_PRED_SIMD
+    const __m128i weights = _mm_set1_epi32((3 << 16) | 1);
+    const __m128i offset  = _mm_set1_epi32(2);
+    for ( x = 0; x < iWidth; x += 4 )
+    {
+      const __m128i pairs = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(pSrc + x - iSrcStride)), _mm_loadl_epi64((const __m128i*)(pDst + x)));
+      const __m128i sum   = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(pairs, weights), offset), 2);
+      _mm_storel_epi64((__m128i*)(pDst + x), _mm_packs_epi32(sum, sum));
+    }
+#else
     for ( x = 1; x < iWidth; x++ )
     {
       pDst[x] = (Pel)((pSrc[x - iSrcStride] +  3 * pDst[x] + 2) >> 2);
     }
+#endif
+    pDst[0] = topLeft;
 
     //left column (horizontal filter)
     for ( y = 1, iDstStride2 = iDstStride, iSrcStride2 = iSrcStride-1; y < iHeight; y++, iDstStride2+=iDstStride, iSrcStride2+=iSrcStride )
@@ -0,0 +1,403 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TComProfiler.cpp
+    \brief    hierarchical scoped timers and counters of the encoder and decoder hot paths
+*/
+
+#include "TComProfiler.h"
+
+#if ENABLE_PROFILING
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+//! \ingroup TLibCommon
+//! \{
+
+/// maximum number of trace events recorded per thread, later events are counted as dropped
+static const size_t PROFILE_MAX_TRACE_EVENTS_PER_THREAD = 1 << 22;
+
+static const TChar* const profileStageNames[NUMBER_OF_PROFILE_STAGES] =
+{
+  "compressGOP",
+  "compressSlice",
+  "xCompressCU",
+  "predInterSearch",
+  "estIntraPredLumaQT",
+  "RDOQ",
+  "encodeSlice",
+  "loopFilterPic",
+  "SAO",
+  "decompressSlice",
+  "parseCtu",
+  "reconstructCtu",
+  "filterPicture"
+};
+
+static const TChar* const profileCounterNames[NUMBER_OF_PROFILE_COUNTERS] =
+{
+  "encoded CTUs",
+  "inter search luma samples",
+  "RDOQ coefficients",
+  "decoded CTUs"
+};
+
+static std::string getProfileNodeName( Int stage, Int depth )
+{
+  std::string name = profileStageNames[stage];
+  if (stage == PROF_ENC_COMPRESS_CU)
+  {
+    TChar suffix[16];
+    snprintf( suffix, sizeof(suffix), "[d%d]", depth );
+    name += suffix;
+  }
+  return name;
+}
+
+/// node of the call tree merged over all threads
+struct TComProfileReportNode
+{
+  Int                                 stage;
+  Int                                 depth;
+  UInt64                              calls;
+  Int64                               totalNs;
+  std::vector<TComProfileReportNode>  children;
+};
+
+static Bool compareReportNodes( const TComProfileReportNode &a, const TComProfileReportNode &b )
+{
+  return a.totalNs > b.totalNs;
+}
+
+static Void printReportNode( std::ostream &os, const TComProfileReportNode &node, Int level, Double rootNs )
+{
+  Int64 childNs = 0;
+  for (UInt i = 0; i < node.children.size(); i++)
+  {
+    childNs += node.children[i].totalNs;
+  }
+
+  TChar line[256];
+  const std::string name = std::string( 2 * level, ' ' ) + getProfileNodeName( node.stage, node.depth );
+  snprintf( line, sizeof(line), "  %-44s %12llu %12.1f %12.1f %8.1f\n", name.c_str(), (unsigned long long)node.calls,
+            node.totalNs * 1e-6, ( node.totalNs - childNs ) * 1e-6, rootNs > 0 ? 100.0 * node.totalNs / rootNs : 0.0 );
+  os << line;
+
+  for (UInt i = 0; i < node.children.size(); i++)
+  {
+    printReportNode( os, node.children[i], level + 1, rootNs );
+  }
+}
+
+// ====================================================================================================================
+// Constructor / destructor / singleton access
+// ====================================================================================================================
+
+TComProfiler::TComProfiler()
+: m_threads()
+, m_epoch( Clock::now() )
+, m_traceEnabled( false )
+{
+}
+
+TComProfiler& TComProfiler::getInstance()
+{
+  static TComProfiler profiler;
+  return profiler;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Void TComProfiler::reset()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  for (UInt i = 0; i < m_threads.size(); i++)
+  {
+    xClearThreadData( *m_threads[i] );
+  }
+  m_epoch = Clock::now();
+}
+
+Void TComProfiler::enter( TComProfileStage stage, Int depth )
+{
+  ThreadData &data = xGetThreadData();
+  const Int parent = data.current;
+
+  for (UInt i = 0; i < data.nodes[parent].children.size(); i++)
+  {
+    const Int child = data.nodes[parent].children[i];
+    if (data.nodes[child].stage == stage && data.nodes[child].depth == depth)
+    {
+      data.current = child;
+      return;
+    }
+  }
+
+  Node node;
+  node.stage   = stage;
+  node.depth   = depth;
+  node.parent  = parent;
+  node.calls   = 0;
+  node.totalNs = 0;
+  data.nodes.push_back( node );
+  data.current = Int( data.nodes.size() ) - 1;
+  data.nodes[parent].children.push_back( data.current );
+}
+
+Void TComProfiler::leave( const Clock::time_point &start )
+{
+  const Clock::time_point end = Clock::now();
+  ThreadData &data = xGetThreadData();
+  Node &node = data.nodes[data.current];
+  const Int64 durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count();
+
+  node.calls++;
+  node.totalNs += durationNs;
+
+  if (m_traceEnabled)
+  {
+    if (data.events.size() < PROFILE_MAX_TRACE_EVENTS_PER_THREAD)
+    {
+      TraceEvent event;
+      event.node       = data.current;
+      event.startNs    = std::chrono::duration_cast<std::chrono::nanoseconds>( start - m_epoch ).count();
+      event.durationNs = durationNs;
+      data.events.push_back( event );
+    }
+    else
+    {
+      data.droppedEvents++;
+    }
+  }
+
+  data.current = node.parent;
+}
+
+Void TComProfiler::count( TComProfileCounter counter, Int64 value )
+{
+  xGetThreadData().counters[counter] += value;
+}
+
+Void TComProfiler::printReport( std::ostream &os, const std::string &title ) const
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  // merge the call trees of all threads by call path
+  TComProfileReportNode root;
+  root.stage   = 0;
+  root.depth   = 0;
+  root.calls   = 0;
+  root.totalNs = 0;
+  Int64 counters[NUMBER_OF_PROFILE_COUNTERS] = { 0 };
+  Int   activeThreads = 0;
+
+  for (UInt t = 0; t < m_threads.size(); t++)
+  {
+    const ThreadData &data = *m_threads[t];
+    if (data.nodes.size() > 1)
+    {
+      activeThreads++;
+    }
+    for (Int c = 0; c < NUMBER_OF_PROFILE_COUNTERS; c++)
+    {
+      counters[c] += data.counters[c];
+    }
+
+    // depth-first walk of the thread tree, keeping the matching merged node for every level
+    std::vector<std::pair<Int, std::vector<Int> > > stack;   // (thread node, path of child indices in the merged tree)
+    stack.push_back( std::make_pair( 0, std::vector<Int>() ) );
+    while (!stack.empty())
+    {
+      const std::pair<Int, std::vector<Int> > entry = stack.back();
+      stack.pop_back();
+      const Node &node = data.nodes[entry.first];
+
+      TComProfileReportNode *merged = &root;
+      for (UInt i = 0; i < entry.second.size(); i++)
+      {
+        merged = &merged->children[entry.second[i]];
+      }
+      if (entry.first != 0)
+      {
+        merged->calls   += node.calls;
+        merged->totalNs += node.totalNs;
+      }
+
+      for (UInt i = 0; i < node.children.size(); i++)
+      {
+        const Node &child = data.nodes[node.children[i]];
+        UInt m = 0;
+        while (m < merged->children.size() && ( merged->children[m].stage != child.stage || merged->children[m].depth != child.depth ))
+        {
+          m++;
+        }
+        if (m == merged->children.size())
+        {
+          TComProfileReportNode newNode;
+          newNode.stage   = child.stage;
+          newNode.depth   = child.depth;
+          newNode.calls   = 0;
+          newNode.totalNs = 0;
+          merged->children.push_back( newNode );
+        }
+        std::vector<Int> path = entry.second;
+        path.push_back( Int( m ) );
+        stack.push_back( std::make_pair( node.children[i], path ) );
+      }
+    }
+  }
+
+  // sort every level by time
+  std::vector<TComProfileReportNode*> pending( 1, &root );
+  while (!pending.empty())
+  {
+    TComProfileReportNode *node = pending.back();
+    pending.pop_back();
+    std::stable_sort( node->children.begin(), node->children.end(), compareReportNodes );
+    for (UInt i = 0; i < node->children.size(); i++)
+    {
+      pending.push_back( &node->children[i] );
+    }
+  }
+
+  Int64 rootNs = 0;
+  for (UInt i = 0; i < root.children.size(); i++)
+  {
+    rootNs += root.children[i].totalNs;
+  }
+
+  TChar line[256];
+  os << "\n\nPROFILE " << title << " --------------------------------------------------------\n";
+  snprintf( line, sizeof(line), "  %-44s %12s %12s %12s %8s\n", "stage", "calls", "total ms", "self ms", "%" );
+  os << line;
+  for (UInt i = 0; i < root.children.size(); i++)
+  {
+    printReportNode( os, root.children[i], 0, Double( rootNs ) );
+  }
+  snprintf( line, sizeof(line), "  (times are summed over %d thread(s))\n", activeThreads );
+  os << line;
+
+  for (Int c = 0; c < NUMBER_OF_PROFILE_COUNTERS; c++)
+  {
+    if (counters[c] != 0)
+    {
+      snprintf( line, sizeof(line), "  %-44s %12lld\n", profileCounterNames[c], (long long)counters[c] );
+      os << line;
+    }
+  }
+}
+
+Bool TComProfiler::writeChromeTrace( const std::string &fileName ) const
+{
+  std::ofstream file( fileName.c_str() );
+  if (!file)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+  TChar line[256];
+  UInt64 droppedEvents = 0;
+  Bool first = true;
+
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  for (UInt t = 0; t < m_threads.size(); t++)
+  {
+    const ThreadData &data = *m_threads[t];
+    droppedEvents += data.droppedEvents;
+    for (UInt e = 0; e < data.events.size(); e++)
+    {
+      const TraceEvent &event = data.events[e];
+      const Node &node = data.nodes[event.node];
+      snprintf( line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                first ? "" : ",\n", getProfileNodeName( node.stage, node.depth ).c_str(), data.id,
+                event.startNs * 1e-3, event.durationNs * 1e-3 );
+      file << line;
+      first = false;
+    }
+  }
+  file << "\n]}\n";
+
+  if (droppedEvents > 0)
+  {
+    fprintf( stderr, "Warning: %llu profile trace events were dropped (limit of %llu events per thread)\n",
+             (unsigned long long)droppedEvents, (unsigned long long)PROFILE_MAX_TRACE_EVENTS_PER_THREAD );
+  }
+  return true;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+TComProfiler::ThreadData& TComProfiler::xGetThreadData()
+{
+  static thread_local ThreadData *threadData = NULL;
+  if (threadData == NULL)
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_threads.push_back( std::unique_ptr<ThreadData>( new ThreadData ) );
+    threadData = m_threads.back().get();
+    threadData->id = Int( m_threads.size() ) - 1;
+    xClearThreadData( *threadData );
+  }
+  return *threadData;
+}
+
+Void TComProfiler::xClearThreadData( ThreadData &data )
+{
+  Node root;
+  root.stage   = 0;
+  root.depth   = 0;
+  root.parent  = 0;
+  root.calls   = 0;
+  root.totalNs = 0;
+
+  data.nodes.assign( 1, root );
+  data.current = 0;
+  data.events.clear();
+  data.droppedEvents = 0;
+  for (Int c = 0; c < NUMBER_OF_PROFILE_COUNTERS; c++)
+  {
+    data.counters[c] = 0;
+  }
+}
+
+//! \}
+
+#endif // ENABLE_PROFILING
@@ -0,0 +1,194 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TComProfiler.h
+    \brief    hierarchical scoped timers and counters of the encoder and decoder hot paths (header)
+*/
+
+#ifndef __TCOMPROFILER__
+#define __TCOMPROFILER__
+
+#include "CommonDef.h"
+
+#if ENABLE_PROFILING
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// profiled stages; the hierarchy follows the nesting of the scopes at run time
+enum TComProfileStage
+{
+  PROF_ENC_COMPRESS_GOP = 0,
+  PROF_ENC_COMPRESS_SLICE,
+  PROF_ENC_COMPRESS_CU,                               ///< xCompressCU, profiled per CU depth
+  PROF_ENC_INTER_SEARCH,                              ///< predInterSearch
+  PROF_ENC_INTRA_LUMA_SEARCH,                         ///< estIntraPredLumaQT
+  PROF_RDOQ,
+  PROF_ENC_ENTROPY_CODING,                            ///< encodeSlice
+  PROF_LOOP_FILTER,                                   ///< deblocking of a picture
+  PROF_SAO,                                           ///< SAO parameter estimation (encoder) and filtering
+  PROF_DEC_SLICE,
+  PROF_DEC_PARSE,                                     ///< CTU syntax parsing
+  PROF_DEC_RECONSTRUCT,                               ///< CTU prediction and reconstruction
+  PROF_DEC_FILTER_PICTURE,                            ///< in-loop filtering of a decoded picture
+  NUMBER_OF_PROFILE_STAGES
+};
+
+/// profiled event counters
+enum TComProfileCounter
+{
+  PROF_COUNTER_ENC_CTUS = 0,                          ///< CTUs compressed (including re-encodes)
+  PROF_COUNTER_INTER_SEARCH_SAMPLES,                  ///< luma samples of the CUs passed to predInterSearch
+  PROF_COUNTER_RDOQ_COEFFS,                           ///< coefficients quantised with RDOQ
+  PROF_COUNTER_DEC_CTUS,                              ///< CTUs decoded
+  NUMBER_OF_PROFILE_COUNTERS
+};
+
+#if ENABLE_PROFILING
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** process-wide profiler. Every thread accumulates a call tree of the scopes it executes in its own storage, so
+ *  timing does not need synchronisation; the trees of all threads are merged by call path for the report. When
+ *  tracing is enabled, every scope is additionally recorded as an event for a Chrome trace ("chrome://tracing",
+ *  Perfetto) file.
+ */
+class TComProfiler
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  static TComProfiler& getInstance();
+
+  Void  setTraceEnabled   ( Bool enabled )            { m_traceEnabled = enabled; }
+  Bool  getTraceEnabled   () const                    { return m_traceEnabled; }
+
+  /// discard all measurements; must not be called while profiled scopes are active
+  Void  reset             ();
+
+  Void  enter             ( TComProfileStage stage, Int depth );
+  Void  leave             ( const Clock::time_point &start );
+  Void  count             ( TComProfileCounter counter, Int64 value );
+
+  /// prints the merged call tree and the counters
+  Void  printReport       ( std::ostream &os, const std::string &title ) const;
+  /// writes the recorded events in the Chrome trace event format
+  Bool  writeChromeTrace  ( const std::string &fileName ) const;
+
+private:
+  struct Node
+  {
+    Int               stage;
+    Int               depth;
+    Int               parent;
+    std::vector<Int>  children;
+    UInt64            calls;
+    Int64             totalNs;
+  };
+
+  struct TraceEvent
+  {
+    Int               node;
+    Int64             startNs;
+    Int64             durationNs;
+  };
+
+  struct ThreadData
+  {
+    Int                     id;
+    std::vector<Node>       nodes;                    ///< call tree, nodes[0] is the root
+    Int                     current;
+    std::vector<TraceEvent> events;
+    UInt64                  droppedEvents;
+    Int64                   counters[NUMBER_OF_PROFILE_COUNTERS];
+  };
+
+  TComProfiler();
+
+  ThreadData& xGetThreadData();
+  static Void xClearThreadData( ThreadData &data );
+
+  mutable std::mutex                          m_mutex;
+  std::vector<std::unique_ptr<ThreadData> >  m_threads;
+  Clock::time_point                           m_epoch;
+  Bool                                        m_traceEnabled;
+};
+
+/// times the enclosing scope
+class TComProfileScope
+{
+public:
+  TComProfileScope( TComProfileStage stage, Int depth )
+  : m_start( TComProfiler::Clock::now() )
+  {
+    TComProfiler::getInstance().enter( stage, depth );
+  }
+
+  ~TComProfileScope()
+  {
+    TComProfiler::getInstance().leave( m_start );
+  }
+
+private:
+  TComProfiler::Clock::time_point m_start;
+};
+
+#define PROFILE_SCOPE(stage)                  TComProfileScope profileScope( stage, 0 )
+#define PROFILE_SCOPE_DEPTH(stage, depth)     TComProfileScope profileScope( stage, depth )
+#define PROFILE_COUNT(counter, value)         TComProfiler::getInstance().count( counter, value )
+
+#else
+
+#define PROFILE_SCOPE(stage)
+#define PROFILE_SCOPE_DEPTH(stage, depth)
+#define PROFILE_COUNT(counter, value)
+
+#endif
+
+//! \}
+
+#endif // __TCOMPROFILER__
@@ -357,6 +357,57 @@ Distortion TComRdCost::getDistPart( Int bitDepth, const Pel* piCur, Int iCurStri
   }
 }
 
+UInt64 TComRdCost::getSSD( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iWidth, Int iHeight, UInt uiShift )
+{
+  UInt64 uiSum = 0;
+
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if ( uiShift == 0 )
+  {
+    // differences fit in 16 bits, pairs of squares in 32 bits; accumulate in 64 bits to allow any picture size
+    const Int     iWidthSimd = iWidth & ~7;
+    const __m128i zero       = _mm_setzero_si128();
+    __m128i       sum        = _mm_setzero_si128();
+    for( Int y = 0; y < iHeight; y++ )
+    {
+      Int x = 0;
+      for( ; x < iWidthSimd; x += 8 )
+      {
+        const __m128i org  = _mm_loadu_si128( ( const __m128i* )( piOrg + x ) );
+        const __m128i cur  = _mm_loadu_si128( ( const __m128i* )( piCur + x ) );
+        const __m128i diff = _mm_sub_epi16( org, cur );
+        const __m128i sq   = _mm_madd_epi16( diff, diff );
+        sum = _mm_add_epi64( sum, _mm_unpacklo_epi32( sq, zero ) );
+        sum = _mm_add_epi64( sum, _mm_unpackhi_epi32( sq, zero ) );
+      }
+      for( ; x < iWidth; x++ )
+      {
+        const Intermediate_Int iTemp = piOrg[x] - piCur[x];
+        uiSum += UInt64( iTemp * iTemp );
+      }
+      piOrg += iStrideOrg;
+      piCur += iStrideCur;
+    }
+    UInt64 lanes[2];
+    _mm_storeu_si128( ( __m128i* )lanes, sum );
+    return uiSum + lanes[0] + lanes[1];
+  }
+#endif
+
+  for( Int y = 0; y < iHeight; y++ )
+  {
+    for( Int x = 0; x < iWidth; x++ )
+    {
+      const Intermediate_Int iTemp = piOrg[x] - piCur[x];
+      uiSum += UInt64( ( iTemp * iTemp ) >> uiShift );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return uiSum;
+}
+
 // ====================================================================================================================
 // Distortion functions
 // ====================================================================================================================
@@ -208,6 +208,9 @@ public:
 
   Distortion   getDistPart(Int bitDepth, const Pel* piCur, Int iCurStride, const Pel* piOrg, Int iOrgStride, UInt uiBlkWidth, UInt uiBlkHeight, const ComponentID compID, DFunc eDFunc = DF_SSE );
 
+  /// sum of squared differences of a picture area of any size, each squared difference is shifted right by uiShift
+  static UInt64 getSSD     ( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iWidth, Int iHeight, UInt uiShift = 0 );
+
 };// END CLASS DEFINITION TComRdCost
 
 //! \}
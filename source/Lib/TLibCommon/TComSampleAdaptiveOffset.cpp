@@ -36,6 +36,7 @@
 */
 
 #include "TComSampleAdaptiveOffset.h"
+#include "TComProfiler.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -613,6 +614,7 @@ Void TComSampleAdaptiveOffset::offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TCom
 
 Void TComSampleAdaptiveOffset::SAOProcess(TComPic* pDecPic)
 {
+  PROFILE_SCOPE( PROF_SAO );
   const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
   Bool bAllDisabled=true;
   for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
@@ -0,0 +1,155 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.cpp
+    \brief    fork-join thread pool
+*/
+
+#include "TComThreadPool.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+TComThreadPool::TComThreadPool()
+: m_task        (NULL)
+, m_numTasks    (0)
+, m_nextTask    (0)
+, m_numFinished (0)
+, m_generation  (0)
+, m_terminate   (false)
+{
+}
+
+TComThreadPool::~TComThreadPool()
+{
+  destroy();
+}
+
+Void TComThreadPool::create( const Int numThreads )
+{
+  destroy();
+  m_terminate = false;
+  for (Int i = 0; i < numThreads; i++)
+  {
+    m_threads.push_back(std::thread(&TComThreadPool::xThreadLoop, this));
+  }
+}
+
+Void TComThreadPool::destroy()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_terminate = true;
+  }
+  m_taskCondition.notify_all();
+  for (size_t i = 0; i < m_threads.size(); i++)
+  {
+    m_threads[i].join();
+  }
+  m_threads.clear();
+}
+
+Void TComThreadPool::run( const Int numTasks, const std::function<Void(Int)> &task )
+{
+  if (m_threads.empty() || numTasks == 1)
+  {
+    for (Int i = 0; i < numTasks; i++)
+    {
+      task(i);
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_task        = &task;
+  m_numTasks    = numTasks;
+  m_nextTask    = 0;
+  m_numFinished = 0;
+  m_generation++;
+  m_taskCondition.notify_all();
+
+  while (xRunNextTask(lock))
+  {
+  }
+  while (m_numFinished < m_numTasks)
+  {
+    m_doneCondition.wait(lock);
+  }
+  m_task = NULL;
+}
+
+/** take the next task of the current run and execute it with the lock released
+ * \returns false if no task was left
+ */
+Bool TComThreadPool::xRunNextTask( std::unique_lock<std::mutex> &lock )
+{
+  if (m_nextTask >= m_numTasks)
+  {
+    return false;
+  }
+  const Int taskIdx = m_nextTask++;
+  const std::function<Void(Int)> &task = *m_task;
+
+  lock.unlock();
+  task(taskIdx);
+  lock.lock();
+
+  if (++m_numFinished == m_numTasks)
+  {
+    m_doneCondition.notify_one();
+  }
+  return true;
+}
+
+Void TComThreadPool::xThreadLoop()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  UInt64 generation = m_generation;
+  while (true)
+  {
+    while (!m_terminate && generation == m_generation)
+    {
+      m_taskCondition.wait(lock);
+    }
+    if (m_terminate)
+    {
+      return;
+    }
+    generation = m_generation;
+    while (xRunNextTask(lock))
+    {
+    }
+  }
+}
+
+//! \}
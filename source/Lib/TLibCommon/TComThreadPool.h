@@ -0,0 +1,89 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.h
+    \brief    fork-join thread pool (header)
+*/
+
+#ifndef __TCOMTHREADPOOL__
+#define __TCOMTHREADPOOL__
+
+#include "CommonDef.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// pool of persistent threads that execute a number of independent tasks and join before returning to the caller
+class TComThreadPool
+{
+public:
+  TComThreadPool();
+  ~TComThreadPool();
+
+  /// start numThreads helper threads, the calling thread takes part in each run() as well
+  Void create         ( const Int numThreads );
+  Void destroy        ();
+
+  Int  getNumThreads  () const { return Int(m_threads.size()); }
+
+  /// execute task(0) .. task(numTasks-1) and wait until all of them have finished
+  Void run            ( const Int numTasks, const std::function<Void(Int)> &task );
+
+private:
+  Void xThreadLoop    ();
+  Bool xRunNextTask   ( std::unique_lock<std::mutex> &lock );
+
+  std::vector<std::thread>          m_threads;
+  std::mutex                        m_mutex;
+  std::condition_variable           m_taskCondition;
+  std::condition_variable           m_doneCondition;
+  const std::function<Void(Int)>*   m_task;
+  Int                               m_numTasks;
+  Int                               m_nextTask;
+  Int                               m_numFinished;
+  UInt64                            m_generation;
+  Bool                              m_terminate;
+};
+
+//! \}
+
+#endif // __TCOMTHREADPOOL__
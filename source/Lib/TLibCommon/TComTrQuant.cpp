@@ -44,6 +44,14 @@
 #include "ContextTables.h"
 #include "TComTU.h"
 #include "Debug.h"
+#include "TComProfiler.h"
+
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0) && defined(__SSE4_1__)
+#include <smmintrin.h>
+#define QUANT_SIMD 1
+#else
+#define QUANT_SIMD 0
+#endif
 
 typedef struct
 {
@@ -63,6 +71,15 @@ typedef struct
 
 #define RDOQ_CHROMA                 1           ///< use of RDOQ in chroma
 
+/// significance context increment within a 4x4 coefficient group, indexed by [patternSigCtx][(posY << 2) + posX]
+static const UChar s_sigCtxIncInGroup[4][1 << MLS_CG_SIZE] =
+{
+  { 2, 1, 1, 0,  1, 1, 0, 0,  1, 0, 0, 0,  0, 0, 0, 0 }, // neither neighbouring group is significant
+  { 2, 2, 2, 2,  1, 1, 1, 1,  0, 0, 0, 0,  0, 0, 0, 0 }, // right group is significant, below is not
+  { 2, 1, 0, 0,  2, 1, 0, 0,  2, 1, 0, 0,  2, 1, 0, 0 }, // below group is significant, right is not
+  { 2, 2, 2, 2,  2, 2, 2, 2,  2, 2, 2, 2,  2, 2, 2, 2 }  // both neighbouring groups are significant
+};
+
 
 // ====================================================================================================================
 // QpParam constructor
@@ -128,6 +145,15 @@ TComTrQuant::TComTrQuant()
   // allocate temporary buffers
   m_plTempCoeff  = new TCoeff[ MAX_CU_SIZE*MAX_CU_SIZE ];
 
+  m_rdoqLevelDouble  = new Intermediate_Int[ MAX_TU_SIZE*MAX_TU_SIZE ];
+  m_rdoqCostCoeff0   = new Double          [ MAX_TU_SIZE*MAX_TU_SIZE ];
+  m_rdoqCostCoeff    = new Double          [ MAX_TU_SIZE*MAX_TU_SIZE ];
+  m_rdoqCostSig      = new Double          [ MAX_TU_SIZE*MAX_TU_SIZE ];
+  m_rdoqRateIncUp    = new Int             [ MAX_TU_SIZE*MAX_TU_SIZE ];
+  m_rdoqRateIncDown  = new Int             [ MAX_TU_SIZE*MAX_TU_SIZE ];
+  m_rdoqSigRateDelta = new Int             [ MAX_TU_SIZE*MAX_TU_SIZE ];
+  m_rdoqDeltaU       = new TCoeff          [ MAX_TU_SIZE*MAX_TU_SIZE ];
+
   // allocate bit estimation class  (for RDOQ)
   m_pcEstBitsSbac = new estBitsSbacStruct;
   initScalingList();
@@ -141,6 +167,14 @@ TComTrQuant::~TComTrQuant()
     delete [] m_plTempCoeff;
     m_plTempCoeff = NULL;
   }
+  delete [] m_rdoqLevelDouble;
+  delete [] m_rdoqCostCoeff0;
+  delete [] m_rdoqCostCoeff;
+  delete [] m_rdoqCostSig;
+  delete [] m_rdoqRateIncUp;
+  delete [] m_rdoqRateIncDown;
+  delete [] m_rdoqSigRateDelta;
+  delete [] m_rdoqDeltaU;
 
   // delete bit estimation class
   if ( m_pcEstBitsSbac )
@@ -1123,6 +1157,125 @@ Void TComTrQuant::signBitHidingHDQ( TCoeff* pQCoef, TCoeff* pCoef, TCoeff* delta
 }
 
 
+#if QUANT_SIMD
+/** Quantise coefficients four at a time for the non-RDOQ path
+ * \param piCoef              input coefficients
+ * \param piQCoef             output levels, clipped to the entropy coding range
+ * \param deltaU              output rounding errors for sign bit hiding
+ * \param piArlCCoef          output adaptive reconstruction levels, or NULL
+ * \param numSamples          number of coefficients
+ * \param piQuantCoeff        per-coefficient quantisation coefficients, or NULL for flat quantisation
+ * \param quantCoeff          flat quantisation coefficient
+ * \param iQBits              quantisation shift
+ * \param iAdd                rounding offset
+ * \param iQBitsC             adaptive reconstruction level shift
+ * \param iAddC               adaptive reconstruction level rounding offset
+ * \param entropyCodingMinimum smallest codable level
+ * \param entropyCodingMaximum largest codable level
+ * \param uiAbsSum            incremented by the quantised magnitudes
+ * \returns number of coefficients processed; the remainder is left to the scalar loop
+ *
+ * Stops at the first group of four whose products may not fit in 32 bits, where the scalar 64-bit path is required.
+ */
+static Int quantiseCoefficientsSIMD( const TCoeff *piCoef, TCoeff *piQCoef, TCoeff *deltaU, TCoeff *piArlCCoef, const Int numSamples,
+                                     const Int *piQuantCoeff, const Int quantCoeff, const Int iQBits, const Int iAdd, const Int iQBitsC, const Int iAddC,
+                                     const TCoeff entropyCodingMinimum, const TCoeff entropyCodingMaximum, TCoeff &uiAbsSum )
+{
+  if (iQBits < 9 || iQBits > 30)
+  {
+    return 0;
+  }
+
+  // |coeff| <= 2^15 and quantisation coefficient < 2^15 keep tmpLevel below 2^30
+  const __m128i vAbsLimit = _mm_set1_epi32(1 << 15);
+  const __m128i vQLimit   = _mm_set1_epi32((1 << 15) - 1);
+  const __m128i vShift    = _mm_cvtsi32_si128(iQBits);
+  const __m128i vShift8   = _mm_cvtsi32_si128(iQBits - 8);
+  const __m128i vShiftC   = _mm_cvtsi32_si128(iQBitsC);
+  const __m128i vAdd      = _mm_set1_epi32(iAdd);
+  const __m128i vAddC     = _mm_set1_epi32(iAddC);
+  const __m128i vMin      = _mm_set1_epi32(entropyCodingMinimum);
+  const __m128i vMax      = _mm_set1_epi32(entropyCodingMaximum);
+  __m128i       vQ        = _mm_set1_epi32(quantCoeff);
+  __m128i       vAbsSum   = _mm_setzero_si128();
+
+  Int n = 0;
+  for (; n + 4 <= numSamples; n += 4)
+  {
+    const __m128i level = _mm_loadu_si128((const __m128i*)(piCoef + n));
+    const __m128i absLevel = _mm_abs_epi32(level);
+    if (piQuantCoeff != NULL)
+    {
+      vQ = _mm_loadu_si128((const __m128i*)(piQuantCoeff + n));
+    }
+
+    const __m128i tooLarge = _mm_or_si128(_mm_cmpgt_epi32(absLevel, vAbsLimit), _mm_cmpgt_epi32(vQ, vQLimit));
+    if (!_mm_testz_si128(tooLarge, tooLarge))
+    {
+      break;
+    }
+
+    const __m128i tmpLevel  = _mm_mullo_epi32(absLevel, vQ);
+    const __m128i magnitude = _mm_sra_epi32(_mm_add_epi32(tmpLevel, vAdd), vShift);
+
+    _mm_storeu_si128((__m128i*)(deltaU + n), _mm_sra_epi32(_mm_sub_epi32(tmpLevel, _mm_sll_epi32(magnitude, vShift)), vShift8));
+    if (piArlCCoef != NULL)
+    {
+      _mm_storeu_si128((__m128i*)(piArlCCoef + n), _mm_sra_epi32(_mm_add_epi32(tmpLevel, vAddC), vShiftC));
+    }
+
+    vAbsSum = _mm_add_epi32(vAbsSum, magnitude);
+    _mm_storeu_si128((__m128i*)(piQCoef + n), _mm_min_epi32(vMax, _mm_max_epi32(vMin, _mm_sign_epi32(magnitude, level))));
+  }
+
+  vAbsSum   = _mm_add_epi32(vAbsSum, _mm_shuffle_epi32(vAbsSum, _MM_SHUFFLE(1, 0, 3, 2)));
+  vAbsSum   = _mm_add_epi32(vAbsSum, _mm_shuffle_epi32(vAbsSum, _MM_SHUFFLE(2, 3, 0, 1)));
+  uiAbsSum += _mm_cvtsi128_si32(vAbsSum);
+
+  return n;
+}
+
+/** Dequantise coefficients four at a time
+ * \param piQCoef          input levels
+ * \param piCoef           output coefficients, clipped to the transform dynamic range
+ * \param numSamples       number of coefficients
+ * \param piDequantCoef    per-coefficient scales, or NULL for a flat scale
+ * \param scale            flat scale
+ * \param rightShift       scaling shift, a left shift when not positive
+ * \param inputMinimum     smallest level before scaling
+ * \param inputMaximum     largest level before scaling
+ * \param transformMinimum smallest output coefficient
+ * \param transformMaximum largest output coefficient
+ * \returns number of coefficients processed; the remainder is left to the scalar loop
+ */
+static Int dequantiseCoefficientsSIMD( const TCoeff *piQCoef, TCoeff *piCoef, const Int numSamples, const Int *piDequantCoef, const Int scale, const Int rightShift,
+                                       const Int inputMinimum, const Int inputMaximum, const TCoeff transformMinimum, const TCoeff transformMaximum )
+{
+  const __m128i vInMin    = _mm_set1_epi32(inputMinimum);
+  const __m128i vInMax    = _mm_set1_epi32(inputMaximum);
+  const __m128i vOutMin   = _mm_set1_epi32(transformMinimum);
+  const __m128i vOutMax   = _mm_set1_epi32(transformMaximum);
+  const __m128i vAdd      = _mm_set1_epi32((rightShift > 0) ? (1 << (rightShift - 1)) : 0);
+  const __m128i vRight    = _mm_cvtsi32_si128(std::max<Int>(0,  rightShift));
+  const __m128i vLeft     = _mm_cvtsi32_si128(std::max<Int>(0, -rightShift));
+  __m128i       vScale    = _mm_set1_epi32(scale);
+
+  Int n = 0;
+  for (; n + 4 <= numSamples; n += 4)
+  {
+    if (piDequantCoef != NULL)
+    {
+      vScale = _mm_loadu_si128((const __m128i*)(piDequantCoef + n));
+    }
+    const __m128i clipQCoef = _mm_min_epi32(vInMax, _mm_max_epi32(vInMin, _mm_loadu_si128((const __m128i*)(piQCoef + n))));
+    const __m128i coeffQ    = _mm_sll_epi32(_mm_sra_epi32(_mm_add_epi32(_mm_mullo_epi32(clipQCoef, vScale), vAdd), vRight), vLeft);
+
+    _mm_storeu_si128((__m128i*)(piCoef + n), _mm_min_epi32(vOutMax, _mm_max_epi32(vOutMin, coeffQ)));
+  }
+  return n;
+}
+#endif
+
 Void TComTrQuant::xQuant(       TComTU       &rTu,
                                 TCoeff      * pSrc,
                                 TCoeff      * pDes,
@@ -1215,7 +1368,19 @@ Void TComTrQuant::xQuant(       TComTU       &rTu,
     const Int iAdd   = (pcCU->getSlice()->getSliceType()==I_SLICE ? 171 : 85) << (iQBits-9);
     const Int qBits8 = iQBits - 8;
 
-    for( Int uiBlockPos = 0; uiBlockPos < uiWidth*uiHeight; uiBlockPos++ )
+#if QUANT_SIMD
+#if ADAPTIVE_QP_SELECTION
+    const Int firstScalarPos = quantiseCoefficientsSIMD( piCoef, piQCoef, deltaU, m_bUseAdaptQpSelect ? piArlCCoef : NULL, uiWidth*uiHeight, enableScalingLists ? piQuantCoeff : NULL,
+                                                         defaultQuantisationCoefficient, iQBits, iAdd, iQBitsC, iAddC, entropyCodingMinimum, entropyCodingMaximum, uiAbsSum );
+#else
+    const Int firstScalarPos = quantiseCoefficientsSIMD( piCoef, piQCoef, deltaU, NULL, uiWidth*uiHeight, enableScalingLists ? piQuantCoeff : NULL,
+                                                         defaultQuantisationCoefficient, iQBits, iAdd, 0, 0, entropyCodingMinimum, entropyCodingMaximum, uiAbsSum );
+#endif
+#else
+    const Int firstScalarPos = 0;
+#endif
+
+    for( Int uiBlockPos = firstScalarPos; uiBlockPos < uiWidth*uiHeight; uiBlockPos++ )
     {
       const TCoeff iLevel   = piCoef[uiBlockPos];
       const TCoeff iSign    = (iLevel < 0 ? -1: 1);
@@ -1359,11 +1524,17 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
 
     Int *piDequantCoef = getDequantCoeff(scalingListType,QP_rem,uiLog2TrSize-2);
 
+#if QUANT_SIMD
+    const Int firstScalarPos = dequantiseCoefficientsSIMD( piQCoef, piCoef, numSamplesInBlock, piDequantCoef, 0, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+#else
+    const Int firstScalarPos = 0;
+#endif
+
     if(rightShift > 0)
     {
       const Intermediate_Int iAdd = 1 << (rightShift - 1);
 
-      for( Int n = 0; n < numSamplesInBlock; n++ )
+      for( Int n = firstScalarPos; n < numSamplesInBlock; n++ )
       {
         const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
         const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * piDequantCoef[n]) + iAdd ) >> rightShift;
@@ -1375,7 +1546,7 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
     {
       const Int leftShift = -rightShift;
 
-      for( Int n = 0; n < numSamplesInBlock; n++ )
+      for( Int n = firstScalarPos; n < numSamplesInBlock; n++ )
       {
         const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
         const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * piDequantCoef[n]) << leftShift;
@@ -1396,11 +1567,17 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
+#if QUANT_SIMD
+    const Int firstScalarPos = dequantiseCoefficientsSIMD( piQCoef, piCoef, numSamplesInBlock, NULL, scale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+#else
+    const Int firstScalarPos = 0;
+#endif
+
     if (rightShift > 0)
     {
       const Intermediate_Int iAdd = 1 << (rightShift - 1);
 
-      for( Int n = 0; n < numSamplesInBlock; n++ )
+      for( Int n = firstScalarPos; n < numSamplesInBlock; n++ )
       {
         const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
         const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale + iAdd) >> rightShift;
@@ -1412,7 +1589,7 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
     {
       const Int leftShift = -rightShift;
 
-      for( Int n = 0; n < numSamplesInBlock; n++ )
+      for( Int n = firstScalarPos; n < numSamplesInBlock; n++ )
       {
         const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
         const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale) << leftShift;
@@ -1428,6 +1605,7 @@ Void TComTrQuant::init(   UInt  uiMaxTrSize,
                           Bool  bUseRDOQ,
                           Bool  bUseRDOQTS,
                           Bool  useSelectiveRDOQ,
+                          Bool  useFastRDOQ,
                           Bool  bEnc,
                           Bool  useTransformSkipFast
 #if ADAPTIVE_QP_SELECTION
@@ -1440,6 +1618,7 @@ Void TComTrQuant::init(   UInt  uiMaxTrSize,
   m_useRDOQ      = bUseRDOQ;
   m_useRDOQTS    = bUseRDOQTS;
   m_useSelectiveRDOQ = useSelectiveRDOQ;
+  m_useFastRDOQ      = useFastRDOQ;
 #if ADAPTIVE_QP_SELECTION
   m_bUseAdaptQpSelect = bUseAdaptQpSelect;
 #endif
@@ -2104,6 +2283,97 @@ Void TComTrQuant::xITransformSkip( TCoeff* plCoef, Pel* pResidual, UInt uiStride
   }
 }
 
+/** Quantisation pre-pass of RDOQ over the whole block, in raster order
+ * \param plSrcCoeff pointer to input buffer
+ * \param piDstCoeff pointer to output buffer, receives the rounded maximum absolute level of each coefficient
+ * \param piArlDstCoeff pointer to output buffer of the adaptive reconstruction levels
+ * \param uiMaxNumCoeff number of coefficients in the block
+ * \param piQCoef quantisation coefficients of the scaling list
+ * \param pdErrScale error scales of the scaling list
+ * \param defaultQuantisationCoefficient quantisation coefficient when scaling lists are not used
+ * \param defaultErrorScale error scale when scaling lists are not used
+ * \param enableScalingLists whether piQCoef and pdErrScale apply
+ * \param iQBits quantisation shift
+ * \param entropyCodingMaximum largest codable level
+ *
+ * Stores the unscaled level and the distortion of coding the coefficient as zero in the RDOQ scratch buffers.
+ */
+Void TComTrQuant::xRdoqPreQuant( const TCoeff      * plSrcCoeff,
+                                       TCoeff      * piDstCoeff,
+#if ADAPTIVE_QP_SELECTION
+                                       TCoeff      * piArlDstCoeff,
+#endif
+                                 const UInt          uiMaxNumCoeff,
+                                 const Int         * piQCoef,
+                                 const Double      * pdErrScale,
+                                 const Int           defaultQuantisationCoefficient,
+                                 const Double        defaultErrorScale,
+                                 const Bool          enableScalingLists,
+                                 const Int           iQBits,
+                                 const TCoeff        entropyCodingMaximum ) const
+{
+  const Intermediate_Int levelLimit = std::numeric_limits<Intermediate_Int>::max() - (Intermediate_Int(1) << (iQBits - 1));
+  const Intermediate_Int iAdd       = Intermediate_Int(1) << (iQBits - 1);
+#if ADAPTIVE_QP_SELECTION
+  const Int              iQBitsC    = iQBits - ARL_C_PRECISION;
+  const Intermediate_Int iAddC      = Intermediate_Int(1) << (iQBitsC - 1);
+#endif
+  UInt n = 0;
+
+#if QUANT_SIMD
+  // without scaling lists, |coeff| <= 2^15 and the quantisation coefficient is below 2^15, so the product fits in 32 bits
+  if (!enableScalingLists && entropyCodingMaximum <= 32767)
+  {
+    const __m128i vQ     = _mm_set1_epi32(defaultQuantisationCoefficient);
+    const __m128i vLimit = _mm_set1_epi32(levelLimit);
+    const __m128i vAdd   = _mm_set1_epi32(iAdd);
+    const __m128i vMax   = _mm_set1_epi32(entropyCodingMaximum);
+    const __m128i vShift = _mm_cvtsi32_si128(iQBits);
+#if ADAPTIVE_QP_SELECTION
+    const __m128i vAddC   = _mm_set1_epi32(iAddC);
+    const __m128i vShiftC = _mm_cvtsi32_si128(iQBitsC);
+#endif
+    const __m128d vScale = _mm_set1_pd(defaultErrorScale);
+
+    for (; n + 4 <= uiMaxNumCoeff; n += 4)
+    {
+      const __m128i src   = _mm_loadu_si128((const __m128i*)(plSrcCoeff + n));
+      const __m128i level = _mm_min_epi32(_mm_mullo_epi32(_mm_abs_epi32(src), vQ), vLimit);
+      const __m128i maxAbs = _mm_min_epi32(_mm_sra_epi32(_mm_add_epi32(level, vAdd), vShift), vMax);
+
+      _mm_storeu_si128((__m128i*)(m_rdoqLevelDouble + n), level);
+      _mm_storeu_si128((__m128i*)(piDstCoeff + n), maxAbs);
+#if ADAPTIVE_QP_SELECTION
+      _mm_storeu_si128((__m128i*)(piArlDstCoeff + n), m_bUseAdaptQpSelect ? _mm_sra_epi32(_mm_add_epi32(level, vAddC), vShiftC) : _mm_setzero_si128());
+#endif
+
+      const __m128d errLo = _mm_cvtepi32_pd(level);
+      const __m128d errHi = _mm_cvtepi32_pd(_mm_unpackhi_epi64(level, level));
+      _mm_storeu_pd(m_rdoqCostCoeff0 + n,     _mm_mul_pd(_mm_mul_pd(errLo, errLo), vScale));
+      _mm_storeu_pd(m_rdoqCostCoeff0 + n + 2, _mm_mul_pd(_mm_mul_pd(errHi, errHi), vScale));
+    }
+  }
+#endif
+
+  for (; n < uiMaxNumCoeff; n++)
+  {
+    const Int    quantisationCoefficient = (enableScalingLists) ? piQCoef   [n] : defaultQuantisationCoefficient;
+    const Double errorScale              = (enableScalingLists) ? pdErrScale[n] : defaultErrorScale;
+
+    const Int64  tmpLevel                = Int64(abs(plSrcCoeff[ n ])) * quantisationCoefficient;
+    const Intermediate_Int lLevelDouble  = (Intermediate_Int)min<Int64>(tmpLevel, levelLimit);
+
+#if ADAPTIVE_QP_SELECTION
+    piArlDstCoeff[n]     = m_bUseAdaptQpSelect ? (TCoeff)(( lLevelDouble + iAddC) >> iQBitsC ) : 0;
+#endif
+    m_rdoqLevelDouble[n] = lLevelDouble;
+    piDstCoeff[n]        = std::min<UInt>(UInt(entropyCodingMaximum), UInt((lLevelDouble + iAdd) >> iQBits));
+
+    const Double dErr    = Double( lLevelDouble );
+    m_rdoqCostCoeff0[n]  = dErr * dErr * errorScale;
+  }
+}
+
 /** RDOQ with CABAC
  * \param rTu reference to transform data
  * \param plSrcCoeff pointer to input buffer
@@ -2126,6 +2396,8 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
                                                       const ComponentID   compID,
                                                       const QpParam      &cQP  )
 {
+  PROFILE_SCOPE( PROF_RDOQ );
+  PROFILE_COUNT( PROF_COUNTER_RDOQ_COEFFS, rTu.getRect( compID ).width * rTu.getRect( compID ).height );
   const TComRectangle  & rect             = rTu.getRect(compID);
   const UInt             uiWidth          = rect.width;
   const UInt             uiHeight         = rect.height;
@@ -2163,24 +2435,6 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
   Int scalingListType = getScalingListType(pcCU->getPredictionMode(uiAbsPartIdx), compID);
   assert(scalingListType < SCALING_LIST_NUM);
 
-#if ADAPTIVE_QP_SELECTION
-  memset(piArlDstCoeff, 0, sizeof(TCoeff) *  uiMaxNumCoeff);
-#endif
-
-  Double pdCostCoeff [ MAX_TU_SIZE * MAX_TU_SIZE ];
-  Double pdCostSig   [ MAX_TU_SIZE * MAX_TU_SIZE ];
-  Double pdCostCoeff0[ MAX_TU_SIZE * MAX_TU_SIZE ];
-  memset( pdCostCoeff, 0, sizeof(Double) *  uiMaxNumCoeff );
-  memset( pdCostSig,   0, sizeof(Double) *  uiMaxNumCoeff );
-  Int rateIncUp   [ MAX_TU_SIZE * MAX_TU_SIZE ];
-  Int rateIncDown [ MAX_TU_SIZE * MAX_TU_SIZE ];
-  Int sigRateDelta[ MAX_TU_SIZE * MAX_TU_SIZE ];
-  TCoeff deltaU   [ MAX_TU_SIZE * MAX_TU_SIZE ];
-  memset( rateIncUp,    0, sizeof(Int   ) *  uiMaxNumCoeff );
-  memset( rateIncDown,  0, sizeof(Int   ) *  uiMaxNumCoeff );
-  memset( sigRateDelta, 0, sizeof(Int   ) *  uiMaxNumCoeff );
-  memset( deltaU,       0, sizeof(TCoeff) *  uiMaxNumCoeff );
-
   const Int iQBits = QUANT_SHIFT + cQP.per + iTransformShift;                   // Right shift of non-RDOQ quantizer;  level = (coeff*uiQ + offset)>>q_bits
   const Double *const pdErrScale = getErrScaleCoeff(scalingListType, (uiLog2TrSize-2), cQP.rem);
   const Int    *const piQCoef    = getQuantCoeff(scalingListType, cQP.rem, (uiLog2TrSize-2));
@@ -2192,24 +2446,49 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
   const TCoeff entropyCodingMinimum = -(1 << maxLog2TrDynamicRange);
   const TCoeff entropyCodingMaximum =  (1 << maxLog2TrDynamicRange) - 1;
 
+  Double *const pdCostCoeff0 = m_rdoqCostCoeff0;
+  Double *const pdCostCoeff  = m_rdoqCostCoeff;
+  Double *const pdCostSig    = m_rdoqCostSig;
+  Int    *const rateIncUp    = m_rdoqRateIncUp;
+  Int    *const rateIncDown  = m_rdoqRateIncDown;
+  Int    *const sigRateDelta = m_rdoqSigRateDelta;
+  TCoeff *const deltaU       = m_rdoqDeltaU;
+
+  // unscaled levels, rounded maximum levels and uncoded costs of the whole block
+  xRdoqPreQuant( plSrcCoeff, piDstCoeff,
 #if ADAPTIVE_QP_SELECTION
-  Int iQBitsC = iQBits - ARL_C_PRECISION;
-  Int iAddC =  1 << (iQBitsC-1);
+                 piArlDstCoeff,
 #endif
+                 uiMaxNumCoeff, piQCoef, pdErrScale, defaultQuantisationCoefficient, defaultErrorScale, enableScalingLists, iQBits, entropyCodingMaximum );
 
   TUEntropyCodingParameters codingParameters;
   getTUEntropyCodingParameters(codingParameters, rTu, compID);
   const UInt uiCGSize = (1 << MLS_CG_SIZE);
 
+  Int iLastScanPos = -1;
+  for (Int iScanPos = uiMaxNumCoeff-1; iScanPos >= 0; iScanPos--)
+  {
+    if (piDstCoeff[ codingParameters.scan[ iScanPos ] ])
+    {
+      iLastScanPos = iScanPos;
+      break;
+    }
+  }
+
+  //===== all levels quantise to zero =====
+  if ( iLastScanPos < 0 )
+  {
+    return;
+  }
+
   Double pdCostCoeffGroupSig[ MLS_GRP_NUM ];
   UInt uiSigCoeffGroupFlag[ MLS_GRP_NUM ];
-  Int iCGLastScanPos = -1;
+  const Int iCGLastScanPos = iLastScanPos >> MLS_CG_SIZE;
 
-  UInt    uiCtxSet            = 0;
+  UInt    uiCtxSet            = getContextSetIndex(compID, iCGLastScanPos, 0);
   Int     c1                  = 1;
   Int     c2                  = 0;
   Double  d64BaseCost         = 0;
-  Int     iLastScanPos        = -1;
 
   UInt    c1Idx     = 0;
   UInt    c2Idx     = 0;
@@ -2223,132 +2502,189 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
   coeffGroupRDStats rdStats;
 
   const UInt significanceMapContextOffset = getSignificanceMapContextOffset(compID);
+  const Bool singleSigCtx                 = codingParameters.firstSignificanceMapContext == significanceMapContextSetStart[channelType][CONTEXT_TYPE_SINGLE];
+  const Bool sigCtx4x4                    = (uiLog2BlockWidth == 2) && (uiLog2BlockHeight == 2);
+  const UInt uiWidthMask                  = uiWidth - 1;
 
   for (Int iCGScanPos = uiCGNum-1; iCGScanPos >= 0; iCGScanPos--)
   {
     UInt uiCGBlkPos = codingParameters.scanCG[ iCGScanPos ];
     UInt uiCGPosY   = uiCGBlkPos / codingParameters.widthInGroups;
     UInt uiCGPosX   = uiCGBlkPos - (uiCGPosY * codingParameters.widthInGroups);
+    const Int iCGStartScanPos = iCGScanPos << MLS_CG_SIZE;
+
+    if (iCGScanPos > iCGLastScanPos)
+    {
+      // groups after the last significant coefficient contribute their uncoded distortion only
+      for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
+      {
+        const Double dCost0  = pdCostCoeff0[ codingParameters.scan[ iCGStartScanPos + iScanPosinCG ] ];
+        d64BlockUncodedCost += dCost0;
+        d64BaseCost         += dCost0;
+      }
+      continue;
+    }
+
+    if (m_useFastRDOQ && iCGScanPos > 0 && iCGScanPos < iCGLastScanPos)
+    {
+      // approximate mode: a group whose total unscaled magnitude is below two quantisation steps is coded as all-zero
+      Int64 groupLevelSum = 0;
+      for (Int iScanPosinCG = 0; iScanPosinCG < uiCGSize; iScanPosinCG++)
+      {
+        groupLevelSum += m_rdoqLevelDouble[ codingParameters.scan[ iCGStartScanPos + iScanPosinCG ] ];
+      }
+
+      if (groupLevelSum < (Int64(2) << iQBits))
+      {
+        for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
+        {
+          const UInt uiBlkPos  = codingParameters.scan[ iCGStartScanPos + iScanPosinCG ];
+          d64BlockUncodedCost += pdCostCoeff0[ uiBlkPos ];
+          d64BaseCost         += pdCostCoeff0[ uiBlkPos ];
+          piDstCoeff[ uiBlkPos ] = 0;
+        }
+
+        UInt  uiCtxSig = getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
+        pdCostCoeffGroupSig[ iCGScanPos ] = xGetRateSigCoeffGroup(0, uiCtxSig);
+        d64BaseCost += pdCostCoeffGroupSig[ iCGScanPos ];
+
+        // no levels were coded, so the context state is that of a fresh group
+        uiCtxSet = getContextSetIndex(compID, (iCGScanPos - 1), 0);
+        continue;
+      }
+    }
 
     memset( &rdStats, 0, sizeof (coeffGroupRDStats));
 
-    const Int patternSigCtx = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups);
+    const Int    patternSigCtx   = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups);
+    const UChar *sigCtxIncInCG   = s_sigCtxIncInGroup[patternSigCtx];
+    const UInt   sigCtxGroupBase = codingParameters.firstSignificanceMapContext + ((uiCGBlkPos != 0) ? notFirstGroupNeighbourhoodContextOffset[channelType] : 0);
 
     for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
     {
-      iScanPos = iCGScanPos*uiCGSize + iScanPosinCG;
-      //===== quantization =====
+      iScanPos = iCGStartScanPos + iScanPosinCG;
       UInt    uiBlkPos          = codingParameters.scan[iScanPos];
-      // set coeff
-
-      const Int    quantisationCoefficient = (enableScalingLists) ? piQCoef   [uiBlkPos] : defaultQuantisationCoefficient;
-      const Double errorScale              = (enableScalingLists) ? pdErrScale[uiBlkPos] : defaultErrorScale;
-
-      const Int64  tmpLevel                = Int64(abs(plSrcCoeff[ uiBlkPos ])) * quantisationCoefficient;
 
-      const Intermediate_Int lLevelDouble  = (Intermediate_Int)min<Int64>(tmpLevel, std::numeric_limits<Intermediate_Int>::max() - (Intermediate_Int(1) << (iQBits - 1)));
-
-#if ADAPTIVE_QP_SELECTION
-      if( m_bUseAdaptQpSelect )
+      if (iScanPos > iLastScanPos)
       {
-        piArlDstCoeff[uiBlkPos]   = (TCoeff)(( lLevelDouble + iAddC) >> iQBitsC );
+        d64BlockUncodedCost += pdCostCoeff0[ uiBlkPos ];
+        d64BaseCost         += pdCostCoeff0[ uiBlkPos ];
+        continue;
       }
-#endif
-      const UInt uiMaxAbsLevel  = std::min<UInt>(UInt(entropyCodingMaximum), UInt((lLevelDouble + (Intermediate_Int(1) << (iQBits - 1))) >> iQBits));
 
-      const Double dErr         = Double( lLevelDouble );
-      pdCostCoeff0[ iScanPos ]  = dErr * dErr * errorScale;
-      d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
-      piDstCoeff[ uiBlkPos ]    = uiMaxAbsLevel;
+      const Double           errorScale    = (enableScalingLists) ? pdErrScale[uiBlkPos] : defaultErrorScale;
+      const Intermediate_Int lLevelDouble  = m_rdoqLevelDouble[ uiBlkPos ];
+      const UInt             uiMaxAbsLevel = UInt(piDstCoeff[ uiBlkPos ]);
+
+      d64BlockUncodedCost += pdCostCoeff0[ uiBlkPos ];
+
+      //===== coefficient level estimation =====
+      UInt  uiLevel;
+      Int   candidateRate[2];
+      UInt  uiOneCtx         = (NUM_ONE_FLAG_CTX_PER_SET * uiCtxSet) + c1;
+      UInt  uiAbsCtx         = (NUM_ABS_FLAG_CTX_PER_SET * uiCtxSet) + c2;
 
-      if ( uiMaxAbsLevel > 0 && iLastScanPos < 0 )
+      if( iScanPos == iLastScanPos )
       {
-        iLastScanPos            = iScanPos;
-        uiCtxSet                = getContextSetIndex(compID, (iScanPos >> MLS_CG_SIZE), 0);
-        iCGLastScanPos          = iCGScanPos;
+        uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ uiBlkPos ], pdCostSig[ iScanPos ], candidateRate,
+                                                lLevelDouble, uiMaxAbsLevel, significanceMapContextOffset, uiOneCtx, uiAbsCtx, uiGoRiceParam,
+                                                c1Idx, c2Idx, iQBits, errorScale, 1, extendedPrecision, maxLog2TrDynamicRange
+                                                );
+        sigRateDelta[ uiBlkPos ] = 0;
       }
-
-      if ( iLastScanPos >= 0 )
+      else
       {
-        //===== coefficient level estimation =====
-        UInt  uiLevel;
-        UInt  uiOneCtx         = (NUM_ONE_FLAG_CTX_PER_SET * uiCtxSet) + c1;
-        UInt  uiAbsCtx         = (NUM_ABS_FLAG_CTX_PER_SET * uiCtxSet) + c2;
-
-        if( iScanPos == iLastScanPos )
+        UInt uiSigCtxInc;
+        if (singleSigCtx)
         {
-          uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
-                                                  lLevelDouble, uiMaxAbsLevel, significanceMapContextOffset, uiOneCtx, uiAbsCtx, uiGoRiceParam,
-                                                  c1Idx, c2Idx, iQBits, errorScale, 1, extendedPrecision, maxLog2TrDynamicRange
-                                                  );
+          uiSigCtxInc        = significanceMapContextSetStart[channelType][CONTEXT_TYPE_SINGLE];
         }
-        else
+        else if (uiBlkPos == 0)
         {
-          UShort uiCtxSig      = significanceMapContextOffset + getSigCtxInc( patternSigCtx, codingParameters, iScanPos, uiLog2BlockWidth, uiLog2BlockHeight, channelType );
-
-          uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
-                                                  lLevelDouble, uiMaxAbsLevel, uiCtxSig, uiOneCtx, uiAbsCtx, uiGoRiceParam,
-                                                  c1Idx, c2Idx, iQBits, errorScale, 0, extendedPrecision, maxLog2TrDynamicRange
-                                                  );
-
-          sigRateDelta[ uiBlkPos ] = m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 1 ] - m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 0 ];
+          uiSigCtxInc        = 0; //special case for the DC context variable
         }
-
-        deltaU[ uiBlkPos ]        = TCoeff((lLevelDouble - (Intermediate_Int(uiLevel) << iQBits)) >> (iQBits-8));
-
-        if( uiLevel > 0 )
+        else if (sigCtx4x4)
         {
-          Int rateNow = xGetICRate( uiLevel, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange );
-          rateIncUp   [ uiBlkPos ] = xGetICRate( uiLevel+1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange ) - rateNow;
-          rateIncDown [ uiBlkPos ] = xGetICRate( uiLevel-1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange ) - rateNow;
+          uiSigCtxInc        = codingParameters.firstSignificanceMapContext + ctxIndMap4x4[ uiBlkPos ];
         }
-        else // uiLevel == 0
+        else
         {
-          rateIncUp   [ uiBlkPos ] = m_pcEstBitsSbac->m_greaterOneBits[ uiOneCtx ][ 0 ];
+          const UInt uiPosY  = uiBlkPos >> uiLog2BlockWidth;
+          const UInt uiPosX  = uiBlkPos & uiWidthMask;
+          uiSigCtxInc        = sigCtxGroupBase + sigCtxIncInCG[ ((uiPosY & ((1 << MLS_CG_LOG2_HEIGHT) - 1)) << MLS_CG_LOG2_WIDTH) + (uiPosX & ((1 << MLS_CG_LOG2_WIDTH) - 1)) ];
         }
-        piDstCoeff[ uiBlkPos ] = uiLevel;
-        d64BaseCost           += pdCostCoeff [ iScanPos ];
+        UShort uiCtxSig      = significanceMapContextOffset + uiSigCtxInc;
 
-        baseLevel = (c1Idx < C1FLAG_NUMBER) ? (2 + (c2Idx < C2FLAG_NUMBER)) : 1;
-        if( uiLevel >= baseLevel )
-        {
-          if (uiLevel > 3*(1<<uiGoRiceParam))
-          {
-            uiGoRiceParam = bUseGolombRiceParameterAdaptation ? (uiGoRiceParam + 1) : (std::min<UInt>((uiGoRiceParam + 1), 4));
-          }
-        }
-        if ( uiLevel >= 1)
-        {
-          c1Idx ++;
-        }
+        uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ uiBlkPos ], pdCostSig[ iScanPos ], candidateRate,
+                                                lLevelDouble, uiMaxAbsLevel, uiCtxSig, uiOneCtx, uiAbsCtx, uiGoRiceParam,
+                                                c1Idx, c2Idx, iQBits, errorScale, 0, extendedPrecision, maxLog2TrDynamicRange
+                                                );
+
+        sigRateDelta[ uiBlkPos ] = m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 1 ] - m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 0 ];
+      }
+
+      deltaU[ uiBlkPos ]        = TCoeff((lLevelDouble - (Intermediate_Int(uiLevel) << iQBits)) >> (iQBits-8));
 
-        //===== update bin model =====
-        if( uiLevel > 1 )
+      if( uiLevel > 0 )
+      {
+        // candidateRate holds the rates of uiMaxAbsLevel and uiMaxAbsLevel-1 evaluated by xGetCodedLevel
+        if (uiLevel == uiMaxAbsLevel)
         {
-          c1 = 0;
-          c2 += (c2 < 2);
-          c2Idx ++;
+          const Int rateNow       = candidateRate[0];
+          rateIncUp   [ uiBlkPos ] = xGetICRate( uiLevel+1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange ) - rateNow;
+          rateIncDown [ uiBlkPos ] = ((uiLevel > 1) ? candidateRate[1] : 0) - rateNow;
         }
-        else if( (c1 < 3) && (c1 > 0) && uiLevel)
+        else
         {
-          c1++;
+          const Int rateNow       = candidateRate[1];
+          rateIncUp   [ uiBlkPos ] = candidateRate[0] - rateNow;
+          rateIncDown [ uiBlkPos ] = xGetICRate( uiLevel-1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange ) - rateNow;
         }
+      }
+      else // uiLevel == 0
+      {
+        rateIncUp   [ uiBlkPos ] = m_pcEstBitsSbac->m_greaterOneBits[ uiOneCtx ][ 0 ];
+        rateIncDown [ uiBlkPos ] = 0;
+      }
+      piDstCoeff[ uiBlkPos ] = uiLevel;
+      d64BaseCost           += pdCostCoeff [ iScanPos ];
 
-        //===== context set update =====
-        if( ( iScanPos % uiCGSize == 0 ) && ( iScanPos > 0 ) )
+      baseLevel = (c1Idx < C1FLAG_NUMBER) ? (2 + (c2Idx < C2FLAG_NUMBER)) : 1;
+      if( uiLevel >= baseLevel )
+      {
+        if (uiLevel > 3*(1<<uiGoRiceParam))
         {
-          uiCtxSet          = getContextSetIndex(compID, ((iScanPos - 1) >> MLS_CG_SIZE), (c1 == 0)); //(iScanPos - 1) because we do this **before** entering the final group
-          c1                = 1;
-          c2                = 0;
-          c1Idx             = 0;
-          c2Idx             = 0;
-          uiGoRiceParam     = initialGolombRiceParameter;
+          uiGoRiceParam = bUseGolombRiceParameterAdaptation ? (uiGoRiceParam + 1) : (std::min<UInt>((uiGoRiceParam + 1), 4));
         }
       }
-      else
+      if ( uiLevel >= 1)
       {
-        d64BaseCost    += pdCostCoeff0[ iScanPos ];
+        c1Idx ++;
       }
+
+      //===== update bin model =====
+      if( uiLevel > 1 )
+      {
+        c1 = 0;
+        c2 += (c2 < 2);
+        c2Idx ++;
+      }
+      else if( (c1 < 3) && (c1 > 0) && uiLevel)
+      {
+        c1++;
+      }
+
+      //===== context set update =====
+      if( ( iScanPosinCG == 0 ) && ( iScanPos > 0 ) )
+      {
+        uiCtxSet          = getContextSetIndex(compID, ((iScanPos - 1) >> MLS_CG_SIZE), (c1 == 0)); //(iScanPos - 1) because we do this **before** entering the final group
+        c1                = 1;
+        c2                = 0;
+        c1Idx             = 0;
+        c2Idx             = 0;
+        uiGoRiceParam     = initialGolombRiceParameter;
+      }
+
       rdStats.d64SigCost += pdCostSig[ iScanPos ];
       if (iScanPosinCG == 0 )
       {
@@ -2358,7 +2694,7 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
       {
         uiSigCoeffGroupFlag[ uiCGBlkPos ] = 1;
         rdStats.d64CodedLevelandDist += pdCostCoeff[ iScanPos ] - pdCostSig[ iScanPos ];
-        rdStats.d64UncodedDist += pdCostCoeff0[ iScanPos ];
+        rdStats.d64UncodedDist += pdCostCoeff0[ uiBlkPos ];
         if ( iScanPosinCG != 0 )
         {
           rdStats.iNNZbeforePos0++;
@@ -2366,82 +2702,74 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
       }
     } //end for (iScanPosinCG)
 
-    if (iCGLastScanPos >= 0)
+    if( iCGScanPos )
     {
-      if( iCGScanPos )
+      if (uiSigCoeffGroupFlag[ uiCGBlkPos ] == 0)
+      {
+        UInt  uiCtxSig = getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
+        d64BaseCost += xGetRateSigCoeffGroup(0, uiCtxSig) - rdStats.d64SigCost;;
+        pdCostCoeffGroupSig[ iCGScanPos ] = xGetRateSigCoeffGroup(0, uiCtxSig);
+      }
+      else
       {
-        if (uiSigCoeffGroupFlag[ uiCGBlkPos ] == 0)
+        if (iCGScanPos < iCGLastScanPos) //skip the last coefficient group, which will be handled together with last position below.
         {
+          if ( rdStats.iNNZbeforePos0 == 0 )
+          {
+            d64BaseCost -= rdStats.d64SigCost_0;
+            rdStats.d64SigCost -= rdStats.d64SigCost_0;
+          }
+          // rd-cost if SigCoeffGroupFlag = 0, initialization
+          Double d64CostZeroCG = d64BaseCost;
+
+          // add SigCoeffGroupFlag cost to total cost
           UInt  uiCtxSig = getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
-          d64BaseCost += xGetRateSigCoeffGroup(0, uiCtxSig) - rdStats.d64SigCost;;
-          pdCostCoeffGroupSig[ iCGScanPos ] = xGetRateSigCoeffGroup(0, uiCtxSig);
-        }
-        else
-        {
-          if (iCGScanPos < iCGLastScanPos) //skip the last coefficient group, which will be handled together with last position below.
+
+          if (iCGScanPos < iCGLastScanPos)
           {
-            if ( rdStats.iNNZbeforePos0 == 0 )
-            {
-              d64BaseCost -= rdStats.d64SigCost_0;
-              rdStats.d64SigCost -= rdStats.d64SigCost_0;
-            }
-            // rd-cost if SigCoeffGroupFlag = 0, initialization
-            Double d64CostZeroCG = d64BaseCost;
+            d64BaseCost  += xGetRateSigCoeffGroup(1, uiCtxSig);
+            d64CostZeroCG += xGetRateSigCoeffGroup(0, uiCtxSig);
+            pdCostCoeffGroupSig[ iCGScanPos ] = xGetRateSigCoeffGroup(1, uiCtxSig);
+          }
 
-            // add SigCoeffGroupFlag cost to total cost
-            UInt  uiCtxSig = getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
+          // try to convert the current coeff group from non-zero to all-zero
+          d64CostZeroCG += rdStats.d64UncodedDist;  // distortion for resetting non-zero levels to zero levels
+          d64CostZeroCG -= rdStats.d64CodedLevelandDist;   // distortion and level cost for keeping all non-zero levels
+          d64CostZeroCG -= rdStats.d64SigCost;     // sig cost for all coeffs, including zero levels and non-zerl levels
 
+          // if we can save cost, change this block to all-zero block
+          if ( d64CostZeroCG < d64BaseCost )
+          {
+            uiSigCoeffGroupFlag[ uiCGBlkPos ] = 0;
+            d64BaseCost = d64CostZeroCG;
             if (iCGScanPos < iCGLastScanPos)
             {
-              d64BaseCost  += xGetRateSigCoeffGroup(1, uiCtxSig);
-              d64CostZeroCG += xGetRateSigCoeffGroup(0, uiCtxSig);
-              pdCostCoeffGroupSig[ iCGScanPos ] = xGetRateSigCoeffGroup(1, uiCtxSig);
+              pdCostCoeffGroupSig[ iCGScanPos ] = xGetRateSigCoeffGroup(0, uiCtxSig);
             }
-
-            // try to convert the current coeff group from non-zero to all-zero
-            d64CostZeroCG += rdStats.d64UncodedDist;  // distortion for resetting non-zero levels to zero levels
-            d64CostZeroCG -= rdStats.d64CodedLevelandDist;   // distortion and level cost for keeping all non-zero levels
-            d64CostZeroCG -= rdStats.d64SigCost;     // sig cost for all coeffs, including zero levels and non-zerl levels
-
-            // if we can save cost, change this block to all-zero block
-            if ( d64CostZeroCG < d64BaseCost )
+            // reset coeffs to 0 in this block
+            for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
             {
-              uiSigCoeffGroupFlag[ uiCGBlkPos ] = 0;
-              d64BaseCost = d64CostZeroCG;
-              if (iCGScanPos < iCGLastScanPos)
-              {
-                pdCostCoeffGroupSig[ iCGScanPos ] = xGetRateSigCoeffGroup(0, uiCtxSig);
-              }
-              // reset coeffs to 0 in this block
-              for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
-              {
-                iScanPos      = iCGScanPos*uiCGSize + iScanPosinCG;
-                UInt uiBlkPos = codingParameters.scan[ iScanPos ];
+              iScanPos      = iCGScanPos*uiCGSize + iScanPosinCG;
+              UInt uiBlkPos = codingParameters.scan[ iScanPos ];
 
-                if (piDstCoeff[ uiBlkPos ])
-                {
-                  piDstCoeff [ uiBlkPos ] = 0;
-                  pdCostCoeff[ iScanPos ] = pdCostCoeff0[ iScanPos ];
-                  pdCostSig  [ iScanPos ] = 0;
-                }
+              if (piDstCoeff[ uiBlkPos ])
+              {
+                piDstCoeff [ uiBlkPos ] = 0;
+                pdCostCoeff[ iScanPos ] = pdCostCoeff0[ uiBlkPos ];
+                pdCostSig  [ iScanPos ] = 0;
               }
-            } // end if ( d64CostAllZeros < d64BaseCost )
-          }
-        } // end if if (uiSigCoeffGroupFlag[ uiCGBlkPos ] == 0)
-      }
-      else
-      {
-        uiSigCoeffGroupFlag[ uiCGBlkPos ] = 1;
-      }
+            }
+          } // end if ( d64CostAllZeros < d64BaseCost )
+        }
+      } // end if if (uiSigCoeffGroupFlag[ uiCGBlkPos ] == 0)
+    }
+    else
+    {
+      uiSigCoeffGroupFlag[ uiCGBlkPos ] = 1;
     }
   } //end for (iCGScanPos)
 
   //===== estimate last position =====
-  if ( iLastScanPos < 0 )
-  {
-    return;
-  }
-
   Double  d64BestCost         = 0;
   Int     ui16CtxCbf          = 0;
   Int     iBestLastIdxP1      = 0;
@@ -2497,7 +2825,7 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
             break;
           }
           d64BaseCost      -= pdCostCoeff[ iScanPos ];
-          d64BaseCost      += pdCostCoeff0[ iScanPos ];
+          d64BaseCost      += pdCostCoeff0[ uiBlkPos ];
         }
         else
         {
@@ -2812,6 +3140,7 @@ Int TComTrQuant::getSigCtxInc    (       Int                        patternSigCt
 __inline UInt TComTrQuant::xGetCodedLevel ( Double&          rd64CodedCost,          //< reference to coded cost
                                             Double&          rd64CodedCost0,         //< reference to cost when coefficient is 0
                                             Double&          rd64CodedCostSig,       //< rd64CodedCostSig reference to cost of significant coefficient
+                                            Int*             piCandidateRate,        //< receives the rates of uiMaxAbsLevel and uiMaxAbsLevel-1
                                             Intermediate_Int lLevelDouble,           //< reference to unscaled quantized level
                                             UInt             uiMaxAbsLevel,          //< scaled quantized level
                                             UShort           ui16CtxNumSig,          //< current ctxInc for coeff_abs_significant_flag
@@ -2849,11 +3178,25 @@ __inline UInt TComTrQuant::xGetCodedLevel ( Double&          rd64CodedCost,
     dCurrCostSig        = xGetRateSigCoef( 1, ui16CtxNumSig );
   }
 
+  // distortion of the two level candidates uiMaxAbsLevel and uiMaxAbsLevel-1
+  Double dCandidateDist[2];
+#if QUANT_SIMD
+  const __m128d dErr    = _mm_cvtepi32_pd(_mm_setr_epi32(lLevelDouble - (Intermediate_Int(uiMaxAbsLevel) << iQBits), lLevelDouble - (Intermediate_Int(uiMaxAbsLevel - 1) << iQBits), 0, 0));
+  _mm_storeu_pd(dCandidateDist, _mm_mul_pd(_mm_mul_pd(dErr, dErr), _mm_set1_pd(errorScale)));
+#else
+  for (Int i = 0; i < 2; i++)
+  {
+    const Double dErr   = Double( lLevelDouble - ( Intermediate_Int(uiMaxAbsLevel - i) << iQBits ) );
+    dCandidateDist[i]   = dErr * dErr * errorScale;
+  }
+#endif
+
   UInt uiMinAbsLevel    = ( uiMaxAbsLevel > 1 ? uiMaxAbsLevel - 1 : 1 );
   for( Int uiAbsLevel  = uiMaxAbsLevel; uiAbsLevel >= uiMinAbsLevel ; uiAbsLevel-- )
   {
-    Double dErr         = Double( lLevelDouble  - ( Intermediate_Int(uiAbsLevel) << iQBits ) );
-    Double dCurrCost    = dErr * dErr * errorScale + xGetICost( xGetICRate( uiAbsLevel, ui16CtxNumOne, ui16CtxNumAbs, ui16AbsGoRice, c1Idx, c2Idx, useLimitedPrefixLength, maxLog2TrDynamicRange ) );
+    const Int iRate     = xGetICRate( uiAbsLevel, ui16CtxNumOne, ui16CtxNumAbs, ui16AbsGoRice, c1Idx, c2Idx, useLimitedPrefixLength, maxLog2TrDynamicRange );
+    piCandidateRate[uiMaxAbsLevel - uiAbsLevel] = iRate;
+    Double dCurrCost    = dCandidateDist[uiMaxAbsLevel - uiAbsLevel] + xGetICost( iRate );
     dCurrCost          += dCurrCostSig;
 
     if( dCurrCost < rd64CodedCost )
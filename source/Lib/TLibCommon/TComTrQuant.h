@@ -72,6 +72,14 @@ typedef struct
   Int golombRiceAdaptationStatistics[RExt__GOLOMB_RICE_ADAPTATION_STATISTICS_SETS];
 } estBitsSbacStruct;
 
+// ====================================================================================================================
+// Function declarations
+// ====================================================================================================================
+
+/// 2D forward and inverse core transforms of a iWidth x iHeight block (DST for 4x4 luma intra when useDST is set)
+Void xTrMxN ( Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange );
+Void xITrMxN( Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange );
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -106,6 +114,7 @@ public:
                               Bool useRDOQ                = false,
                               Bool useRDOQTS              = false,
                               Bool useSelectiveRDOQ       = false,
+                              Bool useFastRDOQ            = false,
                               Bool bEnc                   = false,
                               Bool useTransformSkipFast   = false
 #if ADAPTIVE_QP_SELECTION
@@ -146,9 +155,11 @@ public:
 
 #if RDOQ_CHROMA_LAMBDA
   Void setLambdas(const Double lambdas[MAX_NUM_COMPONENT]) { for (UInt component = 0; component < MAX_NUM_COMPONENT; component++) m_lambdas[component] = lambdas[component]; }
+  const Double* getLambdas() const { return m_lambdas; }
   Void selectLambda(const ComponentID compIdx) { m_dLambda = m_lambdas[compIdx]; }
 #else
   Void setLambda(Double dLambda) { m_dLambda = dLambda;}
+  Double getLambda() const { return m_dLambda; }
 #endif
   Void setRDOQOffset( UInt uiRDOQOffset ) { m_uiRDOQOffset = uiRDOQOffset; }
 
@@ -206,6 +217,16 @@ protected:
 #endif
   TCoeff* m_plTempCoeff;
 
+  // RDOQ scratch buffers, indexed by raster position (levels, costs) or scan position (coded costs)
+  Intermediate_Int *m_rdoqLevelDouble;
+  Double           *m_rdoqCostCoeff0;
+  Double           *m_rdoqCostCoeff;
+  Double           *m_rdoqCostSig;
+  Int              *m_rdoqRateIncUp;
+  Int              *m_rdoqRateIncDown;
+  Int              *m_rdoqSigRateDelta;
+  TCoeff           *m_rdoqDeltaU;
+
 //  QpParam  m_cQP; - removed - placed on the stack.
 #if RDOQ_CHROMA_LAMBDA
   Double   m_lambdas[MAX_NUM_COMPONENT];
@@ -217,6 +238,7 @@ protected:
   Bool     m_useRDOQ;
   Bool     m_useRDOQTS;
   Bool     m_useSelectiveRDOQ;
+  Bool     m_useFastRDOQ;
 #if ADAPTIVE_QP_SELECTION
   Bool     m_bUseAdaptQpSelect;
 #endif
@@ -266,9 +288,24 @@ private:
                                      const ComponentID   compID,
                                      const QpParam      &cQP );
 
+  Void           xRdoqPreQuant     ( const TCoeff      * plSrcCoeff,
+                                           TCoeff      * piDstCoeff,
+#if ADAPTIVE_QP_SELECTION
+                                           TCoeff      * piArlDstCoeff,
+#endif
+                                     const UInt          uiMaxNumCoeff,
+                                     const Int         * piQCoef,
+                                     const Double      * pdErrScale,
+                                     const Int           defaultQuantisationCoefficient,
+                                     const Double        defaultErrorScale,
+                                     const Bool          enableScalingLists,
+                                     const Int           iQBits,
+                                     const TCoeff        entropyCodingMaximum ) const;
+
 __inline UInt              xGetCodedLevel  ( Double&          rd64CodedCost,
                                              Double&          rd64CodedCost0,
                                              Double&          rd64CodedCostSig,
+                                             Int*             piCandidateRate,
                                              Intermediate_Int lLevelDouble,
                                              UInt             uiMaxAbsLevel,
                                              UShort           ui16CtxNumSig,
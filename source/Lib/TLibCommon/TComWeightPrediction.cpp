@@ -41,6 +41,7 @@
 #include "TComPic.h"
 #include "TComInterpolationFilter.h"
 #include "TComWeightPrediction.h"
+#include "TComPelSIMD.h"
 
 
 static inline Pel weightBidir( Int w0, Pel P0, Int w1, Pel P1, Int round, Int shift, Int offset, Int clipBD)
@@ -64,6 +65,86 @@ static inline Pel noWeightOffsetUnidir( Pel P0, Int round, Int shift, Int clipBD
   return ClipBD( ( ((P0 + IF_INTERNAL_OFFS) + round) >> shift ), clipBD );
 }
 
+#if PEL_SIMD
+/** weightBidir() over a block. The IF_INTERNAL_OFFS terms, the rounding and the offset are folded
+ *  into the single constant addend = (w0 + w1) * IF_INTERNAL_OFFS + round + (offset << (shift-1)).
+ */
+template<Int W>
+static Void weightBidirSIMD( const Pel* pSrc0, const Int iSrc0Stride, const Pel* pSrc1, const Int iSrc1Stride,
+                             Pel* pDst, const Int iDstStride, const Int iHeight,
+                             const Int w0, const Int w1, const Int addend, const Int shift, const Int clipBD )
+{
+  const __m128i vmax    = setPelVec( (1 << clipBD) - 1 );
+  const __m128i vaddend = _mm_set1_epi32( addend );
+  const __m128i vshift  = _mm_cvtsi32_si128( shift );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  const __m128i vw0     = _mm_set1_epi32( w0 );
+  const __m128i vw1     = _mm_set1_epi32( w1 );
+#else
+  // weights are in the range [-128, 255], so (P0, P1) pairs can be weighted with one multiply-add
+  const __m128i vw      = _mm_unpacklo_epi16( _mm_set1_epi16( Short(w0) ), _mm_set1_epi16( Short(w1) ) );
+#endif
+  for( Int y = 0; y < iHeight; y++ )
+  {
+    for( Int x = 0; x < W; x += PEL_VEC )
+    {
+      const __m128i a = loadPelVec<W>( pSrc0 + x );
+      const __m128i b = loadPelVec<W>( pSrc1 + x );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      const __m128i sum = _mm_add_epi32( _mm_add_epi32( _mm_mullo_epi32( a, vw0 ), _mm_mullo_epi32( b, vw1 ) ), vaddend );
+      storePelVec<W>( pDst + x, clipPelVec( _mm_sra_epi32( sum, vshift ), vmax ) );
+#else
+      const __m128i sumLo = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), vw ), vaddend ), vshift );
+      const __m128i sumHi = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( a, b ), vw ), vaddend ), vshift );
+      storePelVec<W>( pDst + x, clipPelVec( _mm_packs_epi32( sumLo, sumHi ), vmax ) );
+#endif
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+/** weightUnidir() over a block, with addend = w0 * IF_INTERNAL_OFFS + round. The unweighted cases
+ *  are the same computation with w0 = 1.
+ */
+template<Int W>
+static Void weightUnidirSIMD( const Pel* pSrc0, const Int iSrc0Stride, Pel* pDst, const Int iDstStride, const Int iHeight,
+                              const Int w0, const Int addend, const Int shift, const Int offset, const Int clipBD )
+{
+  const __m128i vmax    = setPelVec( (1 << clipBD) - 1 );
+  const __m128i vw0     = _mm_set1_epi32( w0 );
+  const __m128i vaddend = _mm_set1_epi32( addend );
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vshift  = _mm_cvtsi32_si128( shift );
+  for( Int y = 0; y < iHeight; y++ )
+  {
+    for( Int x = 0; x < W; x += PEL_VEC )
+    {
+      const __m128i a = loadPelVec<W>( pSrc0 + x );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      const __m128i val = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( _mm_mullo_epi32( a, vw0 ), vaddend ), vshift ), voffset );
+      storePelVec<W>( pDst + x, clipPelVec( val, vmax ) );
+#else
+      const __m128i lo    = _mm_cvtepi16_epi32( a );
+      const __m128i hi    = _mm_cvtepi16_epi32( _mm_srli_si128( a, 8 ) );
+      const __m128i valLo = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( _mm_mullo_epi32( lo, vw0 ), vaddend ), vshift ), voffset );
+      const __m128i valHi = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( _mm_mullo_epi32( hi, vw0 ), vaddend ), vshift ), voffset );
+      storePelVec<W>( pDst + x, clipPelVec( _mm_packs_epi32( valLo, valHi ), vmax ) );
+#endif
+    }
+    pSrc0 += iSrc0Stride;
+    pDst  += iDstStride;
+  }
+}
+
+typedef Void (*WeightBidirFn)  ( const Pel*, const Int, const Pel*, const Int, Pel*, const Int, const Int, const Int, const Int, const Int, const Int, const Int );
+typedef Void (*WeightUnidirFn) ( const Pel*, const Int, Pel*, const Int, const Int, const Int, const Int, const Int, const Int, const Int );
+
+static const WeightBidirFn  s_weightBidirSIMD[5]  = { weightBidirSIMD<4>,  weightBidirSIMD<8>,  weightBidirSIMD<16>,  weightBidirSIMD<32>,  weightBidirSIMD<64>  };
+static const WeightUnidirFn s_weightUnidirSIMD[5] = { weightUnidirSIMD<4>, weightUnidirSIMD<8>, weightUnidirSIMD<16>, weightUnidirSIMD<32>, weightUnidirSIMD<64> };
+#endif
+
 
 // ====================================================================================================================
 // Class definition
@@ -116,6 +197,16 @@ Void TComWeightPrediction::addWeightBi( const TComYuv              *pcYuvSrc0,
     const UInt iSrc1Stride = pcYuvSrc1->getStride(compID);
     const UInt iDstStride  = rpcYuvDst->getStride(compID);
 
+#if PEL_SIMD
+    const Int simdIdx = getSIMDWidthIdx( iWidth );
+    if( simdIdx >= 0 )
+    {
+      const Int addend = (w0 + w1) * IF_INTERNAL_OFFS + round + (offset << (shift-1));
+      s_weightBidirSIMD[simdIdx]( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iHeight, w0, w1, addend, shift, clipBD );
+      continue;
+    }
+#endif
+
     for ( Int y = iHeight-1; y >= 0; y-- )
     {
       // do it in batches of 4 (partial unroll)
@@ -171,6 +262,24 @@ Void TComWeightPrediction::addWeightUni( const TComYuv        *const pcYuvSrc0,
     const Int  iHeight     = uiHeight>>csy;
     const Int  iWidth      = uiWidth>>csx;
 
+#if PEL_SIMD
+    const Int simdIdx = getSIMDWidthIdx( iWidth );
+    if( simdIdx >= 0 )
+    {
+      if (w0 != 1 << wp0[compID].shift)
+      {
+        const Int round = (shift > 0) ? (1<<(shift-1)) : 0;
+        s_weightUnidirSIMD[simdIdx]( pSrc0, iSrc0Stride, pDst, iDstStride, iHeight, w0, w0 * IF_INTERNAL_OFFS + round, shift, offset, clipBD );
+      }
+      else
+      {
+        const Int round = (shiftNum > 0) ? (1<<(shiftNum-1)) : 0;
+        s_weightUnidirSIMD[simdIdx]( pSrc0, iSrc0Stride, pDst, iDstStride, iHeight, 1, IF_INTERNAL_OFFS + round, shiftNum, offset, clipBD );
+      }
+      continue;
+    }
+#endif
+
     if (w0 != 1 << wp0[compID].shift)
     {
       const Int  round       = (shift > 0) ? (1<<(shift-1)) : 0;
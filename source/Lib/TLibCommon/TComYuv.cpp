@@ -44,10 +44,102 @@
 #include "CommonDef.h"
 #include "TComYuv.h"
 #include "TComInterpolationFilter.h"
+#include "TComPelSIMD.h"
 
 //! \ingroup TLibCommon
 //! \{
 
+#if PEL_SIMD
+/** pDst = clip(pSrc0 + pSrc1). In the 16-bit build the saturating add gives the same result as the
+ *  exact sum, as the clipping range lies well inside the Short range.
+ */
+template<Int W>
+static Void addClipSIMD( const Pel* pSrc0, const Int iSrc0Stride, const Pel* pSrc1, const Int iSrc1Stride,
+                         Pel* pDst, const Int iDstStride, const Int iHeight, const Int clipbd )
+{
+  const __m128i vmax = setPelVec( (1 << clipbd) - 1 );
+  for( Int y = 0; y < iHeight; y++ )
+  {
+    for( Int x = 0; x < W; x += PEL_VEC )
+    {
+      const __m128i a = loadPelVec<W>( pSrc0 + x );
+      const __m128i b = loadPelVec<W>( pSrc1 + x );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      storePelVec<W>( pDst + x, clipPelVec( _mm_add_epi32( a, b ), vmax ) );
+#else
+      storePelVec<W>( pDst + x, clipPelVec( _mm_adds_epi16( a, b ), vmax ) );
+#endif
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+template<Int W>
+static Void subtractSIMD( const Pel* pSrc0, const Int iSrc0Stride, const Pel* pSrc1, const Int iSrc1Stride,
+                          Pel* pDst, const Int iDstStride, const Int iHeight )
+{
+  for( Int y = 0; y < iHeight; y++ )
+  {
+    for( Int x = 0; x < W; x += PEL_VEC )
+    {
+      const __m128i a = loadPelVec<W>( pSrc0 + x );
+      const __m128i b = loadPelVec<W>( pSrc1 + x );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      storePelVec<W>( pDst + x, _mm_sub_epi32( a, b ) );
+#else
+      storePelVec<W>( pDst + x, _mm_sub_epi16( a, b ) );
+#endif
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+/** pDst = clip((pSrc0 + pSrc1 + offset) >> shiftNum), with the sum formed in 32-bit lanes.
+ */
+template<Int W>
+static Void addAvgSIMD( const Pel* pSrc0, const Int iSrc0Stride, const Pel* pSrc1, const Int iSrc1Stride,
+                        Pel* pDst, const Int iDstStride, const Int iHeight, const Int offset, const Int shiftNum, const Int clipbd )
+{
+  const __m128i vmax    = setPelVec( (1 << clipbd) - 1 );
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vshift  = _mm_cvtsi32_si128( shiftNum );
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  const __m128i one     = _mm_set1_epi16( 1 );
+#endif
+  for( Int y = 0; y < iHeight; y++ )
+  {
+    for( Int x = 0; x < W; x += PEL_VEC )
+    {
+      const __m128i a = loadPelVec<W>( pSrc0 + x );
+      const __m128i b = loadPelVec<W>( pSrc1 + x );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      const __m128i sum = _mm_sra_epi32( _mm_add_epi32( _mm_add_epi32( a, b ), voffset ), vshift );
+      storePelVec<W>( pDst + x, clipPelVec( sum, vmax ) );
+#else
+      const __m128i sumLo = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), one ), voffset ), vshift );
+      const __m128i sumHi = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( a, b ), one ), voffset ), vshift );
+      storePelVec<W>( pDst + x, clipPelVec( _mm_packs_epi32( sumLo, sumHi ), vmax ) );
+#endif
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+typedef Void (*AddClipFn)  ( const Pel*, const Int, const Pel*, const Int, Pel*, const Int, const Int, const Int );
+typedef Void (*SubtractFn) ( const Pel*, const Int, const Pel*, const Int, Pel*, const Int, const Int );
+typedef Void (*AddAvgFn)   ( const Pel*, const Int, const Pel*, const Int, Pel*, const Int, const Int, const Int, const Int, const Int );
+
+static const AddClipFn  s_addClipSIMD[5]  = { addClipSIMD<4>,  addClipSIMD<8>,  addClipSIMD<16>,  addClipSIMD<32>,  addClipSIMD<64>  };
+static const SubtractFn s_subtractSIMD[5] = { subtractSIMD<4>, subtractSIMD<8>, subtractSIMD<16>, subtractSIMD<32>, subtractSIMD<64> };
+static const AddAvgFn   s_addAvgSIMD[5]   = { addAvgSIMD<4>,   addAvgSIMD<8>,   addAvgSIMD<16>,   addAvgSIMD<32>,   addAvgSIMD<64>   };
+#endif
+
 TComYuv::TComYuv()
 {
   for(Int comp=0; comp<MAX_NUM_COMPONENT; comp++)
@@ -299,6 +391,15 @@ Void TComYuv::addClip( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const
     const Int bitDepthDelta = clipBitDepths.stream[toChannelType(compID)] - clipbd;
 #endif
 
+#if PEL_SIMD && !O0043_BEST_EFFORT_DECODING
+    const Int simdIdx = getSIMDWidthIdx( uiPartWidth );
+    if( simdIdx >= 0 )
+    {
+      s_addClipSIMD[simdIdx]( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, uiPartHeight, clipbd );
+      continue;
+    }
+#endif
+
     for ( Int y = uiPartHeight-1; y >= 0; y-- )
     {
       for ( Int x = uiPartWidth-1; x >= 0; x-- )
@@ -335,6 +436,15 @@ Void TComYuv::subtract( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, cons
     const Int  iSrc1Stride = pcYuvSrc1->getStride(compID);
     const Int  iDstStride  = getStride(compID);
 
+#if PEL_SIMD
+    const Int simdIdx = getSIMDWidthIdx( uiPartWidth );
+    if( simdIdx >= 0 )
+    {
+      s_subtractSIMD[simdIdx]( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, uiPartHeight );
+      continue;
+    }
+#endif
+
     for (Int y = uiPartHeight-1; y >= 0; y-- )
     {
       for (Int x = uiPartWidth-1; x >= 0; x-- )
@@ -370,6 +480,15 @@ Void TComYuv::addAvg( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const
     const Int   iWidth      = uiWidth  >> getComponentScaleX(compID);
     const Int   iHeight     = uiHeight >> getComponentScaleY(compID);
 
+#if PEL_SIMD
+    const Int simdIdx = getSIMDWidthIdx( iWidth );
+    if( simdIdx >= 0 )
+    {
+      s_addAvgSIMD[simdIdx]( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iHeight, offset, shiftNum, clipbd );
+      continue;
+    }
+#endif
+
     if (iWidth&1)
     {
       assert(0);
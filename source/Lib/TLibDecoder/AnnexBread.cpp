@@ -38,6 +38,7 @@
 
 
 #include <stdint.h>
+#include <string.h>
 #include <cassert>
 #include <vector>
 #include "AnnexBread.h"
@@ -196,4 +197,111 @@ byteStreamNALUnit(
   stats.m_numBytesInNALUnit = UInt(nalUnit.size());
   return eof;
 }
+
+AnnexBNALUnitReader::AnnexBNALUnitReader(std::istream& istream, size_t chunkSize)
+: m_input(istream)
+, m_buffer(chunkSize)
+, m_begin(0)
+, m_end(0)
+, m_eof(false)
+{
+}
+
+Bool AnnexBNALUnitReader::xFill(size_t numBytes)
+{
+  while (m_end - m_begin < numBytes && !m_eof)
+  {
+    if (m_begin > 0)
+    {
+      memmove(&m_buffer[0], &m_buffer[m_begin], m_end - m_begin);
+      m_end  -= m_begin;
+      m_begin = 0;
+    }
+    if (m_end == m_buffer.size())
+    {
+      m_buffer.resize(2 * m_buffer.size());
+    }
+    m_input.read(reinterpret_cast<char*>(&m_buffer[m_end]), std::streamsize(m_buffer.size() - m_end));
+    m_end += size_t(m_input.gcount());
+    if (!m_input)
+    {
+      m_eof = true;
+    }
+  }
+  return m_end - m_begin >= numBytes;
+}
+
+Bool AnnexBNALUnitReader::readNALUnit(const uint8_t*& nalUnit, size_t& numBytes, AnnexBStats& stats)
+{
+  nalUnit  = NULL;
+  numBytes = 0;
+
+  // leading_zero_8bits, zero_byte and start_code_prefix_one_3bytes
+  size_t pos   = 0;
+  size_t zeros = 0;
+  for (;;)
+  {
+    if (!xFill(pos + 1))
+    {
+      stats.m_numLeadingZero8BitsBytes += UInt(pos);
+      m_begin = m_end;
+      return false;
+    }
+    const uint8_t byte = m_buffer[m_begin + pos++];
+    if (byte == 1 && zeros >= 2)
+    {
+      break;
+    }
+    zeros = (byte == 0) ? zeros + 1 : 0;
+  }
+  const size_t numZeroByteBytes = (zeros >= 3) ? 1 : 0;
+  stats.m_numLeadingZero8BitsBytes += UInt(pos - 3 - numZeroByteBytes);
+  stats.m_numZeroByteBytes         += UInt(numZeroByteBytes);
+  stats.m_numStartCodePrefixBytes  += 3;
+
+  // the NAL unit ends before the next 0x000000, 0x000001 or 0x000002, or at the end of the byte stream
+  const size_t start = pos;
+  size_t       end   = 0;
+  for (;;)
+  {
+    if (!xFill(pos + 3))
+    {
+      end = m_end - m_begin;
+      break;
+    }
+    const uint8_t* data    = &m_buffer[m_begin];
+    const size_t   avail   = m_end - m_begin;
+    const uint8_t* zeroPos = static_cast<const uint8_t*>(memchr(data + pos, 0, avail - 2 - pos));
+    if (zeroPos == NULL)
+    {
+      pos = avail - 2;
+      continue;
+    }
+    pos = zeroPos - data;
+    if (data[pos + 1] == 0 && data[pos + 2] <= 2)
+    {
+      end = pos;
+      break;
+    }
+    pos++;
+  }
+
+  // trailing_zero_8bits: leave the zero_byte and start code of the next NAL unit in the buffer
+  size_t trailing = 0;
+  while (xFill(end + trailing + 1) && m_buffer[m_begin + end + trailing] == 0)
+  {
+    trailing++;
+  }
+  if (xFill(end + trailing + 1) && m_buffer[m_begin + end + trailing] == 1)
+  {
+    trailing = (trailing >= 3) ? trailing - 3 : 0;
+  }
+  stats.m_numTrailingZero8BitsBytes += UInt(trailing);
+
+  numBytes = end - start;
+  nalUnit  = &m_buffer[m_begin + start];
+  stats.m_numBytesInNALUnit = UInt(numBytes);
+  m_begin += end + trailing;
+  return true;
+}
 //! \}
@@ -194,6 +194,38 @@ struct AnnexBStats
 
 Bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
 
+/**
+ * Chunked Annex B reader for tools that only inspect NAL unit headers.
+ *
+ * NAL units are located with a block-wise start code search and returned
+ * as spans into an internal buffer, so the payload is never copied byte by
+ * byte.  The NAL unit boundaries and the AnnexBStats are the same as those
+ * produced by byteStreamNALUnit().
+ */
+class AnnexBNALUnitReader
+{
+public:
+  AnnexBNALUnitReader(std::istream& istream, size_t chunkSize = (1 << 22));
+
+  /**
+   * Locate the next NAL unit.  On success, nalUnit points to its first byte
+   * (the NAL unit header) and stays valid until the next call.
+   *
+   * Returns false if the end of the byte stream was reached before another
+   * start code prefix was found.
+   */
+  Bool readNALUnit(const uint8_t*& nalUnit, size_t& numBytes, AnnexBStats& stats);
+
+private:
+  Bool xFill(size_t numBytes); ///< make numBytes bytes available from m_begin, returns false at EOF
+
+  std::istream&        m_input;
+  std::vector<uint8_t> m_buffer;
+  size_t               m_begin; ///< first unconsumed byte in m_buffer
+  size_t               m_end;   ///< end of valid data in m_buffer
+  Bool                 m_eof;
+};
+
 //! \}
 
 #endif
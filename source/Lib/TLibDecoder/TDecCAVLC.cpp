@@ -91,6 +91,10 @@ Void  xTraceSliceHeader()
 // ====================================================================================================================
 
 TDecCavlc::TDecCavlc()
+#if MCTS_EXTRACTION
+: m_sliceHeaderBodyStartBit(0)
+, m_sliceHeaderBodyEndBit(0)
+#endif
 {
 }
 
@@ -1051,12 +1055,18 @@ Void TDecCavlc::parseSliceHeader (TComSlice* pcSlice, ParameterSetManager *param
     pcSlice->setSliceCurEndCtuTsAddr(numCTUs);
   }
 
+#if MCTS_EXTRACTION
+  m_sliceHeaderBodyStartBit = m_pcBitstream->getNumBitsRead();
+#endif
   if(!pcSlice->getDependentSliceSegmentFlag())
   {
     for (Int i = 0; i < pps->getNumExtraSliceHeaderBits(); i++)
     {
       READ_FLAG(uiCode, "slice_reserved_flag[]"); // ignored
     }
+#if MCTS_EXTRACTION
+    m_sliceHeaderBodyStartBit = m_pcBitstream->getNumBitsRead();
+#endif
 
     READ_UVLC (    uiCode, "slice_type" );            pcSlice->setSliceType((SliceType)uiCode);
     if( pps->getOutputFlagPresentFlag() )
@@ -1514,6 +1524,9 @@ Void TDecCavlc::parseSliceHeader (TComSlice* pcSlice, ParameterSetManager *param
 
   }
 
+#if MCTS_EXTRACTION
+  m_sliceHeaderBodyEndBit = m_pcBitstream->getNumBitsRead();
+#endif
   std::vector<UInt> entryPointOffset;
   if( pps->getTilesEnabledFlag() || pps->getEntropyCodingSyncEnabledFlag() )
   {
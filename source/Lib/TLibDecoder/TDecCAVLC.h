@@ -117,8 +117,18 @@ public:
 
   Void  parseExplicitRdpcmMode( TComTU &rTu, ComponentID compID );
 
+#if MCTS_EXTRACTION
+  UInt  getSliceHeaderBodyStartBit() const { return m_sliceHeaderBodyStartBit; } ///< bit position of slice_type in the last parsed slice segment header (end of slice_segment_address for dependent slice segments)
+  UInt  getSliceHeaderBodyEndBit() const   { return m_sliceHeaderBodyEndBit;   } ///< bit position of num_entry_point_offsets (or the header extension) in the last parsed slice segment header
+#endif
+
 protected:
   Bool  xMoreRbspData();
+
+#if MCTS_EXTRACTION
+  UInt  m_sliceHeaderBodyStartBit;
+  UInt  m_sliceHeaderBodyEndBit;
+#endif
 };
 
 //! \}
@@ -38,6 +38,7 @@
 #include "TDecCu.h"
 #include "TLibCommon/TComTU.h"
 #include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComProfiler.h"
 
 //! \ingroup TLibDecoder
 //! \{
@@ -141,6 +142,8 @@ Void TDecCu::destroy()
  */
 Void TDecCu::decodeCtu( TComDataCU* pCtu, Bool& isLastCtuOfSliceSegment )
 {
+  PROFILE_SCOPE( PROF_DEC_PARSE );
+  PROFILE_COUNT( PROF_COUNTER_DEC_CTUS, 1 );
   if ( pCtu->getSlice()->getPPS()->getUseDQP() )
   {
     setdQPFlag(true);
@@ -161,6 +164,7 @@ Void TDecCu::decodeCtu( TComDataCU* pCtu, Bool& isLastCtuOfSliceSegment )
  */
 Void TDecCu::decompressCtu( TComDataCU* pCtu )
 {
+  PROFILE_SCOPE( PROF_DEC_RECONSTRUCT );
   xDecompressCU( pCtu, 0,  0 );
 }
 
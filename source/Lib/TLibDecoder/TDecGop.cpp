@@ -42,18 +42,21 @@
 #include "TDecBinCoderCABAC.h"
 #include "libmd5/MD5.h"
 #include "TLibCommon/SEI.h"
+#include "TLibCommon/TComProfiler.h"
 
 #include <time.h>
 
 //! \ingroup TLibDecoder
 //! \{
-static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, UInt &numChecksumErrors);
+static Bool calcHashStatus(const TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, std::string &status);
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
 
 TDecGop::TDecGop()
- : m_numberOfChecksumErrorsDetected(0)
+ : m_decodedPictureHashSEIAsync(false)
+ , m_numberOfChecksumErrorsDetected(0)
+ , m_hashTerminate(false)
 {
   m_dDecTime = 0;
 }
@@ -71,6 +74,23 @@ Void TDecGop::create()
 
 Void TDecGop::destroy()
 {
+  xReportHashVerification(true);
+  if (m_hashThread.joinable())
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_hashMutex);
+      m_hashTerminate = true;
+    }
+    m_hashJobCondition.notify_all();
+    m_hashThread.join();
+    m_hashTerminate = false;
+  }
+  for (size_t i = 0; i < m_freeHashPics.size(); i++)
+  {
+    m_freeHashPics[i]->destroy();
+    delete m_freeHashPics[i];
+  }
+  m_freeHashPics.clear();
 }
 
 Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
@@ -102,6 +122,7 @@ Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
 
 Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic)
 {
+  PROFILE_SCOPE( PROF_DEC_SLICE );
   TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
   // Table of extracted substreams.
   // These must be deallocated AND their internal fifos, too.
@@ -134,11 +155,15 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic)
 
 Void TDecGop::filterPicture(TComPic* pcPic)
 {
+  PROFILE_SCOPE( PROF_DEC_FILTER_PICTURE );
   TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
 
   //-- For time output for each slice
   clock_t iBeforeTime = clock();
 
+  // report the verifications that finished in the meantime before the status line of this picture
+  xReportHashVerification(false);
+
   // deblocking filter
   Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
   m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
@@ -185,7 +210,19 @@ Void TDecGop::filterPicture(TComPic* pcPic)
     {
       printf ("Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
-    calcAndPrintHashStatus(*(pcPic->getPicYuvRec()), hash, pcSlice->getSPS()->getBitDepths(), m_numberOfChecksumErrorsDetected);
+    if (m_decodedPictureHashSEIAsync)
+    {
+      xQueueHashVerification(pcPic, hash, pcSlice->getSPS()->getBitDepths());
+    }
+    else
+    {
+      std::string status;
+      if (calcHashStatus(*(pcPic->getPicYuvRec()), hash, pcSlice->getSPS()->getBitDepths(), status))
+      {
+        m_numberOfChecksumErrorsDetected++;
+      }
+      printf("%s", status.c_str());
+    }
   }
 
   printf("\n");
@@ -195,8 +232,132 @@ Void TDecGop::filterPicture(TComPic* pcPic)
 }
 
 /**
- * Calculate and print hash for pic, compare to picture_digest SEI if
- * present in seis.  seis may be NULL.  Hash is printed to stdout, in
+ * Queue the hash verification of pcPic. The reconstruction is copied, so the picture buffer may be reused before the
+ * verification has finished.
+ */
+Void TDecGop::xQueueHashVerification(TComPic* pcPic, const SEIDecodedPictureHash* hash, const BitDepths &bitDepths)
+{
+  const TComPicYuv* rec = pcPic->getPicYuvRec();
+  HashJob* job = new HashJob;
+  job->poc       = pcPic->getPOC();
+  job->pic       = NULL;
+  job->hasSEI    = hash != NULL;
+  if (hash)
+  {
+    job->sei     = *hash;
+  }
+  job->bitDepths = bitDepths;
+  job->done      = false;
+  job->mismatch  = false;
+
+  {
+    std::unique_lock<std::mutex> lock(m_hashMutex);
+    while (!m_freeHashPics.empty() && job->pic == NULL)
+    {
+      TComPicYuv* pic = m_freeHashPics.back();
+      m_freeHashPics.pop_back();
+      if (pic->getWidth(COMPONENT_Y) == rec->getWidth(COMPONENT_Y) && pic->getHeight(COMPONENT_Y) == rec->getHeight(COMPONENT_Y) && pic->getChromaFormat() == rec->getChromaFormat())
+      {
+        job->pic = pic;
+      }
+      else
+      {
+        pic->destroy();
+        delete pic;
+      }
+    }
+  }
+  if (job->pic == NULL)
+  {
+    job->pic = new TComPicYuv;
+    job->pic->createWithoutCUInfo(rec->getWidth(COMPONENT_Y), rec->getHeight(COMPONENT_Y), rec->getChromaFormat());
+  }
+  for (UInt comp = 0; comp < rec->getNumberValidComponents(); comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const Pel* src = rec->getAddr(compID);
+    Pel* dst = job->pic->getAddr(compID);
+    for (Int y = 0; y < rec->getHeight(compID); y++)
+    {
+      ::memcpy(dst + y * job->pic->getStride(compID), src + y * rec->getStride(compID), rec->getWidth(compID) * sizeof(Pel));
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(m_hashMutex);
+    m_hashJobs.push_back(job);
+    if (!m_hashThread.joinable())
+    {
+      m_hashThread = std::thread(&TDecGop::xHashThreadLoop, this);
+    }
+  }
+  m_hashJobCondition.notify_one();
+}
+
+/**
+ * Print the results of the finished verifications in decoding order, stopping at the first one that is still
+ * running unless waitForAll is set.
+ */
+Void TDecGop::xReportHashVerification(const Bool waitForAll)
+{
+  std::unique_lock<std::mutex> lock(m_hashMutex);
+  while (!m_hashJobs.empty())
+  {
+    HashJob* job = m_hashJobs.front();
+    if (!job->done)
+    {
+      if (!waitForAll)
+      {
+        break;
+      }
+      m_hashDoneCondition.wait(lock, [job] { return job->done; });
+    }
+    m_hashJobs.pop_front();
+
+    printf("POC %4d %s\n", job->poc, job->status.c_str());
+    if (job->mismatch)
+    {
+      m_numberOfChecksumErrorsDetected++;
+    }
+    m_freeHashPics.push_back(job->pic);
+    delete job;
+  }
+  fflush(stdout);
+}
+
+Void TDecGop::xHashThreadLoop()
+{
+  std::unique_lock<std::mutex> lock(m_hashMutex);
+  while (true)
+  {
+    // jobs are only removed from the front once they are done, so the unprocessed ones stay at the back
+    size_t next = 0;
+    while (next < m_hashJobs.size() && m_hashJobs[next]->done)
+    {
+      next++;
+    }
+    if (next == m_hashJobs.size())
+    {
+      if (m_hashTerminate)
+      {
+        return;
+      }
+      m_hashJobCondition.wait(lock);
+      continue;
+    }
+
+    HashJob* job = m_hashJobs[next];
+    lock.unlock();
+    job->mismatch = calcHashStatus(*job->pic, job->hasSEI ? &job->sei : NULL, job->bitDepths, job->status);
+    lock.lock();
+    job->done = true;
+    m_hashDoneCondition.notify_all();
+  }
+}
+
+/**
+ * Calculate hash for pic, compare to picture_digest SEI if
+ * present in seis.  seis may be NULL.  The status is returned in
  * a manner suitable for the status line. Theformat is:
  *  [Hash_type:xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx,(yyy)]
  * Where, x..x is the hash
@@ -204,8 +365,9 @@ Void TDecGop::filterPicture(TComPic* pcPic)
  *            OK          - calculated hash matches the SEI message
  *            ***ERROR*** - calculated hash does not match the SEI message
  *            unk         - no SEI message was available for comparison
+ * Returns true on a mismatch, in which case the received hash is appended.
  */
-static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, UInt &numChecksumErrors)
+static Bool calcHashStatus(const TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, std::string &status)
 {
   /* calculate MD5sum for entire reconstructed picture */
   TComPictureHash recon_digest;
@@ -256,12 +418,12 @@ static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash*
     }
   }
 
-  printf("[%s:%s,%s] ", hashType, hashToString(recon_digest, numChar).c_str(), ok);
+  status = std::string("[") + hashType + ":" + hashToString(recon_digest, numChar) + "," + ok + "] ";
 
   if (mismatch)
   {
-    numChecksumErrors++;
-    printf("[rx%s:%s] ", hashType, hashToString(pictureHashSEI->m_pictureHash, numChar).c_str());
+    status += std::string("[rx") + hashType + ":" + hashToString(pictureHashSEI->m_pictureHash, numChar) + "] ";
   }
+  return mismatch;
 }
 //! \}
@@ -50,11 +50,18 @@
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/TComSampleAdaptiveOffset.h"
 
+#include "TLibCommon/SEI.h"
+
 #include "TDecEntropy.h"
 #include "TDecSlice.h"
 #include "TDecBinCoder.h"
 #include "TDecBinCoderCABAC.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 //! \ingroup TLibDecoder
 //! \{
 
@@ -79,8 +86,34 @@ private:
   TComSampleAdaptiveOffset*     m_pcSAO;
   Double                m_dDecTime;
   Int                   m_decodedPictureHashSEIEnabled;  ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
+  Bool                  m_decodedPictureHashSEIAsync;    ///< verify the decoded picture hash on a separate thread
   UInt                  m_numberOfChecksumErrorsDetected;
 
+  /// hash verification of one picture, queued for the hash thread
+  struct HashJob
+  {
+    Int                   poc;
+    TComPicYuv*           pic;                            ///< copy of the reconstruction
+    Bool                  hasSEI;
+    SEIDecodedPictureHash sei;
+    BitDepths             bitDepths;
+    Bool                  done;
+    Bool                  mismatch;
+    std::string           status;
+  };
+
+  std::deque<HashJob*>    m_hashJobs;                     ///< in decoding order
+  std::vector<TComPicYuv*> m_freeHashPics;
+  std::thread             m_hashThread;
+  std::mutex              m_hashMutex;
+  std::condition_variable m_hashJobCondition;
+  std::condition_variable m_hashDoneCondition;
+  Bool                    m_hashTerminate;
+
+  Void  xQueueHashVerification ( TComPic* pcPic, const SEIDecodedPictureHash* hash, const BitDepths &bitDepths );
+  Void  xReportHashVerification( const Bool waitForAll );
+  Void  xHashThreadLoop        ();
+
 public:
   TDecGop();
   virtual ~TDecGop();
@@ -99,6 +132,7 @@ public:
   Void  filterPicture  (TComPic* pcPic );
 
   Void setDecodedPictureHashSEIEnabled(Int enabled) { m_decodedPictureHashSEIEnabled = enabled; }
+  Void setDecodedPictureHashSEIAsync(Bool async)    { m_decodedPictureHashSEIAsync = async; }
   UInt getNumberOfChecksumErrorsDetected() const { return m_numberOfChecksumErrorsDetected; }
 
 };
@@ -0,0 +1,216 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TDecHeaderParser.cpp
+    \brief    header-only parser for bitstream tools
+*/
+
+#include <algorithm>
+#include "TDecHeaderParser.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+TDecHeaderParser::TDecHeaderParser()
+: m_slice(&m_slices[0])
+, m_prevSlice(&m_slices[1])
+, m_prevTid0POC(0)
+{
+}
+
+Void TDecHeaderParser::parseNalUnitHeader(const uint8_t* nalUnit, NALUnit& nalu)
+{
+  nalu.m_nalUnitType      = NalUnitType((nalUnit[0] >> 1) & 0x3f);
+  nalu.m_nuhLayerId       = ((nalUnit[0] & 0x01) << 5) | (nalUnit[1] >> 3);
+  nalu.m_temporalId       = (nalUnit[1] & 0x07) - 1;
+}
+
+Void TDecHeaderParser::xConvertPayloadToRBSP(const uint8_t* nalUnit, size_t numBytes, TComInputBitstream& bitstream)
+{
+  std::vector<uint8_t>& rbsp = bitstream.getFifo();
+  rbsp.resize(numBytes);
+  bitstream.clearEmulationPreventionByteLocation();
+
+  UInt   zeroCount    = 0;
+  size_t numRbspBytes = 0;
+  for (size_t pos = 0; pos < numBytes; pos++)
+  {
+    if (zeroCount == 2 && nalUnit[pos] == 0x03)
+    {
+      bitstream.pushEmulationPreventionByteLocation(UInt(pos));
+      zeroCount = 0;
+      continue;
+    }
+    zeroCount = (nalUnit[pos] == 0x00) ? zeroCount + 1 : 0;
+    rbsp[numRbspBytes++] = nalUnit[pos];
+  }
+  rbsp.resize(numRbspBytes);
+  bitstream.resetToStart();
+}
+
+Void TDecHeaderParser::parseParameterSet(const uint8_t* nalUnit, size_t numBytes, const NALUnit& nalu)
+{
+  TComInputBitstream bitstream;
+  xConvertPayloadToRBSP(nalUnit, numBytes, bitstream);
+  bitstream.read(16); // nal_unit_header()
+  m_cavlcParser.setBitstream(&bitstream);
+
+  switch (nalu.m_nalUnitType)
+  {
+    case NAL_UNIT_VPS:
+      {
+        TComVPS* vps = new TComVPS();
+        m_cavlcParser.parseVPS(vps);
+        m_parameterSetManager.storeVPS(vps, bitstream.getFifo());
+      }
+      break;
+    case NAL_UNIT_SPS:
+      {
+        TComSPS* sps = new TComSPS();
+        m_cavlcParser.parseSPS(sps);
+        m_parameterSetManager.storeSPS(sps, bitstream.getFifo());
+      }
+      break;
+    case NAL_UNIT_PPS:
+      {
+        TComPPS* pps = new TComPPS();
+        m_cavlcParser.parsePPS(pps);
+        m_parameterSetManager.storePPS(pps, bitstream.getFifo());
+      }
+      break;
+    default:
+      assert(0);
+      break;
+  }
+}
+
+Void TDecHeaderParser::parseSEI(const uint8_t* nalUnit, size_t numBytes, const NALUnit& nalu, SEIMessages& seis)
+{
+  TComInputBitstream bitstream;
+  xConvertPayloadToRBSP(nalUnit, numBytes, bitstream);
+  bitstream.read(16); // nal_unit_header()
+  m_seiReader.parseSEImessage(&bitstream, seis, nalu.m_nalUnitType, m_parameterSetManager.getActiveSPS(), NULL);
+}
+
+/** Upper bound of the size of the slice segment header in bytes.
+ *  The PPS id is read first, so that the bound can account for the entry point offsets.
+ */
+size_t TDecHeaderParser::xGetMaxSliceHeaderSize(const uint8_t* nalUnit, size_t numBytes, const NALUnit& nalu)
+{
+  TComInputBitstream bitstream;
+  xConvertPayloadToRBSP(nalUnit, std::min<size_t>(numBytes, 16), bitstream);
+  bitstream.read(16); // nal_unit_header()
+  bitstream.read(1);  // first_slice_segment_in_pic_flag
+  if (nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_BLA_W_LP && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_IRAP_VCL23)
+  {
+    bitstream.read(1); // no_output_of_prior_pics_flag
+  }
+  UInt numLeadingZeroBits = 0;
+  while (numLeadingZeroBits < 32 && bitstream.getNumBitsLeft() > 0 && bitstream.read(1) == 0)
+  {
+    numLeadingZeroBits++;
+  }
+  if (bitstream.getNumBitsLeft() < numLeadingZeroBits)
+  {
+    return numBytes;
+  }
+  const UInt ppsId = (1 << numLeadingZeroBits) - 1 + bitstream.read(numLeadingZeroBits); // slice_pic_parameter_set_id
+
+  const TComPPS* pps = m_parameterSetManager.getPPS(ppsId);
+  const TComSPS* sps = pps ? m_parameterSetManager.getSPS(pps->getSPSId()) : NULL;
+  if (sps == NULL)
+  {
+    return numBytes;
+  }
+
+  size_t numEntryPoints = 0;
+  if (pps->getTilesEnabledFlag() || pps->getEntropyCodingSyncEnabledFlag())
+  {
+    const size_t numCtuRows = (sps->getPicHeightInLumaSamples() + sps->getMaxCUHeight() - 1) / sps->getMaxCUHeight();
+    numEntryPoints = (pps->getNumTileColumnsMinus1() + 1) * (pps->getEntropyCodingSyncEnabledFlag() ? numCtuRows : pps->getNumTileRowsMinus1() + 1);
+  }
+  // fixed part, entry point offsets of up to 32 bits and slice_segment_header_extension, plus emulation prevention bytes
+  const size_t maxHeaderSize = (2048 + 4 * numEntryPoints + 256 + 16) * 3 / 2;
+  return std::min(numBytes, maxHeaderSize);
+}
+
+size_t TDecHeaderParser::parseSliceHeader(const uint8_t* nalUnit, size_t numBytes, const NALUnit& nalu)
+{
+  std::swap(m_slice, m_prevSlice);
+  m_slice->initSlice();
+
+  const Bool firstSliceSegmentInPic = numBytes > 2 && (nalUnit[2] & 0x80) != 0;
+  if (!firstSliceSegmentInPic)
+  {
+    m_slice->copySliceInfo(m_prevSlice);
+  }
+
+  m_slice->setNalUnitType(nalu.m_nalUnitType);
+  Bool nonReferenceFlag = (m_slice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TRAIL_N ||
+                           m_slice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TSA_N   ||
+                           m_slice->getNalUnitType() == NAL_UNIT_CODED_SLICE_STSA_N  ||
+                           m_slice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL_N  ||
+                           m_slice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL_N);
+  m_slice->setTemporalLayerNonReferenceFlag(nonReferenceFlag);
+  m_slice->setReferenced(true);
+  m_slice->setTLayerInfo(nalu.m_temporalId);
+
+  // only the part of the NAL unit that can hold the slice segment header is converted
+  xConvertPayloadToRBSP(nalUnit, xGetMaxSliceHeaderSize(nalUnit, numBytes, nalu), m_sliceHeaderBitstream);
+  m_sliceHeaderBitstream.read(16); // nal_unit_header()
+  m_cavlcParser.setBitstream(&m_sliceHeaderBitstream);
+  m_cavlcParser.parseSliceHeader(m_slice, &m_parameterSetManager, m_prevTid0POC);
+
+  if (firstSliceSegmentInPic)
+  {
+    m_parameterSetManager.activatePPS(m_slice->getPPSId(), m_slice->isIRAP());
+  }
+
+  if ((m_slice->getTLayer() == 0) && m_slice->isReferenceNalu() && (m_slice->getNalUnitType() != NAL_UNIT_CODED_SLICE_RASL_R) && (m_slice->getNalUnitType() != NAL_UNIT_CODED_SLICE_RADL_R))
+  {
+    m_prevTid0POC = m_slice->getPOC();
+  }
+
+  // map the end of the header in the RBSP back to the NAL unit
+  size_t sliceDataOffset = m_sliceHeaderBitstream.getByteLocation();
+  for (UInt i = 0; i < m_sliceHeaderBitstream.numEmulationPreventionBytesRead(); i++)
+  {
+    if (m_sliceHeaderBitstream.getEmulationPreventionByteLocation(i) <= sliceDataOffset)
+    {
+      sliceDataOffset++;
+    }
+  }
+  return sliceDataOffset;
+}
+
+//! \}
@@ -0,0 +1,108 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TDecHeaderParser.h
+    \brief    header-only parser for bitstream tools (header)
+*/
+
+#ifndef __TDECHEADERPARSER__
+#define __TDECHEADERPARSER__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComBitStream.h"
+#include "TLibCommon/TComSlice.h"
+#include "TLibCommon/NAL.h"
+#include "TLibCommon/SEI.h"
+#include "TDecCAVLC.h"
+#include "SEIread.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/**
+ * Header-only parser for bitstream rewriting tools.
+ *
+ * Parameter sets, SEI messages and slice segment headers are parsed with the
+ * regular CAVLC and SEI readers, but no picture buffers are allocated and the
+ * slice segment data is never touched: only the part of a slice NAL unit that
+ * can hold the header is converted to RBSP, and the byte offset of the slice
+ * segment data within the NAL unit is returned so that it can be copied
+ * verbatim.  NAL units are passed in as EBSP spans starting with the NAL unit
+ * header, as returned by AnnexBNALUnitReader.
+ */
+class TDecHeaderParser
+{
+private:
+  ParameterSetManager   m_parameterSetManager;
+  TDecCavlc             m_cavlcParser;
+  SEIReader             m_seiReader;
+  TComInputBitstream    m_sliceHeaderBitstream;    ///< RBSP of the slice segment header prefix of the last slice
+  TComSlice             m_slices[2];
+  TComSlice*            m_slice;                   ///< last parsed slice segment
+  TComSlice*            m_prevSlice;               ///< slice segment parsed before m_slice
+  Int                   m_prevTid0POC;
+
+public:
+  TDecHeaderParser();
+  virtual ~TDecHeaderParser() {}
+
+  static Void parseNalUnitHeader( const uint8_t* nalUnit, NALUnit& nalu );
+
+  Void    parseParameterSet  ( const uint8_t* nalUnit, size_t numBytes, const NALUnit& nalu );
+  Void    parseSEI           ( const uint8_t* nalUnit, size_t numBytes, const NALUnit& nalu, SEIMessages& seis );
+  size_t  parseSliceHeader   ( const uint8_t* nalUnit, size_t numBytes, const NALUnit& nalu ); ///< returns the offset of the slice segment data within the NAL unit
+
+  ParameterSetManager&  getParameterSetManager()  { return m_parameterSetManager; }
+  const TComSlice*      getSlice() const          { return m_slice; }
+  TComInputBitstream&   getSliceHeaderBitstream() { return m_sliceHeaderBitstream; }
+#if MCTS_EXTRACTION
+  UInt    getSliceHeaderBodyStartBit() const      { return m_cavlcParser.getSliceHeaderBodyStartBit(); }
+  UInt    getSliceHeaderBodyEndBit() const        { return m_cavlcParser.getSliceHeaderBodyEndBit(); }
+#endif
+
+protected:
+  static Void xConvertPayloadToRBSP( const uint8_t* nalUnit, size_t numBytes, TComInputBitstream& bitstream );
+  size_t  xGetMaxSliceHeaderSize ( const uint8_t* nalUnit, size_t numBytes, const NALUnit& nalu );
+};
+
+//! \}
+
+#endif
@@ -153,6 +153,10 @@ public:
   Void  destroy ();
 
   Void setDecodedPictureHashSEIEnabled(Int enabled) { m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled); }
+  Void setDecodedPictureHashSEIAsync(Bool async)    { m_cGopDecoder.setDecodedPictureHashSEIAsync(async); }
+#if JVET_X0048_X0103_FILM_GRAIN
+  Void setFilmGrainSynthesisThreads(Int numThreads) { m_grainCharacteristic.setNumThreads(numThreads); }
+#endif
 #if MCTS_ENC_CHECK
   Void setTMctsCheckEnabled(Bool enabled) { m_tmctsCheckEnabled = enabled; }
 
@@ -119,6 +119,13 @@ public:
     m_uiNumPic++;
   }
 
+  /// add the accumulated results of numPic pictures
+  Void  addResults( const ResultData &total, UInt numPic )
+  {
+    addResult(total);
+    m_uiNumPic += numPic - 1;
+  }
+
   Double  getPsnr(ComponentID compID) const { return  m_runningTotal.psnr[compID];  }
   Double  getMsssim(ComponentID compID) const { return  m_runningTotal.MSSSIM[compID];  }
   Double  getxPSNR()                  const { return m_runningTotal.xpsnr;}
@@ -154,6 +154,8 @@ protected:
   Bool      m_printMSSSIM;
   Bool      m_bXPSNREnableFlag;
   Double    m_dXPSNRWeight[MAX_NUM_COMPONENT];
+  Int       m_metricThreads;
+  Bool      m_asyncMetrics;
   Bool      m_cabacZeroWordPaddingEnabled;
 #if SHUTTER_INTERVAL_SEI_PROCESSING
   Bool      m_ShutterFilterEnable;                          ///< enable Pre-Filtering with Shutter Interval SEI
@@ -261,12 +263,14 @@ protected:
   Bool      m_useRDOQ;
   Bool      m_useRDOQTS;
   Bool      m_useSelectiveRDOQ;
+  Bool      m_useFastRDOQ;
   UInt      m_rdPenalty;
   FastInterSearchMode m_fastInterSearchMode;
   Bool      m_bUseEarlyCU;
   Bool      m_useFastDecisionForMerge;
   Bool      m_bUseCbfFastMode;
   Bool      m_useEarlySkipDetection;
+  Bool      m_depthRangePrediction;
   Bool      m_crossComponentPredictionEnabledFlag;
   Bool      m_reconBasedCrossCPredictionEstimate;
   UInt      m_log2SaoOffsetScale[MAX_NUM_CHANNEL_TYPE];
@@ -293,6 +297,10 @@ protected:
 
   Bool      m_bUseConstrainedIntraPred;
   Bool      m_bFastUDIUseMPMEnabled;
+  Bool      m_fastIntraGradient;
+  Int       m_fastIntraGradientModes;
+  Bool      m_splitEarlyTermination;
+  Int       m_parallelRDCandidates;
   Bool      m_bFastMEForGenBLowDelayEnabled;
   Bool      m_bUseBLambdaForNonKeyLowDelayPictures;
   Bool      m_usePCM;
@@ -449,6 +457,8 @@ protected:
   Bool                  m_bimEnabled;
   std::map<Int, Int*>   m_adaptQPmap;
 #endif
+  Bool                  m_cuTreeEnabled;
+  std::map<Int, std::vector<Double> > m_cuTreeQPOffsetMap;  ///< per 16x16 block QP offsets derived by the lookahead
   Bool                  m_cmpSEIEnabled;
   Bool                  m_cmpSEICmpCancelFlag;
   Bool                  m_cmpSEICmpPersistenceFlag;
@@ -499,6 +509,8 @@ protected:
   Bool      m_fgcSEICompModelPresent[MAX_NUM_COMPONENT];
 #if JVET_X0048_X0103_FILM_GRAIN
   Bool      m_fgcSEIAnalysisEnabled;
+  Int       m_fgcSEIAnalysisThreads;
+  Bool      m_fgcSEIAnalysisAsync;
   std::string m_fgcSEIExternalMask;
   std::string m_fgcSEIExternalDenoised;
   Bool      m_fgcSEIPerPictureSEI;
@@ -538,6 +550,8 @@ protected:
   Bool      m_RCCpbSaturationEnabled;
   UInt      m_RCCpbSize;
   Double    m_RCInitialCpbFullness;
+  Int       m_RCPass;                                       ///< two-pass rate control: 0 single pass, 1 first pass writing the statistics, 2 second pass reading them
+  std::string m_RCStatsFileName;                            ///< first-pass statistics file of two-pass rate control
   Bool      m_TransquantBypassEnabledFlag;                    ///< transquant_bypass_enabled_flag setting in PPS.
   Bool      m_CUTransquantBypassFlagForce;                    ///< if transquant_bypass_enabled_flag, then, if true, all CU transquant bypass flags will be set to true.
 
@@ -587,6 +601,8 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  Bool        m_summaryExcludeFirstPicture;                   ///< do not count the first picture in the summary (it repeats the last picture of the previous ParallelSegments segment).
+  std::string m_ctuStatsFileName;                             ///< CSV file receiving the per-CTU statistics of the encoder decisions; if empty, none are collected.
 
 #if JCTVC_AD0021_SEI_MANIFEST
   Bool        m_SEIManifestSEIEnabled;
@@ -636,6 +652,10 @@ public:
 
   Bool      getPrintMSSSIM                  ()         const { return m_printMSSSIM;               }
   Void      setPrintMSSSIM                  (Bool value)     { m_printMSSSIM = value;              }
+  Int       getMetricThreads                ()         const { return m_metricThreads;             }
+  Void      setMetricThreads                (Int value)      { m_metricThreads = value;            }
+  Bool      getAsyncMetrics                 ()         const { return m_asyncMetrics;              }
+  Void      setAsyncMetrics                 (Bool value)     { m_asyncMetrics = value;             }
 
   Bool      getXPSNREnableFlag              () const                     { return m_bXPSNREnableFlag;}
   Double    getXPSNRWeight                  (const ComponentID id) const { return m_dXPSNRWeight[id];}
@@ -804,6 +824,7 @@ public:
   Bool      getDisableIntraPUsInInterSlices    () const { return m_bDisableIntraPUsInInterSlices; }
   MESearchMethod getMotionEstimationSearchMethod ( ) const { return m_motionEstimationSearchMethod; }
   Int       getSearchRange                     () const { return m_iSearchRange; }
+  Int       getBipredSearchRange               () const { return m_bipredSearchRange; }
   Bool      getClipForBiPredMeEnabled          () const { return m_bClipForBiPredMeEnabled; }
   Bool      getFastMEAssumingSmootherMVEnabled () const { return m_bFastMEAssumingSmootherMVEnabled; }
   Int       getMinSearchWindow                 () const { return m_minSearchWindow; }
@@ -829,14 +850,20 @@ public:
   Void      setUseRDOQ                      ( Bool  b )     { m_useRDOQ    = b; }
   Void      setUseRDOQTS                    ( Bool  b )     { m_useRDOQTS  = b; }
   Void      setUseSelectiveRDOQ             ( Bool b )      { m_useSelectiveRDOQ = b; }
+  Void      setUseFastRDOQ                  ( Bool b )      { m_useFastRDOQ = b; }
   Void      setRDpenalty                    ( UInt  u )     { m_rdPenalty  = u; }
   Void      setFastInterSearchMode          ( FastInterSearchMode m ) { m_fastInterSearchMode = m; }
   Void      setUseEarlyCU                   ( Bool  b )     { m_bUseEarlyCU = b; }
   Void      setUseFastDecisionForMerge      ( Bool  b )     { m_useFastDecisionForMerge = b; }
   Void      setUseCbfFastMode               ( Bool  b )     { m_bUseCbfFastMode = b; }
   Void      setUseEarlySkipDetection        ( Bool  b )     { m_useEarlySkipDetection = b; }
+  Void      setDepthRangePrediction         ( Bool  b )     { m_depthRangePrediction = b; }
   Void      setUseConstrainedIntraPred      ( Bool  b )     { m_bUseConstrainedIntraPred = b; }
   Void      setFastUDIUseMPMEnabled         ( Bool  b )     { m_bFastUDIUseMPMEnabled = b; }
+  Void      setFastIntraGradient            ( Bool  b )     { m_fastIntraGradient = b; }
+  Void      setFastIntraGradientModes       ( Int   i )     { m_fastIntraGradientModes = i; }
+  Void      setSplitEarlyTermination        ( Bool  b )     { m_splitEarlyTermination = b; }
+  Void      setParallelRDCandidates         ( Int   i )     { m_parallelRDCandidates = i; }
   Void      setFastMEForGenBLowDelayEnabled ( Bool  b )     { m_bFastMEForGenBLowDelayEnabled = b; }
   Void      setUseBLambdaForNonKeyLowDelayPictures ( Bool b ) { m_bUseBLambdaForNonKeyLowDelayPictures = b; }
 
@@ -854,14 +881,20 @@ public:
   Bool      getUseRDOQ                      ()      { return m_useRDOQ;    }
   Bool      getUseRDOQTS                    ()      { return m_useRDOQTS;  }
   Bool      getUseSelectiveRDOQ             ()      { return m_useSelectiveRDOQ; }
+  Bool      getUseFastRDOQ                  ()      { return m_useFastRDOQ; }
   Int       getRDpenalty                    ()      { return m_rdPenalty;  }
   FastInterSearchMode getFastInterSearchMode() const{ return m_fastInterSearchMode;  }
   Bool      getUseEarlyCU                   ()      { return m_bUseEarlyCU; }
   Bool      getUseFastDecisionForMerge      ()      { return m_useFastDecisionForMerge; }
   Bool      getUseCbfFastMode               ()      { return m_bUseCbfFastMode; }
   Bool      getUseEarlySkipDetection        ()      { return m_useEarlySkipDetection; }
+  Bool      getDepthRangePrediction         ()      { return m_depthRangePrediction; }
   Bool      getUseConstrainedIntraPred      ()      { return m_bUseConstrainedIntraPred; }
   Bool      getFastUDIUseMPMEnabled         ()      { return m_bFastUDIUseMPMEnabled; }
+  Bool      getFastIntraGradient            ()      { return m_fastIntraGradient; }
+  Int       getFastIntraGradientModes       ()      { return m_fastIntraGradientModes; }
+  Bool      getSplitEarlyTermination        ()      { return m_splitEarlyTermination; }
+  Int       getParallelRDCandidates         ()      { return m_parallelRDCandidates; }
   Bool      getFastMEForGenBLowDelayEnabled ()      { return m_bFastMEForGenBLowDelayEnabled; }
   Bool      getUseBLambdaForNonKeyLowDelayPictures () { return m_bUseBLambdaForNonKeyLowDelayPictures; }
   Bool      getPCMInputBitDepthFlag         ()      { return m_bPCMInputBitDepthFlag;   }
@@ -1162,6 +1195,10 @@ public:
   bool*   getFGCSEICompModelPresent                 ()               { return m_fgcSEICompModelPresent; }
   void    setFilmGrainAnalysisEnabled               (bool b)         { m_fgcSEIAnalysisEnabled = b; }
   bool    getFilmGrainAnalysisEnabled               ()               { return m_fgcSEIAnalysisEnabled; }
+  void    setFilmGrainAnalysisThreads               (int i)          { m_fgcSEIAnalysisThreads = i; }
+  int     getFilmGrainAnalysisThreads               ()               { return m_fgcSEIAnalysisThreads; }
+  void    setFilmGrainAnalysisAsync                 (bool b)         { m_fgcSEIAnalysisAsync = b; }
+  bool    getFilmGrainAnalysisAsync                 ()               { return m_fgcSEIAnalysisAsync; }
   void    setFilmGrainExternalMask(std::string s) { m_fgcSEIExternalMask = s; }
   void    setFilmGrainExternalDenoised(std::string s) { m_fgcSEIExternalDenoised = s; }
   std::string getFilmGrainExternalMask() { return m_fgcSEIExternalMask; }
@@ -1251,6 +1288,9 @@ public:
   Int*  getAdaptQPmap(Int poc)                                       { return m_adaptQPmap[poc]; }
   std::map<Int, Int*> *getAdaptQPmap()                               { return &m_adaptQPmap; }
 #endif
+  Void  setCuTree(Bool flag)                                         { m_cuTreeEnabled = flag; }
+  Bool  getCuTree() const                                            { return m_cuTreeEnabled; }
+  std::map<Int, std::vector<Double> > *getCuTreeQPOffsetMap()       { return &m_cuTreeQPOffsetMap; }
   Void     setCmpSEIEnabled(Bool b)                                  { m_cmpSEIEnabled = b; }
   Bool     getCmpSEIEnabled()                                        { return m_cmpSEIEnabled; }
   Void     setCmpSEICmpCancelFlag(Bool b)                            { m_cmpSEICmpCancelFlag = b; }
@@ -1372,6 +1412,10 @@ public:
   Void         setCpbSize             ( UInt ui )                    { m_RCCpbSize = ui;   }
   Double       getInitialCpbFullness  ()                             { return m_RCInitialCpbFullness;  }
   Void         setInitialCpbFullness  (Double f)                     { m_RCInitialCpbFullness = f;     }
+  Int          getRCPass              ()                             { return m_RCPass;                }
+  Void         setRCPass              ( Int i )                      { m_RCPass = i;                   }
+  const std::string& getRCStatsFileName() const                      { return m_RCStatsFileName;       }
+  Void         setRCStatsFileName     ( const std::string& s )       { m_RCStatsFileName = s;          }
   Bool         getTransquantBypassEnabledFlag()                      { return m_TransquantBypassEnabledFlag; }
   Void         setTransquantBypassEnabledFlag(Bool flag)             { m_TransquantBypassEnabledFlag = flag; }
   Bool         getCUTransquantBypassFlagForceValue()                 { return m_CUTransquantBypassFlagForce; }
@@ -1497,6 +1541,10 @@ public:
 
   Void      setSummaryVerboseness(UInt v)                            { m_summaryVerboseness = v; }
   UInt      getSummaryVerboseness( ) const                           { return m_summaryVerboseness; }
+  Void      setSummaryExcludeFirstPicture(Bool b)                    { m_summaryExcludeFirstPicture = b; }
+  Bool      getSummaryExcludeFirstPicture() const                    { return m_summaryExcludeFirstPicture; }
+  Void      setCtuStatsFileName(const std::string &s)                { m_ctuStatsFileName = s; }
+  const std::string& getCtuStatsFileName() const                     { return m_ctuStatsFileName; }
 
 #if JCTVC_AD0021_SEI_MANIFEST
   Void     setSEIManifestSEIEnabled(Bool b) { m_SEIManifestSEIEnabled = b; }
@@ -0,0 +1,209 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncCtuStats.cpp
+    \brief    per-CTU statistics of the encoder decisions
+*/
+
+#include "TEncCtuStats.h"
+#include "TLibCommon/TComPic.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+//! \ingroup TLibEncoder
+//! \{
+
+static const TChar *s_candidateNames[NUMBER_OF_CTU_STATS_CANDIDATES] =
+{
+  "eval_cu", "eval_merge", "eval_inter_2Nx2N", "eval_inter_smp", "eval_inter_amp", "eval_intra_2Nx2N", "eval_intra_NxN", "eval_pcm"
+};
+
+// ====================================================================================================================
+// Constructor / destructor
+// ====================================================================================================================
+
+TEncCtuStats::TEncCtuStats()
+{
+}
+
+TEncCtuStats::~TEncCtuStats()
+{
+  close();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** Create the file and write the CSV header.
+ * \param fileName  name of the statistics file
+ * \returns false if the file could not be created
+ */
+Bool TEncCtuStats::open( const std::string &fileName )
+{
+  m_file.open( fileName.c_str(), std::ios::out | std::ios::trunc );
+  if ( !m_file.is_open() )
+  {
+    return false;
+  }
+
+  m_file << "poc,slice_type,ctu,x,y,qp,time_us,bits";
+  for ( Int i = 0; i < NUMBER_OF_CTU_STATS_CANDIDATES; i++ )
+  {
+    m_file << "," << s_candidateNames[i];
+  }
+  for ( Int d = 0; d < s_numDepths; d++ )
+  {
+    m_file << ",cu_d" << d;
+  }
+  m_file << ",skip,merge,inter,inter_amp,intra,intra_NxN,pcm,lossless,tus,intra_planar,intra_dc,intra_angular\n";
+  m_file << std::fixed << std::setprecision( 1 );
+  return m_file.good();
+}
+
+Void TEncCtuStats::close()
+{
+  if ( m_file.is_open() )
+  {
+    m_file.close();
+  }
+}
+
+/** Collect the decisions stored in the CU data of a compressed CTU and append them with the given measurements.
+ * \param pCtu        CTU after compression
+ * \param timeUs      time spent compressing the CTU, in microseconds
+ * \param numBits     bits of the CTU in the slice data
+ * \param numChecked  RD evaluations made by the CU encoder, by kind
+ */
+Void TEncCtuStats::writeCtu( const TComDataCU *pCtu, const Double timeUs, const UInt numBits, const UInt numChecked[NUMBER_OF_CTU_STATS_CANDIDATES] )
+{
+  Decisions decisions;
+  memset( &decisions, 0, sizeof( decisions ) );
+  xCollectCU( pCtu, 0, 0, decisions );
+
+  const TComSlice *pcSlice = pCtu->getSlice();
+  const TChar sliceType = pcSlice->getSliceType() == I_SLICE ? 'I' : ( pcSlice->getSliceType() == P_SLICE ? 'P' : 'B' );
+
+  m_file << pCtu->getPic()->getPOC() << ',' << sliceType << ',' << pCtu->getCtuRsAddr() << ','
+         << pCtu->getCUPelX() << ',' << pCtu->getCUPelY() << ',' << Int( pCtu->getQP( 0 ) ) << ','
+         << timeUs << ',' << numBits;
+  for ( Int i = 0; i < NUMBER_OF_CTU_STATS_CANDIDATES; i++ )
+  {
+    m_file << ',' << numChecked[i];
+  }
+  for ( Int d = 0; d < s_numDepths; d++ )
+  {
+    m_file << ',' << decisions.numCUs[d];
+  }
+  m_file << ',' << decisions.numSkip << ',' << decisions.numMerge << ',' << decisions.numInter << ',' << decisions.numInterAMP
+         << ',' << decisions.numIntra << ',' << decisions.numIntraNxN << ',' << decisions.numPCM << ',' << decisions.numLossless
+         << ',' << decisions.numTUs
+         << ',' << decisions.numIntraModes[0] << ',' << decisions.numIntraModes[1] << ',' << decisions.numIntraModes[2] << '\n';
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+Void TEncCtuStats::xCollectCU( const TComDataCU *pCtu, const UInt absPartIdx, const UInt depth, Decisions &decisions ) const
+{
+  const TComSPS &sps = *(pCtu->getSlice()->getSPS());
+  const UInt lPelX   = pCtu->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[absPartIdx] ];
+  const UInt tPelY   = pCtu->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[absPartIdx] ];
+  if ( lPelX >= sps.getPicWidthInLumaSamples() || tPelY >= sps.getPicHeightInLumaSamples() )
+  {
+    return;
+  }
+
+  const UInt numParts = pCtu->getPic()->getNumPartitionsInCtu() >> ( depth << 1 );
+  if ( depth < pCtu->getDepth( absPartIdx ) )
+  {
+    for ( UInt i = 0; i < 4; i++ )
+    {
+      xCollectCU( pCtu, absPartIdx + i * ( numParts >> 2 ), depth + 1, decisions );
+    }
+    return;
+  }
+
+  decisions.numCUs[std::min<UInt>( depth, s_numDepths - 1 )]++;
+  if ( pCtu->getCUTransquantBypass( absPartIdx ) )
+  {
+    decisions.numLossless++;
+  }
+  if ( pCtu->isSkipped( absPartIdx ) )
+  {
+    decisions.numSkip++;
+    return;
+  }
+
+  const PartSize partSize = pCtu->getPartitionSize( absPartIdx );
+  if ( pCtu->isIntra( absPartIdx ) )
+  {
+    if ( pCtu->getIPCMFlag( absPartIdx ) )
+    {
+      decisions.numPCM++;
+      return;
+    }
+    decisions.numIntra++;
+    const UInt numPUs = partSize == SIZE_NxN ? 4 : 1;
+    if ( numPUs == 4 )
+    {
+      decisions.numIntraNxN++;
+    }
+    for ( UInt pu = 0; pu < numPUs; pu++ )
+    {
+      const Int mode = pCtu->getIntraDir( CHANNEL_TYPE_LUMA, absPartIdx + pu * ( numParts >> 2 ) );
+      decisions.numIntraModes[mode == PLANAR_IDX ? 0 : ( mode == DC_IDX ? 1 : 2 )]++;
+    }
+  }
+  else if ( partSize == SIZE_2Nx2N && pCtu->getMergeFlag( absPartIdx ) )
+  {
+    decisions.numMerge++;
+  }
+  else
+  {
+    decisions.numInter++;
+    if ( partSize >= SIZE_2NxnU && partSize <= SIZE_nRx2N )
+    {
+      decisions.numInterAMP++;
+    }
+  }
+
+  for ( UInt idx = absPartIdx; idx < absPartIdx + numParts; idx += numParts >> ( pCtu->getTransformIdx( idx ) << 1 ) )
+  {
+    decisions.numTUs++;
+  }
+}
+
+//! \}
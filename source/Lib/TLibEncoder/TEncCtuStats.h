@@ -0,0 +1,111 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncCtuStats.h
+    \brief    per-CTU statistics of the encoder decisions (header)
+*/
+
+#ifndef __TENCCTUSTATS__
+#define __TENCCTUSTATS__
+
+#include "TLibCommon/TComDataCU.h"
+#include <fstream>
+#include <string>
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// kinds of RD evaluations counted per CTU by the CU encoder
+enum CtuStatsCandidate
+{
+  CTU_STATS_CU_NODE      = 0,  ///< CU quadtree nodes visited, i.e. CU sizes considered
+  CTU_STATS_MERGE        = 1,  ///< merge candidates coded, with and without residual
+  CTU_STATS_INTER_2Nx2N  = 2,  ///< motion searches of 2Nx2N inter PUs
+  CTU_STATS_INTER_SMP    = 3,  ///< motion searches of 2NxN, Nx2N and NxN inter partitions
+  CTU_STATS_INTER_AMP    = 4,  ///< motion searches of asymmetric inter partitions
+  CTU_STATS_INTRA_2Nx2N  = 5,  ///< intra 2Nx2N mode decisions
+  CTU_STATS_INTRA_NxN    = 6,  ///< intra NxN mode decisions
+  CTU_STATS_PCM          = 7,  ///< PCM evaluations
+  NUMBER_OF_CTU_STATS_CANDIDATES = 8
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Writer of one CSV line per compressed CTU, with the encoding time, the RD evaluations made and the decisions
+/// taken in it. Nothing is collected unless a file has been opened.
+class TEncCtuStats
+{
+public:
+  TEncCtuStats();
+  ~TEncCtuStats();
+
+  Bool open    ( const std::string &fileName );
+  Void close   ();
+  Bool isOpen  () const { return m_file.is_open(); }
+
+  /// append the line of a compressed CTU
+  Void writeCtu( const TComDataCU *pCtu, const Double timeUs, const UInt numBits, const UInt numChecked[NUMBER_OF_CTU_STATS_CANDIDATES] );
+
+  static const Int s_numDepths = 4;                 ///< CU depths of HEVC (log2_diff_max_min_luma_coding_block_size <= 3)
+
+private:
+  /// decisions taken in a CTU
+  struct Decisions
+  {
+    UInt numCUs[s_numDepths];
+    UInt numSkip;
+    UInt numMerge;                                  ///< merge CUs that are not skipped
+    UInt numInter;                                  ///< inter CUs with at least one AMVP coded PU
+    UInt numInterAMP;
+    UInt numIntra;
+    UInt numIntraNxN;
+    UInt numPCM;
+    UInt numLossless;
+    UInt numTUs;                                    ///< luma transform blocks of the non-skipped CUs
+    UInt numIntraModes[3];                          ///< luma intra PUs coded with planar, DC and angular modes
+  };
+
+  Void xCollectCU( const TComDataCU *pCtu, const UInt absPartIdx, const UInt depth, Decisions &decisions ) const;
+
+  std::ofstream m_file;
+};
+
+//! \}
+
+#endif // __TENCCTUSTATS__
@@ -39,7 +39,9 @@
 #include "TEncTop.h"
 #include "TEncCu.h"
 #include "TEncAnalyze.h"
+#include "TEncLookahead.h"
 #include "TLibCommon/Debug.h"
+#include "TLibCommon/TComProfiler.h"
 
 #include <cmath>
 #include <algorithm>
@@ -49,6 +51,37 @@ using namespace std;
 //! \ingroup TLibEncoder
 //! \{
 
+/// largest number of mode candidates of a CU that are evaluated at the same time (four AMP partitions and intra)
+static const Int MAX_PARALLEL_CANDIDATE_TASKS = 5;
+
+/// context for the evaluation of mode candidates of a CU in parallel to other candidates of the same CU
+struct TEncCu::CandidateWorker
+{
+  TEncCu                 cuEncoder;
+  TEncSearch             search;
+  TComTrQuant            trQuant;
+  TComRdCost             rdCost;
+  TEncEntropy            entropyCoder;
+  TComBitCounter         bitCounter;
+  TEncSbac***            rdSbacCoders;
+  TEncSbac               rdGoOnSbacCoder;
+#if FAST_BIT_EST
+  TEncBinCABACCounter*** binCoders;
+  TEncBinCABACCounter    rdGoOnBinCoder;
+#else
+  TEncBinCABAC***        binCoders;
+  TEncBinCABAC           rdGoOnBinCoder;
+#endif
+
+  // task: modes evaluated one after the other, keeping the best of them
+  Int                    numModes;
+  PredMode               predMode[2];
+  PartSize               partSize[2];
+  Bool                   useMRG;
+  Bool                   blockable;      ///< not tested when the Cbf fast mode has blocked further PUs
+  Bool                   updateBlock;    ///< the Cbf fast mode decision is updated when the candidate is chosen
+};
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -114,6 +147,27 @@ Void TEncCu::destroy()
 {
   Int i;
 
+  m_candidateThreadPool.destroy();
+  for (size_t w = 0; w < m_candidateWorkers.size(); w++)
+  {
+    CandidateWorker *pcWorker = m_candidateWorkers[w];
+    pcWorker->cuEncoder.destroy();
+    for ( UInt uiDepth = 0; uiDepth < m_uhTotalDepth; uiDepth++ )
+    {
+      for ( Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx++ )
+      {
+        delete pcWorker->rdSbacCoders[uiDepth][iCIIdx];
+        delete pcWorker->binCoders[uiDepth][iCIIdx];
+      }
+      delete [] pcWorker->rdSbacCoders[uiDepth];
+      delete [] pcWorker->binCoders[uiDepth];
+    }
+    delete [] pcWorker->rdSbacCoders;
+    delete [] pcWorker->binCoders;
+    delete pcWorker;
+  }
+  m_candidateWorkers.clear();
+
   for( i=0 ; i<m_uhTotalDepth-1 ; i++)
   {
     if(m_ppcBestCU[i])
@@ -225,6 +279,116 @@ Void TEncCu::init( TEncTop* pcEncTop )
 #if JVET_Y0077_BIM
   m_BimQPoffset        = 0;
 #endif
+  m_cuTreeQPoffset     = 0;
+  m_ctuMinDepth        = 0;
+  m_ctuMaxDepth        = MAX_CU_DEPTH;
+}
+
+/** Each worker context mirrors the search, transform, RD cost and entropy coding set-up of the encoder, so that the
+ *  mode candidates of a CU evaluated on it give the same result as in the sequential evaluation.
+ * \param    pcEncTop      pointer of encoder class
+ * \param    sps           SPS providing the CU size and the scaling lists
+ */
+Void TEncCu::createCandidateWorkers( TEncTop* pcEncTop, TComSPS &sps )
+{
+  if ( pcEncTop->getParallelRDCandidates() <= 0 )
+  {
+    return;
+  }
+
+  const UInt maxTotalCUDepth = sps.getMaxTotalCUDepth();
+  const Int  maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE] =
+  {
+    sps.getMaxLog2TrDynamicRange(CHANNEL_TYPE_LUMA),
+    sps.getMaxLog2TrDynamicRange(CHANNEL_TYPE_CHROMA)
+  };
+
+  for ( Int w = 0; w < MAX_PARALLEL_CANDIDATE_TASKS; w++ )
+  {
+    CandidateWorker *pcWorker = new CandidateWorker;
+
+#if FAST_BIT_EST
+    pcWorker->binCoders    = new TEncBinCABACCounter** [maxTotalCUDepth+1];
+#else
+    pcWorker->binCoders    = new TEncBinCABAC** [maxTotalCUDepth+1];
+#endif
+    pcWorker->rdSbacCoders = new TEncSbac** [maxTotalCUDepth+1];
+    for ( UInt uiDepth = 0; uiDepth < maxTotalCUDepth+1; uiDepth++ )
+    {
+      pcWorker->rdSbacCoders[uiDepth] = new TEncSbac* [CI_NUM];
+#if FAST_BIT_EST
+      pcWorker->binCoders[uiDepth]    = new TEncBinCABACCounter* [CI_NUM];
+#else
+      pcWorker->binCoders[uiDepth]    = new TEncBinCABAC* [CI_NUM];
+#endif
+      for ( Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx++ )
+      {
+        pcWorker->rdSbacCoders[uiDepth][iCIIdx] = new TEncSbac;
+#if FAST_BIT_EST
+        pcWorker->binCoders[uiDepth][iCIIdx]    = new TEncBinCABACCounter;
+#else
+        pcWorker->binCoders[uiDepth][iCIIdx]    = new TEncBinCABAC;
+#endif
+        pcWorker->rdSbacCoders[uiDepth][iCIIdx]->init( pcWorker->binCoders[uiDepth][iCIIdx] );
+      }
+    }
+    pcWorker->rdGoOnSbacCoder.init( &pcWorker->rdGoOnBinCoder );
+    pcWorker->entropyCoder.setEntropyCoder( &pcWorker->rdGoOnSbacCoder );
+    pcWorker->entropyCoder.setBitstream( &pcWorker->bitCounter );
+    pcWorker->rdGoOnBinCoder.setBinCountingEnableFlag( true );
+
+    pcWorker->trQuant.init( 1 << pcEncTop->getQuadtreeTULog2MaxSize(),
+                            pcEncTop->getUseRDOQ(),
+                            pcEncTop->getUseRDOQTS(),
+                            pcEncTop->getUseSelectiveRDOQ(),
+                            pcEncTop->getUseFastRDOQ(),
+                            true
+                           ,pcEncTop->getUseTransformSkipFast()
+#if ADAPTIVE_QP_SELECTION
+                           ,pcEncTop->getUseAdaptQpSelect()
+#endif
+                           );
+    if ( pcEncTop->getUseScalingListId() == SCALING_LIST_OFF )
+    {
+      pcWorker->trQuant.setFlatScalingList( maxLog2TrDynamicRange, sps.getBitDepths() );
+      pcWorker->trQuant.setUseScalingList( false );
+    }
+    else
+    {
+      pcWorker->trQuant.setScalingList( &(sps.getScalingList()), maxLog2TrDynamicRange, sps.getBitDepths() );
+      pcWorker->trQuant.setUseScalingList( true );
+    }
+
+    pcWorker->search.init( pcEncTop, &pcWorker->trQuant, pcEncTop->getSearchRange(), pcEncTop->getBipredSearchRange(), pcEncTop->getMotionEstimationSearchMethod(),
+                           sps.getMaxCUWidth(), sps.getMaxCUHeight(), maxTotalCUDepth, &pcWorker->entropyCoder, &pcWorker->rdCost, pcWorker->rdSbacCoders, &pcWorker->rdGoOnSbacCoder );
+
+    TEncCu &cuEncoder = pcWorker->cuEncoder;
+    cuEncoder.create( maxTotalCUDepth, sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getChromaFormatIdc() );
+    cuEncoder.m_pcEncCfg          = pcEncTop;
+    cuEncoder.m_pcPredSearch      = &pcWorker->search;
+    cuEncoder.m_pcTrQuant         = &pcWorker->trQuant;
+    cuEncoder.m_pcRdCost          = &pcWorker->rdCost;
+    cuEncoder.m_pcEntropyCoder    = &pcWorker->entropyCoder;
+    cuEncoder.m_pcBinCABAC        = NULL;
+    cuEncoder.m_pppcRDSbacCoder   = pcWorker->rdSbacCoders;
+    cuEncoder.m_pcRDGoOnSbacCoder = &pcWorker->rdGoOnSbacCoder;
+    cuEncoder.m_pcRateCtrl        = pcEncTop->getRateCtrl();
+    cuEncoder.m_pcSliceEncoder    = NULL;
+    cuEncoder.m_lumaQPOffset      = 0;
+#if JVET_V0078
+    cuEncoder.m_smoothQPoffset    = 0;
+#endif
+#if JVET_Y0077_BIM
+    cuEncoder.m_BimQPoffset       = 0;
+#endif
+    cuEncoder.m_cuTreeQPoffset    = 0;
+    cuEncoder.m_ctuMinDepth       = 0;
+    cuEncoder.m_ctuMaxDepth       = MAX_CU_DEPTH;
+
+    m_candidateWorkers.push_back( pcWorker );
+  }
+
+  m_candidateThreadPool.create( pcEncTop->getParallelRDCandidates() );
 }
 
 // ====================================================================================================================
@@ -236,17 +400,37 @@ Void TEncCu::init( TEncTop* pcEncTop )
  */
 Void TEncCu::compressCtu( TComDataCU* pCtu )
 {
+  PROFILE_COUNT( PROF_COUNTER_ENC_CTUS, 1 );
   // initialize CU data
   m_ppcBestCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
   m_ppcTempCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
   m_bEncodeDQP         = false;
 
+  memset( m_numCtuStatsChecked, 0, sizeof( m_numCtuStatsChecked ) );
+  for ( size_t w = 0; w < m_candidateWorkers.size(); w++ )
+  {
+    memset( m_candidateWorkers[w]->cuEncoder.m_numCtuStatsChecked, 0, sizeof( m_numCtuStatsChecked ) );
+  }
+
+  // restrict the depth range to be searched
+  m_ctuMinDepth = 0;
+  m_ctuMaxDepth = MAX_CU_DEPTH;
+  if ( m_pcEncCfg->getDepthRangePrediction() )
+  {
+    xPredictDepthRange( pCtu );
+  }
+
   // analysis of CU
   DEBUG_STRING_NEW(sDebug)
 
   xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 DEBUG_STRING_PASS_INTO(sDebug) );
   DEBUG_STRING_OUTPUT(std::cout, sDebug)
 
+  if ( m_pcEncCfg->getDepthRangePrediction() )
+  {
+    xStoreDepthRange( pCtu );
+  }
+
 #if ADAPTIVE_QP_SELECTION
   if( m_pcEncCfg->getUseAdaptQpSelect() )
   {
@@ -524,6 +708,8 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const UInt uiDepth )
 #endif
 {
+  PROFILE_SCOPE_DEPTH( PROF_ENC_COMPRESS_CU, uiDepth );
+  m_numCtuStatsChecked[CTU_STATS_CU_NODE]++;
   TComPic* pcPic = rpcBestCU->getPic();
   DEBUG_STRING_NEW(sDebug)
   const TComPPS &pps=*(rpcTempCU->getSlice()->getPPS());
@@ -632,6 +818,14 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
   }
 #endif
 
+  if ( m_pcEncCfg->getCuTree() && uiDepth <= pps.getMaxCuDQPDepth() )
+  {
+    // below the quantization group depth the QP is inherited and already contains the offset
+    m_cuTreeQPoffset = xGetCuTreeQPOffset( rpcTempCU );
+    iMinQP = Clip3( -sps.getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, iMinQP + m_cuTreeQPoffset );
+    iMaxQP = Clip3( -sps.getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, iMaxQP + m_cuTreeQPoffset );
+  }
+
   if ( m_pcEncCfg->getUseRateCtrl() )
   {
     iMinQP = m_pcRateCtrl->getRCQP();
@@ -655,8 +849,10 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
   TComSlice * pcSlice = rpcTempCU->getPic()->getSlice(rpcTempCU->getPic()->getCurrSliceIdx());
 
   const Bool bBoundary = !( uiRPelX < sps.getPicWidthInLumaSamples() && uiBPelY < sps.getPicHeightInLumaSamples() );
+  // below the predicted minimum depth the CU is split without testing any mode, as at the picture boundary
+  const Bool bForceSplit = !bBoundary && uiDepth < m_ctuMinDepth;
 
-  if ( !bBoundary )
+  if ( !bBoundary && !bForceSplit )
   {
     for (Int iQP=iMinQP; iQP<=iMaxQP; iQP++)
     {
@@ -667,12 +863,12 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         iQP = lowestQP;
       }
 #if JVET_Y0077_BIM
-      if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable() || m_pcEncCfg->getBIM()) && uiDepth <= pps.getMaxCuDQPDepth())
+      if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable() || m_pcEncCfg->getBIM() || m_pcEncCfg->getCuTree()) && uiDepth <= pps.getMaxCuDQPDepth())
 #else
 #if JVET_V0078
-	  if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable()) && uiDepth <= pps.getMaxCuDQPDepth())
+	  if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable() || m_pcEncCfg->getCuTree()) && uiDepth <= pps.getMaxCuDQPDepth())
 #else
-	  if ( m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() && uiDepth <= pps.getMaxCuDQPDepth() )
+	  if ( (m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getCuTree()) && uiDepth <= pps.getMaxCuDQPDepth() )
 #endif
 #endif
       {
@@ -738,8 +934,18 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
         rpcTempCU->initEstData( uiDepth, iQP, bIsLosslessMode );
 
+        const Bool bParallelCandidates = !m_candidateWorkers.empty() && rpcBestCU->getSlice()->getSliceType() != I_SLICE;
+        if ( bParallelCandidates )
+        {
+#if AMP_ENC_SPEEDUP
+          xCheckRDCostParallel( rpcBestCU, rpcTempCU, uiDepth, iQP, bIsLosslessMode, eParentPartSize, doNotBlockPu );
+#else
+          xCheckRDCostParallel( rpcBestCU, rpcTempCU, uiDepth, iQP, bIsLosslessMode, NUMBER_OF_PART_SIZES, doNotBlockPu );
+#endif
+        }
+
         // do inter modes, NxN, 2NxN, and Nx2N
-        if( rpcBestCU->getSlice()->getSliceType() != I_SLICE )
+        if( rpcBestCU->getSlice()->getSliceType() != I_SLICE && !bParallelCandidates )
         {
           // 2Nx2N, NxN
 
@@ -887,20 +1093,20 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         // do normal intra modes
         // speedup for inter frames
 #if MCTS_ENC_CHECK
-        if ( m_pcEncCfg->getTMCTSSEITileConstraint() || (rpcBestCU->getSlice()->getSliceType() == I_SLICE) ||
+        if ( !bParallelCandidates && (m_pcEncCfg->getTMCTSSEITileConstraint() || (rpcBestCU->getSlice()->getSliceType() == I_SLICE) ||
              ((!m_pcEncCfg->getDisableIntraPUsInInterSlices()) && (
              (rpcBestCU->getCbf(0, COMPONENT_Y) != 0) ||
              ((rpcBestCU->getCbf(0, COMPONENT_Cb) != 0) && (numberValidComponents > COMPONENT_Cb)) ||
              ((rpcBestCU->getCbf(0, COMPONENT_Cr) != 0) && (numberValidComponents > COMPONENT_Cr))  // avoid very complex intra if it is unlikely
-            )))
+            ))))
         {
 #else
-        if((rpcBestCU->getSlice()->getSliceType() == I_SLICE)                                        ||
+        if(!bParallelCandidates && ((rpcBestCU->getSlice()->getSliceType() == I_SLICE)               ||
             ((!m_pcEncCfg->getDisableIntraPUsInInterSlices()) && (
               (rpcBestCU->getCbf( 0, COMPONENT_Y  ) != 0)                                            ||
              ((rpcBestCU->getCbf( 0, COMPONENT_Cb ) != 0) && (numberValidComponents > COMPONENT_Cb)) ||
              ((rpcBestCU->getCbf( 0, COMPONENT_Cr ) != 0) && (numberValidComponents > COMPONENT_Cr))  // avoid very complex intra if it is unlikely
-            )))
+            ))))
         {
 #endif 
           xCheckRDCostIntra( rpcBestCU, rpcTempCU, SIZE_2Nx2N DEBUG_STRING_PASS_INTO(sDebug) );
@@ -969,6 +1175,11 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
       iMaxQP += iOffset;
     }
 #endif
+    if (m_pcEncCfg->getCuTree())
+    {
+      iMinQP = Clip3( -sps.getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, iMinQP + m_cuTreeQPoffset );
+      iMaxQP = Clip3( -sps.getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, iMaxQP + m_cuTreeQPoffset );
+    }
   }
   else if( uiDepth < pps.getMaxCuDQPDepth() )
   {
@@ -999,16 +1210,31 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
     iMaxQP = iMinQP; // If all TUs are forced into using transquant bypass, do not loop here.
   }
 
-  const Bool bSubBranch = bBoundary || !( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->getTotalCost()!=MAX_DOUBLE && rpcBestCU->isSkipped(0) );
+  const Bool bSubBranch = bBoundary || bForceSplit || !( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->getTotalCost()!=MAX_DOUBLE && rpcBestCU->isSkipped(0) );
+  const Bool bDepthAllowed = bBoundary || uiDepth < m_ctuMaxDepth;
 
-  if( bSubBranch && uiDepth < sps.getLog2DiffMaxMinCodingBlockSize() && (!getFastDeltaQp() || uiWidth > fastDeltaQPCuMaxSize || bBoundary))
+  if( bSubBranch && bDepthAllowed && uiDepth < sps.getLog2DiffMaxMinCodingBlockSize() && (!getFastDeltaQp() || uiWidth > fastDeltaQPCuMaxSize || bBoundary || bForceSplit))
   {
     // further split
     Double splitTotalCost = 0;
+    // with CU-level QP adaptation, the sub-CUs may be coded with different lambdas and their costs are summed
+#if JVET_Y0077_BIM
+    const Bool bSplitTotalCost = (m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable() || m_pcEncCfg->getBIM() || m_pcEncCfg->getCuTree()) && pps.getMaxCuDQPDepth() >= 1;
+#elif JVET_V0078
+    const Bool bSplitTotalCost = (m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable() || m_pcEncCfg->getCuTree()) && pps.getMaxCuDQPDepth() >= 1;
+#else
+    const Bool bSplitTotalCost = (m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getCuTree()) && pps.getMaxCuDQPDepth() >= 1;
+#endif
+    // the split is abandoned once the sub-CUs coded so far cost as much as the best unsplit mode, as the cost can only
+    // grow with the remaining sub-CUs; not with byte-limited slices, where the split may be forced to end the slice
+    const Bool bSplitEarlyTermination = m_pcEncCfg->getSplitEarlyTermination()
+                                     && pcSlice->getSliceMode()        != FIXED_NUMBER_OF_BYTES
+                                     && pcSlice->getSliceSegmentMode() != FIXED_NUMBER_OF_BYTES;
 
     for (Int iQP=iMinQP; iQP<=iMaxQP; iQP++)
     {
       const Bool bIsLosslessMode = false; // False at this level. Next level down may set it to true.
+      Bool       bSplitTerminated = false;
 
       rpcTempCU->initEstData( uiDepth, iQP, bIsLosslessMode );
 
@@ -1051,18 +1277,19 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
           rpcTempCU->copyPartFrom( pcSubBestPartCU, uiPartUnitIdx, uhNextDepth );         // Keep best part data to current temporary data.
           xCopyYuv2Tmp( pcSubBestPartCU->getTotalNumPart()*uiPartUnitIdx, uhNextDepth );
-#if JVET_Y0077_BIM
-          if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable() || m_pcEncCfg->getBIM()) && pps.getMaxCuDQPDepth() >= 1)
-#else
-#if JVET_V0078
-		  if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable()) && pps.getMaxCuDQPDepth() >= 1)
-#else
-		  if ( m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() && pps.getMaxCuDQPDepth() >= 1 )
-#endif
-#endif
+          if ( bSplitTotalCost )
           {
             splitTotalCost += pcSubBestPartCU->getTotalCost();
           }
+          if ( bSplitEarlyTermination && uiPartUnitIdx < 3 )
+          {
+            const Double partialCost = bSplitTotalCost ? splitTotalCost : m_pcRdCost->calcRdCost( rpcTempCU->getTotalBits(), rpcTempCU->getTotalDistortion() );
+            if ( partialCost >= rpcBestCU->getTotalCost() )
+            {
+              bSplitTerminated = true;
+              break;
+            }
+          }
         }
         else
         {
@@ -1071,20 +1298,17 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         }
       }
 
+      if ( bSplitTerminated )
+      {
+        continue;
+      }
+
       m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[uhNextDepth][CI_NEXT_BEST]);
       if( !bBoundary )
       {
         m_pcEntropyCoder->resetBits();
         m_pcEntropyCoder->encodeSplitFlag( rpcTempCU, 0, uiDepth, true );
-#if JVET_Y0077_BIM
-        if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable() || m_pcEncCfg->getBIM()) && pps.getMaxCuDQPDepth() >= 1)
-#else
-#if JVET_V0078
-        if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable()) && pps.getMaxCuDQPDepth() >= 1)
-#else
-        if ( m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() && pps.getMaxCuDQPDepth() >= 1 )
-#endif
-#endif
+        if ( bSplitTotalCost )
         {
           Int splitBits = m_pcEntropyCoder->getNumberOfWrittenBits();
           Double splitBitCost = m_pcRdCost->calcRdCost( splitBits, 0 );
@@ -1095,15 +1319,7 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         rpcTempCU->getTotalBins() += ((TEncBinCABAC *)((TEncSbac*)m_pcEntropyCoder->m_pcEntropyCoderIf)->getEncBinIf())->getBinsCoded();
       }
 
-#if JVET_Y0077_BIM
-      if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable() || m_pcEncCfg->getBIM()) && pps.getMaxCuDQPDepth() >= 1)
-#else
-#if JVET_V0078
-      if ((m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() || m_pcEncCfg->getSmoothQPReductionEnable()) && pps.getMaxCuDQPDepth() >= 1)
-#else
-      if ( m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() && pps.getMaxCuDQPDepth() >= 1 )
-#endif
-#endif
+      if ( bSplitTotalCost )
       {
         rpcTempCU->getTotalCost() = splitTotalCost;
       }
@@ -1244,6 +1460,185 @@ Int TEncCu::xComputeQP( TComDataCU* pcCU, UInt uiDepth )
   return Clip3(-pcCU->getSlice()->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, iBaseQp+iQpOffset );
 }
 
+/** Predict the range of CU depths to be searched in a CTU of an inter slice from the depths chosen in the left and
+ *  above CTUs and in the co-located CTUs of the first reference picture of each list. The range is only restricted if
+ *  at least three of these CTUs are available and, like the current CTU, lie completely inside the picture.
+ * \param pCtu CTU to be compressed
+ */
+Void TEncCu::xPredictDepthRange( TComDataCU* pCtu )
+{
+  const TComSPS &sps       = *(pCtu->getSlice()->getSPS());
+  TComSlice     *pcSlice   = pCtu->getSlice();
+  const Int      poc       = pcSlice->getPOC();
+  const UInt     ctuRsAddr = pCtu->getCtuRsAddr();
+  const UInt     widthInCtus = pCtu->getPic()->getFrameWidthInCtus();
+
+  // only keep the depth ranges of pictures that may still be referenced
+  if ( m_ctuDepthRanges.find( poc ) == m_ctuDepthRanges.end() )
+  {
+    const TComReferencePictureSet *pRPS = pcSlice->getRPS();
+    std::map<Int, std::vector<CtuDepthRange> >::iterator it = m_ctuDepthRanges.begin();
+    while ( it != m_ctuDepthRanges.end() )
+    {
+      Bool bKeep = false;
+      for ( Int i = 0; i < pRPS->getNumberOfPictures() && !bKeep; i++ )
+      {
+        bKeep = ( it->first == poc + pRPS->getDeltaPOC(i) );
+      }
+      if ( bKeep )
+      {
+        ++it;
+      }
+      else
+      {
+        m_ctuDepthRanges.erase( it++ );
+      }
+    }
+    m_ctuDepthRanges[poc].resize( pCtu->getPic()->getNumberOfCtusInFrame() );
+  }
+
+  if ( pcSlice->isIntra() )
+  {
+    return;
+  }
+  m_depthRangeStats.numCtus++;
+  if ( pCtu->getCUPelX() + sps.getMaxCUWidth()  > sps.getPicWidthInLumaSamples()
+    || pCtu->getCUPelY() + sps.getMaxCUHeight() > sps.getPicHeightInLumaSamples() )
+  {
+    return;
+  }
+
+  const CtuDepthRange *neighbours[2 + NUM_REF_PIC_LIST_01];
+  Int numNeighbours = 0;
+  const std::vector<CtuDepthRange> &currRanges = m_ctuDepthRanges[poc];
+  if ( ctuRsAddr % widthInCtus > 0 )
+  {
+    neighbours[numNeighbours++] = &currRanges[ctuRsAddr - 1];
+  }
+  if ( ctuRsAddr >= widthInCtus )
+  {
+    neighbours[numNeighbours++] = &currRanges[ctuRsAddr - widthInCtus];
+  }
+  for ( Int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+  {
+    const RefPicList eRefPicList = RefPicList(list);
+    if ( pcSlice->getNumRefIdx(eRefPicList) == 0 || ( list == REF_PIC_LIST_1 && pcSlice->getRefPOC(REF_PIC_LIST_1, 0) == pcSlice->getRefPOC(REF_PIC_LIST_0, 0) ) )
+    {
+      continue;
+    }
+    std::map<Int, std::vector<CtuDepthRange> >::const_iterator it = m_ctuDepthRanges.find( pcSlice->getRefPOC(eRefPicList, 0) );
+    if ( it != m_ctuDepthRanges.end() )
+    {
+      neighbours[numNeighbours++] = &it->second[ctuRsAddr];
+    }
+  }
+
+  UInt minDepth = MAX_CU_DEPTH;
+  UInt maxDepth = 0;
+  Int  numAvailable = 0;
+  for ( Int i = 0; i < numNeighbours; i++ )
+  {
+    if ( neighbours[i]->valid )
+    {
+      minDepth = std::min<UInt>( minDepth, neighbours[i]->minDepth );
+      maxDepth = std::max<UInt>( maxDepth, neighbours[i]->maxDepth );
+      numAvailable++;
+    }
+  }
+
+  if ( numAvailable >= 3 && ( minDepth > 0 || maxDepth < sps.getLog2DiffMaxMinCodingBlockSize() ) )
+  {
+    m_ctuMinDepth = minDepth;
+    m_ctuMaxDepth = maxDepth;
+    m_depthRangeStats.numRestricted++;
+  }
+}
+
+/** Store the depth range chosen in a CTU, and count the restricted CTUs for which the chosen CU depths reach the
+ *  predicted bounds, i.e. the cases in which the restriction may have changed the decision.
+ */
+Void TEncCu::xStoreDepthRange( TComDataCU* pCtu )
+{
+  const TComSPS &sps = *(pCtu->getSlice()->getSPS());
+  CtuDepthRange &range = m_ctuDepthRanges[pCtu->getSlice()->getPOC()][pCtu->getCtuRsAddr()];
+
+  range.valid = pCtu->getCUPelX() + sps.getMaxCUWidth()  <= sps.getPicWidthInLumaSamples()
+             && pCtu->getCUPelY() + sps.getMaxCUHeight() <= sps.getPicHeightInLumaSamples();
+  if ( !range.valid )
+  {
+    return;
+  }
+  range.minDepth = MAX_CU_DEPTH;
+  range.maxDepth = 0;
+  for ( UInt uiPartIdx = 0; uiPartIdx < pCtu->getTotalNumPart(); uiPartIdx++ )
+  {
+    range.minDepth = std::min<UChar>( range.minDepth, pCtu->getDepth(uiPartIdx) );
+    range.maxDepth = std::max<UChar>( range.maxDepth, pCtu->getDepth(uiPartIdx) );
+  }
+
+  if ( m_ctuMinDepth > 0 && range.minDepth == m_ctuMinDepth )
+  {
+    m_depthRangeStats.numAtMinBound++;
+  }
+  if ( m_ctuMaxDepth < sps.getLog2DiffMaxMinCodingBlockSize() && range.maxDepth == m_ctuMaxDepth )
+  {
+    m_depthRangeStats.numAtMaxBound++;
+  }
+}
+
+Void TEncCu::printDepthRangeStats() const
+{
+  const DepthRangeStats &s = m_depthRangeStats;
+  printf("\nDepth range prediction: %llu of %llu inter CTUs restricted, chosen depth at predicted minimum: %llu, at predicted maximum: %llu\n",
+         (unsigned long long)s.numRestricted, (unsigned long long)s.numCtus, (unsigned long long)s.numAtMinBound, (unsigned long long)s.numAtMaxBound);
+}
+
+Void TEncCu::getCtuStatsChecked( UInt numChecked[NUMBER_OF_CTU_STATS_CANDIDATES] ) const
+{
+  for ( Int i = 0; i < NUMBER_OF_CTU_STATS_CANDIDATES; i++ )
+  {
+    numChecked[i] = m_numCtuStatsChecked[i];
+    for ( size_t w = 0; w < m_candidateWorkers.size(); w++ )
+    {
+      numChecked[i] += m_candidateWorkers[w]->cuEncoder.m_numCtuStatsChecked[i];
+    }
+  }
+}
+
+/** Derive the CU-tree QP offset of a quantization group
+ * \param pcCU Target CU
+ * \returns rounded average of the lookahead QP offsets of the 16x16 blocks covered by the CU
+ */
+Int TEncCu::xGetCuTreeQPOffset( TComDataCU* pcCU )
+{
+  std::map<Int, std::vector<Double> > *qpOffsetMap = m_pcEncCfg->getCuTreeQPOffsetMap();
+  std::map<Int, std::vector<Double> >::const_iterator it = qpOffsetMap->find( pcCU->getPic()->getPOC() );
+  if ( it == qpOffsetMap->end() || it->second.empty() )
+  {
+    return 0;
+  }
+
+  const TComSPS &sps          = *(pcCU->getSlice()->getSPS());
+  const Int     blockSize     = TEncLookahead::s_blockSize;
+  const Int     widthInBlocks = ( Int(sps.getPicWidthInLumaSamples()) + blockSize - 1 ) / blockSize;
+  const Int     startX        = pcCU->getCUPelX() / blockSize;
+  const Int     startY        = pcCU->getCUPelY() / blockSize;
+  const Int     endX          = ( std::min( pcCU->getCUPelX() + pcCU->getWidth(0),  sps.getPicWidthInLumaSamples() )  + blockSize - 1 ) / blockSize;
+  const Int     endY          = ( std::min( pcCU->getCUPelY() + pcCU->getHeight(0), sps.getPicHeightInLumaSamples() ) + blockSize - 1 ) / blockSize;
+
+  Double sum = 0;
+  Int    num = 0;
+  for ( Int y = startY; y < endY; y++ )
+  {
+    for ( Int x = startX; x < endX; x++ )
+    {
+      sum += it->second[y * widthInBlocks + x];
+      num++;
+    }
+  }
+  return num > 0 ? Int(floor( sum / num + 0.5 )) : 0;
+}
+
 /** encode a CU block recursively
  * \param pcCU
  * \param uiAbsPartIdx
@@ -1553,6 +1948,7 @@ Void TEncCu::xCheckRDCostMerge2Nx2N( TComDataCU*& rpcBestCU, TComDataCU*& rpcTem
           }
 
 #endif
+          m_numCtuStatsChecked[CTU_STATS_MERGE]++;
           // do MC
           m_pcPredSearch->motionCompensation ( rpcTempCU, m_ppcPredYuvTemp[uhDepth] );
           // estimate residual and encode everything
@@ -1639,6 +2035,7 @@ Void TEncCu::xCheckRDCostInter( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU,
       return; // only check necessary 2Nx2N Inter in fast deltaqp mode
     }
   }
+  m_numCtuStatsChecked[ePartSize == SIZE_2Nx2N ? CTU_STATS_INTER_2Nx2N : ( ePartSize >= SIZE_2NxnU ? CTU_STATS_INTER_AMP : CTU_STATS_INTER_SMP )]++;
 
   // prior to this, rpcTempCU will have just been reset using rpcTempCU->initEstData( uiDepth, iQP, bIsLosslessMode );
   UChar uhDepth = rpcTempCU->getDepth( 0 );
@@ -1699,6 +2096,7 @@ Void TEncCu::xCheckRDCostIntra( TComDataCU *&rpcBestCU,
       return; // only check necessary 2Nx2N Intra in fast deltaqp mode
     }
   }
+  m_numCtuStatsChecked[eSize == SIZE_NxN ? CTU_STATS_INTRA_NxN : CTU_STATS_INTRA_2Nx2N]++;
 
   UInt uiDepth = rpcTempCU->getDepth( 0 );
 
@@ -1751,6 +2149,215 @@ Void TEncCu::xCheckRDCostIntra( TComDataCU *&rpcBestCU,
 }
 
 
+/** Evaluate the inter partitions after SKIP/merge and 2Nx2N, and the intra modes, on the candidate workers.
+ * The candidates are evaluated speculatively, independently of each other, and then compared in the order of the
+ * sequential evaluation. The decisions that depend on the best mode so far (Cbf fast mode, AMP speed-up, intra
+ * condition) are applied during the comparison, so that the result is identical to the sequential evaluation.
+ * \param rpcBestCU      best CU so far
+ * \param rpcTempCU      temporary CU
+ * \param uiDepth        CU depth
+ * \param iQP            QP of the candidates
+ * \param bIsLosslessMode transquant bypass of the candidates
+ * \param eParentPartSize partition size of the parent CU, used by the AMP speed-up
+ * \param doNotBlockPu   Cbf fast mode decision, updated by the chosen candidates
+ */
+Void TEncCu::xCheckRDCostParallel( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const UInt uiDepth, const Int iQP, const Bool bIsLosslessMode, PartSize eParentPartSize, Bool &doNotBlockPu )
+{
+  const TComSPS &sps = *(rpcTempCU->getSlice()->getSPS());
+  const UInt numberValidComponents = rpcBestCU->getPic()->getNumberValidComponents();
+  Int numTasks = 0;
+
+  // NxN, Nx2N and 2NxN
+  if ( doNotBlockPu )
+  {
+    if ( !( (rpcBestCU->getWidth(0)==8) && (rpcBestCU->getHeight(0)==8) ) && uiDepth == sps.getLog2DiffMaxMinCodingBlockSize() )
+    {
+      xSetCandidateTask( numTasks++, MODE_INTER, SIZE_NxN, false, true, false );
+    }
+    xSetCandidateTask( numTasks++, MODE_INTER, SIZE_Nx2N, false, true, true );
+    xSetCandidateTask( numTasks++, MODE_INTER, SIZE_2NxN, false, true, true );
+  }
+  xRunCandidateTasks( rpcTempCU, uiDepth, iQP, bIsLosslessMode, numTasks );
+  for ( Int i = 0; i < numTasks; i++ )
+  {
+    xCommitCandidateTask( rpcBestCU, rpcTempCU, uiDepth, iQP, bIsLosslessMode, m_candidateWorkers[i], doNotBlockPu );
+  }
+
+  // AMP, which depends on the best partition so far, and intra
+  numTasks = 0;
+  if ( sps.getUseAMP() && uiDepth < sps.getLog2DiffMaxMinCodingBlockSize() )
+  {
+#if AMP_ENC_SPEEDUP
+    Bool bTestAMP_Hor = false, bTestAMP_Ver = false;
+    Bool bTestMergeAMP_Hor = false, bTestMergeAMP_Ver = false;
+#if AMP_MRG
+    deriveTestModeAMP (rpcBestCU, eParentPartSize, bTestAMP_Hor, bTestAMP_Ver, bTestMergeAMP_Hor, bTestMergeAMP_Ver);
+#else
+    deriveTestModeAMP (rpcBestCU, eParentPartSize, bTestAMP_Hor, bTestAMP_Ver);
+#endif
+    if ( doNotBlockPu )
+    {
+      if ( bTestAMP_Hor || bTestMergeAMP_Hor )
+      {
+        xSetCandidateTask( numTasks++, MODE_INTER, SIZE_2NxnU, !bTestAMP_Hor, true, true );
+        xSetCandidateTask( numTasks++, MODE_INTER, SIZE_2NxnD, !bTestAMP_Hor, true, true );
+      }
+      if ( bTestAMP_Ver || bTestMergeAMP_Ver )
+      {
+        xSetCandidateTask( numTasks++, MODE_INTER, SIZE_nLx2N, !bTestAMP_Ver, true, true );
+        xSetCandidateTask( numTasks++, MODE_INTER, SIZE_nRx2N, !bTestAMP_Ver, true, false );
+      }
+    }
+#else
+    xSetCandidateTask( numTasks++, MODE_INTER, SIZE_2NxnU, false, false, false );
+    xSetCandidateTask( numTasks++, MODE_INTER, SIZE_2NxnD, false, false, false );
+    xSetCandidateTask( numTasks++, MODE_INTER, SIZE_nLx2N, false, false, false );
+    xSetCandidateTask( numTasks++, MODE_INTER, SIZE_nRx2N, false, false, false );
+#endif
+  }
+  const Int numInterTasks = numTasks;
+
+  // the intra modes share one worker, as both write their reconstruction into the picture
+#if MCTS_ENC_CHECK
+  if ( m_pcEncCfg->getTMCTSSEITileConstraint() || !m_pcEncCfg->getDisableIntraPUsInInterSlices() )
+#else
+  if ( !m_pcEncCfg->getDisableIntraPUsInInterSlices() )
+#endif
+  {
+    CandidateWorker *pcIntraWorker = m_candidateWorkers[numTasks];
+    xSetCandidateTask( numTasks++, MODE_INTRA, SIZE_2Nx2N, false, false, false );
+    if ( uiDepth == sps.getLog2DiffMaxMinCodingBlockSize() && rpcTempCU->getWidth(0) > ( 1 << sps.getQuadtreeTULog2MinSize() ) )
+    {
+      pcIntraWorker->predMode[1] = MODE_INTRA;
+      pcIntraWorker->partSize[1] = SIZE_NxN;
+      pcIntraWorker->numModes    = 2;
+    }
+  }
+  xRunCandidateTasks( rpcTempCU, uiDepth, iQP, bIsLosslessMode, numTasks );
+  for ( Int i = 0; i < numInterTasks; i++ )
+  {
+    xCommitCandidateTask( rpcBestCU, rpcTempCU, uiDepth, iQP, bIsLosslessMode, m_candidateWorkers[i], doNotBlockPu );
+  }
+
+  if ( numTasks > numInterTasks )
+  {
+#if MCTS_ENC_CHECK
+    const Bool bCheckIntra = m_pcEncCfg->getTMCTSSEITileConstraint() ||
+#else
+    const Bool bCheckIntra =
+#endif
+                             (rpcBestCU->getCbf( 0, COMPONENT_Y  ) != 0)                                            ||
+                            ((rpcBestCU->getCbf( 0, COMPONENT_Cb ) != 0) && (numberValidComponents > COMPONENT_Cb)) ||
+                            ((rpcBestCU->getCbf( 0, COMPONENT_Cr ) != 0) && (numberValidComponents > COMPONENT_Cr));
+    if ( bCheckIntra )
+    {
+      CandidateWorker *pcIntraWorker = m_candidateWorkers[numInterTasks];
+      xCommitCandidateTask( rpcBestCU, rpcTempCU, uiDepth, iQP, bIsLosslessMode, pcIntraWorker, doNotBlockPu );
+      m_bEncodeDQP                    = pcIntraWorker->cuEncoder.m_bEncodeDQP;
+      m_stillToCodeChromaQpOffsetFlag = pcIntraWorker->cuEncoder.m_stillToCodeChromaQpOffsetFlag;
+      m_pcPredSearch->addGradientIntraStats( pcIntraWorker->search );
+    }
+  }
+}
+
+Void TEncCu::xSetCandidateTask( const Int taskIdx, const PredMode ePredMode, const PartSize ePartSize, const Bool bUseMRG, const Bool bBlockable, const Bool bUpdateBlock )
+{
+  CandidateWorker *pcWorker = m_candidateWorkers[taskIdx];
+  pcWorker->numModes    = 1;
+  pcWorker->predMode[0] = ePredMode;
+  pcWorker->partSize[0] = ePartSize;
+  pcWorker->useMRG      = bUseMRG;
+  pcWorker->blockable   = bBlockable;
+  pcWorker->updateBlock = bUpdateBlock;
+}
+
+Void TEncCu::xRunCandidateTasks( TComDataCU* pcTempCU, const UInt uiDepth, const Int iQP, const Bool bIsLosslessMode, const Int numTasks )
+{
+  m_candidateThreadPool.run( numTasks, [&]( Int taskIdx )
+  {
+    xEvaluateCandidateTask( m_candidateWorkers[taskIdx], pcTempCU, uiDepth, iQP, bIsLosslessMode );
+  } );
+}
+
+/** Evaluate the modes of a task on its worker, starting from the state the sequential evaluation would have.
+ */
+Void TEncCu::xEvaluateCandidateTask( CandidateWorker* pcWorker, TComDataCU* pcTempCU, const UInt uiDepth, const Int iQP, const Bool bIsLosslessMode )
+{
+  TEncCu &cuEncoder = pcWorker->cuEncoder;
+
+  pcWorker->rdCost = *m_pcRdCost;
+#if RDOQ_CHROMA_LAMBDA
+  pcWorker->trQuant.setLambdas( m_pcTrQuant->getLambdas() );
+#else
+  pcWorker->trQuant.setLambda( m_pcTrQuant->getLambda() );
+#endif
+  pcWorker->search.copyMotionSearchState( *m_pcPredSearch );
+  pcWorker->rdGoOnSbacCoder.load( m_pcRDGoOnSbacCoder );
+  pcWorker->rdSbacCoders[uiDepth][CI_CURR_BEST]->load( m_pppcRDSbacCoder[uiDepth][CI_CURR_BEST] );
+
+  cuEncoder.m_bEncodeDQP                    = m_bEncodeDQP;
+  cuEncoder.m_bFastDeltaQP                  = m_bFastDeltaQP;
+  cuEncoder.m_stillToCodeChromaQpOffsetFlag = m_stillToCodeChromaQpOffsetFlag;
+  cuEncoder.m_cuChromaQpOffsetIdxPlus1      = m_cuChromaQpOffsetIdxPlus1;
+  cuEncoder.m_ppcOrigYuv[uiDepth]->copyFromPicYuv( pcTempCU->getPic()->getPicYuvOrg(), pcTempCU->getCtuRsAddr(), pcTempCU->getZorderIdxInCtu() );
+
+  TComDataCU *&rpcBestCU = cuEncoder.m_ppcBestCU[uiDepth];
+  TComDataCU *&rpcTempCU = cuEncoder.m_ppcTempCU[uiDepth];
+  rpcBestCU->initEstDataFrom( pcTempCU, uiDepth, iQP, bIsLosslessMode );
+  rpcTempCU->initEstDataFrom( pcTempCU, uiDepth, iQP, bIsLosslessMode );
+
+  pcWorker->search.resetGradientIntraStats();
+
+  DEBUG_STRING_NEW(sDebug)
+  for ( Int i = 0; i < pcWorker->numModes; i++ )
+  {
+    if ( pcWorker->predMode[i] == MODE_INTRA )
+    {
+      cuEncoder.xCheckRDCostIntra( rpcBestCU, rpcTempCU, pcWorker->partSize[i] DEBUG_STRING_PASS_INTO(sDebug) );
+    }
+    else
+    {
+#if AMP_MRG
+      cuEncoder.xCheckRDCostInter( rpcBestCU, rpcTempCU, pcWorker->partSize[i] DEBUG_STRING_PASS_INTO(sDebug), pcWorker->useMRG );
+#else
+      cuEncoder.xCheckRDCostInter( rpcBestCU, rpcTempCU, pcWorker->partSize[i] );
+#endif
+    }
+    rpcTempCU->initEstData( uiDepth, iQP, bIsLosslessMode );
+  }
+}
+
+/** Compare the best mode of a task with the best mode so far, as xCheckBestMode() does in the sequential evaluation.
+ */
+Void TEncCu::xCommitCandidateTask( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const UInt uiDepth, const Int iQP, const Bool bIsLosslessMode, CandidateWorker* pcWorker, Bool &doNotBlockPu )
+{
+  if ( pcWorker->blockable && !doNotBlockPu )
+  {
+    return;
+  }
+
+  TEncCu     &cuEncoder    = pcWorker->cuEncoder;
+  TComDataCU *pcWorkerBest = cuEncoder.m_ppcBestCU[uiDepth];
+  if ( pcWorkerBest->getTotalCost() < rpcBestCU->getTotalCost() )
+  {
+    rpcTempCU->copyPartFrom( pcWorkerBest, 0, uiDepth );
+    rpcTempCU->getTotalCost() = pcWorkerBest->getTotalCost();
+    std::swap( m_ppcPredYuvTemp[uiDepth], cuEncoder.m_ppcPredYuvBest[uiDepth] );
+    std::swap( m_ppcRecoYuvTemp[uiDepth], cuEncoder.m_ppcRecoYuvBest[uiDepth] );
+    m_pppcRDSbacCoder[uiDepth][CI_TEMP_BEST]->load( pcWorker->rdSbacCoders[uiDepth][CI_NEXT_BEST] );
+
+    DEBUG_STRING_NEW(a)
+    DEBUG_STRING_NEW(b)
+    xCheckBestMode( rpcBestCU, rpcTempCU, uiDepth DEBUG_STRING_PASS_INTO(a) DEBUG_STRING_PASS_INTO(b) );
+    rpcTempCU->initEstData( uiDepth, iQP, bIsLosslessMode );
+  }
+
+  if ( pcWorker->updateBlock && m_pcEncCfg->getUseCbfFastMode() && rpcBestCU->getPartitionSize(0) == pcWorker->partSize[0] )
+  {
+    doNotBlockPu = rpcBestCU->getQtRootCbf( 0 ) != 0;
+  }
+}
+
 /** Check R-D costs for a CU with PCM mode.
  * \param rpcBestCU pointer to best mode CU data structure
  * \param rpcTempCU pointer to testing mode CU data structure
@@ -1769,6 +2376,7 @@ Void TEncCu::xCheckIntraPCM( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU )
       return;   // only check necessary PCM in fast deltaqp mode
     }
   }
+  m_numCtuStatsChecked[CTU_STATS_PCM]++;
   
   UInt uiDepth = rpcTempCU->getDepth( 0 );
 
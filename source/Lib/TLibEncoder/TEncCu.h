@@ -45,10 +45,14 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComBitCounter.h"
 #include "TLibCommon/TComDataCU.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TEncEntropy.h"
 #include "TEncSearch.h"
 #include "TEncRateCtrl.h"
+#include "TEncCtuStats.h"
+#include <map>
+#include <vector>
 //! \ingroup TLibEncoder
 //! \{
 
@@ -92,6 +96,33 @@ private:
 #if JVET_Y0077_BIM
   Int                     m_BimQPoffset;
 #endif
+  Int                     m_cuTreeQPoffset;
+
+  // depth range of the current CTU predicted from neighbouring and co-located CTUs
+  UInt                    m_ctuMinDepth;
+  UInt                    m_ctuMaxDepth;
+
+  struct CtuDepthRange
+  {
+    UChar minDepth;
+    UChar maxDepth;
+    Bool  valid;             ///< CTU completely inside the picture and compressed
+    CtuDepthRange() : minDepth(0), maxDepth(0), valid(false) {}
+  };
+  /// depth ranges chosen in the CTUs of the current and the reference pictures, by POC (the CU data of reference
+  /// pictures is not kept by the picture buffer)
+  std::map<Int, std::vector<CtuDepthRange> > m_ctuDepthRanges;
+
+  struct DepthRangeStats
+  {
+    UInt64 numCtus;          ///< CTUs coded in inter slices
+    UInt64 numRestricted;    ///< CTUs for which the depth range was restricted
+    UInt64 numAtMinBound;    ///< restricted CTUs where a CU has been chosen at the predicted minimum depth
+    UInt64 numAtMaxBound;    ///< restricted CTUs where a CU has been chosen at the predicted maximum depth
+    DepthRangeStats() : numCtus(0), numRestricted(0), numAtMinBound(0), numAtMaxBound(0) {}
+  } m_depthRangeStats;
+
+  UInt                    m_numCtuStatsChecked[NUMBER_OF_CTU_STATS_CANDIDATES]; ///< RD evaluations made in the current CTU, by kind
 
   //  Access channel
   TEncCfg*                m_pcEncCfg;
@@ -107,6 +138,11 @@ private:
   TEncSbac*               m_pcRDGoOnSbacCoder;
   TEncRateCtrl*           m_pcRateCtrl;
 
+  // parallel evaluation of the mode candidates of a CU that do not depend on each other
+  struct CandidateWorker;
+  std::vector<CandidateWorker*> m_candidateWorkers; ///< contexts with their own search, transform and RD coders
+  TComThreadPool          m_candidateThreadPool;
+
 public:
   /// copy parameters from encoder class
   Void  init                ( TEncTop* pcEncTop );
@@ -125,14 +161,23 @@ public:
   /// destroy internal buffers
   Void  destroy             ();
 
+  /// create the contexts and threads for the parallel evaluation of mode candidates
+  Void  createCandidateWorkers( TEncTop* pcEncTop, TComSPS &sps );
+
   /// CTU analysis function
   Void  compressCtu         ( TComDataCU*  pCtu );
 
+  /// RD evaluations made in the last compressed CTU, including those of the candidate workers
+  Void  getCtuStatsChecked  ( UInt numChecked[NUMBER_OF_CTU_STATS_CANDIDATES] ) const;
+
   /// CTU encoding function
   Void  encodeCtu           ( TComDataCU*  pCtu );
 
   Int   updateCtuDataISlice ( TComDataCU* pCtu, Int width, Int height );
 
+  /// print statistics of the depth range prediction
+  Void  printDepthRangeStats() const;
+
   Void setFastDeltaQp       ( Bool b)                 { m_bFastDeltaQP = b;         }
 
 protected:
@@ -145,6 +190,9 @@ protected:
   Void  xEncodeCU           ( TComDataCU*  pcCU, UInt uiAbsPartIdx,           UInt uiDepth        );
 
   Int   xComputeQP          ( TComDataCU* pcCU, UInt uiDepth );
+  Int   xGetCuTreeQPOffset  ( TComDataCU* pcCU );
+  Void  xPredictDepthRange  ( TComDataCU* pCtu );
+  Void  xStoreDepthRange    ( TComDataCU* pCtu );
   Void  xCheckBestMode      ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt uiDepth DEBUG_STRING_FN_DECLARE(sParent) DEBUG_STRING_FN_DECLARE(sTest) DEBUG_STRING_PASS_INTO(Bool bAddSizeInfo=true));
 
   Void  xCheckRDCostMerge2Nx2N( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU DEBUG_STRING_FN_DECLARE(sDebug), Bool *earlyDetectionSkipMode );
@@ -163,6 +211,12 @@ protected:
 
   Void  xCheckDQP           ( TComDataCU*  pcCU );
 
+  Void  xCheckRDCostParallel( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const UInt uiDepth, const Int iQP, const Bool bIsLosslessMode, PartSize eParentPartSize, Bool &doNotBlockPu );
+  Void  xSetCandidateTask   ( const Int taskIdx, const PredMode ePredMode, const PartSize ePartSize, const Bool bUseMRG, const Bool bBlockable, const Bool bUpdateBlock );
+  Void  xRunCandidateTasks  ( TComDataCU*  pcTempCU, const UInt uiDepth, const Int iQP, const Bool bIsLosslessMode, const Int numTasks );
+  Void  xEvaluateCandidateTask( CandidateWorker* pcWorker, TComDataCU* pcTempCU, const UInt uiDepth, const Int iQP, const Bool bIsLosslessMode );
+  Void  xCommitCandidateTask( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const UInt uiDepth, const Int iQP, const Bool bIsLosslessMode, CandidateWorker* pcWorker, Bool &doNotBlockPu );
+
   Void  xCheckIntraPCM      ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU                      );
   Void  xCopyAMVPInfo       ( AMVPInfo* pSrc, AMVPInfo* pDst );
   Void  xCopyYuv2Pic        (TComPic* rpcPic, UInt uiCUAddr, UInt uiAbsPartIdx, UInt uiDepth, UInt uiSrcDepth );
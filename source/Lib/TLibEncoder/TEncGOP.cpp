@@ -47,6 +47,7 @@
 #include "TLibCommon/SEI.h"
 #include "TLibCommon/NAL.h"
 #include "NALwrite.h"
+#include "TLibCommon/TComProfiler.h"
 #include <time.h>
 #include <math.h>
 
@@ -102,6 +103,8 @@ TEncGOP::TEncGOP()
   m_associatedIRAPType = NAL_UNIT_CODED_SLICE_IDR_N_LP;
   m_associatedIRAPPOC  = 0;
   m_pcDeblockingTempPicYuv = NULL;
+  m_metricPic          = NULL;
+  m_metricPicD         = NULL;
 }
 
 TEncGOP::~TEncGOP()
@@ -130,6 +133,11 @@ Void  TEncGOP::destroy()
     m_FGAnalyser.destroy();
   }
 #endif
+  if (m_metricThread.joinable())
+  {
+    m_metricThread.join();
+  }
+  m_qualityMetric.destroy();
 }
 
 Void TEncGOP::init ( TEncTop* pcTEncTop )
@@ -158,10 +166,10 @@ Void TEncGOP::init ( TEncTop* pcTEncTop )
           *(BitDepths*)m_pcCfg->getBitDepthInput(), *(BitDepths*)m_pcCfg->getBitDepth(),
           m_pcCfg->getFrameSkip(), m_pcCfg->getFGCSEICompModelPresent(),
           m_pcCfg->getFilmGrainExternalMask(), m_pcCfg->getFilmGrainExternalDenoised());
-
+      m_FGAnalyser.setNumThreads(m_pcCfg->getFilmGrainAnalysisThreads());
   }
 #endif
-
+  m_qualityMetric.create(m_pcCfg->getMetricThreads());
 }
 
 #if JVET_AK0194_DSC_SEI
@@ -1388,6 +1396,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
                            TComList<TComPicYuv*>& rcListPicYuvRecOut, std::list<AccessUnit>& accessUnitsInGOP,
                            Bool isField, Bool isTff, const InputColourSpaceConversion ip_conversion, const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl )
 {
+  PROFILE_SCOPE( PROF_ENC_COMPRESS_GOP );
   // TODO: Split this function up.
 
   TComPic*        pcPic = NULL;
@@ -1467,6 +1476,13 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     accessUnitsInGOP.push_back(AccessUnit());
     AccessUnit& accessUnit = accessUnitsInGOP.back();
     xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, pcPic, pcPicYuvRecOut, pocCurr, isField );
+#if JVET_X0048_X0103_FILM_GRAIN
+    if (m_pcCfg->getFilmGrainAnalysisEnabled() && m_pcCfg->getFilmGrainAnalysisAsync() && xIsFilmGrainAnalysisPicture(pcPic->getPOC()))
+    {
+      // the analysis only reads the source pictures, it overlaps with the coding of the picture
+      m_FGAnalyser.startAnalysis(pcPic);
+    }
+#endif
 
 #if REDUCED_ENCODER_MEMORY
 #if SHUTTER_INTERVAL_SEI_PROCESSING
@@ -1766,7 +1782,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       {
         frameLevel = 0;
       }
-      m_pcRateCtrl->initRCPic( frameLevel );
+      m_pcRateCtrl->initRCPic( frameLevel, pcSlice->getPOC() );
       estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
 
       if (m_pcRateCtrl->getCpbSaturationEnabled() && frameLevel != 0)
@@ -1804,7 +1820,8 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       {
         m_pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
 
-        if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
+        // do not refine allocated bits for all intra case, nor when they follow the first pass of two-pass rate control
+        if ( m_pcCfg->getIntraPeriod() != 1 && m_pcRateCtrl->getRCPic()->getPassStats() == NULL )
         {
           Int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
           bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
@@ -1931,9 +1948,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 #if JVET_X0048_X0103_FILM_GRAIN
     if (m_pcCfg->getFilmGrainAnalysisEnabled())
     {
-      int  filteredFrame = m_pcCfg->getIntraPeriod() < 1 ? 2 * m_pcCfg->getFrameRate() : m_pcCfg->getIntraPeriod();
-      bool ready_to_analyze = pcPic->getPOC() % filteredFrame ? false : true; // either it is mctf denoising or external source for film grain analysis. note: if mctf is used, it is different from mctf for encoding.
-      if (ready_to_analyze)
+      bool ready_to_analyze = xIsFilmGrainAnalysisPicture(pcPic->getPOC());
+      if (ready_to_analyze && m_pcCfg->getFilmGrainAnalysisAsync())
+      {
+          m_FGAnalyser.waitForAnalysis();   // started when the picture buffer was fetched
+      }
+      else if (ready_to_analyze)
       {
           m_FGAnalyser.initBufs(pcPic);
           m_FGAnalyser.estimate_grain(pcPic);
@@ -2033,6 +2053,14 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       }
     }
 
+    if (m_pcCfg->getAsyncMetrics())
+    {
+      // the reconstruction is final: compute the quality metrics while the picture is entropy coded
+      m_metricPic  = pcPic;
+      m_metricPicD = pcPic->getPicYuvRec();
+      m_metricThread = std::thread(&TEncGOP::xCalculatePictureMetrics, this, pcPic, pcPic->getPicYuvRec(), ip_conversion, snr_conversion, std::cref(outputLogCtrl), std::ref(m_metricResult));
+    }
+
     // pcSlice is currently slice 0.
     std::size_t binCountsInNalUnits   = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
     std::size_t numBytesInVclNalUnits = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
@@ -2235,6 +2263,10 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         printf(" [CPB %6d bits]", m_pcRateCtrl->getCpbState());
       }
     }
+    if ( m_pcCfg->getRCPass() == 1 )
+    {
+      m_pcRateCtrl->writePassStats( pcPic, actualTotalBits );
+    }
 
     xCreatePictureTimingSEI(m_pcCfg->getEfficientFieldIRAPEnabled()?effFieldIRAPMap.GetIRAPGOPid():0, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, isField, duData);
     if (m_pcCfg->getScalableNestingSEIEnabled())
@@ -2276,7 +2308,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
 Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded, Bool isField, const TEncAnalyze::OutputLogControl &outputLogCtrl, const BitDepths &bitDepths)
 {
-  assert (uiNumAllPicCoded == m_gcAnalyzeAll.getNumPic());
+  assert (uiNumAllPicCoded == m_gcAnalyzeAll.getNumPic() + (m_pcCfg->getSummaryExcludeFirstPicture() ? 1 : 0));
 
 
   //--CFG_KDY
@@ -2365,6 +2397,15 @@ Void TEncGOP::xInitGOP( Int iPOCLast, Int iNumPicRcvd, Bool isField )
   return;
 }
 
+#if JVET_X0048_X0103_FILM_GRAIN
+Bool TEncGOP::xIsFilmGrainAnalysisPicture( const Int poc ) const
+{
+  // either it is mctf denoising or external source for film grain analysis. note: if mctf is used, it is different from mctf for encoding.
+  const Int filteredFrame = m_pcCfg->getIntraPeriod() < 1 ? 2 * m_pcCfg->getFrameRate() : m_pcCfg->getIntraPeriod();
+  return (poc % filteredFrame) == 0;
+}
+#endif
+
 
 Void TEncGOP::xGetBuffer( TComList<TComPic*>&      rcListPic,
                          TComList<TComPicYuv*>&    rcListPicYuvRecOut,
@@ -2417,24 +2458,15 @@ UInt64 TEncGOP::xFindDistortionFrame (TComPicYuv* pcPic0, TComPicYuv* pcPic1, co
   for(Int chan=0; chan<pcPic0 ->getNumberValidComponents(); chan++)
   {
     const ComponentID ch=ComponentID(chan);
-    Pel*  pSrc0   = pcPic0 ->getAddr(ch);
-    Pel*  pSrc1   = pcPic1 ->getAddr(ch);
+    const Pel*  pSrc0   = pcPic0 ->getAddr(ch);
+    const Pel*  pSrc1   = pcPic1 ->getAddr(ch);
     UInt  uiShift     = 2 * DISTORTION_PRECISION_ADJUSTMENT(bitDepths.recon[toChannelType(ch)]-8);
 
     const Int   iStride = pcPic0->getStride(ch);
     const Int   iWidth  = pcPic0->getWidth(ch);
     const Int   iHeight = pcPic0->getHeight(ch);
 
-    for(Int y = 0; y < iHeight; y++ )
-    {
-      for(Int x = 0; x < iWidth; x++ )
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += UInt64((iTemp*iTemp) >> uiShift);
-      }
-      pSrc0 += iStride;
-      pSrc1 += iStride;
-    }
+    uiTotalDiff += m_qualityMetric.getSSD(pSrc0, iStride, pSrc1, iStride, iWidth, iHeight, uiShift);
   }
 
   return uiTotalDiff;
@@ -2506,10 +2538,11 @@ Void TEncGOP::xCalculateAddPSNRs( const Bool isField, const Bool isFieldTopField
   }
 }
 
-Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit& accessUnit, Double dEncTime, const InputColourSpaceConversion ip_conversion, const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, Double* PSNR_Y )
+/** compute PSNR/MSE, xPSNR and MS-SSIM of a reconstructed picture against its source
+ * This only reads the pictures, so it can run on the metric thread while the picture is entropy coded.
+ */
+Void TEncGOP::xCalculatePictureMetrics( TComPic* pcPic, TComPicYuv* pcPicD, const InputColourSpaceConversion ip_conversion, const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, TEncAnalyze::ResultData &result )
 {
-  TEncAnalyze::ResultData result;
-
   // calculate colour space of reconstructed data
 
   TComPicYuv cscd;
@@ -2561,9 +2594,7 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
     Int    iOrgStride[MAX_NUM_COMPONENT], iRecStride[MAX_NUM_COMPONENT];
     Int    iWidth[MAX_NUM_COMPONENT], iHeight[MAX_NUM_COMPONENT], iSize[MAX_NUM_COMPONENT];
     UInt64 uiSSDtemp[MAX_NUM_COMPONENT];
-    UInt   uiShiftWidth[MAX_NUM_COMPONENT], uiShiftHeight[MAX_NUM_COMPONENT];
-    Intermediate_Int iDiff;
-    
+
     for(Int chan=0; chan<pcPicD->getNumberValidComponents(); chan++)
     {
       const ComponentID ch=ComponentID(chan);
@@ -2573,50 +2604,12 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
       iWidth[ch]        = pcPicD->getWidth (ch) - (m_pcEncTop->getSourcePadding(0) >> pcPic->getComponentScaleX(ch));
       iHeight[ch]       = pcPicD->getHeight(ch) - ((m_pcEncTop->getSourcePadding(1) >> (pcPic->isField()?1:0)) >> pcPic->getComponentScaleY(ch));
       iSize[ch]         = iWidth[ch]*iHeight[ch];
-      uiSSDtemp[ch]     = 0;
-      uiShiftWidth[ch]  = (ch == COMPONENT_Y || pcPicD->getChromaFormat() == CHROMA_444) ? 0 : 1;
-      uiShiftHeight[ch] = (ch == COMPONENT_Y || pcPicD->getChromaFormat() == CHROMA_444 || pcPicD->getChromaFormat() == CHROMA_422) ? 0 : 1;
       dWeightPel[ch]    = m_pcCfg->getXPSNRWeight(ch);
       pOrg[ch]          = pOrgPicYuv->getAddr(ch);
       pRec[ch]          = picd.getAddr(ch);
     }
     
-    Double dSSDtemp=0;
-    std::vector<Double> vecSSEChroma(iSize[COMPONENT_Cb], Double(0));
-    for(Int y = 0, t= 0; y < iHeight[COMPONENT_Cb]; y++ )
-    {
-      for(Int x = 0; x < iWidth[COMPONENT_Cb]; x++, t++)
-      {
-        UInt64 uiSE_cb, uiSE_cr;
-        iDiff = (Intermediate_Int)( (Intermediate_Int)pOrg[COMPONENT_Cb][x] - (Intermediate_Int)pRec[COMPONENT_Cb][x] );
-        uiSE_cb = iDiff * iDiff;
-        iDiff = (Intermediate_Int)( (Intermediate_Int)pOrg[COMPONENT_Cr][x] - (Intermediate_Int)pRec[COMPONENT_Cr][x] );
-        uiSE_cr = iDiff * iDiff;
-        uiSSDtemp[COMPONENT_Cb] += uiSE_cb;
-        uiSSDtemp[COMPONENT_Cr] += uiSE_cr;
-        vecSSEChroma[t] = dWeightPel[COMPONENT_Cb] * (Double) uiSE_cb + dWeightPel[COMPONENT_Cr] * (Double) uiSE_cr;
-      }
-      pOrg[COMPONENT_Cb]  += iOrgStride[COMPONENT_Cb];
-      pRec[COMPONENT_Cb]  += iRecStride[COMPONENT_Cb];
-      pOrg[COMPONENT_Cr]  += iOrgStride[COMPONENT_Cr];
-      pRec[COMPONENT_Cr]  += iRecStride[COMPONENT_Cr];
-    }
-    
-    for(Int y = 0; y < iHeight[COMPONENT_Y]; y++ )
-    {
-      UInt y_step_chroma = (y >> uiShiftHeight[COMPONENT_Cb]) * iWidth[COMPONENT_Cb];
-      for(Int x = 0; x < iWidth[COMPONENT_Y]; x++)
-      {
-        UInt64 uiSE_y;
-        UInt x_step_chroma = (x >> uiShiftWidth[COMPONENT_Cb]);
-        iDiff   = (Intermediate_Int)( (Intermediate_Int)pOrg[COMPONENT_Y][x] - (Intermediate_Int)pRec[COMPONENT_Y][x] );
-        uiSE_y  = iDiff * iDiff;
-        uiSSDtemp[COMPONENT_Y] += uiSE_y;
-        dSSDtemp += sqrt(dWeightPel[COMPONENT_Y] * (Double) uiSE_y + vecSSEChroma[y_step_chroma+x_step_chroma]);
-      }
-      pOrg[COMPONENT_Y]  += iOrgStride[COMPONENT_Y];
-      pRec[COMPONENT_Y]  += iRecStride[COMPONENT_Y];
-    }
+    const Double dSSDtemp = m_qualityMetric.getXPSNRDistortion(pOrg, iOrgStride, pRec, iRecStride, iWidth, iHeight, pcPicD->getChromaFormat(), dWeightPel, uiSSDtemp);
     
     Double fWValue = 0;
     for( Int chan = 0; chan<pcPicD->getNumberValidComponents(); chan++)
@@ -2639,34 +2632,20 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
       const ComponentID ch=ComponentID(chan);
       const Pel*  pOrg       = pOrgPicYuv->getAddr(ch);
       const Int   iOrgStride = pOrgPicYuv->getStride(ch);
-      Pel*  pRec             = picd.getAddr(ch);
+      const Pel*  pRec       = picd.getAddr(ch);
       const Int   iRecStride = picd.getStride(ch);
       const Int   iWidth  = pcPicD->getWidth (ch) - (m_pcEncTop->getSourcePadding(0) >> pcPic->getComponentScaleX(ch));
       const Int   iHeight = pcPicD->getHeight(ch) - ((m_pcEncTop->getSourcePadding(1) >> (pcPic->isField()?1:0)) >> pcPic->getComponentScaleY(ch));
 
       Int   iSize   = iWidth*iHeight;
 
-      UInt64 uiSSDtemp=0;
-      for(Int y = 0; y < iHeight; y++ )
-      {
-        for(Int x = 0; x < iWidth; x++ )
-        {
-          Intermediate_Int iDiff = (Intermediate_Int)( pOrg[x] - pRec[x] );
-          uiSSDtemp   += iDiff * iDiff;
-        }
-        pOrg += iOrgStride;
-        pRec += iRecStride;
-      }
+      const UInt64 uiSSDtemp = m_qualityMetric.getSSD(pOrg, iOrgStride, pRec, iRecStride, iWidth, iHeight);
       const Int maxval = 255 << (pcPic->getPicSym()->getSPS().getBitDepth(toChannelType(ch)) - 8);
       const Double fRefValue = (Double) maxval * maxval * iSize;
       result.psnr[ch]         = ( uiSSDtemp ? 10.0 * log10( fRefValue / (Double)uiSSDtemp ) : 999.99 );
       result.MSEyuvframe[ch]   = (Double)uiSSDtemp/(iSize);
     }
   }
-#if EXTENSION_360_VIDEO
-  m_ext360.calculatePSNRs(pcPic);
-#endif
-
   //===== calculate MS-SSIM =====
   if (outputLogCtrl.printMSSSIM)
   {
@@ -2681,10 +2660,36 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
       const Int   height    = pcPicD->getHeight(ch) - ((m_pcEncTop->getSourcePadding(1) >> (pcPic->isField()?1:0)) >> pcPic->getComponentScaleY(ch));
       const UInt  bitDepth  = pcPic->getPicSym()->getSPS().getBitDepth(toChannelType(ch));
  
-      result.MSSSIM[ch] = xCalculateMSSSIM (pOrg, orgStride, pRec, recStride, width, height, bitDepth);
+      result.MSSSIM[ch] = m_qualityMetric.getMSSSIM(pOrg, orgStride, pRec, recStride, width, height, bitDepth);
     }
   }
 
+  cscd.destroy();
+}
+
+Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit& accessUnit, Double dEncTime, const InputColourSpaceConversion ip_conversion, const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, Double* PSNR_Y )
+{
+  TEncAnalyze::ResultData result;
+
+  if (m_metricThread.joinable())
+  {
+    m_metricThread.join();
+  }
+  if (m_metricPic == pcPic && m_metricPicD == pcPicD)
+  {
+    result = m_metricResult;   // computed on the metric thread
+  }
+  else
+  {
+    xCalculatePictureMetrics( pcPic, pcPicD, ip_conversion, snr_conversion, outputLogCtrl, result );
+  }
+  m_metricPic  = NULL;
+  m_metricPicD = NULL;
+
+#if EXTENSION_360_VIDEO
+  m_ext360.calculatePSNRs(pcPic);
+#endif
+
   /* calculate the size of the access unit, excluding:
    *  - SEI NAL units
    */
@@ -2716,37 +2721,39 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
 
   //===== add distortion metrics =====
   result.bits=(Double)uibits;
-  m_gcAnalyzeAll.addResult (result);
+  TComSlice*  pcSlice = pcPic->getSlice(0);
+  // the first picture of a ParallelSegments segment is counted by the previous segment
+  if (!m_pcCfg->getSummaryExcludeFirstPicture() || pcSlice->getPOC() != 0)
+  {
+    m_gcAnalyzeAll.addResult (result);
 
 #if EXTENSION_360_VIDEO
-  m_ext360.addResult(m_gcAnalyzeAll);
+    m_ext360.addResult(m_gcAnalyzeAll);
 #endif
 
-  TComSlice*  pcSlice = pcPic->getSlice(0);
-  if (pcSlice->isIntra())
-  {
-    m_gcAnalyzeI.addResult (result);
+    if (pcSlice->isIntra())
+    {
+      m_gcAnalyzeI.addResult (result);
 #if EXTENSION_360_VIDEO
-    m_ext360.addResult(m_gcAnalyzeI);
+      m_ext360.addResult(m_gcAnalyzeI);
 #endif
-    *PSNR_Y = result.psnr[COMPONENT_Y];
-  }
-  if (pcSlice->isInterP())
-  {
-    m_gcAnalyzeP.addResult (result);
+    }
+    if (pcSlice->isInterP())
+    {
+      m_gcAnalyzeP.addResult (result);
 #if EXTENSION_360_VIDEO
-    m_ext360.addResult(m_gcAnalyzeP);
+      m_ext360.addResult(m_gcAnalyzeP);
 #endif
-    *PSNR_Y = result.psnr[COMPONENT_Y];
-  }
-  if (pcSlice->isInterB())
-  {
-    m_gcAnalyzeB.addResult (result);
+    }
+    if (pcSlice->isInterB())
+    {
+      m_gcAnalyzeB.addResult (result);
 #if EXTENSION_360_VIDEO
-    m_ext360.addResult(m_gcAnalyzeB);
+      m_ext360.addResult(m_gcAnalyzeB);
 #endif
-    *PSNR_Y = result.psnr[COMPONENT_Y];
+    }
   }
+  *PSNR_Y = result.psnr[COMPONENT_Y];
 
   TChar c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
   if (!pcSlice->isReferenced())
@@ -2813,181 +2820,8 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
     }
     printf("]");
   }
-
-  cscd.destroy();
 }
 
-Double TEncGOP::xCalculateMSSSIM (const Pel *pOrg, const Int orgStride, const Pel* pRec, const Int recStride, const Int width, const Int height, const UInt bitDepth)
-{
-  const Int MAX_MSSSIM_SCALE  = 5;
-  const Int WEIGHTING_MID_TAP = 5;
-  const Int WEIGHTING_SIZE    = WEIGHTING_MID_TAP*2+1;
-
-  UInt maxScale;
-
-  // For low resolution videos determine number of scales 
-  if (width < 22 || height < 22)
-  {
-    maxScale = 1; 
-  }
-  else if (width < 44 || height < 44)
-  {
-    maxScale = 2; 
-  }
-  else if (width < 88 || height < 88)
-  {
-    maxScale = 3; 
-  }
-  else if (width < 176 || height < 176)
-  {
-    maxScale = 4; 
-  }
-  else
-  {
-    maxScale = 5;
-  }
-
-  assert(maxScale>0 && maxScale<=MAX_MSSSIM_SCALE);
-
-  //Normalized Gaussian mask design, 11*11, s.d. 1.5
-  Double weights[WEIGHTING_SIZE][WEIGHTING_SIZE];
-  {
-    Double coeffSum=0.0;
-    for(Int y=0; y<WEIGHTING_SIZE; y++)
-    {
-      for(Int x=0; x<WEIGHTING_SIZE; x++)
-      {
-        weights[y][x]=exp(-((y-WEIGHTING_MID_TAP)*(y-WEIGHTING_MID_TAP)+(x-WEIGHTING_MID_TAP)*(x-WEIGHTING_MID_TAP))/(WEIGHTING_MID_TAP-0.5));
-        coeffSum +=weights[y][x];
-      }
-    }
-
-    for(Int y=0; y<WEIGHTING_SIZE; y++)
-    {
-      for(Int x=0; x<WEIGHTING_SIZE; x++)
-      {
-        weights[y][x] /=coeffSum;
-      }
-    }
-  }
-
-  //Resolution based weights
-  const Double exponentWeights[MAX_MSSSIM_SCALE][MAX_MSSSIM_SCALE] = {{1.0,    0,      0,      0,      0     },
-                                                                      {0.1356, 0.8644, 0,      0,      0     },
-                                                                      {0.0711, 0.4530, 0.4760, 0,      0     },
-                                                                      {0.0517, 0.3295, 0.3462, 0.2726, 0     },
-                                                                      {0.0448, 0.2856, 0.3001, 0.2363, 0.1333}};
-
-  //Downsampling of data:
-  std::vector<Double> original[MAX_MSSSIM_SCALE];
-  std::vector<Double> recon[MAX_MSSSIM_SCALE];
-
-  for(UInt scale=0; scale<maxScale; scale++)
-  {
-    const Int scaledHeight = height >> scale;
-    const Int scaledWidth  = width  >> scale;
-    original[scale].resize(scaledHeight*scaledWidth, Double(0));
-    recon[scale].resize(scaledHeight*scaledWidth, Double(0));
-  }
-
-  // Initial [0] arrays to be a copy of the source data (but stored in array "Double", not Pel array).
-  for(Int y=0; y<height; y++)
-  {
-    for(Int x=0; x<width; x++)
-    {
-      original[0][y*width+x] = pOrg[y*orgStride+x];
-      recon[0][   y*width+x] = pRec[y*recStride+x];
-    }
-  }
-
-  // Set up other arrays to be average value of each 2x2 sample.
-  for(UInt scale=1; scale<maxScale; scale++)
-  {
-    const Int scaledHeight = height >> scale;
-    const Int scaledWidth  = width  >> scale;
-    for(Int y=0; y<scaledHeight; y++)
-    {
-      for(Int x=0; x<scaledWidth; x++)
-      {
-        original[scale][y*scaledWidth+x]= (original[scale-1][ 2*y   *(2*scaledWidth)+2*x  ] +
-                                           original[scale-1][ 2*y   *(2*scaledWidth)+2*x+1] +
-                                           original[scale-1][(2*y+1)*(2*scaledWidth)+2*x  ] +
-                                           original[scale-1][(2*y+1)*(2*scaledWidth)+2*x+1]) / 4.0;
-        recon[scale][y*scaledWidth+x]=    (   recon[scale-1][ 2*y   *(2*scaledWidth)+2*x  ] +
-                                              recon[scale-1][ 2*y   *(2*scaledWidth)+2*x+1] +
-                                              recon[scale-1][(2*y+1)*(2*scaledWidth)+2*x  ] +
-                                              recon[scale-1][(2*y+1)*(2*scaledWidth)+2*x+1]) / 4.0;
-      }
-    }
-  }
-  
-  // Calculate MS-SSIM:
-  const UInt   maxValue  = (1<<bitDepth)-1;
-  const Double c1        = (0.01*maxValue)*(0.01*maxValue);
-  const Double c2        = (0.03*maxValue)*(0.03*maxValue);
-  
-  Double finalMSSSIM = 1.0;
-
-  for(UInt scale=0; scale<maxScale; scale++)
-  {
-    const Int scaledHeight    = height >> scale;
-    const Int scaledWidth     = width  >> scale;
-    const Int blocksPerRow    = scaledWidth-WEIGHTING_SIZE+1;
-    const Int blocksPerColumn = scaledHeight-WEIGHTING_SIZE+1;
-    const Int totalBlocks     = blocksPerRow*blocksPerColumn;
-
-    Double meanSSIM= 0.0;
-
-    for(Int blockIndexY=0; blockIndexY<blocksPerColumn; blockIndexY++)
-    {
-      for(Int blockIndexX=0; blockIndexX<blocksPerRow; blockIndexX++)
-      {
-        Double muOrg          =0.0;
-        Double muRec          =0.0;
-        Double muOrigSqr      =0.0;
-        Double muRecSqr       =0.0;
-        Double muOrigMultRec  =0.0;
-
-        for(Int y=0; y<WEIGHTING_SIZE; y++)
-        {
-          for(Int x=0;x<WEIGHTING_SIZE; x++)
-          {
-            const Double gaussianWeight=weights[y][x];
-            const Int    sampleOffset=(blockIndexY+y)*scaledWidth+(blockIndexX+x);
-            const Double orgPel=original[scale][sampleOffset];
-            const Double recPel=   recon[scale][sampleOffset];
-
-            muOrg        +=orgPel*       gaussianWeight;
-            muRec        +=recPel*       gaussianWeight;
-            muOrigSqr    +=orgPel*orgPel*gaussianWeight;
-            muRecSqr     +=recPel*recPel*gaussianWeight;
-            muOrigMultRec+=orgPel*recPel*gaussianWeight;
-          }
-        }
-
-        const Double sigmaSqrOrig = muOrigSqr    -(muOrg*muOrg);
-        const Double sigmaSqrRec  = muRecSqr     -(muRec*muRec);
-        const Double sigmaOrigRec = muOrigMultRec-(muOrg*muRec);
-
-        Double blockSSIMVal = ((2.0*sigmaOrigRec + c2)/(sigmaSqrOrig+sigmaSqrRec + c2));
-        if(scale == maxScale-1)
-        {
-          blockSSIMVal*=(2.0*muOrg*muRec + c1)/(muOrg*muOrg+muRec*muRec + c1);
-        }
-
-        meanSSIM += blockSSIMVal;
-      }
-    }
-
-    meanSSIM /=totalBlocks;
-
-    finalMSSSIM *= pow(meanSSIM, exponentWeights[maxScale-1][scale]);
-  }
-
-  return finalMSSSIM;
-}
-
-
 Void TEncGOP::xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic* pcPicOrgSecondField,
                                           TComPicYuv* pcPicRecFirstField, TComPicYuv* pcPicRecSecondField,
                                           const InputColourSpaceConversion conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, Double* PSNR_Y )
@@ -3018,15 +2852,13 @@ Void TEncGOP::xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic*
   if (outputLogCtrl.printXPSNR && apcPicRecFields[0]->getChromaFormat() != CHROMA_400 && apcPicRecFields[1]->getChromaFormat() != CHROMA_400)
   {
     // For interlace images, we need to scan the two fields independently
-    Pel*   pOrg[MAX_NUM_COMPONENT];
+    const Pel* pOrg[MAX_NUM_COMPONENT];
     Double dWeightPel[MAX_NUM_COMPONENT];
     Int    iWeightSize[MAX_NUM_COMPONENT] = {1, 1, 1};
-    Pel*   pRec[MAX_NUM_COMPONENT];
+    const Pel* pRec[MAX_NUM_COMPONENT];
     Int    iOrgStride[MAX_NUM_COMPONENT], iRecStride[MAX_NUM_COMPONENT];
     Int    iWidth[MAX_NUM_COMPONENT], iHeight[MAX_NUM_COMPONENT], iSize[MAX_NUM_COMPONENT];
     UInt64 uiSSDtemp[MAX_NUM_COMPONENT];
-    UInt   uiShiftWidth[MAX_NUM_COMPONENT], uiShiftHeight[MAX_NUM_COMPONENT];
-    Intermediate_Int iDiff;
     Double dSSDtemp = 0.0;
     Double fWValue  = 0.0;
     for(UInt fieldNum=0; fieldNum<2; fieldNum++)
@@ -3043,49 +2875,11 @@ Void TEncGOP::xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic*
         iWidth[ch]        = pcPicD->getWidth (ch) - (m_pcEncTop->getSourcePadding(0) >> pcPic->getComponentScaleX(ch));
         iHeight[ch]       = pcPicD->getHeight(ch) - ((m_pcEncTop->getSourcePadding(1) >> 1) >> pcPic->getComponentScaleY(ch));
         iSize[ch]         = iWidth[ch]*iHeight[ch];
-        uiSSDtemp[ch]     = 0;
-        uiShiftWidth[ch]  = (ch == COMPONENT_Y || pcPicD->getChromaFormat() == CHROMA_444) ? 0 : 1;
-        uiShiftHeight[ch] = (ch == COMPONENT_Y || pcPicD->getChromaFormat() == CHROMA_444 || pcPicD->getChromaFormat() == CHROMA_422) ? 0 : 1;
         dWeightPel[ch]    = m_pcCfg->getXPSNRWeight(ch);
         pOrg[ch]          = pOrgPicYuv->getAddr(ch);
         pRec[ch]          = pcPicD->getAddr(ch);
       }
-      std::vector<Double> vecSSEChroma(iSize[COMPONENT_Cb], Double(0));
-
-      for(Int y = 0, t= 0; y < iHeight[COMPONENT_Cb]; y++ )
-      {
-        for(Int x = 0; x < iWidth[COMPONENT_Cb]; x++, t++)
-        {
-          UInt64 uiSE_cb, uiSE_cr;
-          iDiff = (Intermediate_Int)( (Intermediate_Int)pOrg[COMPONENT_Cb][x] - (Intermediate_Int)pRec[COMPONENT_Cb][x] );
-          uiSE_cb = iDiff * iDiff;
-          iDiff = (Intermediate_Int)( (Intermediate_Int)pOrg[COMPONENT_Cr][x] - (Intermediate_Int)pRec[COMPONENT_Cr][x] );
-          uiSE_cr = iDiff * iDiff;
-          uiSSDtemp[COMPONENT_Cb] += uiSE_cb;
-          uiSSDtemp[COMPONENT_Cr] += uiSE_cr;
-          vecSSEChroma[t] = dWeightPel[COMPONENT_Cb] * (Double) uiSE_cb + dWeightPel[COMPONENT_Cr] * (Double) uiSE_cr;
-        }
-        pOrg[COMPONENT_Cb]  += iOrgStride[COMPONENT_Cb];
-        pRec[COMPONENT_Cb]  += iRecStride[COMPONENT_Cb];
-        pOrg[COMPONENT_Cr]  += iOrgStride[COMPONENT_Cr];
-        pRec[COMPONENT_Cr]  += iRecStride[COMPONENT_Cr];
-      }
-
-      for(Int y = 0; y < iHeight[COMPONENT_Y]; y++ )
-      {
-        UInt y_step_chroma = (y >> uiShiftHeight[COMPONENT_Cb]) * iWidth[COMPONENT_Cb];
-        for(Int x = 0; x < iWidth[COMPONENT_Y]; x++)
-        {
-          UInt64 uiSE_y;
-          UInt x_step_chroma = (x >> uiShiftWidth[COMPONENT_Cb]);
-          iDiff   = (Intermediate_Int)( (Intermediate_Int)pOrg[COMPONENT_Y][x] - (Intermediate_Int)pRec[COMPONENT_Y][x] );
-          uiSE_y  = iDiff * iDiff;
-          uiSSDtemp[COMPONENT_Y] += uiSE_y;
-          dSSDtemp += sqrt(dWeightPel[COMPONENT_Y] * (Double) uiSE_y + vecSSEChroma[y_step_chroma+x_step_chroma]);
-        }
-        pOrg[COMPONENT_Y]  += iOrgStride[COMPONENT_Y];
-        pRec[COMPONENT_Y]  += iRecStride[COMPONENT_Y];
-      }
+      dSSDtemp += m_qualityMetric.getXPSNRDistortion(pOrg, iOrgStride, pRec, iRecStride, iWidth, iHeight, pcPicD->getChromaFormat(), dWeightPel, uiSSDtemp);
 
       for( Int chan = 0; chan<pcPicD->getNumberValidComponents(); chan++)
       {
@@ -3121,20 +2915,10 @@ Void TEncGOP::xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic*
         TComPicYuv *pcPicD=apcPicRecFields[fieldNum];
 
         const Pel*  pOrg    = useTrueOrg ? pcPic ->getPicYuvTrueOrg()->getAddr(ch) : pcPic ->getPicYuvOrg()->getAddr(ch);
-        Pel*  pRec    = pcPicD->getAddr(ch);
+        const Pel*  pRec    = pcPicD->getAddr(ch);
         const Int   iStride = pcPicD->getStride(ch);
 
-
-        for(Int y = 0; y < iHeight; y++ )
-        {
-          for(Int x = 0; x < iWidth; x++ )
-          {
-            Intermediate_Int iDiff = (Intermediate_Int)( pOrg[x] - pRec[x] );
-            uiSSDtemp   += iDiff * iDiff;
-          }
-          pOrg += iStride;
-          pRec += iStride;
-        }
+        uiSSDtemp += m_qualityMetric.getSSD(pOrg, iStride, pRec, iStride, iWidth, iHeight);
       }
       const Int maxval = 255 << (sps.getBitDepth(toChannelType(ch)) - 8);
       const Double fRefValue = (Double) maxval * maxval * iSize*2;
@@ -3166,7 +2950,7 @@ Void TEncGOP::xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic*
         const Int   recStride  = pcPicD->getStride(ch);
         const UInt  bitDepth   = sps.getBitDepth(toChannelType(ch));
 
-        sumOverFieldsMSSSIM += xCalculateMSSSIM (pOrg, orgStride, pRec, recStride, width, height, bitDepth);
+        sumOverFieldsMSSSIM += m_qualityMetric.getMSSSIM(pOrg, orgStride, pRec, recStride, width, height, bitDepth);
       }
 
       result.MSSSIM[ch] = sumOverFieldsMSSSIM/2;
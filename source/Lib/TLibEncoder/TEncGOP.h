@@ -65,7 +65,9 @@
 #endif
 
 #include "TEncAnalyze.h"
+#include "TEncQualityMetric.h"
 #include "TEncRateCtrl.h"
+#include <thread>
 #include <vector>
 
 //! \ingroup TLibEncoder
@@ -156,6 +158,13 @@ private:
   SEIEncoder              m_seiEncoder;
   TComPicYuv*             m_pcDeblockingTempPicYuv;
   Int                     m_DBParam[MAX_ENCODER_DEBLOCKING_QUALITY_LAYERS][4];   //[layer_id][0: available; 1: bDBDisabled; 2: Beta Offset Div2; 3: Tc Offset Div2;]
+
+  // per-picture quality metrics
+  TEncQualityMetric       m_qualityMetric;
+  std::thread             m_metricThread;           ///< computes the metrics of m_metricPic while it is entropy coded
+  TComPic*                m_metricPic;
+  TComPicYuv*             m_metricPicD;
+  TEncAnalyze::ResultData m_metricResult;
 #if JVET_AK0194_DSC_SEI
   void xAddToSubstream(int substreamId, OutputNALUnit &nalu);
 
@@ -207,13 +216,16 @@ protected:
 
   Void  xInitGOP          ( Int iPOCLast, Int iNumPicRcvd, Bool isField );
   Void  xGetBuffer        ( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Int iNumPicRcvd, Int iTimeOffset, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, Int pocCurr, Bool isField );
+#if JVET_X0048_X0103_FILM_GRAIN
+  Bool  xIsFilmGrainAnalysisPicture ( const Int poc ) const;
+#endif
 
   Void  xCalculateAddPSNRs         ( const Bool isField, const Bool isFieldTopFieldFirst, const Int iGOPid, TComPic* pcPic, const AccessUnit&accessUnit, TComList<TComPic*> &rcListPic, Double dEncTime, const InputColourSpaceConversion ip_conversion, const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, Double* PSNR_Y );
+  Void  xCalculatePictureMetrics   ( TComPic* pcPic, TComPicYuv* pcPicD, const InputColourSpaceConversion ip_conversion, const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, TEncAnalyze::ResultData &result );
   Void  xCalculateAddPSNR          ( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit&, Double dEncTime, const InputColourSpaceConversion ip_conversion, const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, Double* PSNR_Y );
   Void  xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic* pcPicOrgSecondField,
                                     TComPicYuv* pcPicRecFirstField, TComPicYuv* pcPicRecSecondField,
                                     const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, Double* PSNR_Y );
-  Double xCalculateMSSSIM (const Pel *pOrg, const Int orgStride, const Pel* pRec, const Int recStride, const Int width, const Int height, const UInt bitDepth);
 
   UInt64 xFindDistortionFrame (TComPicYuv* pcPic0, TComPicYuv* pcPic1, const BitDepths &bitDepths);
 
@@ -0,0 +1,701 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLookahead.cpp
+    \brief    lookahead analysis for CU-tree QP propagation
+*/
+
+#include "TEncLookahead.h"
+#include <math.h>
+#include <algorithm>
+#include <limits>
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+TEncLookahead::TEncLookahead() :
+  m_FrameSkip(0),
+  m_inputChromaFormatIDC(NUM_CHROMA_FORMAT),
+  m_chromaFormatIDC(NUM_CHROMA_FORMAT),
+  m_sourceWidth(0),
+  m_sourceHeight(0),
+  m_framesToBeEncoded(0),
+  m_bClipInputVideoToRec709Range(false),
+  m_inputColourSpaceConvert(NUMBER_INPUT_COLOUR_SPACE_CONVERSIONS),
+  m_GOPSize(0),
+  m_intraPeriod(0),
+  m_lookaheadFrames(0),
+  m_strength(0),
+  m_maxRefDistance(0),
+  m_qpOffsetMap(NULL),
+  m_lastReadPoc(-1),
+  m_widthInBlocks(0),
+  m_heightInBlocks(0),
+  m_analysisDone(false),
+  m_analysisStop(false)
+{
+}
+
+TEncLookahead::~TEncLookahead()
+{
+  destroy();
+}
+
+Void TEncLookahead::init(const Int frameSkip,
+                         const Int inputBitDepth[MAX_NUM_CHANNEL_TYPE],
+                         const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE],
+                         const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE],
+                         const Int width,
+                         const Int height,
+                         const Int *padding,
+                         const Int frames,
+                         const Bool Rec709,
+                         const std::string &filename,
+                         const ChromaFormat inputChromaFormatIDC,
+                         const ChromaFormat chromaFormatIDC,
+                         const InputColourSpaceConversion colorSpaceConv,
+                         const Int GOPSize,
+                         const GOPEntry *GOPList,
+                         const Int intraPeriod,
+                         const Int lookaheadFrames,
+                         const Double strength,
+                         std::map<Int, std::vector<Double> > *qpOffsetMap)
+{
+  m_FrameSkip = frameSkip;
+  for (Int i = 0; i < MAX_NUM_CHANNEL_TYPE; i++)
+  {
+    m_inputBitDepth[i]       = inputBitDepth[i];
+    m_MSBExtendedBitDepth[i] = MSBExtendedBitDepth[i];
+    m_internalBitDepth[i]    = internalBitDepth[i];
+  }
+  m_sourceWidth  = width;
+  m_sourceHeight = height;
+  for (Int i = 0; i < 2; i++)
+  {
+    m_sourcePadding[i] = padding[i];
+  }
+  m_framesToBeEncoded            = frames;
+  m_bClipInputVideoToRec709Range = Rec709;
+  m_inputFileName                = filename;
+  m_inputChromaFormatIDC         = inputChromaFormatIDC;
+  m_chromaFormatIDC              = chromaFormatIDC;
+  m_inputColourSpaceConvert      = colorSpaceConv;
+  m_GOPSize                      = GOPSize;
+  m_intraPeriod                  = intraPeriod;
+  m_lookaheadFrames              = lookaheadFrames;
+  m_strength                     = strength;
+  m_qpOffsetMap                  = qpOffsetMap;
+
+  m_maxRefDistance = 0;
+  for (Int i = 0; i < m_GOPSize; i++)
+  {
+    m_GOPList[i] = GOPList[i];
+    for (Int j = 0; j < m_GOPList[i].m_numRefPics; j++)
+    {
+      m_maxRefDistance = std::max(m_maxRefDistance, abs(m_GOPList[i].m_referencePics[j]));
+    }
+  }
+
+  m_widthInBlocks  = (m_sourceWidth  + s_blockSize - 1) / s_blockSize;
+  m_heightInBlocks = (m_sourceHeight + s_blockSize - 1) / s_blockSize;
+
+  m_rdCost.init();
+
+  m_yuvFrames.open(m_inputFileName, false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth);
+  m_yuvFrames.skipFrames(m_FrameSkip, m_sourceWidth - m_sourcePadding[0], m_sourceHeight - m_sourcePadding[1], m_inputChromaFormatIDC);
+  m_readBuffer.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC);
+  m_readBufferTrueOrg.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC);
+  m_lastReadPoc = -1;
+
+  m_analysisDone   = false;
+  m_analysisStop   = false;
+  m_analysisThread = std::thread(&TEncLookahead::xAnalysisLoop, this);
+}
+
+Void TEncLookahead::destroy()
+{
+  if (m_analysisThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_analysisMutex);
+      m_analysisStop = true;
+    }
+    m_analysisCondition.notify_all();
+    m_analysisThread.join();
+  }
+  m_analysisResults.clear();
+  xReleasePictures(std::numeric_limits<Int>::max());
+  if (m_qpOffsetMap != NULL)
+  {
+    m_yuvFrames.close();
+    m_readBuffer.destroy();
+    m_readBufferTrueOrg.destroy();
+    m_qpOffsetMap = NULL;
+  }
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** Provide the CU-tree QP offsets for the pictures of the GOP starting at receivedPoc.
+ *  The offsets are computed ahead of time by the analysis thread, the encoder only waits if the thread has not yet
+ *  finished the GOP.
+ * \param receivedPoc POC of the picture that has just been received by the application
+ */
+Void TEncLookahead::analyse(const Int receivedPoc)
+{
+  if (receivedPoc != 0 && (receivedPoc - 1) % m_GOPSize != 0)
+  {
+    return;
+  }
+
+  // all pictures before the current GOP have been encoded at this point
+  m_qpOffsetMap->erase(m_qpOffsetMap->begin(), m_qpOffsetMap->lower_bound(receivedPoc));
+
+  {
+    std::unique_lock<std::mutex> lock(m_analysisMutex);
+    m_analysisCondition.wait(lock, [this, receivedPoc] { return m_analysisDone || m_analysisResults.find(receivedPoc) != m_analysisResults.end(); });
+    std::map<Int, std::map<Int, std::vector<Double> > >::iterator it = m_analysisResults.find(receivedPoc);
+    if (it != m_analysisResults.end())
+    {
+      m_qpOffsetMap->insert(it->second.begin(), it->second.end());
+      m_analysisResults.erase(it);
+    }
+  }
+  m_analysisCondition.notify_all();
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+Void TEncLookahead::xAnalysisLoop()
+{
+  for (Int firstPoc = 0; firstPoc < m_framesToBeEncoded; firstPoc = (firstPoc == 0) ? 1 : firstPoc + m_GOPSize)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_analysisMutex);
+      m_analysisCondition.wait(lock, [this] { return m_analysisStop || Int(m_analysisResults.size()) < s_maxPendingGOPs; });
+      if (m_analysisStop)
+      {
+        break;
+      }
+    }
+
+    std::map<Int, std::vector<Double> > qpOffsets;
+    xAnalyseGOP(firstPoc, qpOffsets);
+
+    {
+      std::lock_guard<std::mutex> lock(m_analysisMutex);
+      m_analysisResults[firstPoc].swap(qpOffsets);
+    }
+    m_analysisCondition.notify_all();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_analysisMutex);
+    m_analysisDone = true;
+  }
+  m_analysisCondition.notify_all();
+}
+
+/** Derive the CU-tree QP offsets for the pictures of the GOP starting at firstPoc.
+ *  The propagation is carried out over the GOP itself plus the configured number of lookahead pictures, in reverse
+ *  coding order, so that every picture has received the propagated cost of all pictures referencing it.
+ *  The offsets of each picture are normalised to a zero mean, so that they only redistribute the bits within the
+ *  picture and the QP of the picture itself remains controlled by the GOP structure.
+ */
+Void TEncLookahead::xAnalyseGOP(const Int firstPoc, std::map<Int, std::vector<Double> > &qpOffsetMap)
+{
+  Int lastPoc = firstPoc == 0 ? 0 : firstPoc + m_GOPSize - 1;
+
+  xReleasePictures(firstPoc - m_maxRefDistance);
+
+  xLoadPictures(lastPoc + m_lookaheadFrames);
+  const Int lastAnalysedPoc = std::min(lastPoc + m_lookaheadFrames, m_lastReadPoc);
+  lastPoc = std::min(lastPoc, lastAnalysedPoc);
+  if (firstPoc > lastPoc)
+  {
+    return;
+  }
+
+  std::vector<std::pair<Int, Int> > codingOrder;
+  std::map<Int, std::vector<Double> > propagateCost;
+  for (Int poc = firstPoc; poc <= lastAnalysedPoc; poc++)
+  {
+    xAnalysePicture(poc);
+    codingOrder.push_back(std::make_pair(xGetCodingRank(poc), poc));
+    propagateCost[poc].assign(m_widthInBlocks * m_heightInBlocks, 0.0);
+  }
+  std::sort(codingOrder.begin(), codingOrder.end());
+
+  // propagate from the last coded picture of the window back to the first one
+  for (std::vector<std::pair<Int, Int> >::reverse_iterator it = codingOrder.rbegin(); it != codingOrder.rend(); ++it)
+  {
+    const Int                          poc         = it->second;
+    const std::vector<LookaheadBlock> &blocks      = m_picInfo[poc]->blocks;
+    const std::vector<Double>         &propagateIn = propagateCost[poc];
+
+    for (Int by = 0; by < m_heightInBlocks; by++)
+    {
+      for (Int bx = 0; bx < m_widthInBlocks; bx++)
+      {
+        const Int             blkIdx = by * m_widthInBlocks + bx;
+        const LookaheadBlock &blk    = blocks[blkIdx];
+        if (blk.numRefs == 0)
+        {
+          continue;
+        }
+        const Double intraCost = Double(std::max<Distortion>(blk.intraCost, 1));
+        const Double interCost = std::min(Double(blk.interCost), intraCost);
+        const Double amount    = (intraCost + propagateIn[blkIdx]) * (intraCost - interCost) / intraCost / blk.numRefs;
+        if (amount <= 0)
+        {
+          continue;
+        }
+
+        for (Int k = 0; k < blk.numRefs; k++)
+        {
+          std::map<Int, std::vector<Double> >::iterator refIt = propagateCost.find(blk.refPoc[k]);
+          if (refIt == propagateCost.end())
+          {
+            continue; // reference picture has already been encoded
+          }
+          std::vector<Double> &refCost = refIt->second;
+
+          // distribute the amount over the (up to) four blocks overlapped by the motion compensated block
+          const Int posX = bx * s_lowresBlockSize + blk.mvX[k];
+          const Int posY = by * s_lowresBlockSize + blk.mvY[k];
+          const Int refBx = (posX >= 0) ? posX / s_lowresBlockSize : -((s_lowresBlockSize - 1 - posX) / s_lowresBlockSize);
+          const Int refBy = (posY >= 0) ? posY / s_lowresBlockSize : -((s_lowresBlockSize - 1 - posY) / s_lowresBlockSize);
+          const Int fracX = posX - refBx * s_lowresBlockSize;
+          const Int fracY = posY - refBy * s_lowresBlockSize;
+          const Int weights[4] = { (s_lowresBlockSize - fracX) * (s_lowresBlockSize - fracY), fracX * (s_lowresBlockSize - fracY),
+                                   (s_lowresBlockSize - fracX) * fracY,                       fracX * fracY };
+
+          for (Int i = 0; i < 4; i++)
+          {
+            const Int x = refBx + (i & 1);
+            const Int y = refBy + (i >> 1);
+            if (weights[i] > 0 && x >= 0 && x < m_widthInBlocks && y >= 0 && y < m_heightInBlocks)
+            {
+              refCost[y * m_widthInBlocks + x] += amount * weights[i] / (s_lowresBlockSize * s_lowresBlockSize);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (Int poc = firstPoc; poc <= lastPoc; poc++)
+  {
+    const std::vector<LookaheadBlock> &blocks      = m_picInfo[poc]->blocks;
+    const std::vector<Double>         &propagateIn = propagateCost[poc];
+    std::vector<Double>               &qpOffsets   = qpOffsetMap[poc];
+
+    qpOffsets.resize(blocks.size());
+    Double mean = 0;
+    for (Int i = 0; i < Int(blocks.size()); i++)
+    {
+      const Double intraCost = Double(std::max<Distortion>(blocks[i].intraCost, 1));
+      qpOffsets[i] = -m_strength * log((intraCost + propagateIn[i]) / intraCost) / log(2.0);
+      mean += qpOffsets[i];
+    }
+    mean /= Double(blocks.size());
+    for (Int i = 0; i < Int(blocks.size()); i++)
+    {
+      qpOffsets[i] -= mean;
+    }
+  }
+}
+
+Bool TEncLookahead::xIsIntra(const Int poc) const
+{
+  return poc == 0 || (m_intraPeriod > 0 && poc % m_intraPeriod == 0);
+}
+
+Int TEncLookahead::xGetCodingRank(const Int poc) const
+{
+  if (poc == 0)
+  {
+    return 0;
+  }
+  const Int gopIdx    = (poc - 1) / m_GOPSize;
+  const Int pocInGop  = (poc - 1) % m_GOPSize + 1;
+  Int       entryIdx  = 0;
+  while (entryIdx < m_GOPSize - 1 && m_GOPList[entryIdx].m_POC != pocInGop)
+  {
+    entryIdx++;
+  }
+  return 1 + gopIdx * m_GOPSize + entryIdx;
+}
+
+/** Collect the reference pictures that the picture will use according to the GOP structure
+ *  (restricted to pictures that are coded before and are not cut off by an intra picture).
+ */
+Void TEncLookahead::xGetReferences(const Int poc, std::vector<Int> &refs) const
+{
+  refs.clear();
+  if (xIsIntra(poc))
+  {
+    return;
+  }
+  const Int pocInGop  = (poc - 1) % m_GOPSize + 1;
+  const Int lastIntra = m_intraPeriod > 0 ? (poc / m_intraPeriod) * m_intraPeriod : 0;
+  const Int rank      = xGetCodingRank(poc);
+
+  for (Int i = 0; i < m_GOPSize; i++)
+  {
+    const GOPEntry &entry = m_GOPList[i];
+    if (entry.m_POC != pocInGop)
+    {
+      continue;
+    }
+    for (Int j = 0; j < entry.m_numRefPics; j++)
+    {
+      const Int refPoc = poc + entry.m_referencePics[j];
+      if (entry.m_usedByCurrPic[j] && refPoc >= lastIntra && refPoc <= m_lastReadPoc && xGetCodingRank(refPoc) < rank)
+      {
+        refs.push_back(refPoc);
+      }
+    }
+  }
+}
+
+/** Read source pictures up to lastPoc and derive their half-resolution luma
+ * \returns false if the end of the sequence has been reached before lastPoc
+ */
+Bool TEncLookahead::xLoadPictures(const Int lastPoc)
+{
+  const Int  lowresWidth  = m_sourceWidth  >> 1;
+  const Int  lowresHeight = m_sourceHeight >> 1;
+
+  while (m_lastReadPoc < std::min(lastPoc, m_framesToBeEncoded - 1))
+  {
+    if (!m_yuvFrames.read(&m_readBuffer, &m_readBufferTrueOrg, m_inputColourSpaceConvert, m_sourcePadding, m_inputChromaFormatIDC, m_bClipInputVideoToRec709Range))
+    {
+      // eof or read fail
+      m_framesToBeEncoded = m_lastReadPoc + 1;
+      return false;
+    }
+
+    LookaheadPicInfo *pic = new LookaheadPicInfo;
+    pic->lowres.createWithoutCUInfo(lowresWidth, lowresHeight, CHROMA_400, true, s_lowresMargin, s_lowresMargin);
+
+    const Pel *srcRow    = m_readBuffer.getAddr(COMPONENT_Y);
+    const Int  srcStride = m_readBuffer.getStride(COMPONENT_Y);
+          Pel *dstRow    = pic->lowres.getAddr(COMPONENT_Y);
+    const Int  dstStride = pic->lowres.getStride(COMPONENT_Y);
+    for (Int y = 0; y < lowresHeight; y++, srcRow += 2 * srcStride, dstRow += dstStride)
+    {
+      for (Int x = 0; x < lowresWidth; x++)
+      {
+        dstRow[x] = (srcRow[2 * x] + srcRow[2 * x + 1] + srcRow[2 * x + srcStride] + srcRow[2 * x + 1 + srcStride] + 2) >> 2;
+      }
+    }
+    pic->lowres.extendPicBorder();
+
+    m_lastReadPoc++;
+    m_picInfo[m_lastReadPoc] = pic;
+  }
+  return m_lastReadPoc >= lastPoc;
+}
+
+Void TEncLookahead::xReleasePictures(const Int firstPoc)
+{
+  while (!m_picInfo.empty() && m_picInfo.begin()->first < firstPoc)
+  {
+    m_picInfo.begin()->second->lowres.destroy();
+    delete m_picInfo.begin()->second;
+    m_picInfo.erase(m_picInfo.begin());
+  }
+}
+
+/** Estimate intra and inter costs of all blocks of a picture against the references given by the GOP structure.
+ *  The results only depend on the source pictures, so they are kept for the following lookahead windows.
+ */
+Void TEncLookahead::xAnalysePicture(const Int poc)
+{
+  LookaheadPicInfo &pic = *m_picInfo[poc];
+  if (pic.analysed)
+  {
+    return;
+  }
+
+  const Int  numBlocks = m_widthInBlocks * m_heightInBlocks;
+  const Int  bitDepth  = m_internalBitDepth[CHANNEL_TYPE_LUMA];
+  const Int  orgStride = pic.lowres.getStride(COMPONENT_Y);
+
+  pic.blocks.resize(numBlocks);
+  for (Int by = 0; by < m_heightInBlocks; by++)
+  {
+    for (Int bx = 0; bx < m_widthInBlocks; bx++)
+    {
+      LookaheadBlock &blk = pic.blocks[by * m_widthInBlocks + bx];
+      blk.intraCost = xEstimateIntra(pic.lowres, bx, by);
+      blk.interCost = blk.intraCost;
+      blk.numRefs   = 0;
+    }
+  }
+
+  std::vector<Int> refs;
+  xGetReferences(poc, refs);
+
+  // uni-directional motion search against every reference picture
+  std::vector<std::vector<LookaheadBlock> > refBest(refs.size(), std::vector<LookaheadBlock>(numBlocks));
+  for (Int r = 0; r < Int(refs.size()); r++)
+  {
+    const TComPicYuv &ref = m_picInfo[refs[r]]->lowres;
+    for (Int by = 0; by < m_heightInBlocks; by++)
+    {
+      for (Int bx = 0; bx < m_widthInBlocks; bx++)
+      {
+        Int candX[4] = { 0, 0, 0, 0 };
+        Int candY[4] = { 0, 0, 0, 0 };
+        Int numCand = 1;
+        if (bx > 0)
+        {
+          candX[numCand] = refBest[r][by * m_widthInBlocks + bx - 1].mvX[0];
+          candY[numCand] = refBest[r][by * m_widthInBlocks + bx - 1].mvY[0];
+          numCand++;
+        }
+        if (by > 0)
+        {
+          candX[numCand] = refBest[r][(by - 1) * m_widthInBlocks + bx].mvX[0];
+          candY[numCand] = refBest[r][(by - 1) * m_widthInBlocks + bx].mvY[0];
+          numCand++;
+          if (bx + 1 < m_widthInBlocks)
+          {
+            candX[numCand] = refBest[r][(by - 1) * m_widthInBlocks + bx + 1].mvX[0];
+            candY[numCand] = refBest[r][(by - 1) * m_widthInBlocks + bx + 1].mvY[0];
+            numCand++;
+          }
+        }
+
+        LookaheadBlock &best = refBest[r][by * m_widthInBlocks + bx];
+        xMotionSearch(pic.lowres, ref, bx, by, candX, candY, numCand, best.mvX[0], best.mvY[0]);
+
+        const Pel *org = pic.lowres.getAddr(COMPONENT_Y) + by * s_lowresBlockSize * orgStride + bx * s_lowresBlockSize;
+        const Pel *pred = ref.getAddr(COMPONENT_Y) + (by * s_lowresBlockSize + best.mvY[0]) * ref.getStride(COMPONENT_Y) + bx * s_lowresBlockSize + best.mvX[0];
+        best.interCost = m_rdCost.calcHAD(bitDepth, org, orgStride, pred, ref.getStride(COMPONENT_Y), s_lowresBlockSize, s_lowresBlockSize);
+        best.refPoc[0] = refs[r];
+        best.numRefs   = 1;
+      }
+    }
+  }
+
+  // choose between intra, the best uni-directional and the bi-directional (best past + best future) prediction
+  for (Int blkIdx = 0; blkIdx < numBlocks; blkIdx++)
+  {
+    LookaheadBlock &blk = pic.blocks[blkIdx];
+    Int bestPast   = -1;
+    Int bestFuture = -1;
+    for (Int r = 0; r < Int(refs.size()); r++)
+    {
+      Int &bestInDirection = refs[r] < poc ? bestPast : bestFuture;
+      if (bestInDirection < 0 || refBest[r][blkIdx].interCost < refBest[bestInDirection][blkIdx].interCost)
+      {
+        bestInDirection = r;
+      }
+      if (refBest[r][blkIdx].interCost < blk.interCost)
+      {
+        const Distortion intraCost = blk.intraCost;
+        blk = refBest[r][blkIdx];
+        blk.intraCost = intraCost;
+      }
+    }
+
+    if (bestPast >= 0 && bestFuture >= 0)
+    {
+      const Int bx = blkIdx % m_widthInBlocks;
+      const Int by = blkIdx / m_widthInBlocks;
+      const LookaheadBlock &past   = refBest[bestPast][blkIdx];
+      const LookaheadBlock &future = refBest[bestFuture][blkIdx];
+      const TComPicYuv     &ref0   = m_picInfo[refs[bestPast]]->lowres;
+      const TComPicYuv     &ref1   = m_picInfo[refs[bestFuture]]->lowres;
+      const Int  stride0 = ref0.getStride(COMPONENT_Y);
+      const Int  stride1 = ref1.getStride(COMPONENT_Y);
+      const Pel *pred0   = ref0.getAddr(COMPONENT_Y) + (by * s_lowresBlockSize + past.mvY[0]) * stride0 + bx * s_lowresBlockSize + past.mvX[0];
+      const Pel *pred1   = ref1.getAddr(COMPONENT_Y) + (by * s_lowresBlockSize + future.mvY[0]) * stride1 + bx * s_lowresBlockSize + future.mvX[0];
+      Pel biPred[s_lowresBlockSize * s_lowresBlockSize];
+      for (Int y = 0; y < s_lowresBlockSize; y++)
+      {
+        for (Int x = 0; x < s_lowresBlockSize; x++)
+        {
+          biPred[y * s_lowresBlockSize + x] = (pred0[y * stride0 + x] + pred1[y * stride1 + x] + 1) >> 1;
+        }
+      }
+      const Pel *org = pic.lowres.getAddr(COMPONENT_Y) + by * s_lowresBlockSize * orgStride + bx * s_lowresBlockSize;
+      const Distortion biCost = m_rdCost.calcHAD(bitDepth, org, orgStride, biPred, s_lowresBlockSize, s_lowresBlockSize, s_lowresBlockSize);
+      if (biCost < blk.interCost)
+      {
+        blk.interCost = biCost;
+        blk.numRefs   = 2;
+        blk.refPoc[0] = refs[bestPast];
+        blk.mvX[0]    = past.mvX[0];
+        blk.mvY[0]    = past.mvY[0];
+        blk.refPoc[1] = refs[bestFuture];
+        blk.mvX[1]    = future.mvX[0];
+        blk.mvY[1]    = future.mvY[0];
+      }
+    }
+  }
+
+  pic.analysed = true;
+}
+
+/** Intra cost estimate: the smallest SATD of DC, horizontal, vertical and planar prediction from the neighbouring
+ *  (source) samples of the block.
+ */
+Distortion TEncLookahead::xEstimateIntra(const TComPicYuv &org, const Int bx, const Int by)
+{
+  const Int  size     = s_lowresBlockSize;
+  const Int  stride   = org.getStride(COMPONENT_Y);
+  const Pel *pOrg     = org.getAddr(COMPONENT_Y) + by * size * stride + bx * size;
+  const Int  bitDepth = m_internalBitDepth[CHANNEL_TYPE_LUMA];
+
+  Pel above[s_lowresBlockSize + 1];
+  Pel left [s_lowresBlockSize + 1];
+  Int dcSum = 0;
+  for (Int i = 0; i <= size; i++)
+  {
+    above[i] = pOrg[-stride + i];
+    left [i] = pOrg[i * stride - 1];
+  }
+  for (Int i = 0; i < size; i++)
+  {
+    dcSum += above[i] + left[i];
+  }
+  const Pel dcVal = Pel((dcSum + size) / (2 * size));
+
+  Pel pred[4][s_lowresBlockSize * s_lowresBlockSize];
+  for (Int y = 0; y < size; y++)
+  {
+    for (Int x = 0; x < size; x++)
+    {
+      pred[0][y * size + x] = dcVal;
+      pred[1][y * size + x] = left[y];
+      pred[2][y * size + x] = above[x];
+      pred[3][y * size + x] = Pel(((size - 1 - x) * left[y] + (x + 1) * above[size] + (size - 1 - y) * above[x] + (y + 1) * left[size] + size) / (2 * size));
+    }
+  }
+
+  Distortion bestCost = std::numeric_limits<Distortion>::max();
+  for (Int mode = 0; mode < 4; mode++)
+  {
+    bestCost = std::min(bestCost, m_rdCost.calcHAD(bitDepth, pOrg, stride, pred[mode], size, size, size));
+  }
+  return bestCost;
+}
+
+/** Integer sample motion search: best of the predictor candidates followed by a square pattern refinement with
+ *  decreasing step size.
+ */
+Void TEncLookahead::xMotionSearch(const TComPicYuv &org, const TComPicYuv &ref, const Int bx, const Int by,
+                                  const Int *candX, const Int *candY, const Int numCand, Int &bestX, Int &bestY)
+{
+  Distortion bestCost = std::numeric_limits<Distortion>::max();
+  for (Int i = 0; i < numCand; i++)
+  {
+    Int mvX = candX[i];
+    Int mvY = candY[i];
+    xClipMv(bx, by, mvX, mvY);
+    const Distortion cost = xGetSAD(org, ref, bx, by, mvX, mvY);
+    if (cost < bestCost)
+    {
+      bestCost = cost;
+      bestX    = mvX;
+      bestY    = mvY;
+    }
+  }
+
+  for (Int step = 4; step > 0; step >>= 1)
+  {
+    Bool improved = true;
+    for (Int iter = 0; improved && iter < s_searchRange / step; iter++)
+    {
+      improved = false;
+      const Int centreX = bestX;
+      const Int centreY = bestY;
+      for (Int dy = -step; dy <= step; dy += step)
+      {
+        for (Int dx = -step; dx <= step; dx += step)
+        {
+          Int mvX = centreX + dx;
+          Int mvY = centreY + dy;
+          xClipMv(bx, by, mvX, mvY);
+          if (mvX == centreX && mvY == centreY)
+          {
+            continue;
+          }
+          const Distortion cost = xGetSAD(org, ref, bx, by, mvX, mvY);
+          if (cost < bestCost)
+          {
+            bestCost = cost;
+            bestX    = mvX;
+            bestY    = mvY;
+            improved = true;
+          }
+        }
+      }
+    }
+  }
+}
+
+Distortion TEncLookahead::xGetSAD(const TComPicYuv &org, const TComPicYuv &ref, const Int bx, const Int by, const Int mvX, const Int mvY)
+{
+  const Int orgStride = org.getStride(COMPONENT_Y);
+  const Int refStride = ref.getStride(COMPONENT_Y);
+  DistParam distParam;
+  m_rdCost.setDistParam(distParam, m_internalBitDepth[CHANNEL_TYPE_LUMA],
+                        org.getAddr(COMPONENT_Y) + by * s_lowresBlockSize * orgStride + bx * s_lowresBlockSize, orgStride,
+                        ref.getAddr(COMPONENT_Y) + (by * s_lowresBlockSize + mvY) * refStride + bx * s_lowresBlockSize + mvX, refStride,
+                        s_lowresBlockSize, s_lowresBlockSize);
+  return distParam.DistFunc(&distParam);
+}
+
+Void TEncLookahead::xClipMv(const Int bx, const Int by, Int &mvX, Int &mvY) const
+{
+  // keep the motion within the search range and the referenced block within the padded low-resolution picture
+  const Int lowresWidth  = m_sourceWidth  >> 1;
+  const Int lowresHeight = m_sourceHeight >> 1;
+  mvX = Clip3(std::max(-s_searchRange, -s_lowresMargin - bx * s_lowresBlockSize), std::min(s_searchRange, lowresWidth  + s_lowresMargin - (bx + 1) * s_lowresBlockSize), mvX);
+  mvY = Clip3(std::max(-s_searchRange, -s_lowresMargin - by * s_lowresBlockSize), std::min(s_searchRange, lowresHeight + s_lowresMargin - (by + 1) * s_lowresBlockSize), mvY);
+}
+
+//! \}
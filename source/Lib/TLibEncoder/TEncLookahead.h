@@ -0,0 +1,178 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLookahead.h
+    \brief    lookahead analysis for CU-tree QP propagation (header)
+*/
+
+#ifndef __TENCLOOKAHEAD__
+#define __TENCLOOKAHEAD__
+
+#include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComRdCost.h"
+#include "Utilities/TVideoIOYuv.h"
+#include "TEncCfg.h"
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// low-resolution analysis result of one 16x16 block
+struct LookaheadBlock
+{
+  Distortion intraCost;                             ///< intra SATD estimate
+  Distortion interCost;                             ///< best uni- or bi-directional inter SATD estimate
+  Int        numRefs;                               ///< 0: intra, 1: uni-prediction, 2: bi-prediction
+  Int        refPoc[2];
+  Int        mvX[2];                                ///< motion vectors in low-resolution integer samples
+  Int        mvY[2];
+  LookaheadBlock() : intraCost(0), interCost(0), numRefs(0) {}
+};
+
+/// low-resolution analysis data of one source picture
+struct LookaheadPicInfo
+{
+  TComPicYuv                  lowres;               ///< half-resolution luma
+  Bool                        analysed;
+  std::vector<LookaheadBlock> blocks;
+  LookaheadPicInfo() : analysed(false) {}
+};
+
+/// Lookahead analysis that propagates inter dependency through the GOP reference structure (CU-tree)
+/// and derives per 16x16 block QP offsets, independently of the temporal prefilter.
+/// The analysis runs on a separate thread that reads the source pictures by itself and stays up to
+/// s_maxPendingGOPs GOPs ahead of the encoder.
+class TEncLookahead
+{
+public:
+  TEncLookahead();
+  ~TEncLookahead();
+
+  Void init(const Int frameSkip,
+            const Int inputBitDepth[MAX_NUM_CHANNEL_TYPE],
+            const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE],
+            const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE],
+            const Int width,
+            const Int height,
+            const Int *pad,
+            const Int frames,
+            const Bool Rec709,
+            const std::string &filename,
+            const ChromaFormat inputChromaFormatIDC,
+            const ChromaFormat chromaFormatIDC,
+            const InputColourSpaceConversion colorSpaceConv,
+            const Int GOPSize,
+            const GOPEntry *GOPList,
+            const Int intraPeriod,
+            const Int lookaheadFrames,
+            const Double strength,
+            std::map<Int, std::vector<Double> > *qpOffsetMap);
+  Void destroy();
+
+  /// provide the QP offsets of all pictures of the GOP that starts at receivedPoc, waiting for the analysis thread if necessary
+  Void analyse(const Int receivedPoc);
+
+  static const Int s_blockSize = 16;                ///< granularity of the QP offsets in full-resolution luma samples
+
+private:
+  static const Int s_lowresBlockSize = s_blockSize >> 1;
+  static const Int s_lowresMargin    = 64;
+  static const Int s_searchRange     = 16;
+  static const Int s_maxPendingGOPs  = 2;
+
+  // configuration
+  Int                        m_FrameSkip;
+  std::string                m_inputFileName;
+  Int                        m_inputBitDepth[MAX_NUM_CHANNEL_TYPE];
+  Int                        m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];
+  Int                        m_internalBitDepth[MAX_NUM_CHANNEL_TYPE];
+  ChromaFormat               m_inputChromaFormatIDC;
+  ChromaFormat               m_chromaFormatIDC;
+  Int                        m_sourceWidth;
+  Int                        m_sourceHeight;
+  Int                        m_sourcePadding[2];
+  Int                        m_framesToBeEncoded;
+  Bool                       m_bClipInputVideoToRec709Range;
+  InputColourSpaceConversion m_inputColourSpaceConvert;
+  Int                        m_GOPSize;
+  GOPEntry                   m_GOPList[MAX_GOP];
+  Int                        m_intraPeriod;
+  Int                        m_lookaheadFrames;
+  Double                     m_strength;
+  Int                        m_maxRefDistance;
+  std::map<Int, std::vector<Double> > *m_qpOffsetMap;
+
+  // state
+  TVideoIOYuv                m_yuvFrames;
+  TComPicYuv                 m_readBuffer;
+  TComPicYuv                 m_readBufferTrueOrg;
+  Int                        m_lastReadPoc;
+  Int                        m_widthInBlocks;
+  Int                        m_heightInBlocks;
+  TComRdCost                 m_rdCost;
+  std::map<Int, LookaheadPicInfo*> m_picInfo;
+
+  // threading
+  std::thread                m_analysisThread;
+  std::mutex                 m_analysisMutex;
+  std::condition_variable    m_analysisCondition;
+  std::map<Int, std::map<Int, std::vector<Double> > > m_analysisResults;  ///< QP offsets per picture, keyed by the first POC of the GOP
+  Bool                       m_analysisDone;
+  Bool                       m_analysisStop;
+
+  // private functions
+  Void   xAnalysisLoop     ();
+  Void   xAnalyseGOP       ( const Int firstPoc, std::map<Int, std::vector<Double> > &qpOffsetMap );
+  Bool   xIsIntra          ( const Int poc ) const;
+  Int    xGetCodingRank    ( const Int poc ) const;
+  Void   xGetReferences    ( const Int poc, std::vector<Int> &refs ) const;
+  Bool   xLoadPictures     ( const Int lastPoc );
+  Void   xReleasePictures  ( const Int firstPoc );
+  Void   xAnalysePicture   ( const Int poc );
+  Distortion xEstimateIntra( const TComPicYuv &org, const Int bx, const Int by );
+  Void   xMotionSearch     ( const TComPicYuv &org, const TComPicYuv &ref, const Int bx, const Int by, const Int *candX, const Int *candY, const Int numCand, Int &bestX, Int &bestY );
+  Distortion xGetSAD       ( const TComPicYuv &org, const TComPicYuv &ref, const Int bx, const Int by, const Int mvX, const Int mvY );
+  Void   xClipMv           ( const Int bx, const Int by, Int &mvX, Int &mvY ) const;
+};
+
+//! \}
+
+#endif // __TENCLOOKAHEAD__
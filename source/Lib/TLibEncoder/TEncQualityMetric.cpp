@@ -0,0 +1,510 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncQualityMetric.cpp
+    \brief    objective quality metrics of reconstructed pictures
+*/
+
+#include "TEncQualityMetric.h"
+#include "TLibCommon/TComRdCost.h"
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+
+#if VECTOR_CODING__DISTORTION_CALCULATIONS
+#include <emmintrin.h>
+#define QUALITY_METRIC_SIMD 1
+#else
+#define QUALITY_METRIC_SIMD 0
+#endif
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Local functions
+// ====================================================================================================================
+
+/// dst[x] = sum of window[i]*src[x+i]; the taps are accumulated in order, so vector and scalar paths give identical results
+static Void filterRow( const Double* src, Double* dst, const Int width, const Double* window, const Int windowSize )
+{
+  Int x = 0;
+#if QUALITY_METRIC_SIMD
+  for (; x + 2 <= width; x += 2)
+  {
+    __m128d acc = _mm_setzero_pd();
+    for (Int i = 0; i < windowSize; i++)
+    {
+      acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(window[i]), _mm_loadu_pd(src + x + i)));
+    }
+    _mm_storeu_pd(dst + x, acc);
+  }
+#endif
+  for (; x < width; x++)
+  {
+    Double acc = 0.0;
+    for (Int i = 0; i < windowSize; i++)
+    {
+      acc += window[i] * src[x + i];
+    }
+    dst[x] = acc;
+  }
+}
+
+/// dst[x] = sum of window[i]*src[i][x]
+static Void filterColumn( const Double* const* src, Double* dst, const Int width, const Double* window, const Int windowSize )
+{
+  Int x = 0;
+#if QUALITY_METRIC_SIMD
+  for (; x + 2 <= width; x += 2)
+  {
+    __m128d acc = _mm_setzero_pd();
+    for (Int i = 0; i < windowSize; i++)
+    {
+      acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(window[i]), _mm_loadu_pd(src[i] + x)));
+    }
+    _mm_storeu_pd(dst + x, acc);
+  }
+#endif
+  for (; x < width; x++)
+  {
+    Double acc = 0.0;
+    for (Int i = 0; i < windowSize; i++)
+    {
+      acc += window[i] * src[i][x];
+    }
+    dst[x] = acc;
+  }
+}
+
+/// SSIM of each window from its weighted moments E[o], E[r], E[o^2], E[r^2], E[o*r]
+static Void ssimFromMoments( const Double* const* mu, Double* ssim, const Int width, const Double c1, const Double c2, const Bool luminanceTerm )
+{
+  Int x = 0;
+#if QUALITY_METRIC_SIMD
+  const __m128d two  = _mm_set1_pd(2.0);
+  const __m128d vc1  = _mm_set1_pd(c1);
+  const __m128d vc2  = _mm_set1_pd(c2);
+  for (; x + 2 <= width; x += 2)
+  {
+    const __m128d muOrg     = _mm_loadu_pd(mu[0] + x);
+    const __m128d muRec     = _mm_loadu_pd(mu[1] + x);
+    const __m128d sigmaOrg  = _mm_sub_pd(_mm_loadu_pd(mu[2] + x), _mm_mul_pd(muOrg, muOrg));
+    const __m128d sigmaRec  = _mm_sub_pd(_mm_loadu_pd(mu[3] + x), _mm_mul_pd(muRec, muRec));
+    const __m128d sigmaBoth = _mm_sub_pd(_mm_loadu_pd(mu[4] + x), _mm_mul_pd(muOrg, muRec));
+    __m128d val = _mm_div_pd(_mm_add_pd(_mm_mul_pd(two, sigmaBoth), vc2), _mm_add_pd(_mm_add_pd(sigmaOrg, sigmaRec), vc2));
+    if (luminanceTerm)
+    {
+      val = _mm_mul_pd(val, _mm_div_pd(_mm_add_pd(_mm_mul_pd(_mm_mul_pd(two, muOrg), muRec), vc1),
+                                       _mm_add_pd(_mm_add_pd(_mm_mul_pd(muOrg, muOrg), _mm_mul_pd(muRec, muRec)), vc1)));
+    }
+    _mm_storeu_pd(ssim + x, val);
+  }
+#endif
+  for (; x < width; x++)
+  {
+    const Double muOrg     = mu[0][x];
+    const Double muRec     = mu[1][x];
+    const Double sigmaOrg  = mu[2][x] - muOrg*muOrg;
+    const Double sigmaRec  = mu[3][x] - muRec*muRec;
+    const Double sigmaBoth = mu[4][x] - muOrg*muRec;
+    Double val = (2.0*sigmaBoth + c2)/(sigmaOrg + sigmaRec + c2);
+    if (luminanceTerm)
+    {
+      val *= (2.0*muOrg*muRec + c1)/(muOrg*muOrg + muRec*muRec + c1);
+    }
+    ssim[x] = val;
+  }
+}
+
+/// xPSNR distortion of one luma row: sqrt(wY*seY + seChroma) per sample, written to dist
+static Void xpsnrDistortionRow( const Pel* pOrg, const Pel* pRec, const Int width, const Double weightY, const Double* seChroma, const UInt shiftWidth, Double* dist, UInt64 &ssd )
+{
+  Int x = 0;
+#if QUALITY_METRIC_SIMD
+  const __m128d vWeight = _mm_set1_pd(weightY);
+  for (; x + 2 <= width; x += 2)
+  {
+    const Intermediate_Int diff0 = (Intermediate_Int)pOrg[x]     - (Intermediate_Int)pRec[x];
+    const Intermediate_Int diff1 = (Intermediate_Int)pOrg[x + 1] - (Intermediate_Int)pRec[x + 1];
+    const UInt64 se0 = diff0 * diff0;
+    const UInt64 se1 = diff1 * diff1;
+    ssd += se0 + se1;
+    const __m128d chroma = shiftWidth ? _mm_set1_pd(seChroma[x >> 1]) : _mm_loadu_pd(seChroma + x);
+    _mm_storeu_pd(dist + x, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(vWeight, _mm_set_pd((Double)se1, (Double)se0)), chroma)));
+  }
+#endif
+  for (; x < width; x++)
+  {
+    const Intermediate_Int diff = (Intermediate_Int)pOrg[x] - (Intermediate_Int)pRec[x];
+    const UInt64 se = diff * diff;
+    ssd += se;
+    dist[x] = sqrt(weightY * (Double)se + seChroma[x >> shiftWidth]);
+  }
+}
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncQualityMetric::TEncQualityMetric()
+{
+  Double sum = 0.0;
+  for (Int i = 0; i < s_ssimWindowSize; i++)
+  {
+    m_ssimWindow[i] = exp(-((i - s_ssimWindowMidTap)*(i - s_ssimWindowMidTap))/(s_ssimWindowMidTap - 0.5));
+    sum += m_ssimWindow[i];
+  }
+  for (Int i = 0; i < s_ssimWindowSize; i++)
+  {
+    m_ssimWindow[i] /= sum;
+  }
+}
+
+TEncQualityMetric::~TEncQualityMetric()
+{
+}
+
+Void TEncQualityMetric::create( const Int numThreads )
+{
+  m_threadPool.create(numThreads);
+}
+
+Void TEncQualityMetric::destroy()
+{
+  m_threadPool.destroy();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+UInt64 TEncQualityMetric::getSSD( const Pel* pOrg, const Int orgStride, const Pel* pRec, const Int recStride, const Int width, const Int height, const UInt shift )
+{
+  const Int numBands = (height + s_bandHeight - 1) / s_bandHeight;
+  if (m_threadPool.getNumThreads() == 0 || numBands <= 1)
+  {
+    return TComRdCost::getSSD(pOrg, orgStride, pRec, recStride, width, height, shift);
+  }
+
+  std::vector<UInt64> bandSSD(numBands, 0);
+  m_threadPool.run(numBands, [&](Int band)
+  {
+    const Int y0 = band * s_bandHeight;
+    bandSSD[band] = TComRdCost::getSSD(pOrg + y0 * orgStride, orgStride, pRec + y0 * recStride, recStride, width, std::min(s_bandHeight, height - y0), shift);
+  });
+
+  UInt64 ssd = 0;
+  for (Int band = 0; band < numBands; band++)
+  {
+    ssd += bandSSD[band];
+  }
+  return ssd;
+}
+
+/** xPSNR distortion
+ * Each task handles a band of chroma rows together with the luma rows they cover, so the squared chroma errors are
+ * only kept for one row. The per-row sums are added in raster order.
+ */
+Double TEncQualityMetric::getXPSNRDistortion( const Pel* const pOrg[MAX_NUM_COMPONENT], const Int orgStride[MAX_NUM_COMPONENT],
+                                              const Pel* const pRec[MAX_NUM_COMPONENT], const Int recStride[MAX_NUM_COMPONENT],
+                                              const Int width[MAX_NUM_COMPONENT], const Int height[MAX_NUM_COMPONENT], const ChromaFormat chFmt,
+                                              const Double weight[MAX_NUM_COMPONENT], UInt64 ssd[MAX_NUM_COMPONENT] )
+{
+  assert(chFmt != CHROMA_400);
+  const UInt shiftWidth  = (chFmt == CHROMA_444) ? 0 : 1;
+  const UInt shiftHeight = (chFmt == CHROMA_420) ? 1 : 0;
+  const Int  heightC     = height[COMPONENT_Cb];
+  assert(((height[COMPONENT_Y] + (1 << shiftHeight) - 1) >> shiftHeight) <= heightC);
+
+  const Int numBands = m_threadPool.getNumThreads() == 0 ? 1 : std::max(1, (heightC + s_bandHeight - 1) / s_bandHeight);
+  const Int bandHeight = (heightC + numBands - 1) / numBands;
+  std::vector<UInt64> bandSSD(numBands * MAX_NUM_COMPONENT, 0);
+  std::vector<Double> rowDist(height[COMPONENT_Y], 0.0);
+
+  m_threadPool.run(numBands, [&](Int band)
+  {
+    std::vector<Double> seChroma(width[COMPONENT_Cb]);
+    std::vector<Double> dist(width[COMPONENT_Y]);
+    UInt64* sum = &bandSSD[band * MAX_NUM_COMPONENT];
+    const Int endRowC = std::min(heightC, (band + 1) * bandHeight);
+
+    for (Int yc = band * bandHeight; yc < endRowC; yc++)
+    {
+      const Pel* orgCb = pOrg[COMPONENT_Cb] + yc * orgStride[COMPONENT_Cb];
+      const Pel* recCb = pRec[COMPONENT_Cb] + yc * recStride[COMPONENT_Cb];
+      const Pel* orgCr = pOrg[COMPONENT_Cr] + yc * orgStride[COMPONENT_Cr];
+      const Pel* recCr = pRec[COMPONENT_Cr] + yc * recStride[COMPONENT_Cr];
+      for (Int x = 0; x < width[COMPONENT_Cb]; x++)
+      {
+        Intermediate_Int diff = (Intermediate_Int)orgCb[x] - (Intermediate_Int)recCb[x];
+        const UInt64 seCb = diff * diff;
+        diff = (Intermediate_Int)orgCr[x] - (Intermediate_Int)recCr[x];
+        const UInt64 seCr = diff * diff;
+        sum[COMPONENT_Cb] += seCb;
+        sum[COMPONENT_Cr] += seCr;
+        seChroma[x] = weight[COMPONENT_Cb] * (Double)seCb + weight[COMPONENT_Cr] * (Double)seCr;
+      }
+
+      const Int endRow = std::min(height[COMPONENT_Y], (yc + 1) << shiftHeight);
+      for (Int y = yc << shiftHeight; y < endRow; y++)
+      {
+        xpsnrDistortionRow(pOrg[COMPONENT_Y] + y * orgStride[COMPONENT_Y], pRec[COMPONENT_Y] + y * recStride[COMPONENT_Y], width[COMPONENT_Y],
+                           weight[COMPONENT_Y], &seChroma[0], shiftWidth, &dist[0], sum[COMPONENT_Y]);
+        Double rowSum = 0.0;
+        for (Int x = 0; x < width[COMPONENT_Y]; x++)
+        {
+          rowSum += dist[x];
+        }
+        rowDist[y] = rowSum;
+      }
+    }
+  });
+
+  for (Int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    ssd[comp] = 0;
+    for (Int band = 0; band < numBands; band++)
+    {
+      ssd[comp] += bandSSD[band * MAX_NUM_COMPONENT + comp];
+    }
+  }
+  Double distortion = 0.0;
+  for (Int y = 0; y < height[COMPONENT_Y]; y++)
+  {
+    distortion += rowDist[y];
+  }
+  return distortion;
+}
+
+/** MS-SSIM
+ * The pyramid is kept in fixed point: a sample of scale s holds the sum of the 4^s source samples it covers, which is
+ * exact, and is scaled to the sample range when the moments are formed. The 11x11 Gaussian window is applied as a
+ * horizontal and a vertical pass.
+ */
+Double TEncQualityMetric::getMSSSIM( const Pel* pOrg, const Int orgStride, const Pel* pRec, const Int recStride, const Int width, const Int height, const UInt bitDepth )
+{
+  UInt maxScale;
+
+  // For low resolution videos determine number of scales
+  if (width < 22 || height < 22)
+  {
+    maxScale = 1;
+  }
+  else if (width < 44 || height < 44)
+  {
+    maxScale = 2;
+  }
+  else if (width < 88 || height < 88)
+  {
+    maxScale = 3;
+  }
+  else if (width < 176 || height < 176)
+  {
+    maxScale = 4;
+  }
+  else
+  {
+    maxScale = 5;
+  }
+
+  assert(maxScale>0 && maxScale<=s_maxMSSSIMScale);
+
+  //Resolution based weights
+  const Double exponentWeights[s_maxMSSSIMScale][s_maxMSSSIMScale] = {{1.0,    0,      0,      0,      0     },
+                                                                      {0.1356, 0.8644, 0,      0,      0     },
+                                                                      {0.0711, 0.4530, 0.4760, 0,      0     },
+                                                                      {0.0517, 0.3295, 0.3462, 0.2726, 0     },
+                                                                      {0.0448, 0.2856, 0.3001, 0.2363, 0.1333}};
+
+  std::vector<Int> original[s_maxMSSSIMScale];
+  std::vector<Int> recon[s_maxMSSSIMScale];
+
+  for (UInt scale = 0; scale < maxScale; scale++)
+  {
+    original[scale].resize((height >> scale)*(width >> scale));
+    recon[scale].resize((height >> scale)*(width >> scale));
+  }
+
+  for (Int y = 0; y < height; y++)
+  {
+    for (Int x = 0; x < width; x++)
+    {
+      original[0][y*width+x] = pOrg[y*orgStride+x];
+      recon[0][   y*width+x] = pRec[y*recStride+x];
+    }
+  }
+
+  // each sample of the next scale is the sum of a 2x2 block; the previous scale is addressed with a stride of twice
+  // the new width, as it always has been
+  for (UInt scale = 1; scale < maxScale; scale++)
+  {
+    const Int scaledHeight = height >> scale;
+    const Int scaledWidth  = width  >> scale;
+    const Int* prevOrg = &original[scale-1][0];
+    const Int* prevRec = &recon[scale-1][0];
+    for (Int y = 0; y < scaledHeight; y++)
+    {
+      for (Int x = 0; x < scaledWidth; x++)
+      {
+        const Int i0 = 2*y*(2*scaledWidth) + 2*x;
+        const Int i1 = i0 + 2*scaledWidth;
+        original[scale][y*scaledWidth+x] = prevOrg[i0] + prevOrg[i0+1] + prevOrg[i1] + prevOrg[i1+1];
+        recon[scale][y*scaledWidth+x]    = prevRec[i0] + prevRec[i0+1] + prevRec[i1] + prevRec[i1+1];
+      }
+    }
+  }
+
+  const UInt   maxValue  = (1<<bitDepth)-1;
+  const Double c1        = (0.01*maxValue)*(0.01*maxValue);
+  const Double c2        = (0.03*maxValue)*(0.03*maxValue);
+
+  Double finalMSSSIM = 1.0;
+
+  for (UInt scale = 0; scale < maxScale; scale++)
+  {
+    const Double sampleScale = 1.0 / Double(1 << (2*scale));
+    const Double meanSSIM    = xGetMeanSSIM(&original[scale][0], &recon[scale][0], width >> scale, height >> scale, sampleScale, c1, c2, scale == maxScale-1);
+
+    finalMSSSIM *= pow(meanSSIM, exponentWeights[maxScale-1][scale]);
+  }
+
+  return finalMSSSIM;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/// mean SSIM over all window positions of one scale; the rows of window positions are split into bands
+Double TEncQualityMetric::xGetMeanSSIM( const Int* org, const Int* rec, const Int width, const Int height, const Double sampleScale, const Double c1, const Double c2, const Bool luminanceTerm )
+{
+  const Int blocksPerRow    = width  - s_ssimWindowSize + 1;
+  const Int blocksPerColumn = height - s_ssimWindowSize + 1;
+  if (blocksPerRow <= 0 || blocksPerColumn <= 0)
+  {
+    return 0.0;
+  }
+
+  const Int numBands   = m_threadPool.getNumThreads() == 0 ? 1 : (blocksPerColumn + s_bandHeight - 1) / s_bandHeight;
+  const Int bandHeight = (blocksPerColumn + numBands - 1) / numBands;
+  std::vector<Double> rowSSIM(blocksPerColumn, 0.0);
+
+  m_threadPool.run(numBands, [&](Int band)
+  {
+    const Int firstRow = band * bandHeight;
+    const Int endRow   = std::min(blocksPerColumn, firstRow + bandHeight);
+    if (firstRow < endRow)
+    {
+      xGetSSIMRows(org, rec, width, firstRow, endRow, sampleScale, c1, c2, luminanceTerm, &rowSSIM[0]);
+    }
+  });
+
+  Double meanSSIM = 0.0;
+  for (Int row = 0; row < blocksPerColumn; row++)
+  {
+    meanSSIM += rowSSIM[row];
+  }
+  return meanSSIM / (blocksPerRow * blocksPerColumn);
+}
+
+/** SSIM sums of the window rows firstRow .. endRow-1
+ * The five moments of each source row are filtered horizontally into a ring of window-height rows, which is then
+ * filtered vertically for each row of window positions.
+ */
+Void TEncQualityMetric::xGetSSIMRows( const Int* org, const Int* rec, const Int width, const Int firstRow, const Int endRow, const Double sampleScale, const Double c1, const Double c2, const Bool luminanceTerm, Double* rowSSIM ) const
+{
+  const Int numMoments   = 5;
+  const Int blocksPerRow = width - s_ssimWindowSize + 1;
+
+  std::vector<Double> moments(numMoments * width);
+  std::vector<Double> ring(s_ssimWindowSize * numMoments * blocksPerRow);
+  std::vector<Double> mu(numMoments * blocksPerRow);
+  std::vector<Double> ssim(blocksPerRow);
+  const Double* column[s_ssimWindowSize];
+  const Double* muRow[numMoments];
+  for (Int m = 0; m < numMoments; m++)
+  {
+    muRow[m] = &mu[m * blocksPerRow];
+  }
+
+  for (Int y = firstRow; y < endRow + s_ssimWindowSize - 1; y++)
+  {
+    Double* momOrg     = &moments[0];
+    Double* momRec     = &moments[width];
+    Double* momOrgSqr  = &moments[2 * width];
+    Double* momRecSqr  = &moments[3 * width];
+    Double* momOrgRec  = &moments[4 * width];
+    for (Int x = 0; x < width; x++)
+    {
+      const Double orgPel = org[y * width + x] * sampleScale;
+      const Double recPel = rec[y * width + x] * sampleScale;
+      momOrg[x]    = orgPel;
+      momRec[x]    = recPel;
+      momOrgSqr[x] = orgPel * orgPel;
+      momRecSqr[x] = recPel * recPel;
+      momOrgRec[x] = orgPel * recPel;
+    }
+
+    Double* ringRow = &ring[((y - firstRow) % s_ssimWindowSize) * numMoments * blocksPerRow];
+    for (Int m = 0; m < numMoments; m++)
+    {
+      filterRow(&moments[m * width], ringRow + m * blocksPerRow, blocksPerRow, m_ssimWindow, s_ssimWindowSize);
+    }
+
+    const Int row = y - s_ssimWindowSize + 1;
+    if (row < firstRow)
+    {
+      continue;
+    }
+
+    for (Int m = 0; m < numMoments; m++)
+    {
+      for (Int i = 0; i < s_ssimWindowSize; i++)
+      {
+        column[i] = &ring[(((row - firstRow + i) % s_ssimWindowSize) * numMoments + m) * blocksPerRow];
+      }
+      filterColumn(column, &mu[m * blocksPerRow], blocksPerRow, m_ssimWindow, s_ssimWindowSize);
+    }
+
+    ssimFromMoments(muRow, &ssim[0], blocksPerRow, c1, c2, luminanceTerm);
+    Double sum = 0.0;
+    for (Int x = 0; x < blocksPerRow; x++)
+    {
+      sum += ssim[x];
+    }
+    rowSSIM[row] = sum;
+  }
+}
+
+//! \}
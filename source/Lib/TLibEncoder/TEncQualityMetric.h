@@ -0,0 +1,92 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncQualityMetric.h
+    \brief    objective quality metrics of reconstructed pictures (header)
+*/
+
+#ifndef __TENCQUALITYMETRIC__
+#define __TENCQUALITYMETRIC__
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComThreadPool.h"
+#include <vector>
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// SSD, xPSNR and MS-SSIM of a reconstructed plane against its source, split into bands of rows on a thread pool.
+/// Results do not depend on the number of threads.
+class TEncQualityMetric
+{
+public:
+  TEncQualityMetric();
+  ~TEncQualityMetric();
+
+  /// numThreads additional threads are used for every calculation
+  Void   create        ( const Int numThreads );
+  Void   destroy       ();
+
+  /// sum of squared differences of one plane, every term is right-shifted by shift
+  UInt64 getSSD        ( const Pel* pOrg, const Int orgStride, const Pel* pRec, const Int recStride, const Int width, const Int height, const UInt shift = 0 );
+
+  /// sum over all luma samples of the square root of the weighted squared error of the co-located luma and chroma
+  /// samples, as used by xPSNR. ssd receives the sum of squared differences of each component.
+  Double getXPSNRDistortion ( const Pel* const pOrg[MAX_NUM_COMPONENT], const Int orgStride[MAX_NUM_COMPONENT],
+                              const Pel* const pRec[MAX_NUM_COMPONENT], const Int recStride[MAX_NUM_COMPONENT],
+                              const Int width[MAX_NUM_COMPONENT], const Int height[MAX_NUM_COMPONENT], const ChromaFormat chFmt,
+                              const Double weight[MAX_NUM_COMPONENT], UInt64 ssd[MAX_NUM_COMPONENT] );
+
+  /// multi-scale structural similarity of one plane
+  Double getMSSSIM     ( const Pel* pOrg, const Int orgStride, const Pel* pRec, const Int recStride, const Int width, const Int height, const UInt bitDepth );
+
+private:
+  static const Int s_bandHeight        = 32;                  ///< rows per task
+  static const Int s_maxMSSSIMScale    = 5;
+  static const Int s_ssimWindowMidTap  = 5;
+  static const Int s_ssimWindowSize    = 2*s_ssimWindowMidTap+1;
+
+  Double xGetMeanSSIM  ( const Int* org, const Int* rec, const Int width, const Int height, const Double sampleScale, const Double c1, const Double c2, const Bool luminanceTerm );
+  Void   xGetSSIMRows  ( const Int* org, const Int* rec, const Int width, const Int firstRow, const Int endRow, const Double sampleScale, const Double c1, const Double c2, const Bool luminanceTerm, Double* rowSSIM ) const;
+
+  TComThreadPool m_threadPool;
+  Double         m_ssimWindow[s_ssimWindowSize];              ///< normalised 1-D Gaussian, s.d. 1.5; the 11x11 window is its outer product
+};
+
+//! \}
+
+#endif // __TENCQUALITYMETRIC__
@@ -39,6 +39,7 @@
 #include "../TLibCommon/TComChromaFormat.h"
 
 #include <cmath>
+#include <sstream>
 
 using namespace std;
 
@@ -70,6 +71,7 @@ TEncRCSeq::TEncRCSeq()
   m_useLCUSeparateModel = false;
   m_adaptiveBit         = 0;
   m_lastLambda          = 0.0;
+  m_passBitsLeft        = 0;
 }
 
 TEncRCSeq::~TEncRCSeq()
@@ -212,6 +214,9 @@ Void TEncRCSeq::destroy()
     delete[] m_LCUPara;
     m_LCUPara = NULL;
   }
+
+  m_passStats.clear();
+  m_passBitsLeft = 0;
 }
 
 Void TEncRCSeq::initBitsRatio( Int bitsRatio[])
@@ -309,6 +314,45 @@ Void TEncRCSeq::setAllBitRatio( Double basicLambda, Double* equaCoeffA, Double*
   delete[] bitsRatio;
 }
 
+Void TEncRCSeq::initPassStats( const map<Int, TRCPassStats>& passStats )
+{
+  m_passStats.clear();
+  m_passBitsLeft = 0;
+  for ( map<Int, TRCPassStats>::const_iterator it = passStats.begin(); it != passStats.end(); it++ )
+  {
+    // pictures of the first pass beyond the frames to be coded must not take a share of the bits
+    if ( it->first < m_totalFrames )
+    {
+      TRCPassStats& stats = m_passStats[it->first];
+      stats = it->second;
+      m_passBitsLeft += stats.m_bits;
+
+      // a CTU coded with few bits is either cheap or was starved by the first-pass lambda; its share of the picture
+      // distortion tells the two apart, so the CTU weight averages its share of the bits and of the distortion
+      Double totalBits = 0.0;
+      Double totalDistortion = 0.0;
+      for ( Int i = 0; i < (Int)stats.m_LCUBits.size(); i++ )
+      {
+        totalBits       += max( stats.m_LCUBits[i], 0 );
+        totalDistortion += stats.m_LCUDistortion[i];
+      }
+      stats.m_LCUWeight.resize( stats.m_LCUBits.size() );
+      for ( Int i = 0; i < (Int)stats.m_LCUBits.size(); i++ )
+      {
+        const Double bitShare        = totalBits > 0.0 ? max( stats.m_LCUBits[i], 0 ) / totalBits : 0.0;
+        const Double distortionShare = totalDistortion > 0.0 ? stats.m_LCUDistortion[i] / totalDistortion : bitShare;
+        stats.m_LCUWeight[i] = 0.5 * ( bitShare + distortionShare );
+      }
+    }
+  }
+}
+
+const TRCPassStats* TEncRCSeq::getPassStats( Int POC )
+{
+  map<Int, TRCPassStats>::const_iterator it = m_passStats.find( POC );
+  return it == m_passStats.end() ? NULL : &it->second;
+}
+
 //GOP level
 TEncRCGOP::TEncRCGOP()
 {
@@ -610,6 +654,7 @@ TEncRCPic::TEncRCPic()
   m_pixelsLeft    = 0;
 
   m_LCUs         = NULL;
+  m_passStats    = NULL;
   m_picActualHeaderBits = 0;
   m_picActualBits       = 0;
   m_picQP               = 0;
@@ -654,6 +699,21 @@ Int TEncRCPic::xEstPicTargetBits( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP )
   return targetBits;
 }
 
+Int TEncRCPic::xEstPicTargetBitsFromPass( TEncRCSeq* encRCSeq )
+{
+  // the bits left are shared by the remaining pictures in proportion to their first-pass bits, which keeps the relative
+  // allocation of the first pass and spreads the deviation of the pictures coded so far over the rest of the sequence
+  Int64 passBitsLeft = max<Int64>( encRCSeq->getPassBitsLeft(), m_passStats->m_bits );
+  Int targetBits     = Int( (Double)encRCSeq->getBitsLeft() * m_passStats->m_bits / max<Int64>( passBitsLeft, 1 ) );
+
+  if ( targetBits < 100 )
+  {
+    targetBits = 100;   // at least allocate 100 bits for one picture
+  }
+
+  return targetBits;
+}
+
 Int TEncRCPic::xEstPicHeaderBits( list<TEncRCPic*>& listPreviousPictures, Int frameLevel )
 {
   Int numPreviousPics   = 0;
@@ -729,13 +789,18 @@ Void TEncRCPic::addToPictureLsit( list<TEncRCPic*>& listPreviousPictures )
   listPreviousPictures.push_back( this );
 }
 
-Void TEncRCPic::create( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP, Int frameLevel, list<TEncRCPic*>& listPreviousPictures )
+Void TEncRCPic::create( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP, Int frameLevel, Int POC, list<TEncRCPic*>& listPreviousPictures )
 {
   destroy();
   m_encRCSeq = encRCSeq;
   m_encRCGOP = encRCGOP;
+  m_passStats = encRCSeq->getPassStats( POC );
+  if ( m_passStats != NULL && (Int)m_passStats->m_LCUBits.size() != encRCSeq->getNumberOfLCU() )
+  {
+    m_passStats = NULL;   // the first pass used a different CTU grid
+  }
 
-  Int targetBits    = xEstPicTargetBits( encRCSeq, encRCGOP );
+  Int targetBits    = m_passStats != NULL ? xEstPicTargetBitsFromPass( encRCSeq ) : xEstPicTargetBits( encRCSeq, encRCGOP );
   Int estHeaderBits = xEstPicHeaderBits( listPreviousPictures, frameLevel );
 
   if ( targetBits < estHeaderBits + 100 )
@@ -848,6 +913,12 @@ Double TEncRCPic::estimatePicLambda( list<TEncRCPic*>& listPreviousPictures, Sli
     }
   }
 
+  if ( m_passStats != NULL && lastLevelLambda < 0.0 && m_passStats->m_lambda > 0.0 )
+  {
+    // the model of this level is still untrained: scale the lambda of the first pass to the target bits instead
+    estLambda = m_passStats->m_lambda * pow( (Double)m_targetBits / (Double)max( m_passStats->m_bits, 1 ), eSliceType == I_SLICE ? -beta : beta );
+  }
+
   if ( lastLevelLambda > 0.0 )
   {
     lastLevelLambda = Clip3( 0.1, 10000.0, lastLevelLambda );
@@ -895,7 +966,14 @@ Double TEncRCPic::estimatePicLambda( list<TEncRCPic*>& listPreviousPictures, Sli
       betaLCU  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
     }
 
-    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+    if ( m_passStats != NULL )
+    {
+      m_LCUs[i].m_bitWeight = m_passStats->m_LCUWeight[i] * m_targetBits;
+    }
+    else
+    {
+      m_LCUs[i].m_bitWeight = m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+    }
 
     if ( m_LCUs[i].m_bitWeight < 0.01 )
     {
@@ -1286,6 +1364,10 @@ Void TEncRCPic::updateAfterPicture( Int actualHeaderBits, Int actualTotalBits, D
 {
   m_picActualHeaderBits = actualHeaderBits;
   m_picActualBits       = actualTotalBits;
+  if ( m_passStats != NULL )
+  {
+    m_encRCSeq->updateAfterPassPic( m_passStats->m_bits );
+  }
   if ( averageQP > 0.0 )
   {
     m_picQP             = Int( averageQP + 0.5 );
@@ -1872,10 +1954,10 @@ Void TEncRateCtrl::init( Int totalFrames, Int targetBitrate, Int frameRate, Int
   delete[] GOPID2Level;
 }
 
-Void TEncRateCtrl::initRCPic( Int frameLevel )
+Void TEncRateCtrl::initRCPic( Int frameLevel, Int POC )
 {
   m_encRCPic = new TEncRCPic;
-  m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, m_listRCPictures );
+  m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, POC, m_listRCPictures );
 }
 
 Void TEncRateCtrl::initRCGOP( Int numberOfPictures )
@@ -1922,3 +2004,84 @@ Void TEncRateCtrl::destroyRCGOP()
   delete m_encRCGOP;
   m_encRCGOP = NULL;
 }
+
+// The first-pass statistics file holds one line per picture, in coding order:
+//   POC lambda bits numberOfCTUs bits(CTU 0) distortion(CTU 0) ... bits(CTU numberOfCTUs-1) distortion(CTU numberOfCTUs-1)
+// where the CTUs are in coding order and their bits and distortion are the estimates of the rate-distortion optimisation.
+
+Bool TEncRateCtrl::openPassStats( const std::string& fileName )
+{
+  m_passStatsFile.open( fileName.c_str(), ios::out );
+  if ( !m_passStatsFile )
+  {
+    return false;
+  }
+  m_passStatsFile << "# POC lambda bits numberOfCTUs CTU-bits CTU-distortion...\n";
+  return true;
+}
+
+Void TEncRateCtrl::closePassStats()
+{
+  if ( m_passStatsFile.is_open() )
+  {
+    m_passStatsFile.close();
+  }
+}
+
+Void TEncRateCtrl::writePassStats( TComPic* pcPic, Int actualTotalBits )
+{
+  if ( !m_passStatsFile.is_open() )
+  {
+    return;
+  }
+  const TComPicSym* picSym = pcPic->getPicSym();
+  const UInt numberOfCtus  = picSym->getNumberOfCtusInFrame();
+
+  const TComSlice* pcSlice = pcPic->getSlice(0);
+  m_passStatsFile << pcPic->getPOC() << " " << pcSlice->getLambdas()[COMPONENT_Y] << " " << actualTotalBits << " " << numberOfCtus;
+  for ( UInt ctuTsAddr = 0; ctuTsAddr < numberOfCtus; ctuTsAddr++ )
+  {
+    TComDataCU* pCtu = pcPic->getCtu( picSym->getCtuTsToRsAddrMap( ctuTsAddr ) );
+    m_passStatsFile << " " << pCtu->getTotalBits() << " " << pCtu->getTotalDistortion();
+  }
+  m_passStatsFile << "\n";
+}
+
+Bool TEncRateCtrl::readPassStats( const std::string& fileName )
+{
+  ifstream passStatsFile( fileName.c_str(), ios::in );
+  if ( !passStatsFile )
+  {
+    return false;
+  }
+
+  map<Int, TRCPassStats> passStats;
+  string line;
+  while ( getline( passStatsFile, line ) )
+  {
+    if ( line.empty() || line[0] == '#' )
+    {
+      continue;
+    }
+    istringstream lineStream( line );
+    Int POC, numberOfCtus;
+    TRCPassStats stats;
+    if ( !( lineStream >> POC >> stats.m_lambda >> stats.m_bits >> numberOfCtus ) || numberOfCtus < 0 )
+    {
+      return false;
+    }
+    stats.m_LCUBits.resize( numberOfCtus );
+    stats.m_LCUDistortion.resize( numberOfCtus );
+    for ( Int i = 0; i < numberOfCtus; i++ )
+    {
+      if ( !( lineStream >> stats.m_LCUBits[i] >> stats.m_LCUDistortion[i] ) )
+      {
+        return false;
+      }
+    }
+    passStats[POC] = stats;
+  }
+
+  m_encRCSeq->initPassStats( passStats );
+  return true;
+}
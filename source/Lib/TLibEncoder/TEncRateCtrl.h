@@ -47,7 +47,9 @@
 #include "../TLibCommon/TComDataCU.h"
 
 #include <vector>
+#include <map>
 #include <algorithm>
+#include <fstream>
 
 using namespace std;
 
@@ -112,6 +114,15 @@ struct TRCParameter
 #endif
 };
 
+struct TRCPassStats       // statistics of one picture from the first pass of two-pass rate control
+{
+  Double m_lambda;
+  Int m_bits;
+  vector<Int> m_LCUBits;          // in CTU coding order
+  vector<Double> m_LCUDistortion; // in CTU coding order, the complexity of the CTU at the first-pass lambda
+  vector<Double> m_LCUWeight;     // in CTU coding order, the share of the picture bits the CTU is allocated in the second pass
+};
+
 class TEncRCSeq
 {
 public:
@@ -131,6 +142,8 @@ public:
   Void initLCUPara( TRCParameter** LCUPara = NULL );    // NULL to initial with default value
   Void updateAfterPic ( Int bits );
   Void setAllBitRatio( Double basicLambda, Double* equaCoeffA, Double* equaCoeffB );
+  Void initPassStats( const map<Int, TRCPassStats>& passStats );
+  Void updateAfterPassPic( Int passBits ) { m_passBitsLeft -= passBits; }
 
 public:
   Int  getTotalFrames()                 { return m_totalFrames; }
@@ -175,6 +188,9 @@ public:
   Double getLastLambda()                { return m_lastLambda;   }
   Void   setLastLambda( Double lamdba ) { m_lastLambda = lamdba; }
 
+  const TRCPassStats* getPassStats( Int POC );    // NULL when the first pass provided no statistics for the picture
+  Int64  getPassBitsLeft()              { return m_passBitsLeft; }
+
 private:
   Int m_totalFrames;
   Int m_targetRate;
@@ -207,6 +223,9 @@ private:
 
   Int m_adaptiveBit;
   Double m_lastLambda;
+
+  map<Int, TRCPassStats> m_passStats;
+  Int64 m_passBitsLeft;   // first-pass bits of the pictures not coded yet
 };
 
 class TEncRCGOP
@@ -256,7 +275,7 @@ public:
   ~TEncRCPic();
 
 public:
-  Void create( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP, Int frameLevel, list<TEncRCPic*>& listPreviousPictures );
+  Void create( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP, Int frameLevel, Int POC, list<TEncRCPic*>& listPreviousPictures );
   Void destroy();
 
   Int    estimatePicQP    ( Double lambda, list<TEncRCPic*>& listPreviousPictures );
@@ -283,6 +302,7 @@ public:
 
 private:
   Int xEstPicTargetBits( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP );
+  Int xEstPicTargetBitsFromPass( TEncRCSeq* encRCSeq );
   Int xEstPicHeaderBits( list<TEncRCPic*>& listPreviousPictures, Int frameLevel );
   Int xEstPicLowerBound( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP );
 
@@ -309,6 +329,7 @@ public:
   Void setTotalIntraCost(Double cost)                     { m_totalCostIntra = cost; }
   Void getLCUInitTargetBits();
 
+  const TRCPassStats* getPassStats()                      { return m_passStats; }
   Int  getPicActualBits()                                 { return m_picActualBits; }
   Int  getPicActualQP()                                   { return m_picQP; }
   Double getPicActualLambda()                             { return m_picLambda; }
@@ -340,6 +361,7 @@ private:
   Int m_pixelsLeft;
 
   TRCLCU* m_LCUs;
+  const TRCPassStats* m_passStats;
   Int m_picActualHeaderBits;    // only SH and potential APS
   Double m_totalCostIntra;
   Double m_remainingCostIntra;
@@ -365,7 +387,7 @@ public:
   Void init( Int totalFrames, Int targetBitrate, Int frameRate, Int GOPSize, Int picWidth, Int picHeight, Int LCUWidth, Int LCUHeight, Int keepHierBits, Bool useLCUSeparateModel, GOPEntry GOPList[MAX_GOP] );
 #endif
   Void destroy();
-  Void initRCPic( Int frameLevel );
+  Void initRCPic( Int frameLevel, Int POC );
   Void initRCGOP( Int numberOfPictures );
   Void destroyRCGOP();
 
@@ -383,6 +405,11 @@ public:
   Int        updateCpbState(Int actualBits);
   Void       initHrdParam(const TComHRD* pcHrd, Int iFrameRate, Double fInitialCpbFullness);
 
+  Bool       openPassStats ( const std::string& fileName );
+  Void       closePassStats();
+  Void       writePassStats( TComPic* pcPic, Int actualTotalBits );
+  Bool       readPassStats ( const std::string& fileName );
+
 private:
   TEncRCSeq* m_encRCSeq;
   TEncRCGOP* m_encRCGOP;
@@ -393,6 +420,7 @@ private:
   Int        m_cpbState;                // CPB State 
   UInt       m_cpbSize;                 // CPB size
   UInt       m_bufferingRate;           // Buffering rate
+  std::ofstream m_passStatsFile;        // first-pass statistics output of two-pass rate control
 };
 
 #endif
@@ -41,6 +41,7 @@
 #include "TEncSearch.h"
 #include "TLibCommon/TComTU.h"
 #include "TLibCommon/Debug.h"
+#include "TLibCommon/TComProfiler.h"
 #include <math.h>
 #include <limits>
 
@@ -307,6 +308,24 @@ Void TEncSearch::init(TEncCfg*       pcEncCfg,
   m_isInitialized = true;
 }
 
+Void TEncSearch::addGradientIntraStats(const TEncSearch &src)
+{
+  m_gradientIntraStats.numPUs         += src.m_gradientIntraStats.numPUs;
+  m_gradientIntraStats.numModesTested += src.m_gradientIntraStats.numModesTested;
+}
+
+Void TEncSearch::copyMotionSearchState(const TEncSearch &src)
+{
+  memcpy(m_aaiAdaptSR, src.m_aaiAdaptSR, sizeof(m_aaiAdaptSR));
+  for (UInt list = 0; list < NUM_REF_PIC_LIST_01; list++)
+  {
+    for (UInt refIdx = 0; refIdx < MAX_NUM_REF; refIdx++)
+    {
+      m_integerMv2Nx2N[list][refIdx] = src.m_integerMv2Nx2N[list][refIdx];
+    }
+  }
+}
+
 
 __inline Void TEncSearch::xTZSearchHelp( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct, const Int iSearchX, const Int iSearchY, const UChar ucPointNr, const UInt uiDistance )
 {
@@ -2208,6 +2227,7 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
                                Pel         resiLuma[NUMBER_OF_STORED_RESIDUAL_TYPES][MAX_CU_SIZE * MAX_CU_SIZE]
                                DEBUG_STRING_FN_DECLARE(sDebug))
 {
+  PROFILE_SCOPE( PROF_ENC_INTRA_LUMA_SEARCH );
   const UInt         uiDepth               = pcCU->getDepth(0);
   const UInt         uiInitTrDepth         = pcCU->getPartitionSize(0) == SIZE_2Nx2N ? 0 : 1;
   const UInt         uiNumPU               = 1<<(2*uiInitTrDepth);
@@ -2251,6 +2271,12 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
     pcCU->setQPSubParts( pcCU->getSlice()->getSliceQp(), 0, uiDepth );
   }
 
+  // the edge direction histograms used by the mode pre-selection are computed once per CU
+  if (m_pcEncCfg->getFastIntraGradient())
+  {
+    xGetGradientIntraHistograms( pcCU );
+  }
+
   //===== loop over partitions =====
   TComTURecurse tuRecurseCU(pcCU, 0);
   TComTURecurse tuRecurseWithPU(tuRecurseCU, false, (uiInitTrDepth==0)?TComTU::DONT_SPLIT : TComTU::QUAD_SPLIT);
@@ -2277,15 +2303,26 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
     {
       assert(numModesForFullRD < numModesAvailable);
 
+      const TComRectangle &puRect=tuRecurseWithPU.getRect(COMPONENT_Y);
+      const UInt uiAbsPartIdx=tuRecurseWithPU.GetAbsPartIdxTU();
+
+      // optional pre-selection of the modes to be tested, based on the edge directions of the original samples
+      Bool modeSelected[NUM_INTRA_MODE];
+      const Bool bUseGradient = m_pcEncCfg->getFastIntraGradient();
+      if (bUseGradient)
+      {
+        const Int numSelected = xGetGradientIntraCandidates( pcCU, uiInitTrDepth, uiPartOffset, modeSelected );
+        numModesForFullRD = std::min( numModesForFullRD, numSelected );
+        m_gradientIntraStats.numPUs++;
+        m_gradientIntraStats.numModesTested += numSelected;
+      }
+
       for( Int i=0; i < numModesForFullRD; i++ )
       {
         CandCostList[ i ] = MAX_DOUBLE;
       }
       CandNum = 0;
 
-      const TComRectangle &puRect=tuRecurseWithPU.getRect(COMPONENT_Y);
-      const UInt uiAbsPartIdx=tuRecurseWithPU.GetAbsPartIdxTU();
-
       Pel* piOrg         = pcOrgYuv ->getAddr( COMPONENT_Y, uiAbsPartIdx );
       Pel* piPred        = pcPredYuv->getAddr( COMPONENT_Y, uiAbsPartIdx );
       UInt uiStride      = pcPredYuv->getStride( COMPONENT_Y );
@@ -2295,6 +2332,10 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
       distParam.bApplyWeight = false;
       for( Int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++ )
       {
+        if (bUseGradient && !modeSelected[modeIdx])
+        {
+          continue;
+        }
         UInt       uiMode = modeIdx;
         Distortion uiSad  = 0;
 
@@ -2957,6 +2998,8 @@ Void TEncSearch::predInterSearch( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv*
 Void TEncSearch::predInterSearch( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv* pcPredYuv, TComYuv* pcResiYuv, TComYuv* pcRecoYuv, Bool bUseRes )
 #endif
 {
+  PROFILE_SCOPE( PROF_ENC_INTER_SEARCH );
+  PROFILE_COUNT( PROF_COUNTER_INTER_SEARCH_SAMPLES, pcCU->getWidth( 0 ) * pcCU->getHeight( 0 ) );
   for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
   {
     m_acYuvPred[i].clear();
@@ -5562,6 +5605,154 @@ UInt TEncSearch::xModeBitsIntra( TComDataCU* pcCU, UInt uiMode, UInt uiPartOffse
 
 
 
+/** Compute the histograms of the edge directions (Sobel) of the original luma samples in the four quadrants of a CU,
+ *  unless they were already computed for this CU. The quadrants are the PUs of the NxN partitioning, and their sum
+ *  is the histogram of the 2Nx2N PU.
+ * \param pcCU  CU to be analysed
+ */
+Void TEncSearch::xGetGradientIntraHistograms( TComDataCU* pcCU )
+{
+  GradientIntraHistograms &histograms = m_gradientIntraHistograms;
+  if( histograms.pic == pcCU->getPic() && histograms.poc == pcCU->getSlice()->getPOC() && histograms.ctuRsAddr == pcCU->getCtuRsAddr()
+    && histograms.absZorderIdx == pcCU->getZorderIdxInCtu() && histograms.depth == pcCU->getDepth( 0 ) )
+  {
+    return;
+  }
+  histograms.pic          = pcCU->getPic();
+  histograms.poc          = pcCU->getSlice()->getPOC();
+  histograms.ctuRsAddr    = pcCU->getCtuRsAddr();
+  histograms.absZorderIdx = pcCU->getZorderIdxInCtu();
+  histograms.depth        = pcCU->getDepth( 0 );
+
+  // edge slope (in 1/32 sample) of the angular modes 2..18 and 18..34, see the intraPredAngle table
+  static const Int angTable[17] = { 32, 26, 21, 17, 13, 9, 5, 2, 0, -2, -5, -9, -13, -17, -21, -26, -32 };
+
+  const TComPicYuv *pcPicOrg  = pcCU->getPic()->getPicYuvOrg();
+  const Pel        *piOrg     = pcPicOrg->getAddr( COMPONENT_Y );
+  const Int         iStride   = pcPicOrg->getStride( COMPONENT_Y );
+  const Int         picWidth  = pcPicOrg->getWidth( COMPONENT_Y );
+  const Int         picHeight = pcPicOrg->getHeight( COMPONENT_Y );
+  const Int         halfSize  = pcCU->getWidth( 0 ) >> 1;
+  const Int         x0        = pcCU->getCUPelX();
+  const Int         y0        = pcCU->getCUPelY();
+
+  for( Int q = 0; q < 4; q++ )
+  {
+    UInt64 *histogram = histograms.quadrant[q];
+    for( Int mode = 0; mode < NUM_INTRA_MODE; mode++ )
+    {
+      histogram[mode] = 0;
+    }
+
+    const Int qx = x0 + ( q & 1 ) * halfSize;
+    const Int qy = y0 + ( q >> 1 ) * halfSize;
+    for( Int y = qy; y < std::min<Int>( qy + halfSize, picHeight ); y++ )
+    {
+      const Pel *above = piOrg + std::max( y - 1, 0 ) * iStride;
+      const Pel *curr  = piOrg + y * iStride;
+      const Pel *below = piOrg + std::min( y + 1, picHeight - 1 ) * iStride;
+      for( Int x = qx; x < std::min<Int>( qx + halfSize, picWidth ); x++ )
+      {
+        const Int xl = std::max( x - 1, 0 );
+        const Int xr = std::min( x + 1, picWidth - 1 );
+        const Int gx = ( above[xr] + 2 * curr[xr] + below[xr] ) - ( above[xl] + 2 * curr[xl] + below[xl] );
+        const Int gy = ( below[xl] + 2 * below[x] + below[xr] ) - ( above[xl] + 2 * above[x] + above[xr] );
+        if( gx == 0 && gy == 0 )
+        {
+          continue;
+        }
+
+        // the edge runs perpendicular to the gradient: (ex, ey) = (-gy, gx)
+        const Bool   bHorFamily = abs( gy ) >= abs( gx );
+        const Double slope      = bHorFamily ? 32.0 * gx / gy : 32.0 * gy / gx;
+        const Int    sign       = bHorFamily ? 1 : -1;
+        Int idx = 0;
+        while( idx < 16 && fabs( sign * angTable[idx + 1] - slope ) < fabs( sign * angTable[idx] - slope ) )
+        {
+          idx++;
+        }
+        const Int mode = ( bHorFamily ? 2 : 18 ) + idx;
+        histogram[mode] += abs( gx ) + abs( gy );
+      }
+    }
+  }
+}
+
+/** Select the luma intra modes of a PU for the Hadamard based first pass, using the edge direction histograms of the
+ *  CU (see xGetGradientIntraHistograms). Planar, DC, the strongest directions with their neighbouring angular modes
+ *  and the most probable modes are selected.
+ * \param pcCU           CU containing the PU
+ * \param uiInitTrDepth  0 for the 2Nx2N PU, 1 for the NxN PUs
+ * \param uiPartOffset   partition index of the PU
+ * \param modeSelected   returns for every mode whether it is selected
+ * \returns number of selected modes
+ */
+Int TEncSearch::xGetGradientIntraCandidates( TComDataCU* pcCU, const UInt uiInitTrDepth, const UInt uiPartOffset, Bool *modeSelected )
+{
+  UInt64 histogram[NUM_INTRA_MODE] = { 0 };
+  if( uiInitTrDepth == 0 )
+  {
+    for( Int q = 0; q < 4; q++ )
+    {
+      for( Int mode = 0; mode < NUM_INTRA_MODE; mode++ )
+      {
+        histogram[mode] += m_gradientIntraHistograms.quadrant[q][mode];
+      }
+    }
+  }
+  else
+  {
+    const UInt q = uiPartOffset / ( pcCU->getTotalNumPart() >> 2 );
+    for( Int mode = 0; mode < NUM_INTRA_MODE; mode++ )
+    {
+      histogram[mode] = m_gradientIntraHistograms.quadrant[q][mode];
+    }
+  }
+
+  for( Int mode = 0; mode < NUM_INTRA_MODE; mode++ )
+  {
+    modeSelected[mode] = false;
+  }
+  modeSelected[PLANAR_IDX] = true;
+  modeSelected[DC_IDX]     = true;
+
+  for( Int peak = 0; peak < m_pcEncCfg->getFastIntraGradientModes(); peak++ )
+  {
+    Int bestMode = -1;
+    for( Int mode = 2; mode < NUM_INTRA_MODE - 1; mode++ )
+    {
+      if( histogram[mode] > 0 && !modeSelected[mode] && ( bestMode < 0 || histogram[mode] > histogram[bestMode] ) )
+      {
+        bestMode = mode;
+      }
+    }
+    if( bestMode < 0 )
+    {
+      break;
+    }
+    for( Int mode = std::max( bestMode - 1, 2 ); mode <= std::min( bestMode + 1, NUM_INTRA_MODE - 2 ); mode++ )
+    {
+      modeSelected[mode] = true;
+    }
+  }
+
+  Int uiPreds[NUM_MOST_PROBABLE_MODES] = {-1, -1, -1};
+  Int iMode = -1;
+  pcCU->getIntraDirPredictor( uiPartOffset, uiPreds, COMPONENT_Y, &iMode );
+  const Int numCand = ( iMode >= 0 ) ? iMode : Int(NUM_MOST_PROBABLE_MODES);
+  for( Int j = 0; j < numCand; j++ )
+  {
+    modeSelected[uiPreds[j]] = true;
+  }
+
+  Int numSelected = 0;
+  for( Int mode = 0; mode < NUM_INTRA_MODE - 1; mode++ )
+  {
+    numSelected += modeSelected[mode] ? 1 : 0;
+  }
+  return numSelected;
+}
+
 UInt TEncSearch::xUpdateCandList( UInt uiMode, Double uiCost, UInt uiFastCandNum, UInt * CandModeList, Double * CandCostList )
 {
   UInt i;
@@ -118,6 +118,26 @@ protected:
   TComMv          m_integerMv2Nx2N[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
 
   Bool            m_isInitialized;
+
+  // statistics of the gradient based intra mode pre-selection
+  struct GradientIntraStats
+  {
+    UInt64 numPUs;
+    UInt64 numModesTested;
+    GradientIntraStats() : numPUs(0), numModesTested(0) {}
+  } m_gradientIntraStats;
+
+  // edge direction histograms of the four quadrants of the CU last analysed by the gradient intra mode pre-selection
+  struct GradientIntraHistograms
+  {
+    const TComPic *pic;
+    Int            poc;
+    UInt           ctuRsAddr;
+    UInt           absZorderIdx;
+    UInt           depth;
+    UInt64         quadrant[4][NUM_INTRA_MODE];
+    GradientIntraHistograms() : pic(NULL), poc(0), ctuRsAddr(0), absZorderIdx(0), depth(0) {}
+  } m_gradientIntraHistograms;
 public:
   TEncSearch();
   virtual ~TEncSearch();
@@ -137,6 +157,14 @@ public:
 
   Void destroy();
 
+  UInt64 getGradientIntraNumPUs() const         { return m_gradientIntraStats.numPUs; }
+  UInt64 getGradientIntraNumModesTested() const { return m_gradientIntraStats.numModesTested; }
+  Void   resetGradientIntraStats()              { m_gradientIntraStats = GradientIntraStats(); }
+  Void   addGradientIntraStats(const TEncSearch &src);
+
+  /// take over the motion search state carried from one partition to the next (adaptive search range, 2Nx2N integer MVs)
+  Void   copyMotionSearchState(const TEncSearch &src);
+
 protected:
 
   /// sub-function for motion vector refinement used in fractional-pel accuracy
@@ -451,6 +479,8 @@ protected:
 
   UInt  xModeBitsIntra ( TComDataCU* pcCU, UInt uiMode, UInt uiPartOffset, UInt uiDepth, const ChannelType compID );
   UInt  xUpdateCandList( UInt uiMode, Double uiCost, UInt uiFastCandNum, UInt * CandModeList, Double * CandCostList );
+  Void  xGetGradientIntraHistograms( TComDataCU* pcCU );
+  Int   xGetGradientIntraCandidates( TComDataCU* pcCU, const UInt uiInitTrDepth, const UInt uiPartOffset, Bool *modeSelected );
 
   // -------------------------------------------------------------------------------------------------------------------
   // compute symbol bits
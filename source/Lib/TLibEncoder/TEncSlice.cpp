@@ -37,7 +37,9 @@
 
 #include "TEncTop.h"
 #include "TEncSlice.h"
+#include "TLibCommon/TComProfiler.h"
 #include <math.h>
+#include <chrono>
 
 //! \ingroup TLibEncoder
 //! \{
@@ -83,6 +85,7 @@ Void TEncSlice::init( TEncTop* pcEncTop )
 
   m_pcGOPEncoder      = pcEncTop->getGOPEncoder();
   m_pcCuEncoder       = pcEncTop->getCuEncoder();
+  m_pcCtuStats        = pcEncTop->getCtuStats();
   m_pcPredSearch      = pcEncTop->getPredSearch();
 
   m_pcEntropyCoder    = pcEncTop->getEntropyCoder();
@@ -640,6 +643,7 @@ Void TEncSlice::calCostSliceI(TComPic* pcPic) // TODO: this only analyses the fi
  */
 Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP )
 {
+  PROFILE_SCOPE( PROF_ENC_COMPRESS_SLICE );
   // if bCompressEntireSlice is true, then the entire slice (not slice segment) is compressed,
   //   effectively disabling the slice-segment-mode.
 
@@ -668,6 +672,9 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
 
   TComBitCounter  tempBitCounter;
   const UInt      frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+  // the trial compressions of precompressSlice() compress the entire slice and are not reported
+  const Bool      bCtuStats        = m_pcCtuStats->isOpen() && !bCompressEntireSlice;
+  std::chrono::steady_clock::time_point ctuStartTime;
   
   m_pcCuEncoder->setFastDeltaQp(bFastDeltaQP);
 
@@ -819,6 +826,10 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     }
 
     // run CTU trial encoder
+    if ( bCtuStats )
+    {
+      ctuStartTime = std::chrono::steady_clock::now();
+    }
     m_pcCuEncoder->compressCtu( pCtu );
 
 
@@ -861,6 +872,14 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
       break;
     }
 
+    if ( bCtuStats )
+    {
+      const Double timeUs = std::chrono::duration<Double, std::micro>( std::chrono::steady_clock::now() - ctuStartTime ).count();
+      UInt numChecked[NUMBER_OF_CTU_STATS_CANDIDATES];
+      m_pcCuEncoder->getCtuStatsChecked( numChecked );
+      m_pcCtuStats->writeCtu( pCtu, timeUs, numberOfWrittenBits, numChecked );
+    }
+
     pcSlice->setSliceBits( (UInt)(pcSlice->getSliceBits() + numberOfWrittenBits) );
     pcSlice->setSliceSegmentBits(pcSlice->getSliceSegmentBits()+numberOfWrittenBits);
 
@@ -950,6 +969,7 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
 
 Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded )
 {
+  PROFILE_SCOPE( PROF_ENC_ENTROPY_CODING );
   TComSlice *const pcSlice           = pcPic->getSlice(getSliceIdx());
 
   const UInt startCtuTsAddr          = pcSlice->getSliceSegmentCurStartCtuTsAddr();
@@ -73,6 +73,7 @@ private:
   // processing units
   TEncGOP*                m_pcGOPEncoder;                       ///< GOP encoder
   TEncCu*                 m_pcCuEncoder;                        ///< CU encoder
+  TEncCtuStats*           m_pcCtuStats;                         ///< per-CTU statistics output
 
   // encoder search
   TEncSearch*             m_pcPredSearch;                       ///< encoder search class
@@ -36,6 +36,15 @@
 */
 #include "TEncTemporalFilter.h"
 #include <math.h>
+#include <atomic>
+#include <memory>
+
+#if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0) && defined(__SSE4_1__)
+#include <smmintrin.h>
+#define TEMPORAL_FILTER_SIMD 1
+#else
+#define TEMPORAL_FILTER_SIMD 0
+#endif
 
 
 // ====================================================================================================================
@@ -96,7 +105,10 @@ TEncTemporalFilter::TEncTemporalFilter() :
   m_GOPSize(0),
   m_framesToBeEncoded(0),
   m_bClipInputVideoToRec709Range(false),
-  m_inputColourSpaceConvert(NUMBER_INPUT_COLOUR_SPACE_CONVERSIONS)
+  m_inputColourSpaceConvert(NUMBER_INPUT_COLOUR_SPACE_CONVERSIONS),
+  m_lookaheadDepth(0),
+  m_lookaheadDone(false),
+  m_lookaheadStop(false)
 {}
 
 void TEncTemporalFilter::init(const Int frameSkip,
@@ -161,183 +173,326 @@ void TEncTemporalFilter::init(const Int frameSkip,
 #endif
 }
 
+Void TEncTemporalFilter::createThreads(const Int numThreads, const Int lookaheadDepth)
+{
+  m_threadPool.create(numThreads);
+  m_lookaheadDepth = lookaheadDepth;
+  if (m_lookaheadDepth > 0)
+  {
+    m_lookaheadDone = false;
+    m_lookaheadStop = false;
+    m_lookaheadThread = std::thread(&TEncTemporalFilter::lookaheadLoop, this);
+  }
+}
+
+Void TEncTemporalFilter::destroy()
+{
+  if (m_lookaheadThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_lookaheadMutex);
+      m_lookaheadStop = true;
+    }
+    m_lookaheadCondition.notify_all();
+    m_lookaheadThread.join();
+  }
+  for (std::map<Int, TemporalFilterLookaheadResult*>::iterator it = m_lookaheadResults.begin(); it != m_lookaheadResults.end(); ++it)
+  {
+    it->second->picture.destroy();
+    delete[] it->second->qpMap;
+    delete it->second;
+  }
+  m_lookaheadResults.clear();
+  m_lookaheadDepth = 0;
+  m_threadPool.destroy();
+}
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
 
 Bool TEncTemporalFilter::filter(TComPicYuv *orgPic, Int receivedPoc)
 {
-  Bool isFilterThisFrame = false;
+  if (!isFilterFrame(receivedPoc))
+  {
+    return false;
+  }
+  if (m_lookaheadDepth > 0 && getLookaheadResult(orgPic, receivedPoc))
+  {
+    return true;
+  }
+
+  Int *qpMap = NULL;
+  filterPicture(*orgPic, receivedPoc, *orgPic, qpMap);
+#if JVET_Y0077_BIM
+  if (qpMap != NULL)
+  {
+    m_ctuAdaptQP->insert({ receivedPoc, qpMap });
+  }
+#endif
+  return true;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+Bool TEncTemporalFilter::isFilterFrame(const Int receivedPoc) const
+{
   if (m_QP >= 17)  // disable filter for QP < 17
   {
-    for (map<Int, Double>::iterator it = m_temporalFilterStrengths.begin(); it != m_temporalFilterStrengths.end(); ++it)
+    for (map<Int, Double>::const_iterator it = m_temporalFilterStrengths.begin(); it != m_temporalFilterStrengths.end(); ++it)
     {
       Int filteredFrame = it->first;
       if (receivedPoc % filteredFrame == 0)
       {
-        isFilterThisFrame = true;
-        break;
+        return true;
       }
     }
   }
+  return false;
+}
 
-  if (isFilterThisFrame)
-  {
-    const Int currentFilePoc = receivedPoc + m_FrameSkip;
-    const Int firstFrame = std::max(currentFilePoc - m_pastRefs, m_firstValidFrame);
-    const Int lastFrame = std::min(currentFilePoc + m_futureRefs, m_lastValidFrame);
-
-    TVideoIOYuv yuvFrames;
-    yuvFrames.open(m_inputFileName, false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth);
-    yuvFrames.skipFrames(firstFrame, m_sourceWidth - m_sourcePadding[0], m_sourceHeight - m_sourcePadding[1], m_chromaFormatIDC);
+Bool TEncTemporalFilter::filterPicture(const TComPicYuv &orgPic, const Int receivedPoc, TComPicYuv &filteredPic, Int *&qpMap)
+{
+  Bool isFiltered = false;
+  const Int currentFilePoc = receivedPoc + m_FrameSkip;
+  const Int firstFrame = std::max(currentFilePoc - m_pastRefs, m_firstValidFrame);
+  const Int lastFrame = std::min(currentFilePoc + m_futureRefs, m_lastValidFrame);
 
+  TVideoIOYuv yuvFrames;
+  yuvFrames.open(m_inputFileName, false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth);
+  yuvFrames.skipFrames(firstFrame, m_sourceWidth - m_sourcePadding[0], m_sourceHeight - m_sourcePadding[1], m_chromaFormatIDC);
 
-    std::deque<TemporalFilterSourcePicInfo> srcFrameInfo;
 
-    // subsample original picture so it only needs to be done once
-    TComPicYuv origPadded;
+  std::deque<TemporalFilterSourcePicInfo> srcFrameInfo;
 
-    origPadded.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
-    orgPic->copyToPic(&origPadded);
-    origPadded.extendPicBorder();
+  // subsample original picture so it only needs to be done once
+  TComPicYuv origPadded;
 
-    TComPicYuv origSubsampled2;
-    TComPicYuv origSubsampled4;
+  origPadded.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
+  orgPic.copyToPic(&origPadded);
+  origPadded.extendPicBorder();
 
-    subsampleLuma(origPadded, origSubsampled2);
-    subsampleLuma(origSubsampled2, origSubsampled4);
+  TComPicYuv origSubsampled2;
+  TComPicYuv origSubsampled4;
 
-    // determine motion vectors
-    for (Int poc = firstFrame; poc <= lastFrame; poc++)
-    {
-      if (poc == currentFilePoc)
-      { // hop over frame that will be filtered
-        yuvFrames.skipFrames(1, m_sourceWidth - m_sourcePadding[0], m_sourceHeight - m_sourcePadding[1], m_chromaFormatIDC);
-        continue;
-      }
-      srcFrameInfo.push_back(TemporalFilterSourcePicInfo());
-      TemporalFilterSourcePicInfo &srcPic=srcFrameInfo.back();
+  subsampleLuma(origPadded, origSubsampled2);
+  subsampleLuma(origSubsampled2, origSubsampled4);
 
-      TComPicYuv     dummyPicBufferTO; // Only used temporary in yuvFrames.read
-      srcPic.picBuffer.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
-      dummyPicBufferTO.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
-      if (!yuvFrames.read(&srcPic.picBuffer, &dummyPicBufferTO, m_inputColourSpaceConvert, m_sourcePadding, m_chromaFormatIDC, m_bClipInputVideoToRec709Range))
-      {
-        // eof or read fail
-        srcPic.picBuffer.destroy();
-        srcFrameInfo.pop_back();
-        break;
-      }
-      srcPic.picBuffer.extendPicBorder();
-      srcPic.mvs.allocate(m_sourceWidth / 4, m_sourceHeight / 4);
+  // determine motion vectors
+  for (Int poc = firstFrame; poc <= lastFrame; poc++)
+  {
+    if (poc == currentFilePoc)
+    { // hop over frame that will be filtered
+      yuvFrames.skipFrames(1, m_sourceWidth - m_sourcePadding[0], m_sourceHeight - m_sourcePadding[1], m_chromaFormatIDC);
+      continue;
+    }
+    srcFrameInfo.push_back(TemporalFilterSourcePicInfo());
+    TemporalFilterSourcePicInfo &srcPic=srcFrameInfo.back();
 
-      motionEstimation(srcPic.mvs, origPadded, srcPic.picBuffer, origSubsampled2, origSubsampled4);
-      srcPic.origOffset = poc - currentFilePoc;
+    TComPicYuv     dummyPicBufferTO; // Only used temporary in yuvFrames.read
+    srcPic.picBuffer.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
+    dummyPicBufferTO.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
+    if (!yuvFrames.read(&srcPic.picBuffer, &dummyPicBufferTO, m_inputColourSpaceConvert, m_sourcePadding, m_chromaFormatIDC, m_bClipInputVideoToRec709Range))
+    {
+      // eof or read fail
+      srcPic.picBuffer.destroy();
+      srcFrameInfo.pop_back();
+      break;
     }
+    srcPic.picBuffer.extendPicBorder();
+    srcPic.mvs.allocate(m_sourceWidth / 4, m_sourceHeight / 4);
+
+    motionEstimation(srcPic.mvs, origPadded, srcPic.picBuffer, origSubsampled2, origSubsampled4);
+    srcPic.origOffset = poc - currentFilePoc;
+  }
 
-    // filter
-    TComPicYuv newOrgPic;
-    newOrgPic.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
-    Double overallStrength = -1.0;
-    for (map<Int, Double>::iterator it = m_temporalFilterStrengths.begin(); it != m_temporalFilterStrengths.end(); ++it)
+  // filter
+  TComPicYuv newOrgPic;
+  newOrgPic.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
+  Double overallStrength = -1.0;
+  for (map<Int, Double>::const_iterator it = m_temporalFilterStrengths.begin(); it != m_temporalFilterStrengths.end(); ++it)
+  {
+    Int frame = it->first;
+    Double strength = it->second;
+    if (receivedPoc % frame == 0)
     {
-      Int frame = it->first;
-      Double strength = it->second;
-      if (receivedPoc % frame == 0)
-      {
-        overallStrength = strength;
-      }
+      overallStrength = strength;
     }
+  }
 #if JVET_Y0077_BIM
-    const int numRefs = Int(srcFrameInfo.size());
-    if ( m_bimEnabled && ( numRefs > 0 ) )
-    {
-      const Int bimFirstFrame = std::max(currentFilePoc - 2, firstFrame);
-      const Int bimLastFrame = std::min(currentFilePoc + 2, lastFrame);
-      std::vector<Double> sumError(m_numCTU * 2, 0);
-      std::vector<Int>    blkCount(m_numCTU * 2, 0);
+  const int numRefs = Int(srcFrameInfo.size());
+  if ( m_bimEnabled && ( numRefs > 0 ) )
+  {
+    const Int bimFirstFrame = std::max(currentFilePoc - 2, firstFrame);
+    const Int bimLastFrame = std::min(currentFilePoc + 2, lastFrame);
+    std::vector<Double> sumError(m_numCTU * 2, 0);
+    std::vector<Int>    blkCount(m_numCTU * 2, 0);
 
-      int frameIndex = bimFirstFrame - firstFrame;
+    int frameIndex = bimFirstFrame - firstFrame;
 
-      Int distFactor[2] = {3,3};
+    Int distFactor[2] = {3,3};
 
-      Int* qpMap = new Int[m_numCTU];
-      for (int poc = bimFirstFrame; poc <= bimLastFrame; poc++)
+    qpMap = new Int[m_numCTU];
+    for (int poc = bimFirstFrame; poc <= bimLastFrame; poc++)
+    {
+      if ((poc < 0) || (poc == currentFilePoc) || (frameIndex >= numRefs))
       {
-        if ((poc < 0) || (poc == currentFilePoc) || (frameIndex >= numRefs))
-        {
-          continue;
-        }
-        Int dist = abs(poc - currentFilePoc) - 1;
-        distFactor[dist]--;
+        continue;
+      }
+      Int dist = abs(poc - currentFilePoc) - 1;
+      distFactor[dist]--;
 
-        TemporalFilterSourcePicInfo &srcPic = srcFrameInfo.at(frameIndex);
-        for (Int y = 0; y < srcPic.mvs.h() / 2; y++) // going over in 8x8 block steps
+      TemporalFilterSourcePicInfo &srcPic = srcFrameInfo.at(frameIndex);
+      for (Int y = 0; y < srcPic.mvs.h() / 2; y++) // going over in 8x8 block steps
+      {
+        for (Int x = 0; x < srcPic.mvs.w() / 2; x++)
         {
-          for (Int x = 0; x < srcPic.mvs.w() / 2; x++)
-          {
-            Int blocksPerRow = (srcPic.mvs.w() / 2 + 7) / 8;
-            Int ctuX = x / 8;
-            Int ctuY = y / 8;
-            Int ctuId = ctuY * blocksPerRow + ctuX;
-            sumError[dist * m_numCTU + ctuId] += srcPic.mvs.get(x, y).error;
-            blkCount[dist * m_numCTU + ctuId] += 1;
-          }
+          Int blocksPerRow = (srcPic.mvs.w() / 2 + 7) / 8;
+          Int ctuX = x / 8;
+          Int ctuY = y / 8;
+          Int ctuId = ctuY * blocksPerRow + ctuX;
+          sumError[dist * m_numCTU + ctuId] += srcPic.mvs.get(x, y).error;
+          blkCount[dist * m_numCTU + ctuId] += 1;
         }
-        frameIndex++;
       }
-      Double weight = (receivedPoc % 16) ? 0.6 : 1;
-      const Double center = 45.0;
-      for (Int i = 0; i < m_numCTU; i++)
+      frameIndex++;
+    }
+    Double weight = (receivedPoc % 16) ? 0.6 : 1;
+    const Double center = 45.0;
+    for (Int i = 0; i < m_numCTU; i++)
+    {
+      Int avgErrD1 = (Int)((sumError[i] / blkCount[i]) * distFactor[0]);
+      Int avgErrD2 = (Int)((sumError[i + m_numCTU] / blkCount[i + m_numCTU]) * distFactor[1]);
+      Int weightedErr = std::max(avgErrD1, avgErrD2) + abs(avgErrD2 - avgErrD1) * 3;
+      weightedErr = (Int)(weightedErr * weight + (1 - weight) * center);
+      if (weightedErr > s_cuTreeThresh[0])
       {
-        Int avgErrD1 = (Int)((sumError[i] / blkCount[i]) * distFactor[0]);
-        Int avgErrD2 = (Int)((sumError[i + m_numCTU] / blkCount[i + m_numCTU]) * distFactor[1]);
-        Int weightedErr = std::max(avgErrD1, avgErrD2) + abs(avgErrD2 - avgErrD1) * 3;
-        weightedErr = (Int)(weightedErr * weight + (1 - weight) * center);
-        if (weightedErr > s_cuTreeThresh[0])
-        {
-          qpMap[i] = 2;
-        }
-        else if (weightedErr > s_cuTreeThresh[1])
-        {
-          qpMap[i] = 1;
-        }
-        else if (weightedErr < s_cuTreeThresh[3])
-        {
-          qpMap[i] = -2;
-        }
-        else if (weightedErr < s_cuTreeThresh[2])
-        {
-          qpMap[i] = -1;
-        }
-        else
-        {
-          qpMap[i] = 0;
-        }
+        qpMap[i] = 2;
+      }
+      else if (weightedErr > s_cuTreeThresh[1])
+      {
+        qpMap[i] = 1;
+      }
+      else if (weightedErr < s_cuTreeThresh[3])
+      {
+        qpMap[i] = -2;
+      }
+      else if (weightedErr < s_cuTreeThresh[2])
+      {
+        qpMap[i] = -1;
+      }
+      else
+      {
+        qpMap[i] = 0;
       }
-      m_ctuAdaptQP->insert({ receivedPoc, qpMap });
     }
+  }
 
-    if ( m_mctfEnabled && ( numRefs > 0 ) )
-    {
+  if ( m_mctfEnabled && ( numRefs > 0 ) )
+  {
 #endif
-    bilateralFilter(origPadded, srcFrameInfo, newOrgPic, overallStrength);
+  bilateralFilter(origPadded, srcFrameInfo, newOrgPic, overallStrength);
 
-    // move filtered to orgPic
-    newOrgPic.copyToPic(orgPic);
+  // move filtered to orgPic
+  newOrgPic.copyToPic(&filteredPic);
+  isFiltered = true;
 #if JVET_Y0077_BIM
-    }
+  }
 #endif
 
-    yuvFrames.close();
-    return true;
+  yuvFrames.close();
+  return isFiltered;
+}
+
+Void TEncTemporalFilter::lookaheadLoop()
+{
+  TVideoIOYuv yuvFrames;
+  yuvFrames.open(m_inputFileName, false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth);
+  Int filePoc = 0;
+
+  for (Int receivedPoc = 0; receivedPoc < m_framesToBeEncoded; receivedPoc++)
+  {
+    if (!isFilterFrame(receivedPoc))
+    {
+      continue;
+    }
+    {
+      std::unique_lock<std::mutex> lock(m_lookaheadMutex);
+      m_lookaheadCondition.wait(lock, [this] { return m_lookaheadStop || Int(m_lookaheadResults.size()) < m_lookaheadDepth; });
+      if (m_lookaheadStop)
+      {
+        break;
+      }
+    }
+
+    const Int currentFilePoc = receivedPoc + m_FrameSkip;
+    TemporalFilterLookaheadResult *result = new TemporalFilterLookaheadResult;
+    TComPicYuv dummyPicBufferTO; // Only used temporary in yuvFrames.read
+    result->picture.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
+    dummyPicBufferTO.createWithoutCUInfo(m_sourceWidth, m_sourceHeight, m_chromaFormatIDC, true, s_padding, s_padding);
+    yuvFrames.skipFrames(currentFilePoc - filePoc, m_sourceWidth - m_sourcePadding[0], m_sourceHeight - m_sourcePadding[1], m_chromaFormatIDC);
+    filePoc = currentFilePoc + 1;
+    if (!yuvFrames.read(&result->picture, &dummyPicBufferTO, m_inputColourSpaceConvert, m_sourcePadding, m_chromaFormatIDC, m_bClipInputVideoToRec709Range))
+    {
+      // eof or read fail, remaining pictures are filtered in filter()
+      result->picture.destroy();
+      delete result;
+      break;
+    }
+    result->filtered = filterPicture(result->picture, receivedPoc, result->picture, result->qpMap);
+
+    {
+      std::lock_guard<std::mutex> lock(m_lookaheadMutex);
+      m_lookaheadResults[receivedPoc] = result;
+    }
+    m_lookaheadCondition.notify_all();
   }
-  return false;
+  yuvFrames.close();
+
+  {
+    std::lock_guard<std::mutex> lock(m_lookaheadMutex);
+    m_lookaheadDone = true;
+  }
+  m_lookaheadCondition.notify_all();
 }
 
-// ====================================================================================================================
-// Private member functions
-// ====================================================================================================================
+Bool TEncTemporalFilter::getLookaheadResult(TComPicYuv *orgPic, const Int receivedPoc)
+{
+  TemporalFilterLookaheadResult *result = NULL;
+  {
+    std::unique_lock<std::mutex> lock(m_lookaheadMutex);
+    m_lookaheadCondition.wait(lock, [this, receivedPoc] { return m_lookaheadDone || m_lookaheadResults.find(receivedPoc) != m_lookaheadResults.end(); });
+    std::map<Int, TemporalFilterLookaheadResult*>::iterator it = m_lookaheadResults.find(receivedPoc);
+    if (it != m_lookaheadResults.end())
+    {
+      result = it->second;
+      m_lookaheadResults.erase(it);
+    }
+  }
+  m_lookaheadCondition.notify_all();
+
+  if (result == NULL)
+  {
+    return false;
+  }
+  if (result->filtered)
+  {
+    result->picture.copyToPic(orgPic);
+  }
+#if JVET_Y0077_BIM
+  if (result->qpMap != NULL)
+  {
+    m_ctuAdaptQP->insert({ receivedPoc, result->qpMap });
+  }
+#else
+  delete[] result->qpMap;
+#endif
+  result->picture.destroy();
+  delete result;
+  return true;
+}
 
 Void TEncTemporalFilter::subsampleLuma(const TComPicYuv &input, TComPicYuv &output, const Int factor) const
 {
@@ -459,12 +614,12 @@ Int TEncTemporalFilter::motionErrorLuma(const TComPicYuv &orig,
 }
 
 Void TEncTemporalFilter::motionEstimationLuma(Array2D<MotionVector> &mvs, const TComPicYuv &orig, const TComPicYuv &buffer, const Int blockSize,
-    const Array2D<MotionVector> *previous, const Int factor, const Bool doubleRes) const
+    const Array2D<MotionVector> *previous, const Int factor, const Bool doubleRes)
 {
 #if JVET_V0056_MCTF || JVET_Y0077_BIM
-  Int range = doubleRes ? 0 : 5;
+  const Int range = previous == NULL ? 8 : (doubleRes ? 0 : 5);
 #else
-  Int range = 5;
+  const Int range = previous == NULL ? 8 : 5;
 #endif
   const Int stepSize = blockSize;
 
@@ -472,22 +627,34 @@ Void TEncTemporalFilter::motionEstimationLuma(Array2D<MotionVector> &mvs, const
   const Int origHeight = orig.getHeight(COMPONENT_Y);
 
 #if JVET_V0056_MCTF || JVET_Y0077_BIM
-  for (Int blockY = 0; blockY + blockSize <= origHeight; blockY += stepSize)
-  {
-    for (Int blockX = 0; blockX + blockSize <= origWidth; blockX += stepSize)
+  const Int numRows = origHeight / blockSize;
+  const Int numCols = origWidth / blockSize;
 #else
-  for (Int blockY = 0; blockY + blockSize < origHeight; blockY += stepSize)
-  {
-    for (Int blockX = 0; blockX + blockSize < origWidth; blockX += stepSize)
+  const Int numRows = std::max(0, (origHeight - 1) / blockSize);
+  const Int numCols = std::max(0, (origWidth - 1) / blockSize);
 #endif
-    {
-      MotionVector best;
 
-      if (previous == NULL)
+  // block rows are estimated as a wavefront, a block starts once the block above it is done
+  std::unique_ptr<std::atomic<Int>[]> rowProgress(new std::atomic<Int>[numRows]);
+  for (Int row = 0; row < numRows; row++)
+  {
+    rowProgress[row] = 0;
+  }
+
+  m_threadPool.run(numRows, [&](Int row)
+  {
+    const Int blockY = row * stepSize;
+    for (Int col = 0; col < numCols; col++)
+    {
+      const Int blockX = col * stepSize;
+      while (row > 0 && rowProgress[row - 1].load(std::memory_order_acquire) <= col)
       {
-        range = 8;
+        std::this_thread::yield();
       }
-      else
+
+      MotionVector best;
+
+      if (previous != NULL)
       {
 #if JVET_V0056_MCTF || JVET_Y0077_BIM
         for (Int py = -1; py <= 1; py++)
@@ -608,11 +775,12 @@ Void TEncTemporalFilter::motionEstimationLuma(Array2D<MotionVector> &mvs, const
       best.error = (Int) (20 * ((best.error + 5.0) / (variance + 5.0)) + (best.error / (blockSize * blockSize)) / 50);
 #endif
       mvs.get(blockX / stepSize, blockY / stepSize) = best;
+      rowProgress[row].store(col + 1, std::memory_order_release);
     }
-  }
+  });
 }
 
-Void TEncTemporalFilter::motionEstimation(Array2D<MotionVector> &mv, const TComPicYuv &orgPic, const TComPicYuv &buffer, const TComPicYuv &origSubsampled2, const TComPicYuv &origSubsampled4) const
+Void TEncTemporalFilter::motionEstimation(Array2D<MotionVector> &mv, const TComPicYuv &orgPic, const TComPicYuv &buffer, const TComPicYuv &origSubsampled2, const TComPicYuv &origSubsampled4)
 {
   const Int width = m_sourceWidth;
   const Int height = m_sourceHeight;
@@ -633,6 +801,58 @@ Void TEncTemporalFilter::motionEstimation(Array2D<MotionVector> &mv, const TComP
   motionEstimationLuma(mv, orgPic, buffer, 8, &mv_2, 1, true);
 }
 
+#if TEMPORAL_FILTER_SIMD
+/// separable 6-tap interpolation of one block of up to 8x8 samples, bit exact to the scalar path of applyMotion
+static inline Void simdApplyMotionBlock( const Pel *src, const Int srcStride, Pel *dst, const Int dstStride, const Int width, const Int height,
+                                         const Int *xFilter, const Int *yFilter, const Int maxValue )
+{
+  static const Int maxBlockSize = 8;
+  static const Int numTaps      = 6; // taps 1..6 of s_interpolationFilter, the outer ones are always zero
+  assert(width <= maxBlockSize && height <= maxBlockSize);
+
+  __m128i xCoeff[numTaps];
+  __m128i yCoeff[numTaps];
+  for (Int k = 0; k < numTaps; k++)
+  {
+    xCoeff[k] = _mm_set1_epi32(xFilter[k + 1]);
+    yCoeff[k] = _mm_set1_epi32(yFilter[k + 1]);
+  }
+
+  __m128i temp[maxBlockSize + numTaps - 1][maxBlockSize / 4];
+  const Pel *srcRow = src - 2 * srcStride - 2;
+  for (Int row = 0; row < height + numTaps - 1; row++, srcRow += srcStride)
+  {
+    for (Int col = 0; col < width; col += 4)
+    {
+      __m128i sum = _mm_setzero_si128();
+      for (Int k = 0; k < numTaps; k++)
+      {
+        const __m128i pix = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)(srcRow + col + k)));
+        sum = _mm_add_epi32(sum, _mm_mullo_epi32(pix, xCoeff[k]));
+      }
+      temp[row][col >> 2] = sum;
+    }
+  }
+
+  const __m128i offset = _mm_set1_epi32(1 << 11);
+  const __m128i minVal = _mm_setzero_si128();
+  const __m128i maxVal = _mm_set1_epi32(maxValue);
+  for (Int row = 0; row < height; row++, dst += dstStride)
+  {
+    for (Int col = 0; col < width; col += 4)
+    {
+      __m128i sum = offset;
+      for (Int k = 0; k < numTaps; k++)
+      {
+        sum = _mm_add_epi32(sum, _mm_mullo_epi32(temp[row + k][col >> 2], yCoeff[k]));
+      }
+      sum = _mm_min_epi32(_mm_max_epi32(_mm_srai_epi32(sum, 12), minVal), maxVal);
+      _mm_storel_epi64((__m128i*)(dst + col), _mm_packs_epi32(sum, sum));
+    }
+  }
+}
+#endif
+
 Void TEncTemporalFilter::applyMotion(const Array2D<MotionVector> &mvs, const TComPicYuv &input, TComPicYuv &output) const
 {
   static const Int lumaBlockSize=8;
@@ -667,6 +887,14 @@ Void TEncTemporalFilter::applyMotion(const Array2D<MotionVector> &mvs, const TCo
 
         const Int *xFilter = s_interpolationFilter[dx & 0xf];
         const Int *yFilter = s_interpolationFilter[dy & 0xf]; // will add 6 bit.
+#if TEMPORAL_FILTER_SIMD
+        if ((blockSizeX & 3) == 0)
+        {
+          simdApplyMotionBlock(pSrcImage + (y + yInt) * srcStride + x + xInt, srcStride, pDstImage + y * dstStride + x, dstStride,
+                               blockSizeX, blockSizeY, xFilter, yFilter, maxValue);
+          continue;
+        }
+#endif
         const Int numFilterTaps=7;
         const Int centreTapOffset=3;
 
@@ -725,15 +953,18 @@ Void TEncTemporalFilter::bilateralFilter(const TComPicYuv &orgPic,
                                          const std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo,
 #endif
                                                TComPicYuv &newOrgPic,
-                                               Double overallStrength) const
+                                               Double overallStrength)
 {
   const int numRefs = Int(srcFrameInfo.size());
   std::vector<TComPicYuv> correctedPics(numRefs);
   for (Int i = 0; i < numRefs; i++)
   {
     correctedPics[i].createWithoutCUInfo( m_sourceWidth, m_sourceHeight, orgPic.getChromaFormat(), true, s_padding, s_padding );
-    applyMotion(srcFrameInfo[i].mvs, srcFrameInfo[i].picBuffer, correctedPics[i]);
   }
+  m_threadPool.run(numRefs, [&](Int i)
+  {
+    applyMotion(srcFrameInfo[i].mvs, srcFrameInfo[i].picBuffer, correctedPics[i]);
+  });
 
   const Int refStrengthRow = m_futureRefs > 0 ? 0 : 1;
 
@@ -745,113 +976,118 @@ Void TEncTemporalFilter::bilateralFilter(const TComPicYuv &orgPic,
     const ComponentID compID=(ComponentID)c;
     const Int height = orgPic.getHeight(compID);
     const Int width  = orgPic.getWidth(compID);
-    const Pel *srcPelRow = orgPic.getAddr(compID);
     const Int srcStride = orgPic.getStride(compID);
-          Pel *dstPelRow = newOrgPic.getAddr(compID);
     const Int dstStride = newOrgPic.getStride(compID);
     const Double sigmaSq = isChroma(compID)? chromaSigmaSq : lumaSigmaSq;
     const Double weightScaling = overallStrength * (isChroma(compID) ? s_chromaFactor : 0.4);
     const Pel maxSampleValue = (1<<m_internalBitDepth[toChannelType(compID)])-1;
     const Double bitDepthDiffWeighting=1024.0 / (maxSampleValue+1);
-#if JVET_V0056_MCTF || JVET_Y0077_BIM
-    static const Int lumaBlockSize=8;    
+    static const Int lumaBlockSize=8;
     const Int csx=getComponentScaleX(compID, m_chromaFormatIDC);
     const Int csy=getComponentScaleY(compID, m_chromaFormatIDC);
     const Int blkSizeX = lumaBlockSize>>csx;
-    const Int blkSizeY = lumaBlockSize>>csy;    
-#endif
+    const Int blkSizeY = lumaBlockSize>>csy;
+    const Int numBands = (height + blkSizeY - 1) / blkSizeY;
 
-    for (Int y = 0; y < height; y++, srcPelRow+=srcStride, dstPelRow+=dstStride)
+    // bands of one block row are independent, the noise of a block is derived and used within its band
+    m_threadPool.run(numBands, [&](Int band)
     {
-      const Pel *srcPel=srcPelRow;
-            Pel *dstPel=dstPelRow;
-      for (Int x = 0; x < width; x++, srcPel++, dstPel++)
+      const Int bandStart = band * blkSizeY;
+      const Int bandEnd   = std::min(height, bandStart + blkSizeY);
+      const Pel *srcPelRow = orgPic.getAddr(compID) + bandStart * srcStride;
+            Pel *dstPelRow = newOrgPic.getAddr(compID) + bandStart * dstStride;
+      for (Int y = bandStart; y < bandEnd; y++, srcPelRow+=srcStride, dstPelRow+=dstStride)
       {
-        const Int orgVal = (Int) *srcPel;
-        Double temporalWeightSum = 1.0;
-        Double newVal = (Double) orgVal;
-#if JVET_V0056_MCTF || JVET_Y0077_BIM
-        if ((y % blkSizeY == 0) && (x % blkSizeX == 0))
+        const Pel *srcPel=srcPelRow;
+              Pel *dstPel=dstPelRow;
+        for (Int x = 0; x < width; x++, srcPel++, dstPel++)
         {
-          for (Int i = 0; i < numRefs; i++)
+          const Int orgVal = (Int) *srcPel;
+          Double temporalWeightSum = 1.0;
+          Double newVal = (Double) orgVal;
+#if JVET_V0056_MCTF || JVET_Y0077_BIM
+          if ((y % blkSizeY == 0) && (x % blkSizeX == 0))
           {
-            Double variance = 0, diffsum = 0;
-            const ptrdiff_t refStride = correctedPics[i].getStride(compID);
-            const Pel *refPel = correctedPics[i].getAddr(compID) + y * refStride + x;
-
-            for (Int y1 = 0; y1 < blkSizeY; y1++)
+            for (Int i = 0; i < numRefs; i++)
             {
-              for (Int x1 = 0; x1 < blkSizeX; x1++)
-              {
-                const Pel pix  = *(srcPel + srcStride * y1 + x1);
-                const Pel ref  = *(refPel + refStride * y1 + x1);
-                const Int diff = pix - ref;
-
-                variance += diff * diff;
+              Double variance = 0, diffsum = 0;
+              const ptrdiff_t refStride = correctedPics[i].getStride(compID);
+              const Pel *refPel = correctedPics[i].getAddr(compID) + y * refStride + x;
 
-                if (x1 != blkSizeX - 1)
-                {
-                  const Pel pixR  = *(srcPel + srcStride * y1 + x1 + 1);
-                  const Pel refR  = *(refPel + refStride * y1 + x1 + 1);
-                  const Int diffR = pixR - refR;
-                  diffsum += (diffR - diff) * (diffR - diff);
-                }
-                if (y1 != blkSizeY - 1)
+              for (Int y1 = 0; y1 < blkSizeY; y1++)
+              {
+                for (Int x1 = 0; x1 < blkSizeX; x1++)
                 {
-                  const Pel pixD  = *(srcPel + srcStride * y1 + x1 + srcStride);
-                  const Pel refD  = *(refPel + refStride * y1 + x1 + refStride);
-                  const Int diffD = pixD - refD;
-                  diffsum += (diffD - diff) * (diffD - diff);
+                  const Pel pix  = *(srcPel + srcStride * y1 + x1);
+                  const Pel ref  = *(refPel + refStride * y1 + x1);
+                  const Int diff = pix - ref;
+
+                  variance += diff * diff;
+
+                  if (x1 != blkSizeX - 1)
+                  {
+                    const Pel pixR  = *(srcPel + srcStride * y1 + x1 + 1);
+                    const Pel refR  = *(refPel + refStride * y1 + x1 + 1);
+                    const Int diffR = pixR - refR;
+                    diffsum += (diffR - diff) * (diffR - diff);
+                  }
+                  if (y1 != blkSizeY - 1)
+                  {
+                    const Pel pixD  = *(srcPel + srcStride * y1 + x1 + srcStride);
+                    const Pel refD  = *(refPel + refStride * y1 + x1 + refStride);
+                    const Int diffD = pixD - refD;
+                    diffsum += (diffD - diff) * (diffD - diff);
+                  }
                 }
               }
-            }
 
-            const int cntV = blkSizeX * blkSizeY;
-            const int cntD = 2 * cntV - blkSizeX - blkSizeY;
-            srcFrameInfo[i].mvs.get(x / blkSizeX, y / blkSizeY).noise =
-              (int) round((15.0 * cntD / cntV * variance + 5.0) / (diffsum + 5.0));
+              const int cntV = blkSizeX * blkSizeY;
+              const int cntD = 2 * cntV - blkSizeX - blkSizeY;
+              srcFrameInfo[i].mvs.get(x / blkSizeX, y / blkSizeY).noise =
+                (int) round((15.0 * cntD / cntV * variance + 5.0) / (diffsum + 5.0));
+            }
           }
-        }
 
-        Double minError = 9999999;
-        for (Int i = 0; i < numRefs; i++)
-        {
-          minError = std::min(minError, (Double) srcFrameInfo[i].mvs.get(x / blkSizeX, y / blkSizeY).error);
-        }
+          Double minError = 9999999;
+          for (Int i = 0; i < numRefs; i++)
+          {
+            minError = std::min(minError, (Double) srcFrameInfo[i].mvs.get(x / blkSizeX, y / blkSizeY).error);
+          }
 #endif
-        for (Int i = 0; i < numRefs; i++)
-        {
+          for (Int i = 0; i < numRefs; i++)
+          {
 #if JVET_V0056_MCTF || JVET_Y0077_BIM
-          const Int error = srcFrameInfo[i].mvs.get(x / blkSizeX, y / blkSizeY).error;
-          const Int noise = srcFrameInfo[i].mvs.get(x / blkSizeX, y / blkSizeY).noise;
+            const Int error = srcFrameInfo[i].mvs.get(x / blkSizeX, y / blkSizeY).error;
+            const Int noise = srcFrameInfo[i].mvs.get(x / blkSizeX, y / blkSizeY).noise;
 #endif
-          const Pel *pCorrectedPelPtr=correctedPics[i].getAddr(compID)+(y*correctedPics[i].getStride(compID)+x);
-          const Int refVal = (Int) *pCorrectedPelPtr;
-          Double diff = (Double)(refVal - orgVal);
-          diff *= bitDepthDiffWeighting;
-          Double diffSq = diff * diff;
+            const Pel *pCorrectedPelPtr=correctedPics[i].getAddr(compID)+(y*correctedPics[i].getStride(compID)+x);
+            const Int refVal = (Int) *pCorrectedPelPtr;
+            Double diff = (Double)(refVal - orgVal);
+            diff *= bitDepthDiffWeighting;
+            Double diffSq = diff * diff;
 #if JVET_V0056_MCTF || JVET_Y0077_BIM
-          const Int index = std::min(3, std::abs(srcFrameInfo[i].origOffset) - 1);
-          Double ww = 1, sw = 1;
-          ww *= (noise < 25) ? 1 : 1.2;
-          sw *= (noise < 25) ? 1.3 : 0.8;
-          ww *= (error < 50) ? 1.2 : ((error > 100) ? 0.8 : 1);
-          sw *= (error < 50) ? 1.3 : 1;
-          ww *= ((minError + 1) / (error + 1));
-          const Double weight = weightScaling * s_refStrengths[refStrengthRow][index] * ww * exp(-diffSq / (2 * sw * sigmaSq));
+            const Int index = std::min(3, std::abs(srcFrameInfo[i].origOffset) - 1);
+            Double ww = 1, sw = 1;
+            ww *= (noise < 25) ? 1 : 1.2;
+            sw *= (noise < 25) ? 1.3 : 0.8;
+            ww *= (error < 50) ? 1.2 : ((error > 100) ? 0.8 : 1);
+            sw *= (error < 50) ? 1.3 : 1;
+            ww *= ((minError + 1) / (error + 1));
+            const Double weight = weightScaling * s_refStrengths[refStrengthRow][index] * ww * exp(-diffSq / (2 * sw * sigmaSq));
 #else
-          const Int index = std::min(1, std::abs(srcFrameInfo[i].origOffset) - 1);
-          const Double weight = weightScaling * s_refStrengths[refStrengthRow][index] * exp(-diffSq / (2 * sigmaSq));
+            const Int index = std::min(1, std::abs(srcFrameInfo[i].origOffset) - 1);
+            const Double weight = weightScaling * s_refStrengths[refStrengthRow][index] * exp(-diffSq / (2 * sigmaSq));
 #endif
-          newVal += weight * refVal;
-          temporalWeightSum += weight;
+            newVal += weight * refVal;
+            temporalWeightSum += weight;
+          }
+          newVal /= temporalWeightSum;
+          Pel sampleVal = (Pel)round(newVal);
+          sampleVal=(sampleVal<0?0 : (sampleVal>maxSampleValue ? maxSampleValue : sampleVal));
+          *dstPel = sampleVal;
         }
-        newVal /= temporalWeightSum;
-        Pel sampleVal = (Pel)round(newVal);
-        sampleVal=(sampleVal<0?0 : (sampleVal>maxSampleValue ? maxSampleValue : sampleVal));
-        *dstPel = sampleVal;
       }
-    }
+    });
   }
 }
 
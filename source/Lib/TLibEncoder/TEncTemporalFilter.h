@@ -38,10 +38,14 @@
 #ifndef __TEMPORAL_FILTER__
 #define __TEMPORAL_FILTER__
 #include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "Utilities/TVideoIOYuv.h"
 #include <sstream>
 #include <map>
 #include <deque>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
  //! \ingroup EncoderLib
  //! \{
@@ -102,6 +106,15 @@ struct TemporalFilterSourcePicInfo
   Int                   origOffset;
 };
 
+/// picture filtered ahead of the encoder by the lookahead thread
+struct TemporalFilterLookaheadResult
+{
+  TemporalFilterLookaheadResult() : picture(), filtered(false), qpMap(NULL) { }
+  TComPicYuv            picture;
+  Bool                  filtered;                   ///< picture has been modified by the bilateral filter
+  Int                  *qpMap;                      ///< block importance QP offsets, ownership is passed on to the encoder
+};
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -110,7 +123,7 @@ class TEncTemporalFilter
 {
 public:
    TEncTemporalFilter();
-  ~TEncTemporalFilter() {}
+  ~TEncTemporalFilter() { destroy(); }
 
   void init(const Int frameSkip,
             const Int inputBitDepth[MAX_NUM_CHANNEL_TYPE],
@@ -138,6 +151,11 @@ public:
             const Bool bimEnabled);
 #endif
 
+  /// use numThreads helper threads for motion estimation and filtering, and let a separate thread prepare
+  /// up to lookaheadDepth filtered pictures ahead of the calls to filter()
+  Void createThreads(const Int numThreads, const Int lookaheadDepth);
+  Void destroy();
+
   Bool filter(TComPicYuv *orgPic, Int frame);
 
 private:
@@ -184,17 +202,32 @@ private:
   std::map<Int, Int*> *m_ctuAdaptQP;
 #endif
 
+  // threading
+  TComThreadPool m_threadPool;
+  Int m_lookaheadDepth;
+  std::thread m_lookaheadThread;
+  std::mutex m_lookaheadMutex;
+  std::condition_variable m_lookaheadCondition;
+  std::map<Int, TemporalFilterLookaheadResult*> m_lookaheadResults;
+  Bool m_lookaheadDone;
+  Bool m_lookaheadStop;
+
   // Private functions
+  Bool isFilterFrame(const Int receivedPoc) const;
+  Bool filterPicture(const TComPicYuv &orgPic, const Int receivedPoc, TComPicYuv &filteredPic, Int *&qpMap);
+  Void lookaheadLoop();
+  Bool getLookaheadResult(TComPicYuv *orgPic, const Int receivedPoc);
+
   Void subsampleLuma(const TComPicYuv &input, TComPicYuv &output, const Int factor = 2) const;
   Int motionErrorLuma(const TComPicYuv &orig, const TComPicYuv &buffer, const Int x, const Int y, Int dx, Int dy, const Int bs, const Int besterror = 8 * 8 * 1024 * 1024) const;
   Void motionEstimationLuma(Array2D<MotionVector> &mvs, const TComPicYuv &orig, const TComPicYuv &buffer, const Int bs,
-      const Array2D<MotionVector> *previous=0, const Int factor = 1, const Bool doubleRes = false) const;
-  Void motionEstimation(Array2D<MotionVector> &mvs, const TComPicYuv &orgPic, const TComPicYuv &buffer, const TComPicYuv &origSubsampled2, const TComPicYuv &origSubsampled4) const;
+      const Array2D<MotionVector> *previous=0, const Int factor = 1, const Bool doubleRes = false);
+  Void motionEstimation(Array2D<MotionVector> &mvs, const TComPicYuv &orgPic, const TComPicYuv &buffer, const TComPicYuv &origSubsampled2, const TComPicYuv &origSubsampled4);
 
 #if JVET_V0056_MCTF
-  Void bilateralFilter(const TComPicYuv &orgPic, std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, TComPicYuv &newOrgPic, Double overallStrength) const;
+  Void bilateralFilter(const TComPicYuv &orgPic, std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, TComPicYuv &newOrgPic, Double overallStrength);
 #else
-  Void bilateralFilter(const TComPicYuv &orgPic, const std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, TComPicYuv &newOrgPic, Double overallStrength) const;
+  Void bilateralFilter(const TComPicYuv &orgPic, const std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, TComPicYuv &newOrgPic, Double overallStrength);
 #endif
   Void applyMotion(const Array2D<MotionVector> &mvs, const TComPicYuv &input, TComPicYuv &output) const;
 }; // END CLASS DEFINITION TEncTemporalFilter
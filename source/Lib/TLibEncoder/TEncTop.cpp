@@ -118,6 +118,16 @@ Void TEncTop::create ()
     m_cRateCtrl.init( m_framesToBeEncoded, m_RCTargetBitrate, (Int)( (Double)m_iFrameRate/m_temporalSubsampleRatio + 0.5), m_iGOPSize, m_iSourceWidth, m_iSourceHeight,
                       m_maxCUWidth, m_maxCUHeight,m_RCKeepHierarchicalBit, m_RCUseLCUSeparateModel, m_GOPList );
 #endif
+    if ( m_RCPass == 2 && !m_cRateCtrl.readPassStats( m_RCStatsFileName ) )
+    {
+      printf( "Unable to read the rate control statistics file %s\n", m_RCStatsFileName.c_str() );
+      exit( EXIT_FAILURE );
+    }
+  }
+  if ( m_RCPass == 1 && !m_cRateCtrl.openPassStats( m_RCStatsFileName ) )
+  {
+    printf( "Unable to create the rate control statistics file %s\n", m_RCStatsFileName.c_str() );
+    exit( EXIT_FAILURE );
   }
   
 
@@ -156,10 +166,12 @@ Void TEncTop::destroy ()
   m_cGOPEncoder.        destroy();
   m_cSliceEncoder.      destroy();
   m_cCuEncoder.         destroy();
+  m_cCtuStats.          close();
   m_cEncSAO.            destroyEncData();
   m_cEncSAO.            destroy();
   m_cLoopFilter.        destroy();
   m_cRateCtrl.          destroy();
+  m_cRateCtrl.          closePassStats();
   m_cSearch.            destroy();
   Int iDepth;
   for ( iDepth = 0; iDepth < m_maxTotalCUDepth+1; iDepth++ )
@@ -226,6 +238,7 @@ Void TEncTop::init(Bool isFieldCoding)
                    m_useRDOQ,
                    m_useRDOQTS,
                    m_useSelectiveRDOQ,
+                   m_useFastRDOQ,
                    true
                   ,m_useTransformSkipFast
 #if ADAPTIVE_QP_SELECTION
@@ -235,6 +248,13 @@ Void TEncTop::init(Bool isFieldCoding)
 
   // initialize encoder search class
   m_cSearch.init( this, &m_cTrQuant, m_iSearchRange, m_bipredSearchRange, m_motionEstimationSearchMethod, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth, &m_cEntropyCoder, &m_cRdCost, getRDSbacCoder(), getRDGoOnSbacCoder() );
+  m_cCuEncoder.createCandidateWorkers( this, sps0 );
+
+  if ( !m_ctuStatsFileName.empty() && !m_cCtuStats.open( m_ctuStatsFileName ) )
+  {
+    printf( "Unable to create the CTU statistics file %s\n", m_ctuStatsFileName.c_str() );
+    exit( EXIT_FAILURE );
+  }
 
   m_iMaxRefPicNum = 0;
 }
@@ -990,6 +1010,10 @@ Void TEncTop::xInitPPS(TComPPS &pps, const TComSPS &sps)
     bUseDQP = true;
   }
 #endif
+  if (m_cuTreeEnabled)
+  {
+    bUseDQP = true;
+  }
 
   if (m_costMode==COST_SEQUENCE_LEVEL_LOSSLESS || m_costMode==COST_LOSSLESS_CODING)
   {
@@ -1485,12 +1509,12 @@ Int TEncCfg::getQPForPicture(const UInt gopIndex, const TComSlice *pSlice) const
     {
       // Only adjust QP when not lossless
 #if JVET_Y0077_BIM
-      if (!((getMaxDeltaQP() == 0) && (!getLumaLevelToDeltaQPMapping().isEnabled()) && (!getSmoothQPReductionEnable()) && (!getBIM()) && (qp == -lumaQpBDOffset) && (pSlice->getPPS()->getTransquantBypassEnabledFlag())))
+      if (!((getMaxDeltaQP() == 0) && (!getLumaLevelToDeltaQPMapping().isEnabled()) && (!getSmoothQPReductionEnable()) && (!getBIM()) && (!getCuTree()) && (qp == -lumaQpBDOffset) && (pSlice->getPPS()->getTransquantBypassEnabledFlag())))
 #else
 #if JVET_V0078
-      if (!((getMaxDeltaQP() == 0) && (!getLumaLevelToDeltaQPMapping().isEnabled()) && (!getSmoothQPReductionEnable()) && (qp == -lumaQpBDOffset) && (pSlice->getPPS()->getTransquantBypassEnabledFlag())))
+      if (!((getMaxDeltaQP() == 0) && (!getLumaLevelToDeltaQPMapping().isEnabled()) && (!getSmoothQPReductionEnable()) && (!getCuTree()) && (qp == -lumaQpBDOffset) && (pSlice->getPPS()->getTransquantBypassEnabledFlag())))
 #else
-      if (!(( getMaxDeltaQP() == 0 ) && (!getLumaLevelToDeltaQPMapping().isEnabled()) && (qp == -lumaQpBDOffset ) && (pSlice->getPPS()->getTransquantBypassEnabledFlag())))
+      if (!(( getMaxDeltaQP() == 0 ) && (!getLumaLevelToDeltaQPMapping().isEnabled()) && (!getCuTree()) && (qp == -lumaQpBDOffset ) && (pSlice->getPPS()->getTransquantBypassEnabledFlag())))
 #endif
 #endif
       {
@@ -91,6 +91,7 @@ private:
   TEncGOP                 m_cGOPEncoder;                  ///< GOP encoder
   TEncSlice               m_cSliceEncoder;                ///< slice encoder
   TEncCu                  m_cCuEncoder;                   ///< CU encoder
+  TEncCtuStats            m_cCtuStats;                    ///< per-CTU statistics output
   // SPS
   ParameterSetMap<TComSPS> m_spsMap;                      ///< SPS. This is the base value. This is copied to TComPicSym
   ParameterSetMap<TComPPS> m_ppsMap;                      ///< PPS. This is the base value. This is copied to TComPicSym
@@ -144,6 +145,7 @@ public:
   TEncGOP*                getGOPEncoder         () { return  &m_cGOPEncoder;          }
   TEncSlice*              getSliceEncoder       () { return  &m_cSliceEncoder;        }
   TEncCu*                 getCuEncoder          () { return  &m_cCuEncoder;           }
+  TEncCtuStats*           getCtuStats           () { return  &m_cCtuStats;            }
   TEncEntropy*            getEntropyCoder       () { return  &m_cEntropyCoder;        }
   TEncCavlc*              getCavlcCoder         () { return  &m_cCavlcCoder;          }
   TEncSbac*               getSbacCoder          () { return  &m_cSbacCoder;           }
@@ -204,6 +206,16 @@ public:
   Void printSummary(Bool isField)
   {
     m_cGOPEncoder.printOutSummary (m_uiNumAllPicCoded, isField, getOutputLogControl(), m_spsMap.getFirstPS()->getBitDepths());
+    if (m_fastIntraGradient)
+    {
+      const UInt64 numPUs = m_cSearch.getGradientIntraNumPUs();
+      printf("\nGradient intra pre-selection: %.2f of %d luma modes tested per PU (%llu PUs)\n",
+             numPUs ? Double(m_cSearch.getGradientIntraNumModesTested()) / numPUs : 0.0, NUM_INTRA_MODE - 1, (unsigned long long)numPUs);
+    }
+    if (m_depthRangePrediction)
+    {
+      m_cCuEncoder.printDepthRangeStats();
+    }
   }
 
 };
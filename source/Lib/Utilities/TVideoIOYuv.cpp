@@ -41,6 +41,8 @@
 #include <sys/stat.h>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <streambuf>
 #include <memory.h>
 
 #include "TLibCommon/TComRom.h"
@@ -52,6 +54,59 @@ using namespace std;
 // Local Functions
 // ====================================================================================================================
 
+/// Read-only stream buffer over a registered memory file
+class MemoryFileBuf : public std::streambuf
+{
+public:
+  MemoryFileBuf(const UChar* data, size_t size)
+  {
+    TChar *begin = reinterpret_cast<TChar*>(const_cast<UChar*>(data));
+    setg(begin, begin, begin + size);
+  }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+  {
+    if ((which & std::ios_base::in) == 0)
+    {
+      return pos_type(off_type(-1));
+    }
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+    {
+      base = gptr() - eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      base = egptr() - eback();
+    }
+    return seekpos(pos_type(base + off), which);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+  {
+    const off_type offset = off_type(pos);
+    if ((which & std::ios_base::in) == 0 || offset < 0 || offset > egptr() - eback())
+    {
+      return pos_type(off_type(-1));
+    }
+    setg(eback(), eback() + offset, egptr());
+    return pos;
+  }
+};
+
+struct MemoryFile
+{
+  const UChar* data;
+  size_t       size;
+};
+
+static std::map<std::string, MemoryFile>& getMemoryFiles()
+{
+  static std::map<std::string, MemoryFile> memoryFiles;
+  return memoryFiles;
+}
+
 /**
  * Scale all pixels in img depending upon sign of shiftbits by a factor of
  * 2<sup>shiftbits</sup>.
@@ -140,8 +195,16 @@ Void TVideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int
     }
   }
 
+  xReleaseStream();
+
   if ( bWriteMode )
   {
+    if (getMemoryFiles().count(fileName) != 0)
+    {
+      printf("\nmemory file %s cannot be opened for writing\n", fileName.c_str());
+      exit(0);
+    }
+
     m_cHandle.open( fileName.c_str(), ios::binary | ios::out );
 
     if( m_cHandle.fail() )
@@ -152,6 +215,13 @@ Void TVideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int
   }
   else
   {
+    std::map<std::string, MemoryFile>::const_iterator memoryFile = getMemoryFiles().find(fileName);
+    if (memoryFile != getMemoryFiles().end())
+    {
+      m_pcStream = new iostream(new MemoryFileBuf(memoryFile->second.data, memoryFile->second.size));
+      return;
+    }
+
     m_cHandle.open( fileName.c_str(), ios::binary | ios::in );
 
     if( m_cHandle.fail() )
@@ -166,17 +236,57 @@ Void TVideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int
 
 Void TVideoIOYuv::close()
 {
-  m_cHandle.close();
+  if (m_pcStream != &m_cHandle)
+  {
+    xReleaseStream();
+  }
+  else
+  {
+    m_cHandle.close();
+  }
+}
+
+TVideoIOYuv::~TVideoIOYuv()
+{
+  xReleaseStream();
+}
+
+Void TVideoIOYuv::xReleaseStream()
+{
+  if (m_pcStream != &m_cHandle)
+  {
+    delete m_pcStream->rdbuf();
+    delete m_pcStream;
+    m_pcStream = &m_cHandle;
+  }
 }
 
 Bool TVideoIOYuv::isEof()
 {
-  return m_cHandle.eof();
+  return m_pcStream->eof();
 }
 
 Bool TVideoIOYuv::isFail()
 {
-  return m_cHandle.fail();
+  return m_pcStream->fail();
+}
+
+/**
+ * Register an in-memory file. Subsequent read-mode open() calls using fileName
+ * read from data instead of the file system, which allows the encoder (including
+ * the temporal filter and lookahead, which re-open the input by name) to be
+ * driven without disk I/O. The buffer is owned by the caller and must remain
+ * valid until every TVideoIOYuv reading it has been closed.
+ */
+Void TVideoIOYuv::registerMemoryFile(const std::string &fileName, const UChar* data, size_t size)
+{
+  MemoryFile memoryFile = { data, size };
+  getMemoryFiles()[fileName] = memoryFile;
+}
+
+Void TVideoIOYuv::unregisterMemoryFile(const std::string &fileName)
+{
+  getMemoryFiles().erase(fileName);
 }
 
 /**
@@ -211,20 +321,20 @@ Void TVideoIOYuv::skipFrames(Int numFrames, UInt width, UInt height, ChromaForma
   const streamoff offset = frameSize * numFrames;
 
   /* attempt to seek */
-  if (!!m_cHandle.seekg(offset, ios::cur))
+  if (!!m_pcStream->seekg(offset, ios::cur))
   {
     return; /* success */
   }
-  m_cHandle.clear();
+  m_pcStream->clear();
 
   /* fall back to consuming the input */
   TChar buf[512];
   const streamoff offset_mod_bufsize = offset % sizeof(buf);
   for (streamoff i = 0; i < offset - offset_mod_bufsize; i += sizeof(buf))
   {
-    m_cHandle.read(buf, sizeof(buf));
+    m_pcStream->read(buf, sizeof(buf));
   }
-  m_cHandle.read(buf, offset_mod_bufsize);
+  m_pcStream->read(buf, offset_mod_bufsize);
 }
 
 /**
@@ -718,7 +828,7 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
     const Pel minval = b709Compliance? ((   1 << (desired_bitdepth - 8))   ) : 0;
     const Pel maxval = b709Compliance? ((0xff << (desired_bitdepth - 8)) -1) : (1 << desired_bitdepth) - 1;
 
-    if (! readPlane(pPicYuv->getAddr(compID), m_cHandle, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType]))
+    if (! readPlane(pPicYuv->getAddr(compID), *m_pcStream, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType]))
     {
       return false;
     }
@@ -823,7 +933,7 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUser, const InputColourSpaceConversi
     const UInt csx = dstPicYuv->getComponentScaleX(compID);
     const UInt csy = dstPicYuv->getComponentScaleY(compID);
     const Int planeOffset =  (confLeft>>csx) + (confTop>>csy) * dstPicYuv->getStride(compID);
-    if (! writePlane(m_cHandle, dstPicYuv->getAddr(compID) + planeOffset, is16bit, stride444, width444, height444, compID, dstPicYuv->getChromaFormat(), format, m_fileBitdepth[ch]))
+    if (! writePlane(*m_pcStream, dstPicYuv->getAddr(compID) + planeOffset, is16bit, stride444, width444, height444, compID, dstPicYuv->getChromaFormat(), format, m_fileBitdepth[ch]))
     {
       retval=false;
     }
@@ -935,7 +1045,7 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUserTop, TComPicYuv* pPicYuvUserBott
     const UInt csy = dstPicYuvTop->getComponentScaleY(compID);
     const Int planeOffset  = (confLeft>>csx) + ( confTop>>csy) * dstPicYuvTop->getStride(compID); //offset is for entire frame - round up for top field and down for bottom field
 
-    if (! writeField(m_cHandle,
+    if (! writeField(*m_pcStream,
                      (dstPicYuvTop   ->getAddr(compID) + planeOffset),
                      (dstPicYuvBottom->getAddr(compID) + planeOffset),
                      is16bit,
@@ -55,13 +55,14 @@ class TVideoIOYuv
 {
 private:
   fstream   m_cHandle;                                      ///< file handle
+  iostream* m_pcStream;                                     ///< active stream: m_cHandle, or a reader over a registered memory file
   Int       m_fileBitdepth[MAX_NUM_CHANNEL_TYPE]; ///< bitdepth of input/output video file
   Int       m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];  ///< bitdepth after addition of MSBs (with value 0)
   Int       m_bitdepthShift[MAX_NUM_CHANNEL_TYPE];  ///< number of bits to increase or decrease image by before/after write/read
 
 public:
-  TVideoIOYuv()           {}
-  virtual ~TVideoIOYuv()  {}
+  TVideoIOYuv() : m_pcStream(&m_cHandle) {}
+  virtual ~TVideoIOYuv();
 
   Void  open  ( const std::string &fileName, Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] ); ///< open or create file
   Void  close ();                                           ///< close file
@@ -84,6 +85,12 @@ public:
   Bool  isEof ();                                           ///< check for end-of-file
   Bool  isFail();                                           ///< check for failure
 
+  // Registered names are opened (read mode only) from the caller-owned buffer instead of the file system.
+  static Void registerMemoryFile  ( const std::string &fileName, const UChar* data, size_t size ); ///< map fileName onto an in-memory buffer
+  static Void unregisterMemoryFile( const std::string &fileName );                                  ///< remove a mapping added by registerMemoryFile
+
+private:
+  Void  xReleaseStream();
 
 };
 
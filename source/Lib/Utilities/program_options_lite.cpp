@@ -586,8 +586,15 @@ namespace df
         error_reporter.error(filename) << "Failed to open config file\n";
         return;
       }
-      CfgStreamParser csp(filename, opts, error_reporter);
-      csp.scanStream(cfgstream);
+      parseConfigStream(opts, cfgstream, filename, error_reporter);
+    }
+
+    /* parse configuration lines from an arbitrary stream, reporting errors
+     * against the given name */
+    void parseConfigStream(Options& opts, istream& in, const string& name, ErrorReporter& error_reporter)
+    {
+      CfgStreamParser csp(name, opts, error_reporter);
+      csp.scanStream(in);
     }
 
   }